@@ -1,4 +1,52 @@
 #import <SpriteKit/SpriteKit.h>
+#import "SSKNodeSpatialIndex.h"
+#import "SSKTagMask.h"
+
+/**
+ *  A reusable query for nodes by their tag masks
+ *
+ *  @discussion Performing a query fills an index buffer owned by the query, which is only
+ *  reallocated when more nodes match than ever before, so a query kept around & performed
+ *  every frame doesn't allocate any memory. The found nodes are accessed using -nodeAtIndex:,
+ *  and are valid until the tag mask of any node changes, or a node with a tag mask is deallocated.
+ */
+@interface SSKTagMaskQuery : NSObject
+
+/**
+ *  The tag bits that a node must have set to match the query
+ */
+@property (nonatomic) uint64_t requiredMask;
+
+/**
+ *  The tag bits that a node must not have set to match the query
+ */
+@property (nonatomic) uint64_t excludedMask;
+
+/**
+ *  The number of nodes that matched the query when it was last performed
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *  Create a query with required & excluded masks
+ */
++ (instancetype)queryWithRequiredMask:(uint64_t)requiredMask excludedMask:(uint64_t)excludedMask;
+
+/**
+ *  Perform the query against the tag masks of all nodes
+ *
+ *  @return The number of nodes that matched the query
+ */
+- (NSUInteger)perform;
+
+/**
+ *  Get a node that matched the query when it was last performed
+ *
+ *  @param index The index of the node, which must be less than the query's count
+ */
+- (SKNode *)nodeAtIndex:(NSUInteger)index;
+
+@end
 
 /**
  *  Category that adds tag support to instances of SKNode
@@ -7,14 +55,36 @@
  *  integer identifiers, and query for a node's child nodes,
  *  or nodes at a point, that has a certain tag.
  *
- *  This category uses SKNode's userData dictionary to store
- *  the tag information, and thus requires other categories
- *  and node classes using this category to be good citizens
- *  regarding this dictionary. That is, not overwrite it
- *  when initialized, and instead just appending data to it.
+ *  A node's tag is stored unboxed, in an object associated with the node.
+ *  For compatibility, it's also mirrored into SKNode's userData dictionary,
+ *  under the key "SuperSpriteKit_Tag", which requires other categories and
+ *  node classes using this category to be good citizens regarding this
+ *  dictionary. That is, not overwrite it when initialized, and instead just
+ *  appending data to it.
+ *
+ *  Each node tree has an index, owned by its root node (normally the scene),
+ *  which maps each (non-zero) tag to the nodes in the tree that have it. A
+ *  tree is indexed on its first recursive lookup, and its index is then kept
+ *  up to date when a tag is set, and when nodes are added to or removed from
+ *  the tree (the methods doing so are exchanged with versions that move the
+ *  tagged nodes of the affected subtree, at a cost proportional to its size).
+ *  Recursive lookups only look at the nodes in the tree's index that have the
+ *  requested tag, so their cost is proportional to the number of those nodes,
+ *  rather than to the size of the tree.
+ *
+ *  Tags loaded from an archive, copied along with the userData dictionary,
+ *  or set by assigning a new userData dictionary, are picked up when their
+ *  tree is indexed or when their nodes are added to an indexed tree. Only
+ *  tags written into an existing userData dictionary of a node that is
+ *  already in an indexed tree require calling -ssk_rebuildTagIndex.
  *
- *  The tag will be stored under the key "SuperSpriteKit_Tag"
- *  in the node's userData dictionary.
+ *  Nodes can also have a 64-bit tag mask, for category-style queries
+ *  (like "enemy AND visible AND NOT dead"). The masks of all nodes are
+ *  stored in a single packed array (see SSKTagMaskTable), which queries
+ *  scan using vectorized code. Tags & tag masks should only be used from
+ *  the main thread.
+ *
+ *  This category depends on SSKNodeSpatialIndex & SSKTagMask.
  */
 @interface SKNode (SSKTags)
 
@@ -25,6 +95,36 @@
  */
 @property (nonatomic, setter = ssk_setTag:) NSInteger ssk_tag;
 
+/**
+ *  The node's tag mask, where each bit represents a tag
+ *
+ *  @discussion Defaults to 0. Nodes with a non-zero mask take up a slot in
+ *  the packed tag mask array, which is freed when the mask is set to 0, or
+ *  when the node is deallocated. Tag masks are independent of ssk_tag.
+ */
+@property (nonatomic, setter = ssk_setTagMask:) uint64_t ssk_tagMask;
+
+/**
+ *  Get all nodes that have all of the required, and none of the excluded, tag bits set
+ *
+ *  @param requiredMask The tag bits that a node must have set
+ *  @param excludedMask The tag bits that a node must not have set
+ *
+ *  @discussion Only nodes with a non-zero tag mask are returned, regardless of
+ *  whether they're part of a node tree. To avoid allocating a new array on every
+ *  call, use an SSKTagMaskQuery instead.
+ */
++ (NSArray *)ssk_nodesWithTagMask:(uint64_t)requiredMask excludingTagMask:(uint64_t)excludedMask;
+
+/**
+ *  Get all nodes within this node's tree hierarchy that have all of the required,
+ *  and none of the excluded, tag bits set
+ *
+ *  @param requiredMask The tag bits that a node must have set
+ *  @param excludedMask The tag bits that a node must not have set
+ */
+- (NSArray *)ssk_childNodesWithTagMask:(uint64_t)requiredMask excludingTagMask:(uint64_t)excludedMask;
+
 /**
  *  Get the first direct child node of this node that has a certain tag
  *
@@ -42,10 +142,13 @@
  *  @param tag The tag to look for
  *  @param recursive Whether a recrusive search should be performed
  *
- *  @discussion Since a full recurisve search can be quite expensive to
- *  perform (especially when complex and deep node trees are used), consider
- *  disabling recursive searching if only the direct children of this node
- *  should be searched.
+ *  @discussion A non-recursive search returns the first matching child, in the
+ *  order of the node's children. A recursive search returns the same node as
+ *  a depth-first search, that looks at all children of a node before descending
+ *  into them. For non-zero tags, it uses the tag index, and only descends into
+ *  the branches of the tree that lead to a matching node. Searching for nodes
+ *  with the tag 0 (untagged nodes) requires a search through the node's tree
+ *  hierarchy, which can be quite expensive to perform recursively.
  */
 - (SKNode *)ssk_childNodeWithTag:(NSInteger)tag recursive:(BOOL)recursive;
 
@@ -64,11 +167,12 @@
  *  @param tag The tag to look for
  *  @param recursive Whether a recrusive search should be performed
  *
- *  @discussion Since a full recurisve search can be quite expensive to
- *  perform (especially when complex and deep node trees are used), consider
- *  disabling recursive searching if only the direct children of this node
- *  should be searched, or use the -ssk_childNodeWithTag:recursive: API, to
- *  return the first found child who has the tag that is being searched for.
+ *  @discussion A non-recursive search returns the matching children in the
+ *  order of the node's children. For non-zero tags, a recursive search uses
+ *  the tag index, so its cost is proportional to the number of nodes that
+ *  have the tag, and the nodes are returned in no particular order. Searching
+ *  for nodes with the tag 0 (untagged nodes) requires a search through the
+ *  node's tree hierarchy.
  */
 - (NSArray *)ssk_childNodesWithTag:(NSInteger)tag recursive:(BOOL)recursive;
 
@@ -77,9 +181,87 @@
  *
  *  @param tag The tag to look for
  *
- *  @discussion This method will find nodes in the node's full tree hierarchy,
- *  using SpriteKit's built-in -nodesAtPoint:.
+ *  @discussion This method will find nodes in the node's full tree hierarchy.
+ *  If a spatial index has been enabled for the tag on this node, only the nodes
+ *  near the point are looked at, using the frames that the nodes had when the
+ *  index was last updated. Otherwise, SpriteKit's built-in -nodesAtPoint: is used.
  */
 - (NSArray *)ssk_nodesAtPoint:(CGPoint)point withTag:(NSInteger)tag;
 
+/**
+ *  Get all child nodes whose accumulated frame intersects a rect, that has a certain tag
+ *
+ *  @param rect The rect to look for nodes in, in this node's coordinate space
+ *  @param tag The tag to look for
+ *
+ *  @discussion This method will find nodes in the node's full tree hierarchy.
+ *  If a spatial index has been enabled for the tag on this node, only the nodes
+ *  near the rect are looked at. Otherwise, all nodes with the tag are tested.
+ */
+- (NSArray *)ssk_nodesInRect:(CGRect)rect withTag:(NSInteger)tag;
+
+/**
+ *  Enable a spatial index of the nodes with a certain tag in this node's tree hierarchy
+ *
+ *  @param tag The tag to index
+ *  @param cellSize The size of each cell of the index. For best results, use a cell size
+ *  that is around the size of a typical node with the tag.
+ *
+ *  @discussion The index is a uniform grid (see SSKSpatialGrid) of the nodes' accumulated
+ *  frames, in this node's coordinate space. It makes -ssk_nodesAtPoint:withTag: and
+ *  -ssk_nodesInRect:withTag: only look at nodes near the queried point or rect.
+ *
+ *  Since nodes can be moved by actions & physics without SuperSpriteKit knowing about it,
+ *  call -ssk_updateSpatialIndexes once per frame (for example from your scene's
+ *  -didFinishUpdate), after your nodes have moved. Nodes that stay within the same
+ *  cells of the grid are updated in place.
+ */
+- (void)ssk_enableSpatialIndexForTag:(NSInteger)tag cellSize:(CGFloat)cellSize;
+
+/**
+ *  Disable a spatial index previously enabled using -ssk_enableSpatialIndexForTag:cellSize:
+ */
+- (void)ssk_disableSpatialIndexForTag:(NSInteger)tag;
+
+/**
+ *  Update all spatial indexes enabled on this node with the current frames of their nodes
+ *
+ *  @discussion Nodes that have been given or lost the tag of an index, or added to
+ *  or removed from this node's tree hierarchy, are also added to or removed from it.
+ */
+- (void)ssk_updateSpatialIndexes;
+
+/**
+ *  Rebuild the tag index of this node's tree hierarchy
+ *
+ *  @discussion Call this method after writing tags directly into the existing
+ *  userData dictionary of nodes, to make those tags visible to recursive
+ *  searches using the -ssk_childNodesWithTag: family of APIs.
+ */
+- (void)ssk_rebuildTagIndex;
+
+/**
+ *  Search this node's full tree hierarchy for nodes that has a certain tag, using all cores
+ *
+ *  @param tag The tag to look for
+ *  @param returnOnFirstMatch Whether the search should stop as soon as a node was found
+ *
+ *  @discussion Unlike the -ssk_childNodesWithTag: family of APIs, this method doesn't use
+ *  the tag index, and reads the tag of every node instead, which makes it useful for checking
+ *  the results of the index.
+ *
+ *  The tags of the tree are first copied into a flat array on the calling thread, which is
+ *  then split into chunks that are searched concurrently (see SSKTagSnapshot). No node is
+ *  accessed from any other thread, but since the tree is read while taking the copy, this
+ *  method must be called from the thread that owns the tree (normally the main thread).
+ *  The found nodes are returned in depth-first order, so when returning on the first match,
+ *  the same node is found as by a serial depth-first search.
+ *
+ *  Note that this method is slower than a serial search of the tree. Taking the copy visits
+ *  every node on the calling thread, which costs more than comparing their tags there would,
+ *  so only the (cheap) search of the copy gets faster with more cores. For lookups, use the
+ *  -ssk_childNodesWithTag: family of APIs instead. SSKTagSearchBenchmark measures the whole call.
+ */
+- (NSArray *)ssk_concurrentlySearchChildNodesWithTag:(NSInteger)tag returnOnFirstMatch:(BOOL)returnOnFirstMatch;
+
 @end
@@ -1,23 +1,473 @@
 #import "SKNode+SSKTags.h"
+#import <objc/runtime.h>
+#import "SSKTagSnapshot.h"
 
 static NSString * const SSKTagStorageKey = @"SuperSpriteKit_Tag";
+static char SSKTagRecordKey;
+static char SSKTagRootIndexKey;
+static char SSKTagSpatialIndexesKey;
+static char SSKTagMaskSlotKey;
+
+// The number of tree mutations in progress, so that mutations SpriteKit implements using other mutations are only handled once
+static NSUInteger SSKTagsTreeMutationDepth;
+
+// The masks of all nodes that have one, and the slots owning them, at the same indices
+static SSKTagMaskTable SSKTagMasks;
+static void **SSKTagMaskSlots;
+static size_t SSKTagMaskSlotCapacity;
+
+#pragma mark - SSKTagRootIndex
+
+/**
+ *  The tagged nodes of a node tree, keyed by tag, owned by the root node of the tree
+ */
+@interface SSKTagRootIndex : NSObject
+
+@property (nonatomic, strong) NSMutableDictionary *nodesByTag;
+
+- (NSHashTable *)nodesWithTag:(NSInteger)tag;
+- (void)addNode:(SKNode *)node withTag:(NSInteger)tag;
+- (void)removeNode:(SKNode *)node withTag:(NSInteger)tag;
+
+@end
+
+@implementation SSKTagRootIndex
+
+- (instancetype)init
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    _nodesByTag = [NSMutableDictionary new];
+    
+    return self;
+}
+
+- (NSHashTable *)nodesWithTag:(NSInteger)tag
+{
+    return [self.nodesByTag objectForKey:@(tag)];
+}
+
+- (void)addNode:(SKNode *)node withTag:(NSInteger)tag
+{
+    if (tag == 0) {
+        return;
+    }
+    
+    NSHashTable *indexedNodes = [self.nodesByTag objectForKey:@(tag)];
+    
+    if (!indexedNodes) {
+        indexedNodes = [NSHashTable weakObjectsHashTable];
+        [self.nodesByTag setObject:indexedNodes forKey:@(tag)];
+    }
+    
+    [indexedNodes addObject:node];
+}
+
+- (void)removeNode:(SKNode *)node withTag:(NSInteger)tag
+{
+    if (tag == 0) {
+        return;
+    }
+    
+    NSHashTable *indexedNodes = [self.nodesByTag objectForKey:@(tag)];
+    [indexedNodes removeObject:node];
+    
+    if (indexedNodes && ![indexedNodes anyObject]) {
+        [self.nodesByTag removeObjectForKey:@(tag)];
+    }
+}
+
+@end
+
+#pragma mark - SSKTagRecord
+
+/**
+ *  The tag of a node, stored unboxed in an object owned by the node
+ *
+ *  @discussion The record also references the root index that the node is currently in,
+ *  which is nil if the node's tree hasn't been indexed yet.
+ */
+@interface SSKTagRecord : NSObject
+{
+    @public
+    NSInteger _tag;
+    __weak SSKTagRootIndex *_rootIndex;
+}
+
+@end
+
+@implementation SSKTagRecord
+
+@end
+
+#pragma mark - C Utilities
+
+static void SSKTagsSwizzleMethod(SEL originalSelector, SEL swizzledSelector)
+{
+    Method originalMethod = class_getInstanceMethod([SKNode class], originalSelector);
+    Method swizzledMethod = class_getInstanceMethod([SKNode class], swizzledSelector);
+    
+    method_exchangeImplementations(originalMethod, swizzledMethod);
+}
+
+static SKNode *SSKTagsGetRootOfNode(SKNode *node)
+{
+    while (node.parent) {
+        node = node.parent;
+    }
+    
+    return node;
+}
+
+static SSKTagRecord *SSKTagsGetRecordOfNode(SKNode *node, BOOL adoptStoredTag)
+{
+    SSKTagRecord *record = objc_getAssociatedObject(node, &SSKTagRecordKey);
+    
+    if (record || !adoptStoredTag) {
+        return record;
+    }
+    
+    // Tags can also be written directly to the userData dictionary, or be copied or decoded along with it
+    NSInteger storedTag = [[node.userData objectForKey:SSKTagStorageKey] integerValue];
+    
+    if (storedTag == 0) {
+        return nil;
+    }
+    
+    record = [SSKTagRecord new];
+    record->_tag = storedTag;
+    objc_setAssociatedObject(node, &SSKTagRecordKey, record, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    
+    return record;
+}
+
+static void SSKTagsMoveNodeToRootIndex(SKNode *node, SSKTagRecord *record, SSKTagRootIndex *rootIndex)
+{
+    SSKTagRootIndex *previousRootIndex = record->_rootIndex;
+    
+    if (previousRootIndex == rootIndex) {
+        return;
+    }
+    
+    [previousRootIndex removeNode:node withTag:record->_tag];
+    [rootIndex addNode:node withTag:record->_tag];
+    record->_rootIndex = rootIndex;
+}
+
+static void SSKTagsMoveSubtreeToRootIndex(SKNode *subtreeRoot, SSKTagRootIndex *rootIndex)
+{
+    // Using an explicit stack, since trees can be very deep
+    NSMutableArray *stack = [NSMutableArray arrayWithObject:subtreeRoot];
+    
+    while ([stack count] > 0) {
+        SKNode *node = [stack lastObject];
+        [stack removeLastObject];
+        
+        SSKTagRecord *record = SSKTagsGetRecordOfNode(node, YES);
+        
+        if (record) {
+            SSKTagsMoveNodeToRootIndex(node, record, rootIndex);
+        }
+        
+        [stack addObjectsFromArray:node.children];
+    }
+}
+
+static SSKTagRootIndex *SSKTagsGetRootIndexOfTree(SKNode *root, BOOL createIfNeeded)
+{
+    SSKTagRootIndex *rootIndex = objc_getAssociatedObject(root, &SSKTagRootIndexKey);
+    
+    if (!rootIndex && createIfNeeded) {
+        rootIndex = [SSKTagRootIndex new];
+        objc_setAssociatedObject(root, &SSKTagRootIndexKey, rootIndex, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        
+        // A tree is indexed on its first lookup, which also picks up any tags that were loaded from an archive
+        SSKTagsMoveSubtreeToRootIndex(root, rootIndex);
+    }
+    
+    return rootIndex;
+}
+
+static void SSKTagsHandleNodeMovedFromTree(SKNode *node, SKNode *previousRoot)
+{
+    SKNode *root = SSKTagsGetRootOfNode(node);
+    
+    if (root == previousRoot) {
+        return;
+    }
+    
+    SSKTagRootIndex *previousRootIndex = SSKTagsGetRootIndexOfTree(previousRoot, NO);
+    SSKTagRootIndex *rootIndex = SSKTagsGetRootIndexOfTree(root, NO);
+    
+    if (previousRoot == node) {
+        // The node's own tree was attached to another one, so its index is no longer needed
+        objc_setAssociatedObject(node, &SSKTagRootIndexKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        
+        // If the other tree isn't indexed either, its nodes will be picked up when it is
+        if (!rootIndex) {
+            return;
+        }
+    } else if (!previousRootIndex && !rootIndex) {
+        return;
+    }
+    
+    SSKTagsMoveSubtreeToRootIndex(node, rootIndex);
+}
+
+static BOOL SSKTagsIsNodeDescendantOfNode(SKNode *node, SKNode *ancestor)
+{
+    for (SKNode *parent = node.parent; parent; parent = parent.parent) {
+        if (parent == ancestor) {
+            return YES;
+        }
+    }
+    
+    return NO;
+}
+
+static void SSKTagsAddAncestorsOfNodeToSet(SKNode *node, SKNode *ancestor, NSHashTable *ancestors)
+{
+    // Stopping at the first ancestor already in the set, since all of its own ancestors are in it too
+    for (SKNode *parent = node.parent; parent != ancestor; parent = parent.parent) {
+        if ([ancestors containsObject:parent]) {
+            return;
+        }
+        
+        [ancestors addObject:parent];
+    }
+}
+
+static SKNode *SSKTagsGetFirstNodeInTreeOrder(SKNode *node, NSHashTable *nodes, NSHashTable *ancestors)
+{
+    NSArray *children = node.children;
+    
+    // Follows the order of a plain recursive search, which looks at all children before descending into any of them
+    for (SKNode *child in children) {
+        if ([nodes containsObject:child]) {
+            return child;
+        }
+    }
+    
+    for (SKNode *child in children) {
+        if (![ancestors containsObject:child]) {
+            continue;
+        }
+        
+        SKNode *firstNode = SSKTagsGetFirstNodeInTreeOrder(child, nodes, ancestors);
+        
+        if (firstNode) {
+            return firstNode;
+        }
+    }
+    
+    return nil;
+}
+
+static BOOL SSKTagsAppendDescendantsToSnapshot(SKNode *node, NSMutableArray *nodes, SSKTagSnapshot *snapshot)
+{
+    // Using an explicit stack (with children pushed in reverse) to visit the nodes depth-first, since trees can be very deep
+    NSMutableArray *stack = [NSMutableArray new];
+    
+    for (SKNode *child in [node.children reverseObjectEnumerator]) {
+        [stack addObject:child];
+    }
+    
+    while ([stack count] > 0) {
+        SKNode *descendant = [stack lastObject];
+        [stack removeLastObject];
+        
+        SSKTagRecord *record = SSKTagsGetRecordOfNode(descendant, NO);
+        
+        if (!SSKTagSnapshotAppend(snapshot, record ? record->_tag : descendant.ssk_tag)) {
+            return NO;
+        }
+        
+        [nodes addObject:descendant];
+        
+        for (SKNode *child in [descendant.children reverseObjectEnumerator]) {
+            [stack addObject:child];
+        }
+    }
+    
+    return YES;
+}
+
+#pragma mark - SSKTagMaskSlot
+
+/**
+ *  The slot of a node in the tag mask table, owned by the node
+ *
+ *  @discussion Since the slot is released as part of deallocating its node, the node's
+ *  mask is removed from the table as soon as the node goes away. A slot that has been
+ *  removed from the table has the index SIZE_MAX.
+ */
+@interface SSKTagMaskSlot : NSObject
+
+@property (nonatomic, weak) SKNode *node;
+@property (nonatomic) size_t index;
+
+- (void)removeFromTable;
+
+@end
+
+@implementation SSKTagMaskSlot
+
+- (void)dealloc
+{
+    [self removeFromTable];
+}
+
+- (void)removeFromTable
+{
+    if (self.index == SIZE_MAX) {
+        return;
+    }
+    
+    const size_t lastIndex = SSKTagMasks.count - 1;
+    
+    SSKTagMaskTableRemove(&SSKTagMasks, self.index);
+    
+    if (self.index != lastIndex) {
+        SSKTagMaskSlot *movedSlot = (__bridge SSKTagMaskSlot *)SSKTagMaskSlots[lastIndex];
+        movedSlot.index = self.index;
+        
+        SSKTagMaskSlots[self.index] = SSKTagMaskSlots[lastIndex];
+    }
+    
+    self.index = SIZE_MAX;
+}
+
+@end
+
+#pragma mark - SSKTagMaskQuery
+
+@interface SSKTagMaskQuery()
+
+@property (nonatomic, readwrite) NSUInteger count;
+
+@end
+
+@implementation SSKTagMaskQuery
+{
+    size_t *_indices;
+    size_t _indexCapacity;
+}
+
++ (instancetype)queryWithRequiredMask:(uint64_t)requiredMask excludedMask:(uint64_t)excludedMask
+{
+    SSKTagMaskQuery *query = [self new];
+    query.requiredMask = requiredMask;
+    query.excludedMask = excludedMask;
+    
+    return query;
+}
+
+- (void)dealloc
+{
+    free(_indices);
+}
+
+- (NSUInteger)perform
+{
+    size_t matchCount = SSKTagMaskTableQuery(&SSKTagMasks, self.requiredMask, self.excludedMask, _indices, _indexCapacity);
+    
+    if (matchCount > _indexCapacity) {
+        size_t *indices = realloc(_indices, SSKTagMasks.count * sizeof(size_t));
+        
+        if (!indices) {
+            self.count = 0;
+            return 0;
+        }
+        
+        _indices = indices;
+        _indexCapacity = SSKTagMasks.count;
+        
+        matchCount = SSKTagMaskTableQuery(&SSKTagMasks, self.requiredMask, self.excludedMask, _indices, _indexCapacity);
+    }
+    
+    self.count = matchCount;
+    
+    return matchCount;
+}
+
+- (SKNode *)nodeAtIndex:(NSUInteger)index
+{
+    if (index >= self.count || _indices[index] >= SSKTagMasks.count) {
+        return nil;
+    }
+    
+    return ((__bridge SSKTagMaskSlot *)SSKTagMaskSlots[_indices[index]]).node;
+}
+
+@end
+
+#pragma mark - SKNode (SSKTags)
 
 @implementation SKNode (SSKTags)
 
++ (void)load
+{
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        SSKTagsSwizzleMethod(@selector(addChild:), @selector(ssk_tagIndexAddChild:));
+        SSKTagsSwizzleMethod(@selector(insertChild:atIndex:), @selector(ssk_tagIndexInsertChild:atIndex:));
+        SSKTagsSwizzleMethod(@selector(removeFromParent), @selector(ssk_tagIndexRemoveFromParent));
+        SSKTagsSwizzleMethod(@selector(removeAllChildren), @selector(ssk_tagIndexRemoveAllChildren));
+        SSKTagsSwizzleMethod(@selector(removeChildrenInArray:), @selector(ssk_tagIndexRemoveChildrenInArray:));
+        SSKTagsSwizzleMethod(@selector(moveToParent:), @selector(ssk_tagIndexMoveToParent:));
+        SSKTagsSwizzleMethod(@selector(setUserData:), @selector(ssk_tagIndexSetUserData:));
+    });
+}
+
 #pragma mark - Public
 
 - (NSInteger)ssk_tag
 {
-    return [[self.userData objectForKey:SSKTagStorageKey] unsignedIntegerValue];
+    SSKTagRecord *record = objc_getAssociatedObject(self, &SSKTagRecordKey);
+    
+    if (record) {
+        return record->_tag;
+    }
+    
+    // Tags written directly to the userData dictionary, or loaded from an archive, don't have a record yet
+    return [[self.userData objectForKey:SSKTagStorageKey] integerValue];
 }
 
 - (void)ssk_setTag:(NSInteger)tag
 {
-    if (!self.userData) {
-        self.userData = [NSMutableDictionary new];
+    SSKTagRecord *record = SSKTagsGetRecordOfNode(self, NO);
+    
+    // A tag that only exists in userData isn't in any index yet, so it doesn't need to be removed from one
+    if (!record) {
+        record = [SSKTagRecord new];
+        objc_setAssociatedObject(self, &SSKTagRecordKey, record, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    } else if (record->_tag == tag) {
+        return;
+    }
+    
+    SSKTagRootIndex *rootIndex = record->_rootIndex;
+    
+    // Nodes that were never tagged before haven't been added to the index of their tree yet
+    if (!rootIndex) {
+        rootIndex = SSKTagsGetRootIndexOfTree(SSKTagsGetRootOfNode(self), NO);
+        record->_rootIndex = rootIndex;
     }
     
-    [self.userData setObject:@(tag) forKey:SSKTagStorageKey];
+    [rootIndex removeNode:self withTag:record->_tag];
+    record->_tag = tag;
+    [rootIndex addNode:self withTag:tag];
+    
+    // The userData dictionary mirrors the tag, for compatibility with code that reads it from there
+    NSMutableDictionary *userData = self.userData;
+    
+    if (userData) {
+        [userData setObject:@(tag) forKey:SSKTagStorageKey];
+    } else {
+        self.userData = [NSMutableDictionary dictionaryWithObject:@(tag) forKey:SSKTagStorageKey];
+    }
 }
 
 - (SKNode *)ssk_childNodeWithTag:(NSInteger)tag
@@ -48,42 +498,404 @@ static NSString * const SSKTagStorageKey = @"SuperSpriteKit_Tag";
 
 - (NSArray *)ssk_nodesAtPoint:(CGPoint)point withTag:(NSInteger)tag
 {
-    NSArray *nodesAtPoint = [self nodesAtPoint:point];
-    NSPredicate *tagPredicate = [NSPredicate predicateWithFormat:@"ssk_tag == %d", (long)tag];
+    SSKNodeSpatialIndex *spatialIndex = [[self ssk_spatialIndexesCreateIfNeeded:NO] objectForKey:@(tag)];
+    
+    if (spatialIndex) {
+        return [spatialIndex nodesInRect:CGRectMake(point.x, point.y, 0, 0)];
+    }
     
-    return [nodesAtPoint filteredArrayUsingPredicate:tagPredicate];
+    NSMutableArray *foundNodes = [NSMutableArray new];
+    
+    for (SKNode *node in [self nodesAtPoint:point]) {
+        if (node.ssk_tag == tag) {
+            [foundNodes addObject:node];
+        }
+    }
+    
+    return [foundNodes copy];
 }
 
-#pragma mark - Private
+- (NSArray *)ssk_nodesInRect:(CGRect)rect withTag:(NSInteger)tag
+{
+    SSKNodeSpatialIndex *spatialIndex = [[self ssk_spatialIndexesCreateIfNeeded:NO] objectForKey:@(tag)];
+    
+    if (spatialIndex) {
+        return [spatialIndex nodesInRect:rect];
+    }
+    
+    NSMutableArray *foundNodes = [NSMutableArray new];
+    
+    for (SKNode *node in [self ssk_childNodesWithTag:tag recursive:YES]) {
+        if (CGRectIntersectsRect(SSKNodeGetFrameInNode(node, self), rect)) {
+            [foundNodes addObject:node];
+        }
+    }
+    
+    return [foundNodes copy];
+}
 
-- (NSArray *)ssk_childNodesWithTag:(NSInteger)tag recursive:(BOOL)recursive returnOnFirstMatch:(BOOL)returnOnFirstMatch
+- (void)ssk_enableSpatialIndexForTag:(NSInteger)tag cellSize:(CGFloat)cellSize
 {
-    NSPredicate *tagPredicate = [NSPredicate predicateWithFormat:@"ssk_tag == %d", (long)tag];
-    NSArray *directChildMatches = [self.children filteredArrayUsingPredicate:tagPredicate];
+    SSKNodeSpatialIndex *spatialIndex = [[SSKNodeSpatialIndex alloc] initWithCellSize:cellSize];
+    [spatialIndex updateWithNodes:[self ssk_childNodesWithTag:tag recursive:YES] inNode:self];
     
-    if (!recursive) {
-        return directChildMatches;
+    [[self ssk_spatialIndexesCreateIfNeeded:YES] setObject:spatialIndex forKey:@(tag)];
+}
+
+- (void)ssk_disableSpatialIndexForTag:(NSInteger)tag
+{
+    [[self ssk_spatialIndexesCreateIfNeeded:NO] removeObjectForKey:@(tag)];
+}
+
+- (void)ssk_updateSpatialIndexes
+{
+    NSDictionary *spatialIndexes = [self ssk_spatialIndexesCreateIfNeeded:NO];
+    
+    for (NSNumber *tag in spatialIndexes) {
+        SSKNodeSpatialIndex *spatialIndex = [spatialIndexes objectForKey:tag];
+        [spatialIndex updateWithNodes:[self ssk_childNodesWithTag:[tag integerValue] recursive:YES] inNode:self];
     }
+}
+
+- (uint64_t)ssk_tagMask
+{
+    SSKTagMaskSlot *slot = objc_getAssociatedObject(self, &SSKTagMaskSlotKey);
     
-    if (returnOnFirstMatch && [directChildMatches count] > 0) {
-        return directChildMatches;
+    return slot ? SSKTagMasks.masks[slot.index] : 0;
+}
+
+- (void)ssk_setTagMask:(uint64_t)tagMask
+{
+    SSKTagMaskSlot *slot = objc_getAssociatedObject(self, &SSKTagMaskSlotKey);
+    
+    if (slot) {
+        if (tagMask != 0) {
+            SSKTagMasks.masks[slot.index] = tagMask;
+        } else {
+            // Removed right away, rather than when the slot is deallocated, since it might have been autoreleased
+            [slot removeFromTable];
+            objc_setAssociatedObject(self, &SSKTagMaskSlotKey, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+        
+        return;
     }
     
-    NSMutableArray *foundNodes = [directChildMatches mutableCopy];
+    if (tagMask == 0) {
+        return;
+    }
     
-    for (SKNode *child in self.children) {
-        NSArray *childMatches = [child ssk_childNodesWithTag:tag
-                                                   recursive:YES
-                                          returnOnFirstMatch:returnOnFirstMatch];
+    if (SSKTagMasks.count == SSKTagMaskSlotCapacity) {
+        size_t capacity = SSKTagMaskSlotCapacity > 0 ? SSKTagMaskSlotCapacity * 2 : 64;
+        void **slots = realloc(SSKTagMaskSlots, capacity * sizeof(void *));
         
-        if (returnOnFirstMatch && [childMatches count] > 0) {
-            return childMatches;
+        if (!slots) {
+            return;
         }
         
-        [foundNodes addObjectsFromArray:childMatches];
+        SSKTagMaskSlots = slots;
+        SSKTagMaskSlotCapacity = capacity;
+    }
+    
+    size_t index = SSKTagMaskTableAdd(&SSKTagMasks, tagMask);
+    
+    if (index == SIZE_MAX) {
+        return;
+    }
+    
+    slot = [SSKTagMaskSlot new];
+    slot.node = self;
+    slot.index = index;
+    
+    SSKTagMaskSlots[index] = (__bridge void *)slot;
+    objc_setAssociatedObject(self, &SSKTagMaskSlotKey, slot, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+}
+
++ (NSArray *)ssk_nodesWithTagMask:(uint64_t)requiredMask excludingTagMask:(uint64_t)excludedMask
+{
+    return [self ssk_nodesWithTagMask:requiredMask excludingTagMask:excludedMask inNode:nil];
+}
+
+- (NSArray *)ssk_childNodesWithTagMask:(uint64_t)requiredMask excludingTagMask:(uint64_t)excludedMask
+{
+    return [SKNode ssk_nodesWithTagMask:requiredMask excludingTagMask:excludedMask inNode:self];
+}
+
+- (NSArray *)ssk_concurrentlySearchChildNodesWithTag:(NSInteger)tag returnOnFirstMatch:(BOOL)returnOnFirstMatch
+{
+    NSMutableArray *nodes = [NSMutableArray new];
+    SSKTagSnapshot snapshot;
+    SSKTagSnapshotInit(&snapshot);
+    
+    // SKNode isn't thread safe, so the tree is only read on this thread, and the other threads search a flat copy of its tags
+    if (!SSKTagsAppendDescendantsToSnapshot(self, nodes, &snapshot)
+        || !SSKTagSnapshotSearch(&snapshot, tag, returnOnFirstMatch, 0)) {
+        SSKTagSnapshotDestroy(&snapshot);
+        return @[];
     }
     
+    NSMutableArray *foundNodes = [NSMutableArray arrayWithCapacity:snapshot.matchCount];
+    
+    for (size_t matchIndex = 0; matchIndex < snapshot.matchCount; matchIndex++) {
+        [foundNodes addObject:[nodes objectAtIndex:snapshot.matches[matchIndex]]];
+    }
+    
+    SSKTagSnapshotDestroy(&snapshot);
+    
     return [foundNodes copy];
 }
 
+- (void)ssk_rebuildTagIndex
+{
+    SSKTagRecord *record = SSKTagsGetRecordOfNode(self, NO);
+    NSInteger storedTag = [[self.userData objectForKey:SSKTagStorageKey] integerValue];
+    
+    // The userData dictionary may have been modified directly, in which case its tag wins
+    if (record ? record->_tag != storedTag : storedTag != 0) {
+        [self ssk_setTag:storedTag];
+    }
+    
+    for (SKNode *child in self.children) {
+        [child ssk_rebuildTagIndex];
+    }
+}
+
+#pragma mark - Private
+
++ (NSArray *)ssk_nodesWithTagMask:(uint64_t)requiredMask excludingTagMask:(uint64_t)excludedMask inNode:(SKNode *)ancestor
+{
+    // Tag masks are only used from the main thread, so a single query (and its index buffer) is reused by all calls
+    static SSKTagMaskQuery *query;
+    
+    if (!query) {
+        query = [SSKTagMaskQuery new];
+    }
+    
+    query.requiredMask = requiredMask;
+    query.excludedMask = excludedMask;
+    
+    NSUInteger count = [query perform];
+    NSMutableArray *foundNodes = [NSMutableArray arrayWithCapacity:ancestor ? 0 : count];
+    
+    for (NSUInteger index = 0; index < count; index++) {
+        SKNode *node = [query nodeAtIndex:index];
+        
+        if (node && (!ancestor || SSKTagsIsNodeDescendantOfNode(node, ancestor))) {
+            [foundNodes addObject:node];
+        }
+    }
+    
+    // Returned without copying, since the array isn't referenced anywhere else
+    return foundNodes;
+}
+
+- (NSArray *)ssk_childNodesWithTag:(NSInteger)tag recursive:(BOOL)recursive returnOnFirstMatch:(BOOL)returnOnFirstMatch
+{
+    NSMutableArray *foundNodes = [NSMutableArray new];
+    
+    // Direct children are searched in order, and untagged nodes aren't indexed, so those can only be found by searching the tree
+    if (!recursive || tag == 0) {
+        [self ssk_appendChildNodesWithTag:tag
+                                recursive:recursive
+                       returnOnFirstMatch:returnOnFirstMatch
+                                  toArray:foundNodes];
+        
+        return [foundNodes copy];
+    }
+    
+    SKNode *root = SSKTagsGetRootOfNode(self);
+    NSHashTable *indexedNodes = [SSKTagsGetRootIndexOfTree(root, YES) nodesWithTag:tag];
+    NSMutableArray *staleNodes = nil;
+    
+    for (SKNode *node in indexedNodes) {
+        if (node == self) {
+            continue;
+        }
+        
+        if (SSKTagsIsNodeDescendantOfNode(node, self)) {
+            [foundNodes addObject:node];
+        } else if (self == root) {
+            // Nodes can be removed in ways that can't be observed (like by SKAction's removeFromParent), so entries are validated here
+            if (!staleNodes) {
+                staleNodes = [NSMutableArray new];
+            }
+            
+            [staleNodes addObject:node];
+        }
+    }
+    
+    for (SKNode *staleNode in staleNodes) {
+        SSKTagsMoveNodeToRootIndex(staleNode, SSKTagsGetRecordOfNode(staleNode, NO), nil);
+    }
+    
+    if (!returnOnFirstMatch || [foundNodes count] < 2) {
+        return [foundNodes copy];
+    }
+    
+    // The index is unordered, so the first match is found by searching only the branches of the tree that lead to a match
+    NSHashTable *nodes = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    NSHashTable *ancestors = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    
+    for (SKNode *node in foundNodes) {
+        [nodes addObject:node];
+        SSKTagsAddAncestorsOfNodeToSet(node, self, ancestors);
+    }
+    
+    return @[SSKTagsGetFirstNodeInTreeOrder(self, nodes, ancestors)];
+}
+
+- (BOOL)ssk_appendChildNodesWithTag:(NSInteger)tag recursive:(BOOL)recursive returnOnFirstMatch:(BOOL)returnOnFirstMatch toArray:(NSMutableArray *)foundNodes
+{
+    for (SKNode *child in self.children) {
+        if (child.ssk_tag == tag) {
+            [foundNodes addObject:child];
+            
+            if (returnOnFirstMatch) {
+                return YES;
+            }
+        }
+    }
+    
+    if (!recursive) {
+        return NO;
+    }
+    
+    for (SKNode *child in self.children) {
+        if ([child ssk_appendChildNodesWithTag:tag recursive:YES returnOnFirstMatch:returnOnFirstMatch toArray:foundNodes]) {
+            return YES;
+        }
+    }
+    
+    return NO;
+}
+
+#pragma mark - Tree mutation hooks
+
+/*
+ *  These methods are exchanged with SKNode's own implementations in +load, so calling
+ *  the "ssk_tagIndex" version of a method from within itself calls the original method.
+ *  Each of them moves the tagged nodes of the affected subtrees to the index of their
+ *  new tree, at a cost proportional to the size of those subtrees.
+ */
+
+- (void)ssk_tagIndexAddChild:(SKNode *)node
+{
+    SKNode *previousRoot = SSKTagsGetRootOfNode(node);
+    
+    SSKTagsTreeMutationDepth++;
+    [self ssk_tagIndexAddChild:node];
+    SSKTagsTreeMutationDepth--;
+    
+    if (SSKTagsTreeMutationDepth == 0) {
+        SSKTagsHandleNodeMovedFromTree(node, previousRoot);
+    }
+}
+
+- (void)ssk_tagIndexInsertChild:(SKNode *)node atIndex:(NSInteger)index
+{
+    SKNode *previousRoot = SSKTagsGetRootOfNode(node);
+    
+    SSKTagsTreeMutationDepth++;
+    [self ssk_tagIndexInsertChild:node atIndex:index];
+    SSKTagsTreeMutationDepth--;
+    
+    if (SSKTagsTreeMutationDepth == 0) {
+        SSKTagsHandleNodeMovedFromTree(node, previousRoot);
+    }
+}
+
+- (void)ssk_tagIndexRemoveFromParent
+{
+    SKNode *previousRoot = SSKTagsGetRootOfNode(self);
+    
+    SSKTagsTreeMutationDepth++;
+    [self ssk_tagIndexRemoveFromParent];
+    SSKTagsTreeMutationDepth--;
+    
+    if (SSKTagsTreeMutationDepth == 0) {
+        SSKTagsHandleNodeMovedFromTree(self, previousRoot);
+    }
+}
+
+- (void)ssk_tagIndexRemoveAllChildren
+{
+    SKNode *previousRoot = SSKTagsGetRootOfNode(self);
+    NSArray *children = [self.children copy];
+    
+    SSKTagsTreeMutationDepth++;
+    [self ssk_tagIndexRemoveAllChildren];
+    SSKTagsTreeMutationDepth--;
+    
+    if (SSKTagsTreeMutationDepth > 0) {
+        return;
+    }
+    
+    for (SKNode *child in children) {
+        SSKTagsHandleNodeMovedFromTree(child, previousRoot);
+    }
+}
+
+- (void)ssk_tagIndexRemoveChildrenInArray:(NSArray *)nodes
+{
+    SKNode *previousRoot = SSKTagsGetRootOfNode(self);
+    NSMutableArray *children = [NSMutableArray arrayWithCapacity:[nodes count]];
+    
+    for (SKNode *node in nodes) {
+        if (node.parent == self) {
+            [children addObject:node];
+        }
+    }
+    
+    SSKTagsTreeMutationDepth++;
+    [self ssk_tagIndexRemoveChildrenInArray:nodes];
+    SSKTagsTreeMutationDepth--;
+    
+    if (SSKTagsTreeMutationDepth > 0) {
+        return;
+    }
+    
+    for (SKNode *child in children) {
+        SSKTagsHandleNodeMovedFromTree(child, previousRoot);
+    }
+}
+
+- (void)ssk_tagIndexMoveToParent:(SKNode *)parent
+{
+    SKNode *previousRoot = SSKTagsGetRootOfNode(self);
+    
+    SSKTagsTreeMutationDepth++;
+    [self ssk_tagIndexMoveToParent:parent];
+    SSKTagsTreeMutationDepth--;
+    
+    if (SSKTagsTreeMutationDepth == 0) {
+        SSKTagsHandleNodeMovedFromTree(self, previousRoot);
+    }
+}
+
+- (void)ssk_tagIndexSetUserData:(NSMutableDictionary *)userData
+{
+    [self ssk_tagIndexSetUserData:userData];
+    
+    SSKTagRecord *record = SSKTagsGetRecordOfNode(self, NO);
+    NSInteger storedTag = [[userData objectForKey:SSKTagStorageKey] integerValue];
+    
+    // A replaced dictionary (for example one copied from another node) brings its own tag
+    if (record ? record->_tag != storedTag : storedTag != 0) {
+        [self ssk_setTag:storedTag];
+    }
+}
+
+#pragma mark - Spatial indexes
+
+- (NSMutableDictionary *)ssk_spatialIndexesCreateIfNeeded:(BOOL)createIfNeeded
+{
+    NSMutableDictionary *spatialIndexes = objc_getAssociatedObject(self, &SSKTagSpatialIndexesKey);
+    
+    if (!spatialIndexes && createIfNeeded) {
+        spatialIndexes = [NSMutableDictionary new];
+        objc_setAssociatedObject(self, &SSKTagSpatialIndexesKey, spatialIndexes, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    
+    return spatialIndexes;
+}
+
 @end
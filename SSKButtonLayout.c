@@ -0,0 +1,137 @@
+#include "SSKButtonLayout.h"
+
+#include <math.h>
+
+#ifdef __APPLE__
+#include <dispatch/dispatch.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define SSKButtonLayoutChunkSize 1024
+#define SSKButtonLayoutMaximumThreadCount 64
+
+#pragma mark - Utilities
+
+typedef struct {
+    const SSKButtonLayoutInput *inputs;
+    SSKButtonLayoutOutput *outputs;
+    size_t count;
+} SSKButtonLayoutBatch;
+
+static void SSKButtonLayoutComputeChunk(void *context, size_t chunkIndex)
+{
+    const SSKButtonLayoutBatch *batch = context;
+    const size_t start = chunkIndex * SSKButtonLayoutChunkSize;
+    const size_t end = start + SSKButtonLayoutChunkSize < batch->count ? start + SSKButtonLayoutChunkSize : batch->count;
+    
+    for (size_t index = start; index < end; index++) {
+        SSKButtonLayoutCompute(&batch->inputs[index], &batch->outputs[index]);
+    }
+}
+
+#ifndef __APPLE__
+
+typedef struct {
+    SSKButtonLayoutBatch *batch;
+    size_t chunkCount;
+    size_t threadIndex;
+    size_t threadCount;
+} SSKButtonLayoutWorker;
+
+static void *SSKButtonLayoutRunWorker(void *context)
+{
+    const SSKButtonLayoutWorker *worker = context;
+    
+    // Chunks are interleaved between the threads, since every chunk costs about the same
+    for (size_t chunkIndex = worker->threadIndex; chunkIndex < worker->chunkCount; chunkIndex += worker->threadCount) {
+        SSKButtonLayoutComputeChunk(worker->batch, chunkIndex);
+    }
+    
+    return NULL;
+}
+
+#endif
+
+#pragma mark - Button layout
+
+void SSKButtonLayoutCompute(const SSKButtonLayoutInput *input, SSKButtonLayoutOutput *output)
+{
+    output->iconX = 0;
+    output->iconY = 0;
+    output->titleIsLeftAligned = input->hasIcon;
+    
+    if (input->hasIcon) {
+        const double iconLabelWidth = input->iconWidth + input->iconLabelMargin + input->titleWidth;
+        
+        output->iconX = floor((input->width - iconLabelWidth) / 2);
+        output->iconY = floor((input->height - input->iconHeight) / 2);
+        output->titleX = output->iconX + input->iconWidth + input->iconLabelMargin;
+    } else {
+        output->titleX = floor(input->width / 2);
+    }
+    
+    output->titleY = floor(input->height / 2);
+    
+    output->titleY -= input->titleOffsetTop;
+    output->titleX += input->titleOffsetLeft;
+    output->titleY += input->titleOffsetBottom;
+    output->titleX -= input->titleOffsetRight;
+    
+    output->backgroundX = 0;
+    output->backgroundY = 0;
+    output->backgroundWidth = input->width;
+    output->backgroundHeight = input->height;
+}
+
+void SSKButtonLayoutComputeBatch(const SSKButtonLayoutInput *inputs, SSKButtonLayoutOutput *outputs, size_t count)
+{
+    SSKButtonLayoutBatch batch = {inputs, outputs, count};
+    const size_t chunkCount = (count + SSKButtonLayoutChunkSize - 1) / SSKButtonLayoutChunkSize;
+    
+    if (chunkCount <= 1) {
+        SSKButtonLayoutComputeChunk(&batch, 0);
+        return;
+    }
+
+#ifdef __APPLE__
+    dispatch_apply_f(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), &batch, SSKButtonLayoutComputeChunk);
+#else
+    long coreCount = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threadCount = coreCount > 0 ? (size_t)coreCount : 1;
+    
+    if (threadCount > chunkCount) {
+        threadCount = chunkCount;
+    }
+    
+    if (threadCount > SSKButtonLayoutMaximumThreadCount) {
+        threadCount = SSKButtonLayoutMaximumThreadCount;
+    }
+    
+    SSKButtonLayoutWorker workers[SSKButtonLayoutMaximumThreadCount];
+    pthread_t threads[SSKButtonLayoutMaximumThreadCount];
+    bool threadWasCreated[SSKButtonLayoutMaximumThreadCount];
+    
+    // The calling thread runs the first worker itself, instead of idling while waiting for the others
+    for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+        workers[threadIndex] = (SSKButtonLayoutWorker){&batch, chunkCount, threadIndex, threadCount};
+        threadWasCreated[threadIndex] = false;
+        
+        if (threadIndex > 0) {
+            threadWasCreated[threadIndex] = pthread_create(&threads[threadIndex], NULL, SSKButtonLayoutRunWorker, &workers[threadIndex]) == 0;
+        }
+    }
+    
+    SSKButtonLayoutRunWorker(&workers[0]);
+    
+    for (size_t threadIndex = 1; threadIndex < threadCount; threadIndex++) {
+        if (threadWasCreated[threadIndex]) {
+            pthread_join(threads[threadIndex], NULL);
+        } else {
+            // Without a thread, the worker's chunks are laid out on the calling thread
+            SSKButtonLayoutRunWorker(&workers[threadIndex]);
+        }
+    }
+#endif
+}
@@ -0,0 +1,78 @@
+#ifndef SSKButtonLayout_h
+#define SSKButtonLayout_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  Describes everything that affects the placement of a button's icon, title & background
+ *
+ *  @discussion The title width has to be measured by the caller (for example from the frame
+ *  of the button's title label). Without an icon, the icon size is ignored.
+ */
+typedef struct {
+    double width;
+    double height;
+    bool hasIcon;
+    double iconWidth;
+    double iconHeight;
+    double iconLabelMargin;
+    double titleWidth;
+    double titleOffsetTop;
+    double titleOffsetLeft;
+    double titleOffsetBottom;
+    double titleOffsetRight;
+} SSKButtonLayoutInput;
+
+/**
+ *  The placements of a button's icon, title & background, in the button's coordinate space
+ *
+ *  @discussion The icon position is its bottom left corner, and is only valid if the input
+ *  had an icon. When the title is left aligned, the title position is its left edge,
+ *  otherwise it's its center. The title is always vertically centered on its position.
+ */
+typedef struct {
+    double iconX;
+    double iconY;
+    double titleX;
+    double titleY;
+    bool titleIsLeftAligned;
+    double backgroundX;
+    double backgroundY;
+    double backgroundWidth;
+    double backgroundHeight;
+} SSKButtonLayoutOutput;
+
+#pragma mark - Button layout
+
+/**
+ *  Compute the layout of a single button
+ *
+ *  @discussion This is a pure function, which can be called from any thread.
+ */
+extern void SSKButtonLayoutCompute(const SSKButtonLayoutInput *input, SSKButtonLayoutOutput *output);
+
+/**
+ *  Compute the layouts of many buttons, using all available cores
+ *
+ *  @param inputs The inputs of the buttons to lay out
+ *  @param outputs The array to write the layout of each button to, at the index of its input
+ *  @param count The number of buttons to lay out
+ *
+ *  @discussion The buttons are split into fixed-size chunks, which are laid out concurrently
+ *  (using GCD where available, and POSIX threads elsewhere). Small batches are laid out on the
+ *  calling thread. Returns once all buttons have been laid out.
+ */
+extern void SSKButtonLayoutComputeBatch(const SSKButtonLayoutInput *inputs, SSKButtonLayoutOutput *outputs, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
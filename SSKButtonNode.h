@@ -2,6 +2,11 @@
 #import "SSKMultiplatform.h"
 #import "SSKInteractionHandler.h"
 #import "SSKStretchableNode.h"
+#import "SSKLayoutPass.h"
+#import "SSKTweenEngine.h"
+#import "SSKButtonLayout.h"
+
+@class SSKButtonStyle;
 
 #pragma mark - Enums
 
@@ -72,8 +77,11 @@ typedef enum : NSUInteger {
  *  requires the SKView it's being displayed in to have an SSKInteractionHandler
  *  attached to it. For more information about interaction handling in
  *  SuperSpriteKit, see SSKInteractionHandler.
+ *
+ *  This class depends on SSKButtonStyle & SSKButtonLayout, which computes the placement
+ *  of the button's icon & title.
  */
-@interface SSKButtonNode : SKNode <SSKInteractiveNode>
+@interface SSKButtonNode : SKNode <SSKInteractiveNode, SSKLayoutPassNode, SSKTweenResizable>
 
 /**
  *  The size of the button
@@ -129,6 +137,21 @@ typedef enum : NSUInteger {
  */
 @property (nonatomic, getter = isSelected) BOOL selected;
 
+/**
+ *  The style of the button, defining its appearance for each state
+ *
+ *  @discussion Styles are immutable, and shared between all buttons that are assigned the same
+ *  style, so a skin only has to be defined once (using SSKMutableButtonStyle) to be applied to
+ *  any number of buttons. Assigned styles are copied, so mutable styles can be assigned too.
+ *
+ *  The per-state appearance methods below (like -setTitle:forState:) read from & write to the
+ *  button's style. Changing an attribute of a button that shares its style gives the button its
+ *  own copy of the style first, so other buttons aren't affected.
+ *
+ *  See SSKButtonStyle for more information.
+ */
+@property (nonatomic, copy) SSKButtonStyle *style;
+
 /**
  *  The margin between the button's icon and title if they both exist
  */
@@ -139,6 +162,16 @@ typedef enum : NSUInteger {
  */
 @property (nonatomic, strong, readonly) SKLabelNode *titleLabelNode;
 
+/**
+ *  The number of child node properties (such as the title label's text, or the background's
+ *  texture) that have been changed by -updateLayout during the button's lifetime
+ *
+ *  @discussion Layout only changes the child node properties whose value differs from the
+ *  one resolved from the button's style for its current state. Compare the value of this
+ *  property before & after a state change (and its layout) to measure how much work it caused.
+ */
+@property (nonatomic, readonly) NSUInteger childMutationCount;
+
 /**
  *  Allocate & initialize an instance of SSKButtonNode
  *
@@ -146,6 +179,20 @@ typedef enum : NSUInteger {
  */
 + (instancetype)buttonNodeWithSize:(CGSize)size;
 
+/**
+ *  Lay out many buttons at once, spreading the layout math across all available cores
+ *
+ *  @param buttonNodes The buttons to lay out
+ *
+ *  @discussion Each button's content (title, icon & background) is resolved from its style &
+ *  applied on the calling thread, after which the placement of all icons & titles is computed
+ *  concurrently using SSKButtonLayoutComputeBatch, and finally applied to the buttons. Use this
+ *  to lay out thousands of buttons at once, for example when loading a level select screen.
+ *  Any pending layout of the buttons is performed by this call. Buttons whose class overrides
+ *  -updateLayout are laid out by calling that method instead.
+ */
++ (void)layoutButtonNodes:(NSArray *)buttonNodes;
+
 #pragma mark Targets & actions
 
 /**
@@ -154,6 +201,10 @@ typedef enum : NSUInteger {
  *  @param target The target to send a message to
  *  @param action The message to send to the target
  *  @param state The state to trigger this action for
+ *
+ *  @discussion The action may take the button as its single argument. Its implementation
+ *  is looked up when it's added (and again only if the target's class changes), so triggering
+ *  it is a direct function call. The target isn't retained.
  */
 - (void)addTarget:(id)target
            action:(SEL)action
@@ -168,6 +219,31 @@ typedef enum : NSUInteger {
 - (void)removeTarget:(id)target
             forState:(SSKButtonState)state;
 
+/**
+ *  Add a block that should be called when the button enters a state
+ *
+ *  @param handler The block to call. It's passed the button that entered the state.
+ *  @param state The state to call the block for
+ *
+ *  @return An object identifying the handler, which can be passed to -removeActionHandler:forState:
+ *
+ *  @discussion Handlers are called in the order they (and any targets) were added. Be careful
+ *  not to capture the button strongly in the block, since the button retains the block. Handlers
+ *  may add or remove targets & handlers (including themselves), which takes effect the next time
+ *  the button enters the state.
+ */
+- (id)addActionHandler:(void(^)(SSKButtonNode *buttonNode))handler
+              forState:(SSKButtonState)state;
+
+/**
+ *  Remove a block previously added using -addActionHandler:forState:
+ *
+ *  @param handlerToken The object returned when the handler was added
+ *  @param state The state for which to remove the handler
+ */
+- (void)removeActionHandler:(id)handlerToken
+                   forState:(SSKButtonState)state;
+
 #pragma mark Backgrounds
 
 /**
@@ -353,7 +429,10 @@ typedef enum : NSUInteger {
  *
  *  @discussion You don't have to call this method manually, as it gets
  *  called every time you update a property that requires the button to
- *  relayout itself.
+ *  relayout itself. Layout is scheduled through the shared SSKLayoutPass,
+ *  so when the pass is deferred, updating several properties in a row only
+ *  causes this method to be called once. Only the child nodes whose appearance differs
+ *  from the one resolved for the button's current state are updated.
  *
  *  You may override this method in any SSKButtonNode subclass to
  *  apply your own layout to the button.
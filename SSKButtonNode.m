@@ -1,21 +1,16 @@
 #import "SSKButtonNode.h"
+#import "SSKButtonStyle.h"
+#import "SSKButtonLayout.h"
+#import <objc/runtime.h>
 
 #pragma mark - C Utilities
 
-static NSArray *SSKButtonNodeGetArrayForEdgeInsets(SSKEdgeInsetsType edgeInsets)
+static BOOL SSKButtonNodeEdgeInsetsAreEqual(SSKEdgeInsetsType edgeInsets, SSKEdgeInsetsType otherEdgeInsets)
 {
-    return @[@(edgeInsets.top), @(edgeInsets.left), @(edgeInsets.bottom), @(edgeInsets.right)];
-}
-
-static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsArray)
-{
-    SSKEdgeInsetsType edgeInsets;
-    edgeInsets.top = [[edgeInsetsArray objectAtIndex:0] doubleValue];
-    edgeInsets.left = [[edgeInsetsArray objectAtIndex:1] doubleValue];
-    edgeInsets.bottom = [[edgeInsetsArray objectAtIndex:2] doubleValue];
-    edgeInsets.right = [[edgeInsetsArray objectAtIndex:3] doubleValue];
-    
-    return edgeInsets;
+    return edgeInsets.top == otherEdgeInsets.top &&
+           edgeInsets.left == otherEdgeInsets.left &&
+           edgeInsets.bottom == otherEdgeInsets.bottom &&
+           edgeInsets.right == otherEdgeInsets.right;
 }
 
 #pragma mark - SSKButtonTargetActionPair
@@ -23,18 +18,27 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
 @interface SSKButtonTargetActionPair : NSObject
 
 @property (nonatomic, weak) id target;
-@property (nonatomic, strong) NSString *actionSelectorString;
+@property (nonatomic) SEL action;
+
+- (void)performWithSender:(SSKButtonNode *)sender;
 
 @end
 
 @implementation SSKButtonTargetActionPair
+{
+    Class _resolvedClass;
+    IMP _implementation;
+    BOOL _passesSender;
+}
 
 + (instancetype)pairForTarget:(id)target action:(SEL)action
 {
     SSKButtonTargetActionPair *pair = [self new];
     
     pair.target = target;
-    pair.actionSelectorString = NSStringFromSelector(action);
+    pair.action = action;
+    pair->_passesSender = strchr(sel_getName(action), ':') != NULL;
+    [pair resolveImplementationForTarget:target];
     
     return pair;
 }
@@ -49,13 +53,60 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
         return NO;
     }
     
-    if (![[object actionSelectorString] isEqualToString:self.actionSelectorString]) {
+    if ([object action] != self.action) {
         return NO;
     }
     
     return YES;
 }
 
+- (void)resolveImplementationForTarget:(id)target
+{
+    NSAssert([target respondsToSelector:self.action], @"Invalid selector \"%@\" for target %@", NSStringFromSelector(self.action), target);
+    
+    _resolvedClass = object_getClass(target);
+    _implementation = [target methodForSelector:self.action];
+}
+
+- (void)performWithSender:(SSKButtonNode *)sender
+{
+    id target = self.target;
+    
+    if (!target) {
+        return;
+    }
+    
+    // The implementation is only looked up again if the target's class changed, for example by key-value observing
+    if (object_getClass(target) != _resolvedClass) {
+        [self resolveImplementationForTarget:target];
+    }
+    
+    if (_passesSender) {
+        ((void(*)(id, SEL, SSKButtonNode *))_implementation)(target, self.action, sender);
+    } else {
+        ((void(*)(id, SEL))_implementation)(target, self.action);
+    }
+}
+
+@end
+
+#pragma mark - SSKButtonActionHandler
+
+@interface SSKButtonActionHandler : NSObject
+
+@property (nonatomic, copy) void(^block)(SSKButtonNode *buttonNode);
+
+- (void)performWithSender:(SSKButtonNode *)sender;
+
+@end
+
+@implementation SSKButtonActionHandler
+
+- (void)performWithSender:(SSKButtonNode *)sender
+{
+    self.block(sender);
+}
+
 @end
 
 #pragma mark - SSKButtonNode
@@ -63,21 +114,20 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
 @interface SSKButtonNode()
 
 @property (nonatomic, strong) NSDictionary *targetActionPairs;
-@property (nonatomic, strong) NSMutableDictionary *backgroundColors;
-@property (nonatomic, strong) NSMutableDictionary *backgroundTextures;
-@property (nonatomic, strong) NSMutableDictionary *stretchableBackgroundTextureCapInsets;
-@property (nonatomic, strong) NSMutableDictionary *iconTextures;
-@property (nonatomic, strong) NSMutableDictionary *titles;
-@property (nonatomic, strong) NSMutableDictionary *titleOffsets;
+@property (nonatomic, strong) SSKMutableButtonStyle *ownedStyle;
 
 @property (nonatomic, strong, readwrite) SKLabelNode *titleLabelNode;
 @property (nonatomic, strong) SSKStretchableNode *backgroundNode;
 @property (nonatomic, strong) SKSpriteNode *iconNode;
+@property (nonatomic) BOOL needsLayout;
+@property (nonatomic, readwrite) NSUInteger childMutationCount;
 
 @end
 
 @implementation SSKButtonNode
 
+@synthesize style = _style;
+
 + (instancetype)buttonNodeWithSize:(CGSize)size
 {
     SSKButtonNode *buttonNode = [self node];
@@ -94,12 +144,7 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
     }
     
     buttonNode.targetActionPairs = targetActionPairs;
-    buttonNode.backgroundColors = [NSMutableDictionary new];
-    buttonNode.backgroundTextures = [NSMutableDictionary new];
-    buttonNode.stretchableBackgroundTextureCapInsets = [NSMutableDictionary new];
-    buttonNode.iconTextures = [NSMutableDictionary new];
-    buttonNode.titles = [NSMutableDictionary new];
-    buttonNode.titleOffsets = [NSMutableDictionary new];
+    buttonNode->_style = [SSKButtonStyle emptyStyle];
     
     CGFloat systemFontSize = [SSKFontType systemFontSize];
     SSKFontType *systemFont = [SSKFontType systemFontOfSize:systemFontSize];
@@ -127,6 +172,37 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
     return buttonNode;
 }
 
++ (void)layoutButtonNodes:(NSArray *)buttonNodes
+{
+    NSUInteger buttonNodeCount = [buttonNodes count];
+    SSKButtonLayoutInput *layoutInputs = malloc(buttonNodeCount * sizeof(SSKButtonLayoutInput));
+    SSKButtonLayoutOutput *layoutOutputs = malloc(buttonNodeCount * sizeof(SSKButtonLayoutOutput));
+    NSMutableArray *batchedButtonNodes = [NSMutableArray arrayWithCapacity:buttonNodeCount];
+    IMP defaultUpdateLayout = [SSKButtonNode instanceMethodForSelector:@selector(updateLayout)];
+    
+    for (SSKButtonNode *buttonNode in buttonNodes) {
+        buttonNode.needsLayout = NO;
+        
+        // Subclasses that apply their own layout are laid out one by one, as usual
+        if (!layoutInputs || !layoutOutputs || [buttonNode methodForSelector:@selector(updateLayout)] != defaultUpdateLayout) {
+            [buttonNode updateLayout];
+            continue;
+        }
+        
+        [buttonNode updateContentWithLayoutInput:&layoutInputs[[batchedButtonNodes count]]];
+        [batchedButtonNodes addObject:buttonNode];
+    }
+    
+    SSKButtonLayoutComputeBatch(layoutInputs, layoutOutputs, [batchedButtonNodes count]);
+    
+    [batchedButtonNodes enumerateObjectsUsingBlock:^(SSKButtonNode *buttonNode, NSUInteger index, BOOL *stop) {
+        [buttonNode applyLayoutOutput:&layoutOutputs[index]];
+    }];
+    
+    free(layoutInputs);
+    free(layoutOutputs);
+}
+
 #pragma mark - Public API
 
 - (void)addTarget:(id)target action:(SEL)action forState:(SSKButtonState)state
@@ -149,8 +225,8 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
 {
     NSMutableArray *targetActionPairs = [self targetActionPairsForState:state];
     
-    for (SSKButtonTargetActionPair *pair in targetActionPairs) {
-        if (pair.target == target) {
+    for (id pair in targetActionPairs) {
+        if ([pair isKindOfClass:[SSKButtonTargetActionPair class]] && [pair target] == target) {
             [targetActionPairs removeObject:pair];
             
             break;
@@ -158,126 +234,124 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
     }
 }
 
-- (SKColor *)backgroundColorForState:(SSKButtonState)state
+- (id)addActionHandler:(void (^)(SSKButtonNode *))handler forState:(SSKButtonState)state
 {
-    return [self.backgroundColors objectForKey:@(state)];
+    if (!handler) {
+        return nil;
+    }
+    
+    SSKButtonActionHandler *actionHandler = [SSKButtonActionHandler new];
+    actionHandler.block = handler;
+    
+    [[self targetActionPairsForState:state] addObject:actionHandler];
+    
+    return actionHandler;
 }
 
-- (void)setBackgroundColor:(SKColor *)color forState:(SSKButtonState)state
+- (void)removeActionHandler:(id)handlerToken forState:(SSKButtonState)state
 {
-    id objectToInsert = color;
-    
-    if (!objectToInsert) {
-        objectToInsert = [NSNull null];
+    if (!handlerToken) {
+        return;
     }
     
-    [self.backgroundColors setObject:objectToInsert forKey:@(state)];
-    
-    if (self.state == state) {
-        [self updateLayout];
-    }
+    [[self targetActionPairsForState:state] removeObjectIdenticalTo:handlerToken];
+}
+
+- (SKColor *)backgroundColorForState:(SSKButtonState)state
+{
+    // The per-state getters read the current style directly, since the style property returns a snapshot
+    return [self styleObject:[_style backgroundColorForState:state]
+                forAttribute:SSKButtonStyleAttributeBackgroundColor
+                       state:state];
+}
+
+- (void)setBackgroundColor:(SKColor *)color forState:(SSKButtonState)state
+{
+    [[self mutableStyle] setBackgroundColor:color forState:state];
+    [self styleDidChangeForState:state];
 }
 
 - (SKTexture *)backgroundTextureForState:(SSKButtonState)state
 {
-    return [self.backgroundTextures objectForKey:@(state)];
+    return [self styleObject:[_style backgroundTextureForState:state]
+                forAttribute:SSKButtonStyleAttributeBackgroundTexture
+                       state:state];
 }
 
 - (void)setBackgroundTexture:(SKTexture *)texture forState:(SSKButtonState)state
 {
-    id objectToInsert = texture;
-    
-    if (!objectToInsert) {
-        objectToInsert = [NSNull null];
-    }
-    
-    [self.backgroundTextures setObject:objectToInsert forKey:@(state)];
-    
-    if (self.state == state) {
-        [self updateLayout];
-    }
+    [[self mutableStyle] setBackgroundTexture:texture forState:state];
+    [self styleDidChangeForState:state];
 }
 
 - (SSKEdgeInsetsType)stretchableBackgoundCapInsetsForState:(SSKButtonState)state
 {
-    NSArray *capInsetsArray = [self.stretchableBackgroundTextureCapInsets objectForKey:@(state)];
-    
-    return SSKButtonNodeGetEdgeInsetsForArray(capInsetsArray);
+    return [_style stretchableBackgroundCapInsetsForState:state];
 }
 
 - (void)setStretchableBackgroundCapInsets:(SSKEdgeInsetsType)capInsets forState:(SSKButtonState)state
 {
-    NSArray *capInsetsArray = SSKButtonNodeGetArrayForEdgeInsets(capInsets);
-    
-    [self.stretchableBackgroundTextureCapInsets setObject:capInsetsArray
-                                                   forKey:@(state)];
-    
-    if (self.state == state) {
-        [self updateLayout];
-    }
+    [[self mutableStyle] setStretchableBackgroundCapInsets:capInsets forState:state];
+    [self styleDidChangeForState:state];
 }
 
 - (SKTexture *)iconTextureForState:(SSKButtonState)state
 {
-    return [self.iconTextures objectForKey:@(state)];
+    return [self styleObject:[_style iconTextureForState:state]
+                forAttribute:SSKButtonStyleAttributeIconTexture
+                       state:state];
 }
 
 - (void)setIconTexture:(SKTexture *)texture forState:(SSKButtonState)state
 {
-    id objectToInsert = texture;
-    
-    if (!objectToInsert) {
-        objectToInsert = [NSNull null];
-    }
-    
-    [self.iconTextures setObject:objectToInsert forKey:@(state)];
-    
-    if (self.state == state) {
-        [self updateLayout];
-    }
+    [[self mutableStyle] setIconTexture:texture forState:state];
+    [self styleDidChangeForState:state];
 }
 
 - (NSString *)titleForState:(SSKButtonState)state
 {
-    return [self.titles objectForKey:@(state)];
+    return [self styleObject:[_style titleForState:state]
+                forAttribute:SSKButtonStyleAttributeTitle
+                       state:state];
 }
 
 - (void)setTitle:(NSString *)title forState:(SSKButtonState)state
 {
-    id objectToInsert = title;
-    
-    if (!objectToInsert) {
-        objectToInsert = [NSNull null];
-    }
-    
-    [self.titles setObject:objectToInsert forKey:@(state)];
-    
-    if (self.state == state) {
-        [self updateLayout];
-    }
+    [[self mutableStyle] setTitle:title forState:state];
+    [self styleDidChangeForState:state];
 }
 
 - (SSKEdgeInsetsType)titleOffsetForState:(SSKButtonState)state
 {
-    NSArray *edgeInsetsArray = [self.titleOffsets objectForKey:@(state)];
-    
-    return SSKButtonNodeGetEdgeInsetsForArray(edgeInsetsArray);
+    return [_style titleOffsetForState:state];
 }
 
 - (void)setTitleOffset:(SSKEdgeInsetsType)offset forState:(SSKButtonState)state
 {
-    NSArray *edgeInsetsArray = SSKButtonNodeGetArrayForEdgeInsets(offset);
-    
-    [self.titleOffsets setObject:edgeInsetsArray
-                          forKey:@(state)];
-    
-    if (self.state == state) {
-        [self updateLayout];
-    }
+    [[self mutableStyle] setTitleOffset:offset forState:state];
+    [self styleDidChangeForState:state];
 }
 
 #pragma mark - Accessor overrides
 
+- (SSKButtonStyle *)style
+{
+    // A style owned by the button is mutable, so a snapshot of it is returned
+    if (self.ownedStyle) {
+        return [self.ownedStyle copy];
+    }
+    
+    return _style;
+}
+
+- (void)setStyle:(SSKButtonStyle *)style
+{
+    _style = style ? [style copy] : [SSKButtonStyle emptyStyle];
+    self.ownedStyle = nil;
+    
+    [self setNeedsLayout];
+}
+
 - (void)setZPosition:(CGFloat)zPosition
 {
     [super setZPosition:zPosition];
@@ -296,7 +370,7 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
 {
     self.backgroundNode.size = size;
     
-    [self updateLayout];
+    [self setNeedsLayout];
 }
 
 - (void)setState:(SSKButtonState)state
@@ -317,7 +391,7 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
         _selected = NO;
     }
     
-    [self updateLayout];
+    [self setNeedsLayout];
     [self triggerActionsForState];
     
     if (self.selectionStyle == SSKButtonSelectionStyleNone) {
@@ -357,6 +431,26 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
     }
 }
 
+#pragma mark - SSKLayoutPassNode
+
+- (void)setNeedsLayout
+{
+    self.needsLayout = YES;
+    
+    [[SSKLayoutPass sharedPass] scheduleNode:self];
+}
+
+- (void)layoutIfNeeded
+{
+    if (!self.needsLayout) {
+        return;
+    }
+    
+    self.needsLayout = NO;
+    
+    [self updateLayout];
+}
+
 #pragma mark - Utilities
 
 - (NSMutableArray *)targetActionPairsForState:(SSKButtonState)state
@@ -364,139 +458,171 @@ static SSKEdgeInsetsType SSKButtonNodeGetEdgeInsetsForArray(NSArray *edgeInsetsA
     return [self.targetActionPairs objectForKey:@(state)];
 }
 
-- (void)updateLayout
+- (SSKMutableButtonStyle *)mutableStyle
 {
-    NSString *titleForState = [self titleForState:self.state];
+    // Styles are shared between buttons until one of them is changed, at which point the button gets its own copy
+    if (!self.ownedStyle) {
+        self.ownedStyle = [_style mutableCopy];
+        _style = self.ownedStyle;
+    }
     
-    if (!titleForState && self.state != SSKButtonStateNormal) {
-        titleForState = [self titleForState:SSKButtonStateNormal];
+    return self.ownedStyle;
+}
+
+- (void)styleDidChangeForState:(SSKButtonState)state
+{
+    if (self.state == state) {
+        [self setNeedsLayout];
+    }
+}
+
+- (id)styleObject:(id)object forAttribute:(SSKButtonStyleAttributes)attribute state:(SSKButtonState)state
+{
+    // Attributes that were set to nil are returned as NSNull, to tell them apart from attributes that were never set
+    if (!object && [_style hasAttribute:attribute forState:state]) {
+        return [NSNull null];
     }
     
-    if (titleForState) {
-        if (![titleForState isKindOfClass:[NSString class]]) {
-            titleForState = @"";
-        }
-        
-        self.titleLabelNode.text = titleForState;
+    return object;
+}
+
+- (SSKButtonState)styleStateForAttribute:(SSKButtonStyleAttributes)attribute
+{
+    if (self.state == SSKButtonStateNormal || [_style hasAttribute:attribute forState:self.state]) {
+        return self.state;
     }
     
-    SKTexture *iconTexture = [self iconTextureForState:self.state];
+    return SSKButtonStateNormal;
+}
+
+- (void)updateLayout
+{
+    SSKButtonLayoutInput layoutInput;
+    [self updateContentWithLayoutInput:&layoutInput];
+    
+    SSKButtonLayoutOutput layoutOutput;
+    SSKButtonLayoutCompute(&layoutInput, &layoutOutput);
     
-    if (!iconTexture && self.state != SSKButtonStateNormal) {
-        iconTexture = [self iconTextureForState:SSKButtonStateNormal];
-    }
+    [self applyLayoutOutput:&layoutOutput];
+}
+
+- (void)updateContentWithLayoutInput:(SSKButtonLayoutInput *)layoutInput
+{
+    // Each child node property is only set if its resolved value differs from its current one,
+    // since for example setting the background texture redraws all of the background's parts
+    SSKButtonStyle *style = _style;
+    SSKButtonState titleState = [self styleStateForAttribute:SSKButtonStyleAttributeTitle];
     
-    if (iconTexture) {
-        if (![iconTexture isKindOfClass:[SKTexture class]]) {
-            iconTexture = nil;
-        }
+    if ([style hasAttribute:SSKButtonStyleAttributeTitle forState:titleState]) {
+        NSString *title = [style titleForState:titleState] ?: @"";
         
-        self.iconNode.texture = iconTexture;
-        self.iconNode.size = iconTexture.size;
+        if (![self.titleLabelNode.text isEqualToString:title]) {
+            self.titleLabelNode.text = title;
+            self.childMutationCount++;
+        }
     }
     
-    SKLabelHorizontalAlignmentMode labelAlignmentMode;
+    SSKButtonState iconState = [self styleStateForAttribute:SSKButtonStyleAttributeIconTexture];
     
-    if (self.iconNode.texture) {
-        labelAlignmentMode = SKLabelHorizontalAlignmentModeLeft;
-    } else {
-        labelAlignmentMode = SKLabelHorizontalAlignmentModeCenter;
+    if ([style hasAttribute:SSKButtonStyleAttributeIconTexture forState:iconState]) {
+        SKTexture *iconTexture = [style iconTextureForState:iconState];
+        
+        if (self.iconNode.texture != iconTexture) {
+            self.iconNode.texture = iconTexture;
+            self.iconNode.size = iconTexture.size;
+            self.childMutationCount += 2;
+        }
     }
     
-    self.titleLabelNode.horizontalAlignmentMode = labelAlignmentMode;
-    
-    CGPoint titleNodePosition = self.titleLabelNode.position;
+    SSKButtonState backgroundTextureState = [self styleStateForAttribute:SSKButtonStyleAttributeBackgroundTexture];
     
-    if (self.iconNode.texture) {
-        CGFloat iconLabelWidth = self.iconNode.size.width + self.iconLabelMargin + CGRectGetWidth(self.titleLabelNode.frame);
+    if ([style hasAttribute:SSKButtonStyleAttributeBackgroundTexture forState:backgroundTextureState]) {
+        SKTexture *backgroundTexture = [style backgroundTextureForState:backgroundTextureState];
+        SSKButtonState capInsetsState = [self styleStateForAttribute:SSKButtonStyleAttributeStretchableBackgroundCapInsets];
+        SSKEdgeInsetsType capInsets = [style stretchableBackgroundCapInsetsForState:capInsetsState];
         
-        CGPoint iconNodePosition = self.iconNode.position;
-        iconNodePosition.x = floorf((self.size.width - iconLabelWidth) / 2);
-        iconNodePosition.y = floorf((self.size.height - self.iconNode.size.height) / 2);
-        self.iconNode.position = iconNodePosition;
-        
-        titleNodePosition.x = iconNodePosition.x + self.iconNode.size.width + self.iconLabelMargin;
+        if (self.backgroundNode.texture != backgroundTexture || !SSKButtonNodeEdgeInsetsAreEqual(self.backgroundNode.textureCapInsets, capInsets)) {
+            [self.backgroundNode setTexture:backgroundTexture capInsets:capInsets];
+            self.childMutationCount++;
+        }
     } else {
-        titleNodePosition.x = floorf(self.size.width / 2);
+        SSKButtonState backgroundColorState = [self styleStateForAttribute:SSKButtonStyleAttributeBackgroundColor];
+        
+        if ([style hasAttribute:SSKButtonStyleAttributeBackgroundColor forState:backgroundColorState]) {
+            SKColor *backgroundColor = [style backgroundColorForState:backgroundColorState];
+            
+            if (self.backgroundNode.texture) {
+                self.backgroundNode.texture = nil;
+                self.childMutationCount++;
+            }
+            
+            if (self.backgroundNode.color != backgroundColor && ![self.backgroundNode.color isEqual:backgroundColor]) {
+                self.backgroundNode.color = backgroundColor;
+                self.childMutationCount++;
+            }
+        }
     }
     
-    titleNodePosition.y = floorf(self.size.height / 2);
-    
-    SSKEdgeInsetsType titleOffset;
+    SSKEdgeInsetsType titleOffset = [style titleOffsetForState:[self styleStateForAttribute:SSKButtonStyleAttributeTitleOffset]];
+    CGSize size = self.size;
+    
+    layoutInput->width = size.width;
+    layoutInput->height = size.height;
+    layoutInput->hasIcon = self.iconNode.texture != nil;
+    layoutInput->iconWidth = self.iconNode.size.width;
+    layoutInput->iconHeight = self.iconNode.size.height;
+    layoutInput->iconLabelMargin = self.iconLabelMargin;
+    layoutInput->titleWidth = CGRectGetWidth(self.titleLabelNode.frame);
+    layoutInput->titleOffsetTop = titleOffset.top;
+    layoutInput->titleOffsetLeft = titleOffset.left;
+    layoutInput->titleOffsetBottom = titleOffset.bottom;
+    layoutInput->titleOffsetRight = titleOffset.right;
+}
 
-    if ([self.titleOffsets objectForKey:@(self.state)]) {
-        titleOffset = [self titleOffsetForState:self.state];
+- (void)applyLayoutOutput:(const SSKButtonLayoutOutput *)layoutOutput
+{
+    SKLabelHorizontalAlignmentMode labelAlignmentMode;
+    
+    if (layoutOutput->titleIsLeftAligned) {
+        labelAlignmentMode = SKLabelHorizontalAlignmentModeLeft;
     } else {
-        titleOffset = [self titleOffsetForState:SSKButtonStateNormal];
+        labelAlignmentMode = SKLabelHorizontalAlignmentModeCenter;
     }
     
-    titleNodePosition.y -= titleOffset.top;
-    titleNodePosition.x += titleOffset.left;
-    titleNodePosition.y += titleOffset.bottom;
-    titleNodePosition.x -= titleOffset.right;
-    
-    self.titleLabelNode.position = titleNodePosition;
-    
-    SKTexture *backgroundTexture = [self backgroundTextureForState:self.state];
-    
-    if (!backgroundTexture && self.state != SSKButtonStateNormal) {
-        backgroundTexture = [self backgroundTextureForState:SSKButtonStateNormal];
+    if (self.titleLabelNode.horizontalAlignmentMode != labelAlignmentMode) {
+        self.titleLabelNode.horizontalAlignmentMode = labelAlignmentMode;
+        self.childMutationCount++;
     }
     
-    if (backgroundTexture) {
-        if (![backgroundTexture isKindOfClass:[SKTexture class]]) {
-            backgroundTexture = nil;
-        }
-        
-        SSKEdgeInsetsType backgroundTextureCapInsets = SSKEdgeInsetsMake(0, 0, 0, 0);
-        
-        if ([self.stretchableBackgroundTextureCapInsets objectForKey:@(self.state)]) {
-            backgroundTextureCapInsets = [self stretchableBackgoundCapInsetsForState:self.state];
-        } else if (self.state != SSKButtonStateNormal) {
-            backgroundTextureCapInsets = [self stretchableBackgoundCapInsetsForState:SSKButtonStateNormal];
-        }
-        
-        [self.backgroundNode setTexture:backgroundTexture capInsets:backgroundTextureCapInsets];
-    } else {
-        SKColor *backgroundColor = [self backgroundColorForState:self.state];
-        
-        if (!backgroundColor && self.state != SSKButtonStateNormal) {
-            backgroundColor = [self backgroundColorForState:SSKButtonStateNormal];
-        }
+    if (self.iconNode.texture) {
+        CGPoint iconNodePosition = CGPointMake(layoutOutput->iconX, layoutOutput->iconY);
         
-        if (backgroundColor) {
-            if (![backgroundColor isKindOfClass:[SKColor class]]) {
-                backgroundColor = nil;
-            }
-            
-            self.backgroundNode.texture = nil;
-            self.backgroundNode.color = backgroundColor;
+        if (!CGPointEqualToPoint(self.iconNode.position, iconNodePosition)) {
+            self.iconNode.position = iconNodePosition;
+            self.childMutationCount++;
         }
     }
+    
+    CGPoint titleNodePosition = CGPointMake(layoutOutput->titleX, layoutOutput->titleY);
+    
+    if (!CGPointEqualToPoint(self.titleLabelNode.position, titleNodePosition)) {
+        self.titleLabelNode.position = titleNodePosition;
+        self.childMutationCount++;
+    }
 }
 
 - (void)triggerActionsForState
 {
     NSMutableArray *targetActionPairs = [self targetActionPairsForState:self.state];
     
-    for (SSKButtonTargetActionPair *pair in targetActionPairs) {
-        SEL selector = NSSelectorFromString(pair.actionSelectorString);
-        
-        NSMethodSignature *methodSignature = [pair.target methodSignatureForSelector:selector];
-        
-        NSAssert(methodSignature, @"Invalid selector \"%@\" for target %@", pair.actionSelectorString, pair.target);
-        
-        NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:methodSignature];
-        invocation.target = pair.target;
-        invocation.selector = selector;
-        
-        SSKButtonNode *_self = self;
-        
-        if ([methodSignature numberOfArguments] > 2) {
-            [invocation setArgument:&_self atIndex:2];
-        }
-        
-        [invocation invoke];
+    if ([targetActionPairs count] == 0) {
+        return;
+    }
+    
+    // Pairs & handlers both resolve their dispatch up front, so each one is a single message. A copy is iterated,
+    // since actions may add or remove targets & handlers (including themselves) while being performed.
+    for (id action in [targetActionPairs copy]) {
+        [action performWithSender:self];
     }
 }
 
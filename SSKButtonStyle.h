@@ -0,0 +1,128 @@
+#import <SpriteKit/SpriteKit.h>
+#import "SSKMultiplatform.h"
+#import "SSKButtonNode.h"
+
+#pragma mark - Enums
+
+/**
+ *  Bitmask describing the attributes of a button style
+ */
+typedef enum : NSUInteger {
+    SSKButtonStyleAttributeBackgroundColor = 1 << 0,
+    SSKButtonStyleAttributeBackgroundTexture = 1 << 1,
+    SSKButtonStyleAttributeStretchableBackgroundCapInsets = 1 << 2,
+    SSKButtonStyleAttributeIconTexture = 1 << 3,
+    SSKButtonStyleAttributeTitle = 1 << 4,
+    SSKButtonStyleAttributeTitleOffset = 1 << 5
+} SSKButtonStyleAttributes;
+
+#pragma mark - SSKButtonStyle
+
+/**
+ *  An immutable set of per-state appearance attributes for SSKButtonNode
+ *
+ *  @discussion A style stores the background color, background texture, stretchable
+ *  background cap insets, icon texture, title & title offset of each button state, in
+ *  fixed-size arrays indexed by state. Each state also has a set of presence bits, recording
+ *  which attributes have been set for it. An attribute that has been set to nil is present,
+ *  which is how a state opts out of falling back to the SSKButtonStateNormal state.
+ *
+ *  Since styles are immutable, a single style (a "skin") can be assigned to any number of
+ *  buttons without being copied. Use SSKMutableButtonStyle to create a style.
+ */
+@interface SSKButtonStyle : NSObject <NSCopying, NSMutableCopying>
+
+/**
+ *  Return a shared style without any attributes set
+ */
++ (instancetype)emptyStyle;
+
+/**
+ *  Return whether an attribute has been set for a state, including if it has been set to nil
+ *
+ *  @param attribute The attribute to check
+ *  @param state The state to check the attribute for
+ */
+- (BOOL)hasAttribute:(SSKButtonStyleAttributes)attribute forState:(SSKButtonState)state;
+
+/**
+ *  Return all attributes that have been set for a state
+ */
+- (SSKButtonStyleAttributes)attributesForState:(SSKButtonState)state;
+
+/**
+ *  Return the background color for a state, or nil if none has been set
+ */
+- (SKColor *)backgroundColorForState:(SSKButtonState)state;
+
+/**
+ *  Return the background texture for a state, or nil if none has been set
+ */
+- (SKTexture *)backgroundTextureForState:(SSKButtonState)state;
+
+/**
+ *  Return the stretchable background cap insets for a state, or zero insets if none have been set
+ */
+- (SSKEdgeInsetsType)stretchableBackgroundCapInsetsForState:(SSKButtonState)state;
+
+/**
+ *  Return the icon texture for a state, or nil if none has been set
+ */
+- (SKTexture *)iconTextureForState:(SSKButtonState)state;
+
+/**
+ *  Return the title for a state, or nil if none has been set
+ */
+- (NSString *)titleForState:(SSKButtonState)state;
+
+/**
+ *  Return the title offset for a state, or zero insets if none has been set
+ */
+- (SSKEdgeInsetsType)titleOffsetForState:(SSKButtonState)state;
+
+@end
+
+#pragma mark - SSKMutableButtonStyle
+
+/**
+ *  A mutable button style, used to define a style before assigning it to buttons
+ *
+ *  @discussion Buttons copy the styles assigned to them, which results in an immutable style
+ *  that is shared between all buttons the copy is assigned to. Mutating a style after assigning
+ *  it to a button doesn't affect the button. See the corresponding methods of SSKButtonNode for
+ *  how each attribute is used. Setting an object attribute to nil or NSNull marks it as present,
+ *  but empty.
+ */
+@interface SSKMutableButtonStyle : SSKButtonStyle
+
+/**
+ *  Set the background color for a state
+ */
+- (void)setBackgroundColor:(SKColor *)color forState:(SSKButtonState)state;
+
+/**
+ *  Set the background texture for a state
+ */
+- (void)setBackgroundTexture:(SKTexture *)texture forState:(SSKButtonState)state;
+
+/**
+ *  Set the cap insets used to stretch the background texture for a state
+ */
+- (void)setStretchableBackgroundCapInsets:(SSKEdgeInsetsType)capInsets forState:(SSKButtonState)state;
+
+/**
+ *  Set the icon texture for a state
+ */
+- (void)setIconTexture:(SKTexture *)texture forState:(SSKButtonState)state;
+
+/**
+ *  Set the title for a state
+ */
+- (void)setTitle:(NSString *)title forState:(SSKButtonState)state;
+
+/**
+ *  Set the title offset for a state
+ */
+- (void)setTitleOffset:(SSKEdgeInsetsType)offset forState:(SSKButtonState)state;
+
+@end
@@ -0,0 +1,217 @@
+#import "SSKButtonStyle.h"
+
+#define SSKButtonStyleStateCount (SSKButtonStateDisabled + 1)
+
+#pragma mark - C Utilities
+
+static id SSKButtonStyleGetObjectForValue(id value)
+{
+    // NSNull is accepted for compatibility with SSKButtonNode's older API, and stored as nil
+    if (value == [NSNull null]) {
+        return nil;
+    }
+    
+    return value;
+}
+
+#pragma mark - SSKButtonStyle
+
+@interface SSKButtonStyle()
+
+- (void)setObject:(id)object forAttribute:(SSKButtonStyleAttributes)attribute state:(SSKButtonState)state;
+- (void)setEdgeInsets:(SSKEdgeInsetsType)edgeInsets forAttribute:(SSKButtonStyleAttributes)attribute state:(SSKButtonState)state;
+
+@end
+
+@implementation SSKButtonStyle
+{
+    SSKButtonStyleAttributes _attributes[SSKButtonStyleStateCount];
+    SKColor *_backgroundColors[SSKButtonStyleStateCount];
+    SKTexture *_backgroundTextures[SSKButtonStyleStateCount];
+    SSKEdgeInsetsType _stretchableBackgroundCapInsets[SSKButtonStyleStateCount];
+    SKTexture *_iconTextures[SSKButtonStyleStateCount];
+    NSString *_titles[SSKButtonStyleStateCount];
+    SSKEdgeInsetsType _titleOffsets[SSKButtonStyleStateCount];
+}
+
++ (instancetype)emptyStyle
+{
+    static SSKButtonStyle *emptyStyle;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        emptyStyle = [SSKButtonStyle new];
+    });
+    
+    return emptyStyle;
+}
+
+#pragma mark - Public API
+
+- (BOOL)hasAttribute:(SSKButtonStyleAttributes)attribute forState:(SSKButtonState)state
+{
+    return ([self attributesForState:state] & attribute) == attribute;
+}
+
+- (SSKButtonStyleAttributes)attributesForState:(SSKButtonState)state
+{
+    if (state >= SSKButtonStyleStateCount) {
+        return 0;
+    }
+    
+    return _attributes[state];
+}
+
+- (SKColor *)backgroundColorForState:(SSKButtonState)state
+{
+    return state < SSKButtonStyleStateCount ? _backgroundColors[state] : nil;
+}
+
+- (SKTexture *)backgroundTextureForState:(SSKButtonState)state
+{
+    return state < SSKButtonStyleStateCount ? _backgroundTextures[state] : nil;
+}
+
+- (SSKEdgeInsetsType)stretchableBackgroundCapInsetsForState:(SSKButtonState)state
+{
+    return state < SSKButtonStyleStateCount ? _stretchableBackgroundCapInsets[state] : SSKEdgeInsetsMake(0, 0, 0, 0);
+}
+
+- (SKTexture *)iconTextureForState:(SSKButtonState)state
+{
+    return state < SSKButtonStyleStateCount ? _iconTextures[state] : nil;
+}
+
+- (NSString *)titleForState:(SSKButtonState)state
+{
+    return state < SSKButtonStyleStateCount ? _titles[state] : nil;
+}
+
+- (SSKEdgeInsetsType)titleOffsetForState:(SSKButtonState)state
+{
+    return state < SSKButtonStyleStateCount ? _titleOffsets[state] : SSKEdgeInsetsMake(0, 0, 0, 0);
+}
+
+#pragma mark - NSCopying & NSMutableCopying
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable styles can be shared, so copying them is free
+    if ([self class] == [SSKButtonStyle class]) {
+        return self;
+    }
+    
+    return [self copyToStyleOfClass:[SSKButtonStyle class] zone:zone];
+}
+
+- (id)mutableCopyWithZone:(NSZone *)zone
+{
+    return [self copyToStyleOfClass:[SSKMutableButtonStyle class] zone:zone];
+}
+
+#pragma mark - Private
+
+- (SSKButtonStyle *)copyToStyleOfClass:(Class)styleClass zone:(NSZone *)zone
+{
+    SSKButtonStyle *copy = [[styleClass allocWithZone:zone] init];
+    
+    for (NSUInteger state = 0; state < SSKButtonStyleStateCount; state++) {
+        copy->_attributes[state] = _attributes[state];
+        copy->_backgroundColors[state] = _backgroundColors[state];
+        copy->_backgroundTextures[state] = _backgroundTextures[state];
+        copy->_stretchableBackgroundCapInsets[state] = _stretchableBackgroundCapInsets[state];
+        copy->_iconTextures[state] = _iconTextures[state];
+        copy->_titles[state] = _titles[state];
+        copy->_titleOffsets[state] = _titleOffsets[state];
+    }
+    
+    return copy;
+}
+
+- (void)setObject:(id)object forAttribute:(SSKButtonStyleAttributes)attribute state:(SSKButtonState)state
+{
+    if (state >= SSKButtonStyleStateCount) {
+        return;
+    }
+    
+    object = SSKButtonStyleGetObjectForValue(object);
+    
+    switch (attribute) {
+        case SSKButtonStyleAttributeBackgroundColor:
+            _backgroundColors[state] = object;
+            break;
+        case SSKButtonStyleAttributeBackgroundTexture:
+            _backgroundTextures[state] = object;
+            break;
+        case SSKButtonStyleAttributeIconTexture:
+            _iconTextures[state] = object;
+            break;
+        case SSKButtonStyleAttributeTitle:
+            _titles[state] = [object copy];
+            break;
+        default:
+            NSAssert(NO, @"Attribute %lu is not an object attribute", (unsigned long)attribute);
+            return;
+    }
+    
+    _attributes[state] |= attribute;
+}
+
+- (void)setEdgeInsets:(SSKEdgeInsetsType)edgeInsets forAttribute:(SSKButtonStyleAttributes)attribute state:(SSKButtonState)state
+{
+    if (state >= SSKButtonStyleStateCount) {
+        return;
+    }
+    
+    switch (attribute) {
+        case SSKButtonStyleAttributeStretchableBackgroundCapInsets:
+            _stretchableBackgroundCapInsets[state] = edgeInsets;
+            break;
+        case SSKButtonStyleAttributeTitleOffset:
+            _titleOffsets[state] = edgeInsets;
+            break;
+        default:
+            NSAssert(NO, @"Attribute %lu is not an edge insets attribute", (unsigned long)attribute);
+            return;
+    }
+    
+    _attributes[state] |= attribute;
+}
+
+@end
+
+#pragma mark - SSKMutableButtonStyle
+
+@implementation SSKMutableButtonStyle
+
+- (void)setBackgroundColor:(SKColor *)color forState:(SSKButtonState)state
+{
+    [self setObject:color forAttribute:SSKButtonStyleAttributeBackgroundColor state:state];
+}
+
+- (void)setBackgroundTexture:(SKTexture *)texture forState:(SSKButtonState)state
+{
+    [self setObject:texture forAttribute:SSKButtonStyleAttributeBackgroundTexture state:state];
+}
+
+- (void)setStretchableBackgroundCapInsets:(SSKEdgeInsetsType)capInsets forState:(SSKButtonState)state
+{
+    [self setEdgeInsets:capInsets forAttribute:SSKButtonStyleAttributeStretchableBackgroundCapInsets state:state];
+}
+
+- (void)setIconTexture:(SKTexture *)texture forState:(SSKButtonState)state
+{
+    [self setObject:texture forAttribute:SSKButtonStyleAttributeIconTexture state:state];
+}
+
+- (void)setTitle:(NSString *)title forState:(SSKButtonState)state
+{
+    [self setObject:title forAttribute:SSKButtonStyleAttributeTitle state:state];
+}
+
+- (void)setTitleOffset:(SSKEdgeInsetsType)offset forState:(SSKButtonState)state
+{
+    [self setEdgeInsets:offset forAttribute:SSKButtonStyleAttributeTitleOffset state:state];
+}
+
+@end
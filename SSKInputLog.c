@@ -0,0 +1,167 @@
+#include "SSKInputLog.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char SSKInputLogMagic[4] = {'S', 'S', 'K', 'L'};
+static const uint32_t SSKInputLogVersion = 1;
+
+#define SSKInputLogHeaderSize 8
+
+#pragma mark - Input log writers
+
+bool SSKInputLogWriterOpen(SSKInputLogWriter *writer, const char *path)
+{
+    writer->recordCount = 0;
+    writer->file = fopen(path, "wb");
+    
+    if (!writer->file) {
+        return false;
+    }
+    
+    unsigned char header[SSKInputLogHeaderSize];
+    memcpy(header, SSKInputLogMagic, sizeof(SSKInputLogMagic));
+    memcpy(header + sizeof(SSKInputLogMagic), &SSKInputLogVersion, sizeof(SSKInputLogVersion));
+    
+    if (fwrite(header, sizeof(header), 1, writer->file) != 1) {
+        fclose(writer->file);
+        writer->file = NULL;
+        return false;
+    }
+    
+    return true;
+}
+
+bool SSKInputLogWriterAppend(SSKInputLogWriter *writer, double timestamp, const SSKInputEvent *event)
+{
+    if (!writer->file) {
+        return false;
+    }
+    
+    // Cleared first, so that the padding bytes are written as zeros, and identical sessions produce identical files
+    SSKInputLogRecord record;
+    memset(&record, 0, sizeof(record));
+    
+    record.timestamp = timestamp;
+    record.event.kind = event->kind;
+    record.event.interactionType = event->interactionType;
+    record.event.key = event->key;
+    record.event.pointerID = event->pointerID;
+    record.event.x = event->x;
+    record.event.y = event->y;
+    record.event.dx = event->dx;
+    record.event.dy = event->dy;
+    
+    if (fwrite(&record, sizeof(record), 1, writer->file) != 1) {
+        return false;
+    }
+    
+    writer->recordCount++;
+    
+    return true;
+}
+
+bool SSKInputLogWriterClose(SSKInputLogWriter *writer)
+{
+    if (!writer->file) {
+        return false;
+    }
+    
+    bool succeeded = !ferror(writer->file);
+    succeeded = fclose(writer->file) == 0 && succeeded;
+    
+    writer->file = NULL;
+    
+    return succeeded;
+}
+
+#pragma mark - Input log readers
+
+bool SSKInputLogReaderOpen(SSKInputLogReader *reader, const char *path)
+{
+    reader->records = NULL;
+    reader->recordCount = 0;
+    reader->mapping = NULL;
+    reader->mappingSize = 0;
+    
+    int fileDescriptor = open(path, O_RDONLY);
+    
+    if (fileDescriptor < 0) {
+        return false;
+    }
+    
+    struct stat fileStatus;
+    
+    if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size < SSKInputLogHeaderSize) {
+        close(fileDescriptor);
+        return false;
+    }
+    
+    const size_t fileSize = (size_t)fileStatus.st_size;
+    void *mapping = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    
+    // The mapping stays valid after the file is closed
+    close(fileDescriptor);
+    
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    
+    const unsigned char *bytes = mapping;
+    uint32_t version;
+    memcpy(&version, bytes + sizeof(SSKInputLogMagic), sizeof(version));
+    
+    if (memcmp(bytes, SSKInputLogMagic, sizeof(SSKInputLogMagic)) != 0 || version != SSKInputLogVersion) {
+        munmap(mapping, fileSize);
+        return false;
+    }
+    
+    // Mappings are page aligned, and the header keeps the records 8 byte aligned
+    reader->records = (const SSKInputLogRecord *)(bytes + SSKInputLogHeaderSize);
+    reader->recordCount = (fileSize - SSKInputLogHeaderSize) / sizeof(SSKInputLogRecord);
+    reader->mapping = mapping;
+    reader->mappingSize = fileSize;
+    
+    return true;
+}
+
+void SSKInputLogReaderClose(SSKInputLogReader *reader)
+{
+    if (reader->mapping) {
+        munmap(reader->mapping, reader->mappingSize);
+    }
+    
+    reader->records = NULL;
+    reader->recordCount = 0;
+    reader->mapping = NULL;
+    reader->mappingSize = 0;
+}
+
+size_t SSKInputLogReaderGetFrameEnd(const SSKInputLogReader *reader, size_t index, double frameDuration, double *frameEndTime)
+{
+    if (index >= reader->recordCount) {
+        *frameEndTime = 0;
+        return reader->recordCount;
+    }
+    
+    if (!(frameDuration > 0)) {
+        *frameEndTime = reader->records[reader->recordCount - 1].timestamp;
+        return reader->recordCount;
+    }
+    
+    // The frame is the one containing the first record, which skips over any empty frames before it
+    *frameEndTime = (floor(reader->records[index].timestamp / frameDuration) + 1) * frameDuration;
+    
+    size_t endIndex = index + 1;
+    
+    while (endIndex < reader->recordCount && reader->records[endIndex].timestamp < *frameEndTime) {
+        endIndex++;
+    }
+    
+    return endIndex;
+}
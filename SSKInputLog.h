@@ -0,0 +1,113 @@
+#ifndef SSKInputLog_h
+#define SSKInputLog_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "SSKInputQueue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  A single recorded input event
+ *
+ *  @discussion The timestamp is the number of seconds since the recording started.
+ */
+typedef struct {
+    double timestamp;
+    SSKInputEvent event;
+} SSKInputLogRecord;
+
+/**
+ *  Writes input events to a binary input log file
+ *
+ *  @discussion An input log is an 8 byte header (the characters "SSKL" followed by a 32-bit
+ *  version number), followed by tightly packed SSKInputLogRecord values. All values use the
+ *  byte order of the machine that wrote the log, which makes the records directly usable
+ *  once the file is memory-mapped. Logs can't be read on machines with a different byte order.
+ */
+typedef struct {
+    FILE *file;
+    size_t recordCount;
+} SSKInputLogWriter;
+
+/**
+ *  Reads the records of a memory-mapped input log file
+ *
+ *  @discussion The first "recordCount" records of "records" are valid until the reader is closed.
+ */
+typedef struct {
+    const SSKInputLogRecord *records;
+    size_t recordCount;
+    void *mapping;
+    size_t mappingSize;
+} SSKInputLogReader;
+
+#pragma mark - Input log writers
+
+/**
+ *  Create an input log file and open a writer for it
+ *
+ *  @param writer The writer to open
+ *  @param path The path of the file to write. Any existing file at the path is replaced.
+ *
+ *  @return Whether the file could be created
+ */
+extern bool SSKInputLogWriterOpen(SSKInputLogWriter *writer, const char *path);
+
+/**
+ *  Append an event to an input log
+ *
+ *  @return Whether the event could be written
+ */
+extern bool SSKInputLogWriterAppend(SSKInputLogWriter *writer, double timestamp, const SSKInputEvent *event);
+
+/**
+ *  Flush all appended events to an input log file, and close it
+ *
+ *  @return Whether all events were written successfully
+ */
+extern bool SSKInputLogWriterClose(SSKInputLogWriter *writer);
+
+#pragma mark - Input log readers
+
+/**
+ *  Memory-map an input log file for reading
+ *
+ *  @param reader The reader to open
+ *  @param path The path of the file to read
+ *
+ *  @return Whether the file could be mapped, and is a valid input log. An empty log is valid.
+ */
+extern bool SSKInputLogReaderOpen(SSKInputLogReader *reader, const char *path);
+
+/**
+ *  Unmap an input log file, invalidating all of its records
+ */
+extern void SSKInputLogReaderClose(SSKInputLogReader *reader);
+
+/**
+ *  Get the records of an input log that belong to the same frame, to replay it one frame at a time
+ *
+ *  @param reader The reader of the log
+ *  @param index The index of the first record of the frame
+ *  @param frameDuration The duration of each frame, in seconds
+ *  @param frameEndTime Set to the time at which the frame ends, which is a multiple of the frame duration
+ *
+ *  @return The index after the last record of the frame
+ *
+ *  @discussion A frame contains all records with a timestamp before its end time, starting at the
+ *  given record. Frames without any records are skipped, and each frame contains at least one record.
+ *  If the frame duration isn't positive, all remaining records are part of the same frame.
+ */
+extern size_t SSKInputLogReaderGetFrameEnd(const SSKInputLogReader *reader, size_t index, double frameDuration, double *frameEndTime);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
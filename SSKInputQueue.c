@@ -0,0 +1,127 @@
+#include "SSKInputQueue.h"
+
+#include <stdlib.h>
+
+#pragma mark - Utilities
+
+static bool SSKInputEventIsMove(const SSKInputEvent *event)
+{
+    return event->kind == SSKInputEventKindPointerMoved || event->kind == SSKInputEventKindDrag;
+}
+
+static bool SSKInputEventCanBeMergedIntoEvent(const SSKInputEvent *event, const SSKInputEvent *previousEvent)
+{
+    return SSKInputEventIsMove(event)
+        && previousEvent->kind == event->kind
+        && previousEvent->interactionType == event->interactionType
+        && previousEvent->pointerID == event->pointerID;
+}
+
+/**
+ *  Get the drained event that a move can be merged into, or NULL if it can't be merged
+ *
+ *  @discussion Scans back over the moves of other pointers, since the moves of several fingers are
+ *  interleaved (A, B, A, B), but stops at any other event, and at the previous event of the same pointer.
+ */
+static SSKInputEvent *SSKInputQueueGetEventToMergeInto(const SSKInputEvent *event, SSKInputEvent *events, size_t count)
+{
+    if (!SSKInputEventIsMove(event)) {
+        return NULL;
+    }
+    
+    for (size_t index = count; index > 0; index--) {
+        SSKInputEvent *previousEvent = &events[index - 1];
+        
+        if (!SSKInputEventIsMove(previousEvent) || previousEvent->pointerID == event->pointerID) {
+            return SSKInputEventCanBeMergedIntoEvent(event, previousEvent) ? previousEvent : NULL;
+        }
+    }
+    
+    return NULL;
+}
+
+#pragma mark - Input queues
+
+bool SSKInputQueueInit(SSKInputQueue *queue, size_t capacity)
+{
+    size_t powerOfTwoCapacity = 1;
+    
+    while (powerOfTwoCapacity < capacity) {
+        powerOfTwoCapacity *= 2;
+    }
+    
+    queue->events = malloc(powerOfTwoCapacity * sizeof(SSKInputEvent));
+    queue->capacity = queue->events ? powerOfTwoCapacity : 0;
+    queue->head = 0;
+    queue->tail = 0;
+    
+    return queue->events != NULL;
+}
+
+void SSKInputQueueDestroy(SSKInputQueue *queue)
+{
+    free(queue->events);
+    
+    queue->events = NULL;
+    queue->capacity = 0;
+    queue->head = 0;
+    queue->tail = 0;
+}
+
+bool SSKInputQueuePush(SSKInputQueue *queue, const SSKInputEvent *event)
+{
+    // Only the producer writes the tail, so it can be read without synchronization
+    const size_t tail = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    const size_t head = __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+    
+    if (tail - head >= queue->capacity) {
+        return false;
+    }
+    
+    queue->events[tail & (queue->capacity - 1)] = *event;
+    
+    // Publishing the tail after writing the event makes the event visible to the consumer
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+    
+    return true;
+}
+
+bool SSKInputQueuePop(SSKInputQueue *queue, SSKInputEvent *event)
+{
+    const size_t head = __atomic_load_n(&queue->head, __ATOMIC_RELAXED);
+    const size_t tail = __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    
+    if (head == tail) {
+        return false;
+    }
+    
+    *event = queue->events[head & (queue->capacity - 1)];
+    
+    // Publishing the head after reading the event lets the producer reuse its slot
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+    
+    return true;
+}
+
+size_t SSKInputQueueDrain(SSKInputQueue *queue, SSKInputEvent *events, size_t capacity)
+{
+    size_t count = 0;
+    SSKInputEvent event;
+    
+    while (count < capacity && SSKInputQueuePop(queue, &event)) {
+        SSKInputEvent *previousEvent = SSKInputQueueGetEventToMergeInto(&event, events, count);
+        
+        if (previousEvent) {
+            previousEvent->x = event.x;
+            previousEvent->y = event.y;
+            previousEvent->dx += event.dx;
+            previousEvent->dy += event.dy;
+            continue;
+        }
+        
+        events[count] = event;
+        count++;
+    }
+    
+    return count;
+}
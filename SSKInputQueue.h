@@ -0,0 +1,118 @@
+#ifndef SSKInputQueue_h
+#define SSKInputQueue_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  Enum describing the kinds of input events
+ */
+typedef enum {
+    SSKInputEventKindPointStarted,
+    SSKInputEventKindPointCancelled,
+    SSKInputEventKindPointEnded,
+    SSKInputEventKindPointerMoved,
+    SSKInputEventKindDrag,
+    SSKInputEventKindKeyPressed,
+    SSKInputEventKindKeyReleased,
+    SSKInputEventKindSpecialKeyPressed,
+    SSKInputEventKindSpecialKeyReleased
+} SSKInputEventKind;
+
+/**
+ *  A single input event
+ *
+ *  @discussion The pointer ID identifies the finger or mouse button that generated a point
+ *  event, and is what moves & drags are coalesced by. The key field holds a key code for key
+ *  events, and a special key for special key events. For drags, dx & dy hold the velocity.
+ */
+typedef struct {
+    uint8_t kind;
+    uint8_t interactionType;
+    uint16_t key;
+    uint64_t pointerID;
+    double x;
+    double y;
+    double dx;
+    double dy;
+} SSKInputEvent;
+
+/**
+ *  A fixed-capacity, lock-free, single producer & single consumer queue of input events
+ *
+ *  @discussion Events are pushed by one thread (the producer) and popped by one other thread
+ *  (the consumer) without any locks. The head & tail indices increase forever, and are only
+ *  accessed using atomic operations. The head is only written by the consumer, and the tail
+ *  only by the producer.
+ */
+typedef struct {
+    size_t capacity;
+    SSKInputEvent *events;
+    size_t head;
+    size_t tail;
+} SSKInputQueue;
+
+#pragma mark - Input queues
+
+/**
+ *  Initialize an empty input queue
+ *
+ *  @param queue The queue to initialize
+ *  @param capacity The maximum number of events the queue can hold, rounded up to a power of 2
+ *
+ *  @return Whether memory for the queue could be allocated
+ */
+extern bool SSKInputQueueInit(SSKInputQueue *queue, size_t capacity);
+
+/**
+ *  Free all memory used by an input queue
+ *
+ *  @discussion The queue must not be used by any other thread while it's being destroyed.
+ */
+extern void SSKInputQueueDestroy(SSKInputQueue *queue);
+
+/**
+ *  Push an event onto an input queue, should only be called by the producer
+ *
+ *  @return Whether the event could be pushed. False is returned if the queue is full.
+ */
+extern bool SSKInputQueuePush(SSKInputQueue *queue, const SSKInputEvent *event);
+
+/**
+ *  Pop the oldest event from an input queue, should only be called by the consumer
+ *
+ *  @return Whether an event was popped. False is returned if the queue is empty.
+ */
+extern bool SSKInputQueuePop(SSKInputQueue *queue, SSKInputEvent *event);
+
+/**
+ *  Pop all events from an input queue, coalescing moves & drags, should only be called by the consumer
+ *
+ *  @param queue The queue to drain
+ *  @param events The array to write the popped events to
+ *  @param capacity The number of events that fit in the array. At most this many events are popped.
+ *
+ *  @return The number of events written to the array
+ *
+ *  @discussion A pointer move or drag is merged into the most recent drained event of the same
+ *  pointer, if that event is a move or drag of the same kind & interaction type, and only moves
+ *  of other pointers were drained after it. The merged event gets the latest position, and the
+ *  sum of the velocities. This way, the interleaved moves of several fingers (A, B, A, B) result
+ *  in a single event per finger. Moves are never merged across any other event (including key
+ *  events and the starts & ends of other pointers), so a drag, a key press & another drag are
+ *  still handled in that order.
+ */
+extern size_t SSKInputQueueDrain(SSKInputQueue *queue, SSKInputEvent *events, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,6 +1,10 @@
 #import <Foundation/Foundation.h>
 #import <SpriteKit/SpriteKit.h>
 #import "SSKMultiplatform.h"
+#import "SSKNodeSpatialIndex.h"
+#import "SSKInputQueue.h"
+#import "SSKInputLog.h"
+#import "SSKKeyboardState.h"
 
 #pragma mark - Enums
 
@@ -56,6 +60,8 @@ typedef enum : NSUInteger {
  *
  *  @discussion An interaction is considered cancelled whenever an interaction on the
  *  screen ended, and an interaction was started on a node, but not ended on the same node.
+ *  Each pointer (touch or mouse button) is tracked separately, so ending one touch doesn't
+ *  cancel the interactions of other touches.
  *
  *  On iOS, this is also sent if the system considered the user's touch to be cancelled,
  *  such as if it moved off screen.
@@ -68,6 +74,8 @@ typedef enum : NSUInteger {
  *  @param type The type of interaction that was ended.
  *  @param point The point (in the node's coordinate space) where the
  *  interaction took place.
+ *
+ *  @discussion Only sent if the interaction also started on the node.
  */
 - (void)pointInteractionWithType:(SSKInteractionType)type endedAtPoint:(CGPoint)point;
 
@@ -92,6 +100,10 @@ typedef enum : NSUInteger {
  *  interaction took place.
  *  @param velocity The velocity of the drag (the delta between the current
  *  point and the previously registered point - in the node's coordinate space).
+ *
+ *  @discussion Drags are sent to the nodes that the dragging pointer's interaction started on,
+ *  even once the pointer has moved outside of them. Those nodes are remembered when the
+ *  interaction starts, so drags don't require any hit testing.
  */
 - (void)dragInteractionWithType:(SSKInteractionType)type
                         atPoint:(CGPoint)point
@@ -159,9 +171,178 @@ typedef enum : NSUInteger {
  *  corresponding to the events you wish to receive.
  *
  *  For more information see <SSKInteractiveNode>.
+ *
+ *  By default, every point interaction hit tests the scene's full node tree. For dense
+ *  scenes, register the interactive nodes with the handler and enable
+ *  usesInteractiveNodeRegistry, to only hit test the registered nodes using a spatial grid.
+ *  To handle high-frequency input (like high polling rate mice) at most once per pointer per
+ *  frame, enable queuesEvents.
+ *
+ *  All events seen by the handler can be recorded to a binary input log, which can then be
+ *  replayed through the same dispatch path, for example to profile a heavy input session.
+ *
+ *  Besides sending keyboard events to the scene, the handler keeps track of which keys are
+ *  down, which can be polled every frame (for example using -isKeyDown:).
+ *
+ *  This class depends on SSKNodeSpatialIndex, SSKInputQueue, SSKInputLog & SSKKeyboardState.
  */
 @interface SSKInteractionHandler : NSObject
 
+/**
+ *  Whether only registered interactive nodes should be hit tested
+ *
+ *  @discussion When enabled, interaction events are only sent to nodes registered using
+ *  -registerInteractiveNode: (in addition to the scene), and hit testing is done against a
+ *  spatial grid of their frames, rather than against the scene's full node tree. This keeps
+ *  the cost of each event (like mouse moves) proportional to the number of nodes near the
+ *  point, rather than to the total number of nodes.
+ *
+ *  A node's frame is computed when it's registered, and the frames of all registered nodes
+ *  are updated by -updateWithCurrentTime:, which should be called once per frame when this
+ *  is enabled. Defaults to NO.
+ */
+@property (nonatomic) BOOL usesInteractiveNodeRegistry;
+
+/**
+ *  Whether interaction events should be queued, and handled once per frame
+ *
+ *  @discussion When enabled, interaction events are pushed onto a fixed-size, lock-free queue
+ *  instead of being handled as they arrive, and are handled in order by -updateWithCurrentTime:
+ *  (which must then be called once per frame). Consecutive pointer moves & drags from the same
+ *  pointer are merged into one event with the latest position and the summed velocity, so that
+ *  a run of moves is only hit tested once, no matter how often the system reports it. The moves
+ *  of several pointers are merged per pointer even when they're interleaved, but moves are never
+ *  merged across any other event (like a key press, or another pointer starting or ending).
+ *  If the queue fills up between two frames, the queued events are handled right away instead
+ *  of being dropped. Defaults to NO.
+ */
+@property (nonatomic) BOOL queuesEvents;
+
+/**
+ *  Register a node to receive interaction events, when using the interactive node registry
+ *
+ *  @param node The node to register. Nodes that don't implement any <SSKInteractiveNode>
+ *  methods are ignored. The node isn't retained, and is unregistered when deallocated.
+ *  Its current frame is indexed right away, so it can be hit before the next frame update.
+ */
+- (void)registerInteractiveNode:(SKNode<SSKInteractiveNode> *)node;
+
+/**
+ *  Unregister a node previously registered using -registerInteractiveNode:
+ */
+- (void)unregisterInteractiveNode:(SKNode<SSKInteractiveNode> *)node;
+
+/**
+ *  Register all interactive nodes within a node's tree hierarchy, including the node itself
+ */
+- (void)registerInteractiveNodesInTree:(SKNode *)node;
+
+/**
+ *  The keyboard state of the current frame, for polling keys without any method calls
+ *
+ *  @discussion Use the SSKKeyboardState query functions (like SSKKeyboardStateIsKeyDown) on the
+ *  returned pointer, which stays valid for the lifetime of the handler. Keyboard events update the
+ *  state, and -updateWithCurrentTime: publishes them as the current frame's state, so the state
+ *  doesn't change within a frame. Keyboard events are still sent to the scene as well.
+ */
+@property (nonatomic, readonly) const SSKKeyboardState *keyboardState;
+
+/**
+ *  Whether a key is down in the current frame
+ *
+ *  @param keyCode The key code of the key
+ */
+- (BOOL)isKeyDown:(unsigned short)keyCode;
+
+/**
+ *  Whether a key was pressed between the previous frame and the current one
+ *
+ *  @param keyCode The key code of the key
+ *
+ *  @discussion A key that was both pressed & released between two frames is reported as both
+ *  pressed & released, even though it's not down.
+ */
+- (BOOL)wasKeyPressedThisFrame:(unsigned short)keyCode;
+
+/**
+ *  Whether a key was released between the previous frame and the current one
+ *
+ *  @param keyCode The key code of the key
+ */
+- (BOOL)wasKeyReleasedThisFrame:(unsigned short)keyCode;
+
+/**
+ *  Whether a special key is down in the current frame
+ */
+- (BOOL)isSpecialKeyDown:(SSKSpecialKey)specialKey;
+
+/**
+ *  Whether a special key was pressed between the previous frame and the current one
+ */
+- (BOOL)wasSpecialKeyPressedThisFrame:(SSKSpecialKey)specialKey;
+
+/**
+ *  Whether a special key was released between the previous frame and the current one
+ */
+- (BOOL)wasSpecialKeyReleasedThisFrame:(SSKSpecialKey)specialKey;
+
+/**
+ *  Start recording all interaction events seen by the handler to a binary input log file
+ *
+ *  @param path The path of the file to write. Any existing file at the path is replaced.
+ *
+ *  @return Whether the file could be created
+ *
+ *  @discussion Events are recorded as they arrive, before being queued (see queuesEvents),
+ *  along with the number of seconds since recording started. Any ongoing recording is stopped.
+ */
+- (BOOL)startRecordingInputToFileAtPath:(NSString *)path;
+
+/**
+ *  Stop recording interaction events, and close the input log file
+ */
+- (void)stopRecordingInput;
+
+/**
+ *  Replay all events of a binary input log file, as fast as possible, at 60 frames per second
+ *
+ *  @discussion See -replayInputFromFileAtPath:inScene:frameDuration:.
+ */
+- (NSUInteger)replayInputFromFileAtPath:(NSString *)path inScene:(SKScene *)scene;
+
+/**
+ *  Replay all events of a binary input log file, as fast as possible, one frame at a time
+ *
+ *  @param path The path of an input log file written using -startRecordingInputToFileAtPath:
+ *  @param scene The scene to send the events to. Pass nil to use the scene of the handler's view.
+ *  The scene doesn't have to be presented in a view, which makes it possible to replay input
+ *  against an offscreen scene.
+ *  @param frameDuration The duration of each replayed frame, in seconds
+ *
+ *  @return The number of replayed events, or NSNotFound if the file isn't a valid input log
+ *
+ *  @discussion The events are handled exactly like live events, without any platform event
+ *  objects. They're grouped into frames using their recorded timestamps, and after the events
+ *  of each frame, -updateWithCurrentTime: is called with the frame's end time (relative to the
+ *  start of the recording). This way, queued events are coalesced per frame, and the keyboard
+ *  state & interactive node registry advance between frames, just like they did while recording.
+ *  Frames without any events are skipped, and the timestamps are not waited for.
+ */
+- (NSUInteger)replayInputFromFileAtPath:(NSString *)path inScene:(SKScene *)scene frameDuration:(NSTimeInterval)frameDuration;
+
+/**
+ *  Update the interaction handler, should be called once per frame
+ *
+ *  @param currentTime The current time, as passed to -[SKScene update:]
+ *
+ *  @discussion When using the interactive node registry, this updates the frames of all
+ *  registered nodes (call it after your nodes have moved, for example from your scene's
+ *  -didFinishUpdate). Nodes that stay within the same cells of the grid are updated in place.
+ *  When queueing events, all events queued since the last call are then handled. Finally,
+ *  the keyboard state is advanced to the next frame.
+ */
+- (void)updateWithCurrentTime:(NSTimeInterval)currentTime;
+
 @end
 
 #pragma mark - SKView+SSKInteractionHandler
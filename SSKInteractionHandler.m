@@ -6,7 +6,123 @@ typedef enum : NSUInteger {
     SSKInteractionHandlerEventEnded
 } SSKInteractionHandlerEvent;
 
-#if !TARGET_OS_IPHONE
+/**
+ *  Bitmask describing which <SSKInteractiveNode> methods a class implements
+ */
+typedef enum : NSUInteger {
+    SSKInteractiveNodeCapabilityStarted = 1 << 0,
+    SSKInteractiveNodeCapabilityEnded = 1 << 1,
+    SSKInteractiveNodeCapabilityCancelled = 1 << 2,
+    SSKInteractiveNodeCapabilityPointerMoved = 1 << 3,
+    SSKInteractiveNodeCapabilityDrag = 1 << 4
+} SSKInteractiveNodeCapabilities;
+
+static const CGFloat SSKInteractionHandlerGridCellSize = 128;
+static const size_t SSKInteractionHandlerEventQueueCapacity = 1024;
+static const NSTimeInterval SSKInteractionHandlerReplayFrameDuration = 1.0 / 60.0;
+
+static SSKInteractiveNodeCapabilities SSKInteractionHandlerGetCapabilities(id object)
+{
+    // Cached per class, since conformance & method lookups are expensive compared to a dictionary lookup
+    static NSMutableDictionary *capabilitiesByClass;
+    
+    if (!capabilitiesByClass) {
+        capabilitiesByClass = [NSMutableDictionary new];
+    }
+    
+    Class class = [object class];
+    NSNumber *cachedCapabilities = [capabilitiesByClass objectForKey:class];
+    
+    if (cachedCapabilities) {
+        return [cachedCapabilities unsignedIntegerValue];
+    }
+    
+    SSKInteractiveNodeCapabilities capabilities = 0;
+    
+    if ([class conformsToProtocol:@protocol(SSKInteractiveNode)]) {
+        if ([class instancesRespondToSelector:@selector(pointInteractionWithType:startedAtPoint:)]) {
+            capabilities |= SSKInteractiveNodeCapabilityStarted;
+        }
+        
+        if ([class instancesRespondToSelector:@selector(pointInteractionWithType:endedAtPoint:)]) {
+            capabilities |= SSKInteractiveNodeCapabilityEnded;
+        }
+        
+        if ([class instancesRespondToSelector:@selector(pointInteractionCancelled)]) {
+            capabilities |= SSKInteractiveNodeCapabilityCancelled;
+        }
+        
+        if ([class instancesRespondToSelector:@selector(pointerMovedInteractionAtPoint:)]) {
+            capabilities |= SSKInteractiveNodeCapabilityPointerMoved;
+        }
+        
+        if ([class instancesRespondToSelector:@selector(dragInteractionWithType:atPoint:velocity:)]) {
+            capabilities |= SSKInteractiveNodeCapabilityDrag;
+        }
+    }
+    
+    [capabilitiesByClass setObject:@(capabilities) forKey:class];
+    
+    return capabilities;
+}
+
+static SSKInputEvent SSKInteractionHandlerMakeInputEvent(SSKInputEventKind kind, SSKInteractionType type, uint64_t pointerID, CGPoint point, CGVector velocity)
+{
+    SSKInputEvent inputEvent;
+    inputEvent.kind = kind;
+    inputEvent.interactionType = type;
+    inputEvent.key = 0;
+    inputEvent.pointerID = pointerID;
+    inputEvent.x = point.x;
+    inputEvent.y = point.y;
+    inputEvent.dx = velocity.dx;
+    inputEvent.dy = velocity.dy;
+    
+    return inputEvent;
+}
+
+static SSKInputEventKind SSKInteractionHandlerGetInputEventKind(SSKInteractionHandlerEvent event)
+{
+    SSKInputEventKind kind = SSKInputEventKindPointStarted;
+    
+    switch (event) {
+        case SSKInteractionHandlerEventStarted:
+            break;
+        case SSKInteractionHandlerEventCancelled:
+            kind = SSKInputEventKindPointCancelled;
+            break;
+        case SSKInteractionHandlerEventEnded:
+            kind = SSKInputEventKindPointEnded;
+            break;
+    }
+    
+    return kind;
+}
+
+#if TARGET_OS_IPHONE
+
+static uint64_t SSKInteractionViewGetPointerID(UITouch *touch)
+{
+    // A touch object stays the same for the whole duration of a touch, so its address identifies the finger
+    return (uint64_t)(uintptr_t)(__bridge void *)touch;
+}
+
+#else
+
+static uint64_t SSKInteractionViewGetMousePointerID(SSKInteractionType type)
+{
+    // Each mouse button is its own pointer, so that both buttons can be held down at once
+    return (uint64_t)type;
+}
+
+// The modifier flag mask of each special key, indexed by SSKSpecialKey
+static const NSUInteger SSKSpecialKeyModifierFlagMasks[] = {
+    [SSKSpecialKeyShift] = NSShiftKeyMask,
+    [SSKSpecialKeyControl] = NSControlKeyMask,
+    [SSKSpecialKeyAlt] = NSAlternateKeyMask,
+    [SSKSpecialKeyCommand] = NSCommandKeyMask,
+    [SSKSpecialKeyFn] = NSFunctionKeyMask
+};
 
 static BOOL SSKEventModifierFlagsContainNewKeyDown(NSUInteger newFlags, NSUInteger lastFlags, NSUInteger keyMask)
 {
@@ -48,17 +164,85 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
 
 @end
 
+#pragma mark - SSKPointerCapture
+
+#define SSKPointerCaptureInlineCapacity 4
+
+/**
+ *  The nodes that a pointer's interaction started on, which receive all of its drag & end events
+ */
+@interface SSKPointerCapture : NSObject
+
+- (void)addNode:(SKNode<SSKInteractiveNode> *)node;
+- (void)enumerateNodesUsingBlock:(void(^)(SKNode<SSKInteractiveNode> *node))block;
+
+@end
+
+@implementation SSKPointerCapture
+{
+    // Almost every interaction starts on only a few nodes, so they're kept inline, without any allocations
+    __weak SKNode<SSKInteractiveNode> *_inlineNodes[SSKPointerCaptureInlineCapacity];
+    NSUInteger _inlineNodeCount;
+    NSPointerArray *_overflowNodes;
+}
+
+- (void)addNode:(SKNode<SSKInteractiveNode> *)node
+{
+    if (_inlineNodeCount < SSKPointerCaptureInlineCapacity) {
+        _inlineNodes[_inlineNodeCount] = node;
+        _inlineNodeCount++;
+        return;
+    }
+    
+    if (!_overflowNodes) {
+        _overflowNodes = [NSPointerArray weakObjectsPointerArray];
+    }
+    
+    [_overflowNodes addPointer:(__bridge void *)node];
+}
+
+- (void)enumerateNodesUsingBlock:(void(^)(SKNode<SSKInteractiveNode> *node))block
+{
+    NSAssert(block, @"A block must be supplied");
+    
+    for (NSUInteger index = 0; index < _inlineNodeCount; index++) {
+        SKNode<SSKInteractiveNode> *node = _inlineNodes[index];
+        
+        if (node) {
+            block(node);
+        }
+    }
+    
+    for (SKNode<SSKInteractiveNode> *node in _overflowNodes) {
+        if (node) {
+            block(node);
+        }
+    }
+}
+
+@end
+
 #pragma mark - SSKInteractionHandler implementation
 
 @interface SSKInteractionHandler()
 
 @property (nonatomic, strong, readonly) SKView *view;
 @property (nonatomic, strong) SSKInteractionView *interactionView;
-@property (nonatomic, strong) NSHashTable *currentInteractionNodes;
+@property (nonatomic, strong) NSMutableDictionary *pointerCaptures;
+@property (nonatomic, strong) SSKNodeSpatialIndex *registry;
+@property (nonatomic) BOOL processingQueuedEvents;
+@property (nonatomic, strong) SKScene *replayScene;
 
 @end
 
 @implementation SSKInteractionHandler
+{
+    SSKInputQueue _eventQueue;
+    SSKInputEvent *_drainedEvents;
+    SSKInputLogWriter _inputLogWriter;
+    NSTimeInterval _inputLogStartTime;
+    SSKKeyboardState _keyboardState;
+}
 
 - (id)init
 {
@@ -66,11 +250,176 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
         return nil;
     }
     
-    _currentInteractionNodes = [NSHashTable hashTableWithOptions:NSPointerFunctionsWeakMemory];
+    _pointerCaptures = [NSMutableDictionary new];
+    SSKKeyboardStateInit(&_keyboardState);
+    _registry = [[SSKNodeSpatialIndex alloc] initWithCellSize:SSKInteractionHandlerGridCellSize];
     
     return self;
 }
 
+- (void)dealloc
+{
+    SSKInputQueueDestroy(&_eventQueue);
+    free(_drainedEvents);
+    
+    if (_inputLogWriter.file) {
+        SSKInputLogWriterClose(&_inputLogWriter);
+    }
+}
+
+#pragma mark - Public
+
+- (void)registerInteractiveNode:(SKNode<SSKInteractiveNode> *)node
+{
+    // Scenes always receive events, so they're never hit tested
+    if ([node isKindOfClass:[SKScene class]] || !SSKInteractionHandlerGetCapabilities(node)) {
+        return;
+    }
+    
+    // The frame is computed right away, so the node can be hit before the next update
+    [self.registry addNode:node inNode:node.scene];
+}
+
+- (void)unregisterInteractiveNode:(SKNode<SSKInteractiveNode> *)node
+{
+    [self.registry removeNode:node];
+}
+
+- (void)registerInteractiveNodesInTree:(SKNode *)node
+{
+    [self registerInteractiveNode:(SKNode<SSKInteractiveNode> *)node];
+    
+    for (SKNode *child in node.children) {
+        [self registerInteractiveNodesInTree:child];
+    }
+}
+
+- (void)updateWithCurrentTime:(NSTimeInterval)currentTime
+{
+    if (self.usesInteractiveNodeRegistry) {
+        [self.registry updateFramesInNode:self.scene];
+    }
+    
+    [self processQueuedEvents];
+    
+    SSKKeyboardStateAdvanceFrame(&_keyboardState);
+}
+
+- (const SSKKeyboardState *)keyboardState
+{
+    return &_keyboardState;
+}
+
+- (BOOL)isKeyDown:(unsigned short)keyCode
+{
+    return SSKKeyboardStateIsKeyDown(&_keyboardState, keyCode);
+}
+
+- (BOOL)wasKeyPressedThisFrame:(unsigned short)keyCode
+{
+    return SSKKeyboardStateWasKeyPressedThisFrame(&_keyboardState, keyCode);
+}
+
+- (BOOL)wasKeyReleasedThisFrame:(unsigned short)keyCode
+{
+    return SSKKeyboardStateWasKeyReleasedThisFrame(&_keyboardState, keyCode);
+}
+
+- (BOOL)isSpecialKeyDown:(SSKSpecialKey)specialKey
+{
+    return SSKKeyboardStateIsSpecialKeyDown(&_keyboardState, (unsigned int)specialKey);
+}
+
+- (BOOL)wasSpecialKeyPressedThisFrame:(SSKSpecialKey)specialKey
+{
+    return SSKKeyboardStateWasSpecialKeyPressedThisFrame(&_keyboardState, (unsigned int)specialKey);
+}
+
+- (BOOL)wasSpecialKeyReleasedThisFrame:(SSKSpecialKey)specialKey
+{
+    return SSKKeyboardStateWasSpecialKeyReleasedThisFrame(&_keyboardState, (unsigned int)specialKey);
+}
+
+- (void)setQueuesEvents:(BOOL)queuesEvents
+{
+    if (_queuesEvents == queuesEvents) {
+        return;
+    }
+    
+    if (queuesEvents) {
+        if (!_eventQueue.events) {
+            _drainedEvents = malloc(SSKInteractionHandlerEventQueueCapacity * sizeof(SSKInputEvent));
+            
+            if (!_drainedEvents || !SSKInputQueueInit(&_eventQueue, SSKInteractionHandlerEventQueueCapacity)) {
+                free(_drainedEvents);
+                _drainedEvents = NULL;
+                return;
+            }
+        }
+    } else {
+        // Events queued before turning queueing off are still delivered, in order
+        [self processQueuedEvents];
+    }
+    
+    _queuesEvents = queuesEvents;
+}
+
+- (BOOL)startRecordingInputToFileAtPath:(NSString *)path
+{
+    [self stopRecordingInput];
+    
+    if (!SSKInputLogWriterOpen(&_inputLogWriter, [path fileSystemRepresentation])) {
+        return NO;
+    }
+    
+    _inputLogStartTime = [NSProcessInfo processInfo].systemUptime;
+    
+    return YES;
+}
+
+- (void)stopRecordingInput
+{
+    if (_inputLogWriter.file) {
+        SSKInputLogWriterClose(&_inputLogWriter);
+    }
+}
+
+- (NSUInteger)replayInputFromFileAtPath:(NSString *)path inScene:(SKScene *)scene
+{
+    return [self replayInputFromFileAtPath:path inScene:scene frameDuration:SSKInteractionHandlerReplayFrameDuration];
+}
+
+- (NSUInteger)replayInputFromFileAtPath:(NSString *)path inScene:(SKScene *)scene frameDuration:(NSTimeInterval)frameDuration
+{
+    SSKInputLogReader reader;
+    
+    if (!SSKInputLogReaderOpen(&reader, [path fileSystemRepresentation])) {
+        return NSNotFound;
+    }
+    
+    SKScene *previousReplayScene = self.replayScene;
+    self.replayScene = scene;
+    
+    for (size_t index = 0; index < reader.recordCount;) {
+        double frameEndTime;
+        size_t frameEndIndex = SSKInputLogReaderGetFrameEnd(&reader, index, frameDuration, &frameEndTime);
+        
+        for (; index < frameEndIndex; index++) {
+            [self handleInputEvent:&reader.records[index].event];
+        }
+        
+        [self updateWithCurrentTime:frameEndTime];
+    }
+    
+    self.replayScene = previousReplayScene;
+    
+    SSKInputLogReaderClose(&reader);
+    
+    return reader.recordCount;
+}
+
+#pragma mark - Private
+
 - (void)didMoveToView:(SKView *)view
 {
     self.interactionView = [[SSKInteractionView alloc] initWithFrame:view.bounds interactionHandler:self];
@@ -92,114 +441,260 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     return (SKView *)self.interactionView.superview;
 }
 
-- (void)handlePointInteractionEvent:(SSKInteractionHandlerEvent)event type:(SSKInteractionType)type point:(CGPoint)point
+- (SKScene *)scene
 {
+    return self.replayScene ?: self.view.scene;
+}
+
+- (BOOL)interceptInputEvent:(SSKInputEvent)inputEvent
+{
+    // Events dispatched while processing the queue were already recorded & dequeued, so they're handled directly
+    if (self.processingQueuedEvents) {
+        return NO;
+    }
+    
+    if (_inputLogWriter.file) {
+        NSTimeInterval timestamp = [NSProcessInfo processInfo].systemUptime - _inputLogStartTime;
+        SSKInputLogWriterAppend(&_inputLogWriter, timestamp, &inputEvent);
+    }
+    
+    if (!self.queuesEvents) {
+        return NO;
+    }
+    
+    if (!SSKInputQueuePush(&_eventQueue, &inputEvent)) {
+        // Rather than dropping events when the queue is full, the queued events are handled right away
+        [self processQueuedEvents];
+        SSKInputQueuePush(&_eventQueue, &inputEvent);
+    }
+    
+    return YES;
+}
+
+- (void)processQueuedEvents
+{
+    if (!_eventQueue.events || self.processingQueuedEvents) {
+        return;
+    }
+    
+    self.processingQueuedEvents = YES;
+    
+    size_t eventCount;
+    
+    while ((eventCount = SSKInputQueueDrain(&_eventQueue, _drainedEvents, SSKInteractionHandlerEventQueueCapacity)) > 0) {
+        for (size_t index = 0; index < eventCount; index++) {
+            [self handleInputEvent:&_drainedEvents[index]];
+        }
+    }
+    
+    self.processingQueuedEvents = NO;
+}
+
+- (void)handleInputEvent:(const SSKInputEvent *)inputEvent
+{
+    CGPoint point = CGPointMake(inputEvent->x, inputEvent->y);
+    SSKInteractionType type = (SSKInteractionType)inputEvent->interactionType;
+    
+    switch ((SSKInputEventKind)inputEvent->kind) {
+        case SSKInputEventKindPointStarted:
+            [self handlePointInteractionEvent:SSKInteractionHandlerEventStarted type:type point:point pointerID:inputEvent->pointerID];
+            break;
+        case SSKInputEventKindPointCancelled:
+            [self handlePointInteractionEvent:SSKInteractionHandlerEventCancelled type:type point:point pointerID:inputEvent->pointerID];
+            break;
+        case SSKInputEventKindPointEnded:
+            [self handlePointInteractionEvent:SSKInteractionHandlerEventEnded type:type point:point pointerID:inputEvent->pointerID];
+            break;
+        case SSKInputEventKindPointerMoved:
+            [self handlePointerMovedEventAtPoint:point];
+            break;
+        case SSKInputEventKindDrag:
+            [self handleDragInteractionWithType:type
+                                          point:point
+                                       velocity:CGVectorMake(inputEvent->dx, inputEvent->dy)
+                                      pointerID:inputEvent->pointerID];
+            break;
+        case SSKInputEventKindKeyPressed:
+            [self handleKeyboardEvent:SSKInteractionHandlerEventStarted keyCode:inputEvent->key];
+            break;
+        case SSKInputEventKindKeyReleased:
+            [self handleKeyboardEvent:SSKInteractionHandlerEventEnded keyCode:inputEvent->key];
+            break;
+        case SSKInputEventKindSpecialKeyPressed:
+            [self handleKeyboardEvent:SSKInteractionHandlerEventStarted specialKey:(SSKSpecialKey)inputEvent->key];
+            break;
+        case SSKInputEventKindSpecialKeyReleased:
+            [self handleKeyboardEvent:SSKInteractionHandlerEventEnded specialKey:(SSKSpecialKey)inputEvent->key];
+            break;
+    }
+}
+
+- (void)handlePointInteractionEvent:(SSKInteractionHandlerEvent)event type:(SSKInteractionType)type point:(CGPoint)point pointerID:(uint64_t)pointerID
+{
+    SSKInputEventKind kind = SSKInteractionHandlerGetInputEventKind(event);
+    
+    if ([self interceptInputEvent:SSKInteractionHandlerMakeInputEvent(kind, type, pointerID, point, CGVectorMake(0, 0))]) {
+        return;
+    }
+    
     switch (event) {
         case SSKInteractionHandlerEventStarted: {
-            if ([self.view.scene conformsToProtocol:@protocol(SSKInteractiveNode)]) {
-                if ([self.view.scene respondsToSelector:@selector(pointInteractionWithType:startedAtPoint:)]) {
-                    [(SKScene<SSKInteractiveNode> *)self.view.scene pointInteractionWithType:type startedAtPoint:point];
-                }
+            if (SSKInteractionHandlerGetCapabilities(self.scene) & SSKInteractiveNodeCapabilityStarted) {
+                [(SKScene<SSKInteractiveNode> *)self.scene pointInteractionWithType:type startedAtPoint:point];
             }
             
+            // A pointer can't start a new interaction without ending its previous one
+            [self cancelInteractionOfPointerWithID:pointerID];
+            
+            SSKPointerCapture *capture = [SSKPointerCapture new];
+            SSKInteractiveNodeCapabilities capturedCapabilities = SSKInteractiveNodeCapabilityStarted | SSKInteractiveNodeCapabilityEnded | SSKInteractiveNodeCapabilityCancelled | SSKInteractiveNodeCapabilityDrag;
+            
             [self forEachInteractiveNodeAtPoint:point
-                         thatRespondsToSelector:@selector(pointInteractionWithType:startedAtPoint:)
+                                 withCapability:capturedCapabilities
                                        runBlock:^(SKNode<SSKInteractiveNode> *node) {
-                                           [self.currentInteractionNodes addObject:node];
+                                           [capture addNode:node];
                                            
-                                           CGPoint nodePoint = [node convertPoint:point fromNode:self.view.scene];
-                                           [node pointInteractionWithType:type startedAtPoint:nodePoint];
+                                           if (SSKInteractionHandlerGetCapabilities(node) & SSKInteractiveNodeCapabilityStarted) {
+                                               CGPoint nodePoint = [node convertPoint:point fromNode:self.scene];
+                                               [node pointInteractionWithType:type startedAtPoint:nodePoint];
+                                           }
                                        }];
+            
+            [self.pointerCaptures setObject:capture forKey:@(pointerID)];
         }
             break;
         case SSKInteractionHandlerEventCancelled:
-            if ([self.view.scene conformsToProtocol:@protocol(SSKInteractiveNode)]) {
-                if ([self.view.scene respondsToSelector:@selector(pointInteractionCancelled)]) {
-                    [(SKScene<SSKInteractiveNode> *)self.view.scene pointInteractionCancelled];
-                }
+            if (SSKInteractionHandlerGetCapabilities(self.scene) & SSKInteractiveNodeCapabilityCancelled) {
+                [(SKScene<SSKInteractiveNode> *)self.scene pointInteractionCancelled];
             }
             
-            [self pointInteractionCancelledOrEnded];
+            [self cancelInteractionOfPointerWithID:pointerID];
             break;
         case SSKInteractionHandlerEventEnded: {
-            if ([self.view.scene conformsToProtocol:@protocol(SSKInteractiveNode)]) {
-                if ([self.view.scene respondsToSelector:@selector(pointInteractionWithType:endedAtPoint:)]) {
-                    [(SKScene<SSKInteractiveNode> *)self.view.scene pointInteractionWithType:type endedAtPoint:point];
-                }
+            if (SSKInteractionHandlerGetCapabilities(self.scene) & SSKInteractiveNodeCapabilityEnded) {
+                [(SKScene<SSKInteractiveNode> *)self.scene pointInteractionWithType:type endedAtPoint:point];
             }
             
-            [self forEachInteractiveNodeAtPoint:point
-                         thatRespondsToSelector:@selector(pointInteractionWithType:endedAtPoint:)
-                                       runBlock:^(SKNode<SSKInteractiveNode> *node) {
-                                           [self.currentInteractionNodes removeObject:node];
-                                           
-                                           CGPoint nodePoint = [node convertPoint:point fromNode:self.view.scene];
-                                           [node pointInteractionWithType:type endedAtPoint:nodePoint];
-                                       }];
+            SSKPointerCapture *capture = [self.pointerCaptures objectForKey:@(pointerID)];
+            [self.pointerCaptures removeObjectForKey:@(pointerID)];
             
-            [self pointInteractionCancelledOrEnded];
+            // Nodes that the pointer has left since the interaction started have their interaction cancelled instead
+            [capture enumerateNodesUsingBlock:^(SKNode<SSKInteractiveNode> *node) {
+                SSKInteractiveNodeCapabilities capabilities = SSKInteractionHandlerGetCapabilities(node);
+                
+                if ([self node:node containsScenePoint:point]) {
+                    if (capabilities & SSKInteractiveNodeCapabilityEnded) {
+                        CGPoint nodePoint = [node convertPoint:point fromNode:self.scene];
+                        [node pointInteractionWithType:type endedAtPoint:nodePoint];
+                    }
+                } else if (capabilities & SSKInteractiveNodeCapabilityCancelled) {
+                    [node pointInteractionCancelled];
+                }
+            }];
         }
             break;
     }
 }
 
-- (void)pointInteractionCancelledOrEnded
+- (void)cancelInteractionOfPointerWithID:(uint64_t)pointerID
 {
-    for (SKNode<SSKInteractiveNode> *node in self.currentInteractionNodes) {
-        if ([node respondsToSelector:@selector(pointInteractionCancelled)]) {
+    SSKPointerCapture *capture = [self.pointerCaptures objectForKey:@(pointerID)];
+    
+    if (!capture) {
+        return;
+    }
+    
+    [self.pointerCaptures removeObjectForKey:@(pointerID)];
+    
+    [capture enumerateNodesUsingBlock:^(SKNode<SSKInteractiveNode> *node) {
+        if (SSKInteractionHandlerGetCapabilities(node) & SSKInteractiveNodeCapabilityCancelled) {
             [node pointInteractionCancelled];
         }
+    }];
+}
+
+- (BOOL)node:(SKNode *)node containsScenePoint:(CGPoint)point
+{
+    if (node.scene != self.scene || !node.parent) {
+        return NO;
     }
     
-    [self.currentInteractionNodes removeAllObjects];
+    // -containsPoint: expects a point in the parent's coordinate space
+    return [node containsPoint:[node.parent convertPoint:point fromNode:self.scene]];
 }
 
 - (void)handlePointerMovedEventAtPoint:(CGPoint)point
 {
-    if ([self.view.scene conformsToProtocol:@protocol(SSKInteractiveNode)]) {
-        if ([self.view.scene respondsToSelector:@selector(pointerMovedInteractionAtPoint:)]) {
-            [(SKScene<SSKInteractiveNode> *)self.view.scene pointerMovedInteractionAtPoint:point];
-        }
+    if ([self interceptInputEvent:SSKInteractionHandlerMakeInputEvent(SSKInputEventKindPointerMoved, SSKInteractionTypePrimary, 0, point, CGVectorMake(0, 0))]) {
+        return;
+    }
+    
+    if (SSKInteractionHandlerGetCapabilities(self.scene) & SSKInteractiveNodeCapabilityPointerMoved) {
+        [(SKScene<SSKInteractiveNode> *)self.scene pointerMovedInteractionAtPoint:point];
     }
     
     [self forEachInteractiveNodeAtPoint:point
-                 thatRespondsToSelector:@selector(pointerMovedInteractionAtPoint:)
+                         withCapability:SSKInteractiveNodeCapabilityPointerMoved
                                runBlock:^(SKNode<SSKInteractiveNode> *node) {
-                                   CGPoint nodePoint = [node convertPoint:point fromNode:self.view.scene];
+                                   CGPoint nodePoint = [node convertPoint:point fromNode:self.scene];
                                    [node pointerMovedInteractionAtPoint:nodePoint];
                                }];
 }
 
-- (void)handleDragInteractionWithType:(SSKInteractionType)type point:(CGPoint)point velocity:(CGVector)velocity
+- (void)handleDragInteractionWithType:(SSKInteractionType)type point:(CGPoint)point velocity:(CGVector)velocity pointerID:(uint64_t)pointerID
 {
-    if ([self.view.scene conformsToProtocol:@protocol(SSKInteractiveNode)]) {
-        if ([self.view.scene respondsToSelector:@selector(dragInteractionWithType:atPoint:velocity:)]) {
-            [(SKScene<SSKInteractiveNode> *)self.view.scene dragInteractionWithType:type
-                                                                            atPoint:point
-                                                                           velocity:velocity];
-        }
+    if ([self interceptInputEvent:SSKInteractionHandlerMakeInputEvent(SSKInputEventKindDrag, type, pointerID, point, velocity)]) {
+        return;
     }
     
-    [self forEachInteractiveNodeAtPoint:point
-                 thatRespondsToSelector:@selector(dragInteractionWithType:atPoint:velocity:)
-                               runBlock:^(SKNode<SSKInteractiveNode> *node) {
-                                   CGPoint nodePoint = [node convertPoint:point fromNode:self.view.scene];
-                                   [node dragInteractionWithType:type atPoint:nodePoint velocity:velocity];
-                               }];
+    if (SSKInteractionHandlerGetCapabilities(self.scene) & SSKInteractiveNodeCapabilityDrag) {
+        [(SKScene<SSKInteractiveNode> *)self.scene dragInteractionWithType:type
+                                                                        atPoint:point
+                                                                       velocity:velocity];
+    }
+    
+    void(^dragBlock)(SKNode<SSKInteractiveNode> *) = ^(SKNode<SSKInteractiveNode> *node) {
+        CGPoint nodePoint = [node convertPoint:point fromNode:self.scene];
+        [node dragInteractionWithType:type atPoint:nodePoint velocity:velocity];
+    };
+    
+    SSKPointerCapture *capture = [self.pointerCaptures objectForKey:@(pointerID)];
+    
+    // Drags of a captured pointer go straight to the nodes its interaction started on, without any hit testing
+    if (capture) {
+        [capture enumerateNodesUsingBlock:^(SKNode<SSKInteractiveNode> *node) {
+            if (SSKInteractionHandlerGetCapabilities(node) & SSKInteractiveNodeCapabilityDrag) {
+                dragBlock(node);
+            }
+        }];
+        
+        return;
+    }
+    
+    [self forEachInteractiveNodeAtPoint:point withCapability:SSKInteractiveNodeCapabilityDrag runBlock:dragBlock];
 }
 
-- (void)forEachInteractiveNodeAtPoint:(CGPoint)point thatRespondsToSelector:(SEL)selector runBlock:(void(^)(SKNode<SSKInteractiveNode> *node))block
+- (void)forEachInteractiveNodeAtPoint:(CGPoint)point withCapability:(SSKInteractiveNodeCapabilities)capability runBlock:(void(^)(SKNode<SSKInteractiveNode> *node))block
 {
     NSAssert(block, @"A block must be supplied");
     
-    NSArray *nodesAtPoint = [self.view.scene nodesAtPoint:point];
-    
-    for (SKNode *node in nodesAtPoint) {
-        if (![node conformsToProtocol:@protocol(SSKInteractiveNode)]) {
-            continue;
+    if (self.usesInteractiveNodeRegistry) {
+        SKScene *scene = self.scene;
+        
+        // Collected before running the block, since the block may register or unregister nodes
+        for (SKNode *node in [self.registry nodesInRect:CGRectMake(point.x, point.y, 0, 0)]) {
+            if (node.scene == scene && (SSKInteractionHandlerGetCapabilities(node) & capability)) {
+                block((SKNode<SSKInteractiveNode> *)node);
+            }
         }
         
-        if ([node respondsToSelector:selector]) {
+        return;
+    }
+    
+    NSArray *nodesAtPoint = [self.scene nodesAtPoint:point];
+    
+    for (SKNode *node in nodesAtPoint) {
+        if (SSKInteractionHandlerGetCapabilities(node) & capability) {
             block((SKNode<SSKInteractiveNode> *)node);
         }
     }
@@ -207,11 +702,24 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
 
 - (void)handleKeyboardEvent:(SSKInteractionHandlerEvent)event keyCode:(unsigned short)keyCode
 {
-    if (![self.view.scene conformsToProtocol:@protocol(SSKInteractiveScene)]) {
+    SSKInputEvent inputEvent = SSKInteractionHandlerMakeInputEvent(event == SSKInteractionHandlerEventStarted ? SSKInputEventKindKeyPressed : SSKInputEventKindKeyReleased,
+                                                                   SSKInteractionTypePrimary,
+                                                                   0,
+                                                                   CGPointZero,
+                                                                   CGVectorMake(0, 0));
+    inputEvent.key = keyCode;
+    
+    if (event == SSKInteractionHandlerEventCancelled || [self interceptInputEvent:inputEvent]) {
+        return;
+    }
+    
+    SSKKeyboardStateSetKeyDown(&_keyboardState, keyCode, event == SSKInteractionHandlerEventStarted);
+    
+    if (![self.scene conformsToProtocol:@protocol(SSKInteractiveScene)]) {
         return;
     }
     
-    SKScene<SSKInteractiveScene> *interactiveScene = (SKScene<SSKInteractiveScene> *)self.view.scene;
+    SKScene<SSKInteractiveScene> *interactiveScene = (SKScene<SSKInteractiveScene> *)self.scene;
     
     switch (event) {
         case SSKInteractionHandlerEventStarted:
@@ -233,11 +741,24 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
 
 - (void)handleKeyboardEvent:(SSKInteractionHandlerEvent)event specialKey:(SSKSpecialKey)specialKey
 {
-    if (![self.view.scene conformsToProtocol:@protocol(SSKInteractiveScene)]) {
+    SSKInputEvent inputEvent = SSKInteractionHandlerMakeInputEvent(event == SSKInteractionHandlerEventStarted ? SSKInputEventKindSpecialKeyPressed : SSKInputEventKindSpecialKeyReleased,
+                                                                   SSKInteractionTypePrimary,
+                                                                   0,
+                                                                   CGPointZero,
+                                                                   CGVectorMake(0, 0));
+    inputEvent.key = specialKey;
+    
+    if (event == SSKInteractionHandlerEventCancelled || [self interceptInputEvent:inputEvent]) {
+        return;
+    }
+    
+    SSKKeyboardStateSetSpecialKeyDown(&_keyboardState, (unsigned int)specialKey, event == SSKInteractionHandlerEventStarted);
+    
+    if (![self.scene conformsToProtocol:@protocol(SSKInteractiveScene)]) {
         return;
     }
     
-    SKScene<SSKInteractiveScene> *interactiveScene = (SKScene<SSKInteractiveScene> *)self.view.scene;
+    SKScene<SSKInteractiveScene> *interactiveScene = (SKScene<SSKInteractiveScene> *)self.scene;
     
     switch (event) {
         case SSKInteractionHandlerEventStarted:
@@ -288,7 +809,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     for (UITouch *touch in touches) {
         [self.interactionHandler handlePointInteractionEvent:SSKInteractionHandlerEventStarted
                                                         type:SSKInteractionTypePrimary
-                                                       point:[touch locationInNode:self.scene]];
+                                                       point:[touch locationInNode:self.scene]
+                                                   pointerID:SSKInteractionViewGetPointerID(touch)];
     }
 }
 
@@ -304,7 +826,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
         
         [self.interactionHandler handleDragInteractionWithType:SSKInteractionTypePrimary
                                                          point:point
-                                                      velocity:velocity];
+                                                      velocity:velocity
+                                                     pointerID:SSKInteractionViewGetPointerID(touch)];
     }
 }
 
@@ -313,7 +836,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     for (UITouch *touch in touches) {
         [self.interactionHandler handlePointInteractionEvent:SSKInteractionHandlerEventCancelled
                                                         type:SSKInteractionTypePrimary
-                                                       point:[touch locationInNode:self.scene]];
+                                                       point:[touch locationInNode:self.scene]
+                                                   pointerID:SSKInteractionViewGetPointerID(touch)];
     }
 }
 
@@ -322,7 +846,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     for (UITouch *touch in touches) {
         [self.interactionHandler handlePointInteractionEvent:SSKInteractionHandlerEventEnded
                                                         type:SSKInteractionTypePrimary
-                                                       point:[touch locationInNode:self.scene]];
+                                                       point:[touch locationInNode:self.scene]
+                                                   pointerID:SSKInteractionViewGetPointerID(touch)];
     }
 }
 
@@ -336,7 +861,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     
     [self.interactionHandler handlePointInteractionEvent:SSKInteractionHandlerEventStarted
                                                     type:SSKInteractionTypePrimary
-                                                   point:[event locationInNode:self.scene]];
+                                                   point:[event locationInNode:self.scene]
+                                               pointerID:SSKInteractionViewGetMousePointerID(SSKInteractionTypePrimary)];
 }
 
 - (void)rightMouseDown:(NSEvent *)event
@@ -345,7 +871,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     
     [self.interactionHandler handlePointInteractionEvent:SSKInteractionHandlerEventStarted
                                                     type:SSKInteractionTypeSecondary
-                                                   point:[event locationInNode:self.scene]];
+                                                   point:[event locationInNode:self.scene]
+                                               pointerID:SSKInteractionViewGetMousePointerID(SSKInteractionTypeSecondary)];
 }
 
 - (void)mouseDragged:(NSEvent *)event
@@ -356,7 +883,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     
     [self.interactionHandler handleDragInteractionWithType:SSKInteractionTypePrimary
                                                      point:[event locationInNode:self.scene]
-                                                  velocity:velocity];
+                                                  velocity:velocity
+                                                 pointerID:SSKInteractionViewGetMousePointerID(SSKInteractionTypePrimary)];
 }
 
 - (void)rightMouseDragged:(NSEvent *)event
@@ -367,21 +895,24 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
     
     [self.interactionHandler handleDragInteractionWithType:SSKInteractionTypeSecondary
                                                      point:[event locationInNode:self.scene]
-                                                  velocity:velocity];
+                                                  velocity:velocity
+                                                 pointerID:SSKInteractionViewGetMousePointerID(SSKInteractionTypeSecondary)];
 }
 
 - (void)mouseUp:(NSEvent *)event
 {
     [self.interactionHandler handlePointInteractionEvent:SSKInteractionHandlerEventEnded
                                                     type:SSKInteractionTypePrimary
-                                                   point:[event locationInNode:self.scene]];
+                                                   point:[event locationInNode:self.scene]
+                                               pointerID:SSKInteractionViewGetMousePointerID(SSKInteractionTypePrimary)];
 }
 
 - (void)rightMouseUp:(NSEvent *)event
 {
     [self.interactionHandler handlePointInteractionEvent:SSKInteractionHandlerEventEnded
                                                     type:SSKInteractionTypeSecondary
-                                                   point:[event locationInNode:self.scene]];
+                                                   point:[event locationInNode:self.scene]
+                                               pointerID:SSKInteractionViewGetMousePointerID(SSKInteractionTypeSecondary)];
 }
 
 - (void)mouseMoved:(NSEvent *)event
@@ -414,35 +945,8 @@ static BOOL SSKEventModifierFlagsContainNewKeyUp(NSUInteger newFlags, NSUInteger
         return;
     }
     
-    NSArray *specialKeyMasks = @[
-        @(NSShiftKeyMask),
-        @(NSControlKeyMask),
-        @(NSAlternateKeyMask),
-        @(NSCommandKeyMask),
-        @(NSFunctionKeyMask)
-    ];
-    
-    for (NSNumber *encodedSpecialKeyMask in specialKeyMasks) {
-        NSUInteger specialKeyMask = [encodedSpecialKeyMask unsignedIntegerValue];
-        SSKSpecialKey specialKey = 0;
-        
-        switch (specialKeyMask) {
-            case NSShiftKeyMask:
-                specialKey = SSKSpecialKeyShift;
-                break;
-            case NSControlKeyMask:
-                specialKey = SSKSpecialKeyControl;
-                break;
-            case NSAlternateKeyMask:
-                specialKey = SSKSpecialKeyAlt;
-                break;
-            case NSCommandKeyMask:
-                specialKey = SSKSpecialKeyCommand;
-                break;
-            case NSFunctionKeyMask:
-                specialKey = SSKSpecialKeyFn;
-                break;
-        }
+    for (SSKSpecialKey specialKey = SSKSpecialKeyShift; specialKey <= SSKSpecialKeyFn; specialKey++) {
+        NSUInteger specialKeyMask = SSKSpecialKeyModifierFlagMasks[specialKey];
         
         if (SSKEventModifierFlagsContainNewKeyDown(eventModifierFlags, _eventModifierFlags, specialKeyMask)) {
             [self.interactionHandler handleKeyboardEvent:SSKInteractionHandlerEventStarted
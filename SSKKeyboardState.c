@@ -0,0 +1,69 @@
+#include "SSKKeyboardState.h"
+
+#include <string.h>
+
+#pragma mark - Utilities
+
+static void SSKKeyboardStateSetBit(uint64_t *pendingDown, uint64_t *pendingPressed, uint64_t *pendingReleased, uint64_t bit, bool isDown)
+{
+    if (((*pendingDown & bit) != 0) == isDown) {
+        return;
+    }
+    
+    if (isDown) {
+        *pendingDown |= bit;
+        *pendingPressed |= bit;
+    } else {
+        *pendingDown &= ~bit;
+        *pendingReleased |= bit;
+    }
+}
+
+#pragma mark - Keyboard states
+
+void SSKKeyboardStateInit(SSKKeyboardState *state)
+{
+    memset(state, 0, sizeof(SSKKeyboardState));
+}
+
+void SSKKeyboardStateSetKeyDown(SSKKeyboardState *state, unsigned int keyCode, bool isDown)
+{
+    if (keyCode >= SSKKeyboardStateKeyCount) {
+        return;
+    }
+    
+    const unsigned int wordIndex = keyCode >> 6;
+    
+    SSKKeyboardStateSetBit(&state->pendingDown.keys[wordIndex],
+                           &state->pendingPressed.keys[wordIndex],
+                           &state->pendingReleased.keys[wordIndex],
+                           (uint64_t)1 << (keyCode & 63),
+                           isDown);
+}
+
+void SSKKeyboardStateSetSpecialKeyDown(SSKKeyboardState *state, unsigned int specialKey, bool isDown)
+{
+    if (specialKey >= 32) {
+        return;
+    }
+    
+    uint64_t pendingDown = state->pendingDown.specialKeys;
+    uint64_t pendingPressed = state->pendingPressed.specialKeys;
+    uint64_t pendingReleased = state->pendingReleased.specialKeys;
+    
+    SSKKeyboardStateSetBit(&pendingDown, &pendingPressed, &pendingReleased, (uint64_t)1 << specialKey, isDown);
+    
+    state->pendingDown.specialKeys = (uint32_t)pendingDown;
+    state->pendingPressed.specialKeys = (uint32_t)pendingPressed;
+    state->pendingReleased.specialKeys = (uint32_t)pendingReleased;
+}
+
+void SSKKeyboardStateAdvanceFrame(SSKKeyboardState *state)
+{
+    state->down = state->pendingDown;
+    state->pressed = state->pendingPressed;
+    state->released = state->pendingReleased;
+    
+    memset(&state->pendingPressed, 0, sizeof(SSKKeySet));
+    memset(&state->pendingReleased, 0, sizeof(SSKKeySet));
+}
@@ -0,0 +1,136 @@
+#ifndef SSKKeyboardState_h
+#define SSKKeyboardState_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  The number of key codes tracked by a keyboard state. Higher key codes are ignored.
+ */
+#define SSKKeyboardStateKeyCount 256
+
+/**
+ *  A set of keys, as a 256-bit key code bitmap & a bitmap of special keys
+ */
+typedef struct {
+    uint64_t keys[SSKKeyboardStateKeyCount / 64];
+    uint32_t specialKeys;
+} SSKKeySet;
+
+/**
+ *  The state of a keyboard, double-buffered per frame
+ *
+ *  @discussion Key events update the pending sets. Advancing the frame publishes the pending
+ *  sets as the sets of the current frame (which are the ones that are queried), and starts
+ *  accumulating presses & releases for the next frame. This keeps all queries stable within a
+ *  frame, and a key that is both pressed & released between two frames is still reported as
+ *  pressed and released in the next frame.
+ */
+typedef struct {
+    SSKKeySet down;
+    SSKKeySet pressed;
+    SSKKeySet released;
+    SSKKeySet pendingDown;
+    SSKKeySet pendingPressed;
+    SSKKeySet pendingReleased;
+} SSKKeyboardState;
+
+#pragma mark - Keyboard states
+
+/**
+ *  Initialize a keyboard state with no keys down
+ */
+extern void SSKKeyboardStateInit(SSKKeyboardState *state);
+
+/**
+ *  Register that a key was pressed or released
+ *
+ *  @param state The state to update
+ *  @param keyCode The key code of the key
+ *  @param isDown Whether the key was pressed (true) or released (false)
+ *
+ *  @discussion Pressing a key that is already down, or releasing a key that is already up, has no effect.
+ */
+extern void SSKKeyboardStateSetKeyDown(SSKKeyboardState *state, unsigned int keyCode, bool isDown);
+
+/**
+ *  Register that a special key (an SSKSpecialKey) was pressed or released
+ */
+extern void SSKKeyboardStateSetSpecialKeyDown(SSKKeyboardState *state, unsigned int specialKey, bool isDown);
+
+/**
+ *  Publish all key events since the last call as the current frame's state
+ */
+extern void SSKKeyboardStateAdvanceFrame(SSKKeyboardState *state);
+
+#pragma mark - Queries
+
+static inline bool SSKKeySetContainsKey(const SSKKeySet *set, unsigned int keyCode)
+{
+    return keyCode < SSKKeyboardStateKeyCount && ((set->keys[keyCode >> 6] >> (keyCode & 63)) & 1);
+}
+
+static inline bool SSKKeySetContainsSpecialKey(const SSKKeySet *set, unsigned int specialKey)
+{
+    return specialKey < 32 && ((set->specialKeys >> specialKey) & 1);
+}
+
+/**
+ *  Whether a key is down in the current frame
+ */
+static inline bool SSKKeyboardStateIsKeyDown(const SSKKeyboardState *state, unsigned int keyCode)
+{
+    return SSKKeySetContainsKey(&state->down, keyCode);
+}
+
+/**
+ *  Whether a key was pressed between the previous frame and the current one
+ */
+static inline bool SSKKeyboardStateWasKeyPressedThisFrame(const SSKKeyboardState *state, unsigned int keyCode)
+{
+    return SSKKeySetContainsKey(&state->pressed, keyCode);
+}
+
+/**
+ *  Whether a key was released between the previous frame and the current one
+ */
+static inline bool SSKKeyboardStateWasKeyReleasedThisFrame(const SSKKeyboardState *state, unsigned int keyCode)
+{
+    return SSKKeySetContainsKey(&state->released, keyCode);
+}
+
+/**
+ *  Whether a special key is down in the current frame
+ */
+static inline bool SSKKeyboardStateIsSpecialKeyDown(const SSKKeyboardState *state, unsigned int specialKey)
+{
+    return SSKKeySetContainsSpecialKey(&state->down, specialKey);
+}
+
+/**
+ *  Whether a special key was pressed between the previous frame and the current one
+ */
+static inline bool SSKKeyboardStateWasSpecialKeyPressedThisFrame(const SSKKeyboardState *state, unsigned int specialKey)
+{
+    return SSKKeySetContainsSpecialKey(&state->pressed, specialKey);
+}
+
+/**
+ *  Whether a special key was released between the previous frame and the current one
+ */
+static inline bool SSKKeyboardStateWasSpecialKeyReleasedThisFrame(const SSKKeyboardState *state, unsigned int specialKey)
+{
+    return SSKKeySetContainsSpecialKey(&state->released, specialKey);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
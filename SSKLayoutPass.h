@@ -0,0 +1,93 @@
+#import <SpriteKit/SpriteKit.h>
+
+/**
+ *  Protocol adopted by nodes that can have their layout scheduled by SSKLayoutPass
+ */
+@protocol SSKLayoutPassNode <NSObject>
+
+/**
+ *  Mark the node as needing layout
+ *
+ *  @discussion When the shared layout pass is deferred, the node's layout is performed
+ *  by the next call to -[SSKLayoutPass performLayout]. Otherwise, it's performed right away.
+ */
+- (void)setNeedsLayout;
+
+/**
+ *  Perform the node's layout, if it's marked as needing layout
+ */
+- (void)layoutIfNeeded;
+
+@end
+
+/**
+ *  A process-wide pass that coalesces the layout work of nodes into one pass per frame
+ *
+ *  @discussion By default, the layout pass is not deferred, meaning that nodes are laid out
+ *  as soon as they're marked as needing layout. When deferred, setting multiple properties
+ *  on a node (or on nodes that depend on each other, like an SSKButtonNode and its
+ *  SSKStretchableNode background) only marks them as dirty, and each node is laid out once
+ *  when -performLayout is called. Call -performLayout from your scene's -didEvaluateActions
+ *  (or -update:) method, so that all layout is done before the scene is rendered.
+ *
+ *  Nodes are laid out from the root of the node tree and down, so that a node that changes
+ *  its children while being laid out doesn't cause them to be laid out twice. Scheduled
+ *  nodes are only weakly referenced, so a node that is released before the next pass is
+ *  simply skipped.
+ *
+ *  SSKTileableNode, SSKStretchableNode and SSKButtonNode all use the shared layout pass.
+ */
+@interface SSKLayoutPass : NSObject
+
+/**
+ *  Whether layout should be deferred until -performLayout is called
+ *
+ *  @discussion The default is NO. Setting this property to NO performs any pending layout.
+ */
+@property (nonatomic, getter = isDeferred) BOOL deferred;
+
+/**
+ *  The number of times a node was marked as needing layout
+ */
+@property (nonatomic, readonly) NSUInteger scheduledLayoutCount;
+
+/**
+ *  The number of times a node was laid out by the layout pass
+ */
+@property (nonatomic, readonly) NSUInteger performedLayoutCount;
+
+/**
+ *  The number of times a node was marked as needing layout while already having
+ *  pending layout, meaning that its layout was coalesced with a previous request
+ */
+@property (nonatomic, readonly) NSUInteger coalescedLayoutCount;
+
+/**
+ *  Return the shared, process-wide, layout pass
+ */
++ (instancetype)sharedPass;
+
+/**
+ *  Schedule a node to be laid out
+ *
+ *  @param node The node to schedule
+ *
+ *  @discussion Nodes call this method from their -setNeedsLayout implementation. If the
+ *  pass isn't deferred, the node is laid out right away.
+ */
+- (void)scheduleNode:(SKNode<SSKLayoutPassNode> *)node;
+
+/**
+ *  Lay out all nodes that have been scheduled since the last layout pass
+ *
+ *  @discussion Nodes that get scheduled while the pass is being performed (for example
+ *  child nodes resized by their parent) are also laid out before this method returns.
+ */
+- (void)performLayout;
+
+/**
+ *  Reset the scheduled, performed & coalesced counters to zero
+ */
+- (void)resetCounters;
+
+@end
@@ -0,0 +1,130 @@
+#import "SSKLayoutPass.h"
+
+#pragma mark - C Utilities
+
+static NSUInteger SSKLayoutPassGetNodeDepth(SKNode *node)
+{
+    NSUInteger depth = 0;
+    
+    for (SKNode *parent = node.parent; parent; parent = parent.parent) {
+        depth++;
+    }
+    
+    return depth;
+}
+
+#pragma mark - SSKLayoutPass
+
+@interface SSKLayoutPass()
+
+@property (nonatomic, readwrite) NSUInteger scheduledLayoutCount;
+@property (nonatomic, readwrite) NSUInteger performedLayoutCount;
+@property (nonatomic, readwrite) NSUInteger coalescedLayoutCount;
+@property (nonatomic, strong) NSHashTable *scheduledNodes;
+
+@end
+
+@implementation SSKLayoutPass
+
++ (instancetype)sharedPass
+{
+    static SSKLayoutPass *sharedPass;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        sharedPass = [self new];
+    });
+    
+    return sharedPass;
+}
+
+- (id)init
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    // Weak, so that a node that is removed & released before the next pass doesn't stay alive until then
+    _scheduledNodes = [NSHashTable weakObjectsHashTable];
+    
+    return self;
+}
+
+#pragma mark - Public
+
+- (void)scheduleNode:(SKNode<SSKLayoutPassNode> *)node
+{
+    if (!node) {
+        return;
+    }
+    
+    self.scheduledLayoutCount++;
+    
+    if (!self.isDeferred) {
+        self.performedLayoutCount++;
+        [node layoutIfNeeded];
+        
+        return;
+    }
+    
+    if ([self.scheduledNodes containsObject:node]) {
+        self.coalescedLayoutCount++;
+        return;
+    }
+    
+    [self.scheduledNodes addObject:node];
+}
+
+- (void)performLayout
+{
+    NSArray *scheduledNodes = [self.scheduledNodes allObjects];
+    
+    while ([scheduledNodes count] > 0) {
+        NSMutableArray *nodesWithDepth = [NSMutableArray arrayWithCapacity:[scheduledNodes count]];
+        
+        for (SKNode *node in scheduledNodes) {
+            [nodesWithDepth addObject:@[@(SSKLayoutPassGetNodeDepth(node)), node]];
+        }
+        
+        // The scheduled nodes are unordered, so they're ordered by depth here, once per pass
+        [nodesWithDepth sortUsingComparator:^NSComparisonResult(NSArray *nodeWithDepth, NSArray *otherNodeWithDepth) {
+            return [[nodeWithDepth firstObject] compare:[otherNodeWithDepth firstObject]];
+        }];
+        
+        for (NSArray *nodeWithDepth in nodesWithDepth) {
+            SKNode<SSKLayoutPassNode> *node = [nodeWithDepth lastObject];
+            
+            // Nodes stay scheduled until laid out, so that ancestors marking them as needing layout are coalesced
+            [self.scheduledNodes removeObject:node];
+            
+            self.performedLayoutCount++;
+            [node layoutIfNeeded];
+        }
+        
+        scheduledNodes = [self.scheduledNodes allObjects];
+    }
+}
+
+- (void)resetCounters
+{
+    self.scheduledLayoutCount = 0;
+    self.performedLayoutCount = 0;
+    self.coalescedLayoutCount = 0;
+}
+
+#pragma mark - Accessor overrides
+
+- (void)setDeferred:(BOOL)deferred
+{
+    if (_deferred == deferred) {
+        return;
+    }
+    
+    _deferred = deferred;
+    
+    if (!deferred) {
+        [self performLayout];
+    }
+}
+
+@end
@@ -0,0 +1,132 @@
+#include "SSKListLayout.h"
+
+#include <stdlib.h>
+
+#pragma mark - List layouts
+
+void SSKListLayoutInit(SSKListLayout *layout)
+{
+    layout->count = 0;
+    layout->capacity = 0;
+    layout->offsets = NULL;
+}
+
+void SSKListLayoutDestroy(SSKListLayout *layout)
+{
+    free(layout->offsets);
+    
+    SSKListLayoutInit(layout);
+}
+
+bool SSKListLayoutSetRows(SSKListLayout *layout, const double *heights, double defaultHeight, size_t count)
+{
+    if (count + 1 > layout->capacity) {
+        size_t capacity = layout->capacity > 0 ? layout->capacity : 64;
+        
+        while (capacity < count + 1) {
+            capacity *= 2;
+        }
+        
+        double *offsets = realloc(layout->offsets, capacity * sizeof(double));
+        
+        if (!offsets) {
+            return false;
+        }
+        
+        layout->offsets = offsets;
+        layout->capacity = capacity;
+    }
+    
+    layout->count = count;
+    layout->offsets[0] = 0;
+    
+    for (size_t row = 0; row < count; row++) {
+        layout->offsets[row + 1] = layout->offsets[row] + (heights ? heights[row] : defaultHeight);
+    }
+    
+    return true;
+}
+
+void SSKListLayoutSetRowHeight(SSKListLayout *layout, size_t row, double height)
+{
+    if (row >= layout->count) {
+        return;
+    }
+    
+    const double delta = height - SSKListLayoutGetRowHeight(layout, row);
+    
+    if (delta == 0) {
+        return;
+    }
+    
+    for (size_t index = row + 1; index <= layout->count; index++) {
+        layout->offsets[index] += delta;
+    }
+}
+
+double SSKListLayoutGetRowOffset(const SSKListLayout *layout, size_t row)
+{
+    if (!layout->offsets) {
+        return 0;
+    }
+    
+    return layout->offsets[row < layout->count ? row : layout->count];
+}
+
+double SSKListLayoutGetRowHeight(const SSKListLayout *layout, size_t row)
+{
+    if (row >= layout->count) {
+        return 0;
+    }
+    
+    return layout->offsets[row + 1] - layout->offsets[row];
+}
+
+double SSKListLayoutGetContentHeight(const SSKListLayout *layout)
+{
+    return layout->offsets ? layout->offsets[layout->count] : 0;
+}
+
+size_t SSKListLayoutGetRowAtOffset(const SSKListLayout *layout, double offset)
+{
+    if (layout->count == 0) {
+        return 0;
+    }
+    
+    // Find the last row whose top is at or above the offset
+    size_t low = 0;
+    size_t high = layout->count;
+    
+    while (high - low > 1) {
+        const size_t middle = low + (high - low) / 2;
+        
+        if (layout->offsets[middle] <= offset) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    
+    return low;
+}
+
+size_t SSKListLayoutGetRowsInRange(const SSKListLayout *layout, double top, double height, size_t *firstRow)
+{
+    *firstRow = 0;
+    
+    if (layout->count == 0 || height <= 0 || top >= SSKListLayoutGetContentHeight(layout) || top + height <= 0) {
+        return 0;
+    }
+    
+    const size_t first = SSKListLayoutGetRowAtOffset(layout, top);
+    size_t last = SSKListLayoutGetRowAtOffset(layout, top + height);
+    
+    // Rows that start exactly at the bottom of the range aren't within it, and there can be several, since rows can have no height
+    while (last > first && layout->offsets[last] >= top + height) {
+        last--;
+    }
+    
+    *firstRow = first;
+    
+    return last - first + 1;
+}
@@ -0,0 +1,97 @@
+#ifndef SSKListLayout_h
+#define SSKListLayout_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  The vertical layout of a list of rows with variable heights
+ *
+ *  @discussion The offsets array holds a prefix sum of the row heights, with count + 1
+ *  entries: offsets[i] is the distance from the top of the list to the top of row i, and
+ *  offsets[count] is the height of the whole list. Since the offsets are sorted, the row at
+ *  an offset is found using a binary search.
+ */
+typedef struct {
+    size_t count;
+    size_t capacity;
+    double *offsets;
+} SSKListLayout;
+
+#pragma mark - List layouts
+
+/**
+ *  Initialize an empty list layout
+ */
+extern void SSKListLayoutInit(SSKListLayout *layout);
+
+/**
+ *  Free all memory used by a list layout, and make it empty
+ */
+extern void SSKListLayoutDestroy(SSKListLayout *layout);
+
+/**
+ *  Replace all rows of a list layout
+ *
+ *  @param layout The layout to update
+ *  @param heights The height of each row. Pass NULL to give every row the default height.
+ *  @param defaultHeight The height of each row, if no heights array is given
+ *  @param count The number of rows
+ *
+ *  @return Whether memory for the rows could be allocated. If not, the layout is left unchanged.
+ */
+extern bool SSKListLayoutSetRows(SSKListLayout *layout, const double *heights, double defaultHeight, size_t count);
+
+/**
+ *  Change the height of a single row, which moves all rows below it
+ *
+ *  @discussion This costs time proportional to the number of rows below the changed row.
+ */
+extern void SSKListLayoutSetRowHeight(SSKListLayout *layout, size_t row, double height);
+
+/**
+ *  Return the distance from the top of the list to the top of a row
+ */
+extern double SSKListLayoutGetRowOffset(const SSKListLayout *layout, size_t row);
+
+/**
+ *  Return the height of a row
+ */
+extern double SSKListLayoutGetRowHeight(const SSKListLayout *layout, size_t row);
+
+/**
+ *  Return the height of all rows combined
+ */
+extern double SSKListLayoutGetContentHeight(const SSKListLayout *layout);
+
+/**
+ *  Return the row at a distance from the top of the list, in O(log n) time
+ *
+ *  @return The index of the row containing the offset. Offsets above the list return the
+ *  first row, and offsets below it return the last row. An empty list returns 0.
+ */
+extern size_t SSKListLayoutGetRowAtOffset(const SSKListLayout *layout, double offset);
+
+/**
+ *  Find the rows that intersect a vertical range of the list
+ *
+ *  @param layout The layout to search
+ *  @param top The distance from the top of the list to the top of the range
+ *  @param height The height of the range
+ *  @param firstRow Set to the index of the first row within the range
+ *
+ *  @return The number of rows within the range, starting at the first row
+ */
+extern size_t SSKListLayoutGetRowsInRange(const SSKListLayout *layout, double top, double height, size_t *firstRow);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
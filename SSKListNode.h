@@ -0,0 +1,183 @@
+#import <SpriteKit/SpriteKit.h>
+#import "SSKListLayout.h"
+#import "SSKLayoutPass.h"
+#import "SSKInteractionHandler.h"
+
+@class SSKListNode;
+
+#pragma mark - SSKListNodeDataSource
+
+/**
+ *  Protocol implemented by objects that provide the cells of an SSKListNode
+ */
+@protocol SSKListNodeDataSource <NSObject>
+
+/**
+ *  Return the number of cells in a list node
+ */
+- (NSUInteger)numberOfCellsInListNode:(SSKListNode *)listNode;
+
+/**
+ *  Return the node to display for a cell of a list node
+ *
+ *  @param listNode The list node requesting the cell
+ *  @param index The index of the cell
+ *
+ *  @discussion Call -dequeueReusableCellWithIdentifier: on the list node first, to reuse a cell
+ *  that was scrolled out of view, and only create a new cell if none was returned. Give newly
+ *  created cells a reuse identifier (see ssk_reuseIdentifier), to make them reusable.
+ *
+ *  The cell is positioned by its origin, at the bottom left corner of its frame within the list.
+ */
+- (SKNode *)listNode:(SSKListNode *)listNode cellAtIndex:(NSUInteger)index;
+
+@optional
+
+/**
+ *  Return the height of a row of a list node
+ *
+ *  @discussion If not implemented, every row has the list node's rowHeight. Heights are
+ *  only requested when the list is reloaded.
+ */
+- (CGFloat)listNode:(SSKListNode *)listNode heightForRowAtIndex:(NSUInteger)row;
+
+@end
+
+#pragma mark - SSKListNode
+
+/**
+ *  A node that displays a scrollable, virtualized list or grid of cells
+ *
+ *  @discussion Only the cells within the visible rows (plus a buffer of rows above & below
+ *  them) exist as child nodes. When a cell is scrolled out of view, it's removed and put into
+ *  a reuse pool, from which the data source can dequeue it again for another index, the same
+ *  way table views work. This keeps the number of nodes proportional to the size of the list
+ *  node, rather than to the number of cells, so lists of thousands of buttons or labels stay cheap.
+ *
+ *  Rows are laid out from the top of the node down. Each row contains columnCount cells,
+ *  so a column count above 1 makes the list a grid. Row heights are kept as a prefix sum in
+ *  an SSKListLayout, so finding the rows at any scroll offset is a binary search.
+ *
+ *  The list is scrolled by dragging it (which requires an SSKInteractionHandler), or by
+ *  setting contentOffset. Cells aren't clipped to the node's size; add the list node to an
+ *  SKCropNode to hide the cells that are partially outside of it. Changes are laid out through
+ *  the shared SSKLayoutPass.
+ *
+ *  This class depends on SSKListLayout.
+ */
+@interface SSKListNode : SKNode <SSKLayoutPassNode, SSKInteractiveNode>
+
+/**
+ *  The object that provides the list's cells
+ *
+ *  @discussion Setting this property reloads the list.
+ */
+@property (nonatomic, weak) id<SSKListNodeDataSource> dataSource;
+
+/**
+ *  The size of the visible area of the list
+ */
+@property (nonatomic) CGSize size;
+
+/**
+ *  The height of each row, if the data source doesn't provide row heights
+ *
+ *  @discussion The default is 44. Setting this property reloads the list.
+ */
+@property (nonatomic) CGFloat rowHeight;
+
+/**
+ *  The number of cells in each row
+ *
+ *  @discussion The default is 1. Each cell gets an equal share of the list's width.
+ *  Setting this property reloads the list.
+ */
+@property (nonatomic) NSUInteger columnCount;
+
+/**
+ *  The number of rows to keep above & below the visible rows
+ *
+ *  @discussion Keeping a few extra rows avoids creating cells right at the edge of the
+ *  list while scrolling. The default is 2.
+ */
+@property (nonatomic) NSUInteger bufferRowCount;
+
+/**
+ *  The distance that the list is scrolled down from its top
+ *
+ *  @discussion Values outside of the scrollable range are clamped.
+ */
+@property (nonatomic) CGFloat contentOffset;
+
+/**
+ *  The combined height of all rows
+ */
+@property (nonatomic, readonly) CGFloat contentHeight;
+
+/**
+ *  The cells that are currently child nodes of the list
+ */
+@property (nonatomic, strong, readonly) NSArray *visibleCells;
+
+/**
+ *  Allocate & initialize an instance of SSKListNode
+ *
+ *  @param size The size of the visible area of the list
+ */
++ (instancetype)listNodeWithSize:(CGSize)size;
+
+/**
+ *  Discard all cells & row heights, and request them again from the data source
+ *
+ *  @discussion The discarded cells are put into the reuse pool.
+ */
+- (void)reloadData;
+
+/**
+ *  Return a cell that was scrolled out of view, for reuse
+ *
+ *  @param identifier The reuse identifier of the cell to dequeue
+ *
+ *  @return A cell with the reuse identifier, or nil if there are no cells to reuse
+ */
+- (SKNode *)dequeueReusableCellWithIdentifier:(NSString *)identifier;
+
+/**
+ *  Return the cell currently displayed for an index, or nil if it isn't displayed
+ */
+- (SKNode *)cellAtIndex:(NSUInteger)index;
+
+/**
+ *  Return the index of the row at a distance from the top of the list
+ *
+ *  @discussion Runs in O(log n) time, using a binary search of the row offsets.
+ */
+- (NSUInteger)rowAtContentOffset:(CGFloat)contentOffset;
+
+/**
+ *  Scroll the list so that a row is at its top (or as close to it as the list can scroll)
+ */
+- (void)scrollToRowAtIndex:(NSUInteger)row;
+
+/**
+ *  Change the height of a single row, without reloading the list
+ */
+- (void)setHeight:(CGFloat)height forRowAtIndex:(NSUInteger)row;
+
+@end
+
+#pragma mark - SKNode+SSKListNode
+
+/**
+ *  Category adding reuse identifiers to nodes, for use as cells of an SSKListNode
+ */
+@interface SKNode (SSKListNode)
+
+/**
+ *  The reuse identifier of a cell, used to dequeue it from an SSKListNode's reuse pool
+ *
+ *  @discussion Cells without a reuse identifier are never reused.
+ */
+@property (nonatomic, copy) NSString *ssk_reuseIdentifier;
+
+@end
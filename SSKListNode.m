@@ -0,0 +1,333 @@
+#import "SSKListNode.h"
+#import <objc/runtime.h>
+
+static char SSKReuseIdentifierKey;
+
+@interface SSKListNode()
+
+@property (nonatomic, strong) NSMutableDictionary *cellsByIndex;
+@property (nonatomic, strong) NSMutableDictionary *reusableCells;
+@property (nonatomic) NSUInteger cellCount;
+@property (nonatomic) BOOL needsLayout;
+
+@end
+
+@implementation SSKListNode
+{
+    SSKListLayout _layout;
+}
+
++ (instancetype)listNodeWithSize:(CGSize)size
+{
+    SSKListNode *listNode = [self node];
+    listNode.size = size;
+    
+    return listNode;
+}
+
+- (id)init
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    SSKListLayoutInit(&_layout);
+    _cellsByIndex = [NSMutableDictionary new];
+    _reusableCells = [NSMutableDictionary new];
+    _rowHeight = 44;
+    _columnCount = 1;
+    _bufferRowCount = 2;
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    SSKListLayoutDestroy(&_layout);
+}
+
+#pragma mark - Public API
+
+- (void)reloadData
+{
+    for (NSNumber *index in [self.cellsByIndex allKeys]) {
+        [self enqueueReusableCell:[self.cellsByIndex objectForKey:index]];
+    }
+    
+    [self.cellsByIndex removeAllObjects];
+    
+    id<SSKListNodeDataSource> dataSource = self.dataSource;
+    self.cellCount = [dataSource numberOfCellsInListNode:self];
+    
+    NSUInteger rowCount = (self.cellCount + self.columnCount - 1) / self.columnCount;
+    double *rowHeights = NULL;
+    
+    if ([dataSource respondsToSelector:@selector(listNode:heightForRowAtIndex:)]) {
+        rowHeights = malloc(rowCount * sizeof(double));
+        
+        for (NSUInteger row = 0; rowHeights && row < rowCount; row++) {
+            rowHeights[row] = [dataSource listNode:self heightForRowAtIndex:row];
+        }
+    }
+    
+    if (!SSKListLayoutSetRows(&_layout, rowHeights, self.rowHeight, rowCount)) {
+        self.cellCount = 0;
+        SSKListLayoutSetRows(&_layout, NULL, 0, 0);
+    }
+    
+    free(rowHeights);
+    
+    // Clamps the offset to the new content height
+    self.contentOffset = _contentOffset;
+    
+    [self setNeedsLayout];
+}
+
+- (SKNode *)dequeueReusableCellWithIdentifier:(NSString *)identifier
+{
+    if (!identifier) {
+        return nil;
+    }
+    
+    NSMutableArray *reusableCells = [self.reusableCells objectForKey:identifier];
+    SKNode *cell = [reusableCells lastObject];
+    
+    if (cell) {
+        [reusableCells removeLastObject];
+    }
+    
+    return cell;
+}
+
+- (SKNode *)cellAtIndex:(NSUInteger)index
+{
+    return [self.cellsByIndex objectForKey:@(index)];
+}
+
+- (NSUInteger)rowAtContentOffset:(CGFloat)contentOffset
+{
+    return SSKListLayoutGetRowAtOffset(&_layout, contentOffset);
+}
+
+- (void)scrollToRowAtIndex:(NSUInteger)row
+{
+    self.contentOffset = SSKListLayoutGetRowOffset(&_layout, row);
+}
+
+- (void)setHeight:(CGFloat)height forRowAtIndex:(NSUInteger)row
+{
+    SSKListLayoutSetRowHeight(&_layout, row, height);
+    
+    self.contentOffset = _contentOffset;
+    
+    [self setNeedsLayout];
+}
+
+#pragma mark - Accessor overrides
+
+- (void)setDataSource:(id<SSKListNodeDataSource>)dataSource
+{
+    _dataSource = dataSource;
+    
+    [self reloadData];
+}
+
+- (void)setSize:(CGSize)size
+{
+    if (CGSizeEqualToSize(_size, size)) {
+        return;
+    }
+    
+    _size = size;
+    
+    self.contentOffset = _contentOffset;
+    
+    [self setNeedsLayout];
+}
+
+- (void)setRowHeight:(CGFloat)rowHeight
+{
+    if (_rowHeight == rowHeight) {
+        return;
+    }
+    
+    _rowHeight = rowHeight;
+    
+    [self reloadData];
+}
+
+- (void)setColumnCount:(NSUInteger)columnCount
+{
+    columnCount = MAX(columnCount, 1);
+    
+    if (_columnCount == columnCount) {
+        return;
+    }
+    
+    _columnCount = columnCount;
+    
+    [self reloadData];
+}
+
+- (void)setBufferRowCount:(NSUInteger)bufferRowCount
+{
+    if (_bufferRowCount == bufferRowCount) {
+        return;
+    }
+    
+    _bufferRowCount = bufferRowCount;
+    
+    [self setNeedsLayout];
+}
+
+- (void)setContentOffset:(CGFloat)contentOffset
+{
+    CGFloat maximumContentOffset = MAX(self.contentHeight - self.size.height, 0);
+    contentOffset = MIN(MAX(contentOffset, 0), maximumContentOffset);
+    
+    if (_contentOffset == contentOffset) {
+        return;
+    }
+    
+    _contentOffset = contentOffset;
+    
+    [self setNeedsLayout];
+}
+
+- (CGFloat)contentHeight
+{
+    return SSKListLayoutGetContentHeight(&_layout);
+}
+
+- (NSArray *)visibleCells
+{
+    NSArray *sortedIndexes = [[self.cellsByIndex allKeys] sortedArrayUsingSelector:@selector(compare:)];
+    
+    return [self.cellsByIndex objectsForKeys:sortedIndexes notFoundMarker:[NSNull null]];
+}
+
+#pragma mark - SSKLayoutPassNode
+
+- (void)setNeedsLayout
+{
+    self.needsLayout = YES;
+    
+    [[SSKLayoutPass sharedPass] scheduleNode:self];
+}
+
+- (void)layoutIfNeeded
+{
+    if (!self.needsLayout) {
+        return;
+    }
+    
+    self.needsLayout = NO;
+    
+    [self updateVisibleCells];
+}
+
+#pragma mark - SSKInteractiveNode
+
+- (void)dragInteractionWithType:(SSKInteractionType)type atPoint:(CGPoint)point velocity:(CGVector)velocity
+{
+    // Dragging upwards reveals the rows further down the list
+    self.contentOffset += velocity.dy;
+}
+
+#pragma mark - Utilities
+
+- (void)updateVisibleCells
+{
+    size_t firstRow;
+    size_t rowCount = SSKListLayoutGetRowsInRange(&_layout, self.contentOffset, self.size.height, &firstRow);
+    
+    NSUInteger firstIndex = 0;
+    NSUInteger endIndex = 0;
+    
+    if (rowCount > 0) {
+        size_t bufferedFirstRow = firstRow > self.bufferRowCount ? firstRow - self.bufferRowCount : 0;
+        size_t bufferedEndRow = MIN(firstRow + rowCount + self.bufferRowCount, _layout.count);
+        
+        firstIndex = bufferedFirstRow * self.columnCount;
+        endIndex = MIN(bufferedEndRow * self.columnCount, self.cellCount);
+    }
+    
+    // Cells that left the buffered range are recycled before any new ones are requested, so they can be reused right away
+    for (NSNumber *index in [self.cellsByIndex allKeys]) {
+        NSUInteger cellIndex = [index unsignedIntegerValue];
+        
+        if (cellIndex < firstIndex || cellIndex >= endIndex) {
+            [self enqueueReusableCell:[self.cellsByIndex objectForKey:index]];
+            [self.cellsByIndex removeObjectForKey:index];
+        }
+    }
+    
+    CGFloat cellWidth = self.size.width / self.columnCount;
+    
+    for (NSUInteger cellIndex = firstIndex; cellIndex < endIndex; cellIndex++) {
+        SKNode *cell = [self.cellsByIndex objectForKey:@(cellIndex)];
+        
+        if (!cell) {
+            cell = [self.dataSource listNode:self cellAtIndex:cellIndex];
+            
+            if (!cell) {
+                continue;
+            }
+            
+            [self.cellsByIndex setObject:cell forKey:@(cellIndex)];
+            
+            if (cell.parent != self) {
+                [cell removeFromParent];
+                [self addChild:cell];
+            }
+        }
+        
+        NSUInteger row = cellIndex / self.columnCount;
+        NSUInteger column = cellIndex % self.columnCount;
+        CGFloat rowBottom = SSKListLayoutGetRowOffset(&_layout, row + 1) - self.contentOffset;
+        
+        CGPoint position = CGPointMake(column * cellWidth, self.size.height - rowBottom);
+        
+        if (!CGPointEqualToPoint(cell.position, position)) {
+            cell.position = position;
+        }
+    }
+}
+
+- (void)enqueueReusableCell:(SKNode *)cell
+{
+    [cell removeFromParent];
+    
+    NSString *identifier = cell.ssk_reuseIdentifier;
+    
+    if (!identifier) {
+        return;
+    }
+    
+    NSMutableArray *reusableCells = [self.reusableCells objectForKey:identifier];
+    
+    if (!reusableCells) {
+        reusableCells = [NSMutableArray new];
+        [self.reusableCells setObject:reusableCells forKey:identifier];
+    }
+    
+    [reusableCells addObject:cell];
+}
+
+@end
+
+#pragma mark - SKNode+SSKListNode
+
+@implementation SKNode (SSKListNode)
+
+- (NSString *)ssk_reuseIdentifier
+{
+    return objc_getAssociatedObject(self, &SSKReuseIdentifierKey);
+}
+
+- (void)setSsk_reuseIdentifier:(NSString *)reuseIdentifier
+{
+    objc_setAssociatedObject(self, &SSKReuseIdentifierKey, reuseIdentifier, OBJC_ASSOCIATION_COPY_NONATOMIC);
+}
+
+@end
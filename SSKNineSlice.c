@@ -0,0 +1,121 @@
+#include "SSKNineSlice.h"
+
+#pragma mark - Utilities
+
+/**
+ *  The column (left to right) and row (bottom to top) of each part, indexed by SSKNineSlicePart
+ */
+static const unsigned char SSKNineSlicePartColumns[SSKNineSlicePartCount] = {0, 1, 2, 2, 2, 1, 0, 0, 1};
+static const unsigned char SSKNineSlicePartRows[SSKNineSlicePartCount] = {2, 2, 2, 1, 0, 0, 0, 1, 1};
+
+static void SSKNineSliceWriteVertex(SSKTileMeshVertex *vertex, double x, double y, double u, double v)
+{
+    vertex->x = (float)x;
+    vertex->y = (float)y;
+    vertex->u = (float)u;
+    vertex->v = (float)v;
+}
+
+#pragma mark - Nine-slices
+
+void SSKNineSliceCompute(SSKNineSlice *slice, SSKTileSize size, SSKTileSize textureSize, SSKNineSliceInsets insets)
+{
+    const double xs[4] = {0, insets.left, size.width - insets.right, size.width};
+    const double ys[4] = {0, insets.bottom, size.height - insets.top, size.height};
+    const double textureXs[4] = {0, insets.left, textureSize.width - insets.right, textureSize.width};
+    const double textureYs[4] = {0, insets.bottom, textureSize.height - insets.top, textureSize.height};
+    const double us[4] = {0, textureXs[1] / textureSize.width, textureXs[2] / textureSize.width, 1};
+    const double vs[4] = {0, textureYs[1] / textureSize.height, textureYs[2] / textureSize.height, 1};
+    
+    size_t count = 0;
+    
+    for (size_t part = 0; part < SSKNineSlicePartCount; part++) {
+        const size_t column = SSKNineSlicePartColumns[part];
+        const size_t row = SSKNineSlicePartRows[part];
+        
+        SSKTileRect rect;
+        rect.x = xs[column];
+        rect.y = ys[row];
+        rect.width = xs[column + 1] - xs[column];
+        rect.height = ys[row + 1] - ys[row];
+        
+        SSKTileRect textureRect;
+        textureRect.x = us[column];
+        textureRect.y = vs[row];
+        textureRect.width = us[column + 1] - us[column];
+        textureRect.height = vs[row + 1] - vs[row];
+        
+        SSKTileSize partTextureSize;
+        partTextureSize.width = textureXs[column + 1] - textureXs[column];
+        partTextureSize.height = textureYs[row + 1] - textureYs[row];
+        
+        slice->parts[count] = (SSKNineSlicePart)part;
+        slice->rects[count] = rect;
+        slice->textureRects[count] = textureRect;
+        slice->textureSizes[count] = partTextureSize;
+        
+        SSKTileMeshVertex *vertices = slice->vertices + count * 4;
+        SSKNineSliceWriteVertex(&vertices[0], xs[column], ys[row], us[column], vs[row]);
+        SSKNineSliceWriteVertex(&vertices[1], xs[column + 1], ys[row], us[column + 1], vs[row]);
+        SSKNineSliceWriteVertex(&vertices[2], xs[column + 1], ys[row + 1], us[column + 1], vs[row + 1]);
+        SSKNineSliceWriteVertex(&vertices[3], xs[column], ys[row + 1], us[column], vs[row + 1]);
+        
+        // Skipped parts are overwritten by the next part, by not advancing the count
+        count += (rect.width > 0) & (rect.height > 0) & (textureRect.width > 0) & (textureRect.height > 0);
+    }
+    
+    slice->count = count;
+}
+
+bool SSKNineSliceHasSameParts(const SSKNineSlice *slice, const SSKNineSlice *otherSlice)
+{
+    if (slice->count != otherSlice->count) {
+        return false;
+    }
+    
+    for (size_t index = 0; index < slice->count; index++) {
+        if (slice->parts[index] != otherSlice->parts[index]) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool SSKNineSliceAppendTiledMesh(const SSKNineSlice *slice, SSKTileMesh *mesh, SSKTileLayout *layout)
+{
+    for (size_t index = 0; index < slice->count; index++) {
+        const SSKTileRect rect = slice->rects[index];
+        const SSKTileRect textureRect = slice->textureRects[index];
+        
+        SSKTileSize partSize;
+        partSize.width = rect.width;
+        partSize.height = rect.height;
+        
+        const SSKTileGrid grid = SSKTileGridMake(partSize, slice->textureSizes[index], textureRect);
+        
+        if (!SSKTileLayoutCompute(layout, &grid, SSKTileGridGetFullRange(&grid))) {
+            continue;
+        }
+        
+        for (size_t tileIndex = 0; tileIndex < layout->count; tileIndex++) {
+            SSKTileRect tileRect;
+            tileRect.x = rect.x + layout->x[tileIndex];
+            tileRect.y = rect.y + layout->y[tileIndex];
+            tileRect.width = layout->width[tileIndex];
+            tileRect.height = layout->height[tileIndex];
+            
+            SSKTileRect tileTextureRect;
+            tileTextureRect.x = layout->textureX[tileIndex];
+            tileTextureRect.y = layout->textureY[tileIndex];
+            tileTextureRect.width = layout->textureWidth[tileIndex];
+            tileTextureRect.height = layout->textureHeight[tileIndex];
+            
+            if (!SSKTileMeshAppendQuad(mesh, tileRect, tileTextureRect)) {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
@@ -0,0 +1,111 @@
+#ifndef SSKNineSlice_h
+#define SSKNineSlice_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "SSKTileLayout.h"
+#include "SSKTileMesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  Enum describing the nine parts of a nine-slice
+ */
+typedef enum {
+    SSKNineSlicePartTopLeft,
+    SSKNineSlicePartTop,
+    SSKNineSlicePartTopRight,
+    SSKNineSlicePartRight,
+    SSKNineSlicePartBottomRight,
+    SSKNineSlicePartBottom,
+    SSKNineSlicePartBottomLeft,
+    SSKNineSlicePartLeft,
+    SSKNineSlicePartCenter
+} SSKNineSlicePart;
+
+/**
+ *  The number of parts in a nine-slice
+ */
+#define SSKNineSlicePartCount 9
+
+/**
+ *  Platform-agnostic cap insets, used to cut a texture into nine parts
+ */
+typedef struct {
+    double top;
+    double left;
+    double bottom;
+    double right;
+} SSKNineSliceInsets;
+
+/**
+ *  The geometry of a nine-slice
+ *
+ *  @discussion Only parts with a non-zero area are included, so the first "count"
+ *  elements of each array are valid. The parts are always stored in the order of
+ *  SSKNineSlicePart, and the parts array contains which part each element describes.
+ *
+ *  Rects use the coordinate space of the nine-slice, with the origin in the bottom left
+ *  corner. Texture rects use the unit coordinate space of the texture, and texture sizes
+ *  are the sizes of the texture rects in the texture's point space, computed directly from
+ *  the cap insets (multiplying a texture rect by the texture's size can be off by a rounding
+ *  error, which makes tiling produce extra, near-zero tiles). The vertices
+ *  contain one quad per part (4 vertices each, in the same order as SSKTileMesh), mapping
+ *  each part's texture rect onto its rect.
+ */
+typedef struct {
+    size_t count;
+    SSKNineSlicePart parts[SSKNineSlicePartCount];
+    SSKTileRect rects[SSKNineSlicePartCount];
+    SSKTileRect textureRects[SSKNineSlicePartCount];
+    SSKTileSize textureSizes[SSKNineSlicePartCount];
+    SSKTileMeshVertex vertices[SSKNineSlicePartCount * 4];
+} SSKNineSlice;
+
+#pragma mark - Nine-slices
+
+/**
+ *  Compute the geometry of a nine-slice
+ *
+ *  @param slice The nine-slice to write the geometry into
+ *  @param size The size that the texture should be stretched across
+ *  @param textureSize The size of the texture
+ *  @param insets The cap insets, in the texture's (and the size's) point space
+ *
+ *  @discussion All parts are computed in a single pass, without branching per part.
+ *  Parts whose rect or texture rect has a zero (or negative) area are skipped, so zero
+ *  cap insets produce a single center part.
+ */
+extern void SSKNineSliceCompute(SSKNineSlice *slice, SSKTileSize size, SSKTileSize textureSize, SSKNineSliceInsets insets);
+
+/**
+ *  Return whether two nine-slices contain the same set of parts
+ */
+extern bool SSKNineSliceHasSameParts(const SSKNineSlice *slice, const SSKNineSlice *otherSlice);
+
+/**
+ *  Append the tiled geometry of a nine-slice to a tile mesh
+ *
+ *  @param slice The nine-slice to append the geometry of
+ *  @param mesh The mesh to append the geometry to. Existing quads are kept.
+ *  @param layout A layout used as scratch memory while tiling each part.
+ *  Pass the same layout across calls to avoid reallocating it.
+ *
+ *  @return Whether the geometry could be appended. False is returned if memory
+ *  for the mesh or layout could not be allocated.
+ *
+ *  @discussion Each part is tiled the same way an SSKTileableNode tiles its texture,
+ *  so the mesh matches what SSKStretchableNode displays using part nodes.
+ */
+extern bool SSKNineSliceAppendTiledMesh(const SSKNineSlice *slice, SSKTileMesh *mesh, SSKTileLayout *layout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,74 @@
+#import <SpriteKit/SpriteKit.h>
+#import "SSKSpatialGrid.h"
+
+/**
+ *  Get the frame of a node in the coordinate space of one of its ancestors
+ *
+ *  @param node The node to get the frame of. Its accumulated frame is used, so the frame
+ *  contains all of the node's children.
+ *  @param ancestor The node whose coordinate space the frame should be in
+ *
+ *  @discussion If the node is rotated or scaled by the nodes in between, the frame is the
+ *  bounding box of the node's transformed frame.
+ */
+extern CGRect SSKNodeGetFrameInNode(SKNode *node, SKNode *ancestor);
+
+/**
+ *  A set of nodes, indexed by their frames in the coordinate space of another node
+ *
+ *  @discussion The frames are stored in an SSKSpatialGrid, so finding the nodes in a rect only
+ *  looks at the nodes in the cells it overlaps. Nodes are only weakly referenced, and are removed
+ *  once they're deallocated. Frames aren't observed, so the index must be updated whenever the
+ *  nodes have moved. Nodes that stay within the same cells of the grid are updated in place.
+ *
+ *  This class is used by SSKInteractionHandler's interactive node registry, and by the spatial
+ *  indexes of SKNode+SSKTags.
+ */
+@interface SSKNodeSpatialIndex : NSObject
+
+/**
+ *  Initialize an empty spatial index
+ *
+ *  @param cellSize The size of each cell of the index's grid, see SSKSpatialGrid
+ */
+- (instancetype)initWithCellSize:(CGFloat)cellSize;
+
+/**
+ *  Add a node to the index, with its current frame
+ *
+ *  @param node The node to add. Nodes that are already in the index are ignored.
+ *  @param ancestor The node whose coordinate space the frame should be in. If the node isn't
+ *  a descendant of it (or if it's nil), the node is added with an empty frame, which can't be
+ *  found until the index is updated.
+ */
+- (void)addNode:(SKNode *)node inNode:(SKNode *)ancestor;
+
+/**
+ *  Remove a node from the index
+ */
+- (void)removeNode:(SKNode *)node;
+
+/**
+ *  Update the frames of all nodes in the index
+ *
+ *  @param ancestor The node whose coordinate space the frames should be in. Nodes that aren't
+ *  descendants of it are kept in the index, but with an empty frame.
+ */
+- (void)updateFramesInNode:(SKNode *)ancestor;
+
+/**
+ *  Replace the nodes of the index, and update their frames
+ *
+ *  @param nodes The nodes that the index should contain. Nodes that aren't in this array are removed.
+ *  @param ancestor The node whose coordinate space the frames should be in
+ */
+- (void)updateWithNodes:(NSArray *)nodes inNode:(SKNode *)ancestor;
+
+/**
+ *  Return all nodes whose frame intersects a rect, in no particular order
+ *
+ *  @discussion Pass a rect with a zero size to find the nodes at a point.
+ */
+- (NSArray *)nodesInRect:(CGRect)rect;
+
+@end
@@ -0,0 +1,231 @@
+#import "SSKNodeSpatialIndex.h"
+
+#pragma mark - Utilities
+
+static SSKTileRect SSKNodeSpatialIndexGetTileRect(CGRect rect)
+{
+    SSKTileRect tileRect;
+    tileRect.x = CGRectGetMinX(rect);
+    tileRect.y = CGRectGetMinY(rect);
+    tileRect.width = CGRectGetWidth(rect);
+    tileRect.height = CGRectGetHeight(rect);
+    
+    return tileRect;
+}
+
+static SSKTileRect SSKNodeSpatialIndexGetFrameOfNode(SKNode *node, SKNode *ancestor)
+{
+    // Nodes outside of the ancestor's tree get a rect that the grid can't place, so they can't be found
+    if (!ancestor || node == ancestor || ![node inParentHierarchy:ancestor]) {
+        SSKTileRect frame = {NAN, NAN, 0, 0};
+        return frame;
+    }
+    
+    return SSKNodeSpatialIndexGetTileRect(SSKNodeGetFrameInNode(node, ancestor));
+}
+
+CGRect SSKNodeGetFrameInNode(SKNode *node, SKNode *ancestor)
+{
+    CGRect frame = [node calculateAccumulatedFrame];
+    
+    if (node.parent == ancestor) {
+        return frame;
+    }
+    
+    // Converting all corners, since the frame can be rotated or scaled by the nodes in between
+    CGPoint corners[4] = {
+        CGPointMake(CGRectGetMinX(frame), CGRectGetMinY(frame)),
+        CGPointMake(CGRectGetMaxX(frame), CGRectGetMinY(frame)),
+        CGPointMake(CGRectGetMaxX(frame), CGRectGetMaxY(frame)),
+        CGPointMake(CGRectGetMinX(frame), CGRectGetMaxY(frame))
+    };
+    
+    CGFloat minX = CGFLOAT_MAX, minY = CGFLOAT_MAX, maxX = -CGFLOAT_MAX, maxY = -CGFLOAT_MAX;
+    
+    for (NSUInteger cornerIndex = 0; cornerIndex < 4; cornerIndex++) {
+        CGPoint corner = [ancestor convertPoint:corners[cornerIndex] fromNode:node.parent];
+        
+        minX = MIN(minX, corner.x);
+        minY = MIN(minY, corner.y);
+        maxX = MAX(maxX, corner.x);
+        maxY = MAX(maxY, corner.y);
+    }
+    
+    return CGRectMake(minX, minY, maxX - minX, maxY - minY);
+}
+
+#pragma mark - SSKNodeSpatialIndex
+
+@interface SSKNodeSpatialIndex()
+
+@property (nonatomic, strong) NSMapTable *entryIDsByNode;
+@property (nonatomic, strong) NSPointerArray *nodesByEntryID;
+
+@end
+
+@implementation SSKNodeSpatialIndex
+{
+    SSKSpatialGrid _grid;
+    size_t *_queryResults;
+    size_t _queryResultCapacity;
+}
+
+- (instancetype)initWithCellSize:(CGFloat)cellSize
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    SSKSpatialGridInit(&_grid, cellSize);
+    _entryIDsByNode = [NSMapTable weakToStrongObjectsMapTable];
+    _nodesByEntryID = [NSPointerArray weakObjectsPointerArray];
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    SSKSpatialGridDestroy(&_grid);
+    free(_queryResults);
+}
+
+#pragma mark - Public
+
+- (void)addNode:(SKNode *)node inNode:(SKNode *)ancestor
+{
+    if ([self.entryIDsByNode objectForKey:node]) {
+        return;
+    }
+    
+    [self insertNode:node withFrame:SSKNodeSpatialIndexGetFrameOfNode(node, ancestor)];
+}
+
+- (void)removeNode:(SKNode *)node
+{
+    NSNumber *entryID = [self.entryIDsByNode objectForKey:node];
+    
+    if (!entryID) {
+        return;
+    }
+    
+    SSKSpatialGridRemove(&_grid, [entryID unsignedIntegerValue]);
+    [self.nodesByEntryID replacePointerAtIndex:[entryID unsignedIntegerValue] withPointer:NULL];
+    [self.entryIDsByNode removeObjectForKey:node];
+}
+
+- (void)updateFramesInNode:(SKNode *)ancestor
+{
+    for (size_t entryID = 0; entryID < [self.nodesByEntryID count]; entryID++) {
+        if (entryID >= _grid.entryCount || !_grid.entries[entryID].isInUse) {
+            continue;
+        }
+        
+        SKNode *node = [self.nodesByEntryID pointerAtIndex:entryID];
+        
+        if (!node) {
+            SSKSpatialGridRemove(&_grid, entryID);
+            continue;
+        }
+        
+        if (!SSKSpatialGridMove(&_grid, entryID, SSKNodeSpatialIndexGetFrameOfNode(node, ancestor))) {
+            [self.nodesByEntryID replacePointerAtIndex:entryID withPointer:NULL];
+            [self.entryIDsByNode removeObjectForKey:node];
+        }
+    }
+}
+
+- (void)updateWithNodes:(NSArray *)nodes inNode:(SKNode *)ancestor
+{
+    NSMapTable *entryIDsByNode = [NSMapTable weakToStrongObjectsMapTable];
+    
+    for (SKNode *node in nodes) {
+        SSKTileRect frame = SSKNodeSpatialIndexGetFrameOfNode(node, ancestor);
+        NSNumber *entryID = [self.entryIDsByNode objectForKey:node];
+        
+        if (entryID && !SSKSpatialGridMove(&_grid, [entryID unsignedIntegerValue], frame)) {
+            entryID = nil;
+        }
+        
+        if (!entryID) {
+            entryID = [self insertNode:node withFrame:frame];
+            
+            if (!entryID) {
+                continue;
+            }
+        }
+        
+        [entryIDsByNode setObject:entryID forKey:node];
+    }
+    
+    // Remove the entries of nodes that were deallocated, or that aren't part of the new nodes
+    for (size_t entryID = 0; entryID < [self.nodesByEntryID count]; entryID++) {
+        if (entryID >= _grid.entryCount || !_grid.entries[entryID].isInUse) {
+            continue;
+        }
+        
+        SKNode *indexedNode = [self.nodesByEntryID pointerAtIndex:entryID];
+        NSNumber *currentEntryID = indexedNode ? [entryIDsByNode objectForKey:indexedNode] : nil;
+        
+        // A missing entry ID must not be read as 0, or the node in entry 0 would never be removed
+        if (currentEntryID && [currentEntryID unsignedIntegerValue] == entryID) {
+            continue;
+        }
+        
+        SSKSpatialGridRemove(&_grid, entryID);
+    }
+    
+    self.entryIDsByNode = entryIDsByNode;
+}
+
+- (NSArray *)nodesInRect:(CGRect)rect
+{
+    SSKTileRect tileRect = SSKNodeSpatialIndexGetTileRect(rect);
+    size_t foundCount = SSKSpatialGridQueryRect(&_grid, tileRect, _queryResults, _queryResultCapacity);
+    
+    if (foundCount > _queryResultCapacity) {
+        size_t *queryResults = realloc(_queryResults, foundCount * sizeof(size_t));
+        
+        if (!queryResults) {
+            return @[];
+        }
+        
+        _queryResults = queryResults;
+        _queryResultCapacity = foundCount;
+        
+        foundCount = SSKSpatialGridQueryRect(&_grid, tileRect, _queryResults, _queryResultCapacity);
+    }
+    
+    NSMutableArray *foundNodes = [NSMutableArray arrayWithCapacity:foundCount];
+    
+    for (size_t index = 0; index < foundCount; index++) {
+        SKNode *node = [self.nodesByEntryID pointerAtIndex:_queryResults[index]];
+        
+        if (node) {
+            [foundNodes addObject:node];
+        }
+    }
+    
+    return foundNodes;
+}
+
+#pragma mark - Private
+
+- (NSNumber *)insertNode:(SKNode *)node withFrame:(SSKTileRect)frame
+{
+    size_t entryID = SSKSpatialGridInsert(&_grid, frame);
+    
+    if (entryID == SIZE_MAX) {
+        return nil;
+    }
+    
+    if (entryID >= [self.nodesByEntryID count]) {
+        [self.nodesByEntryID setCount:entryID + 1];
+    }
+    
+    [self.nodesByEntryID replacePointerAtIndex:entryID withPointer:(__bridge void *)node];
+    [self.entryIDsByNode setObject:@(entryID) forKey:node];
+    
+    return @(entryID);
+}
+
+@end
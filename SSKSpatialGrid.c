@@ -0,0 +1,491 @@
+#include "SSKSpatialGrid.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#pragma mark - Utilities
+
+static uint64_t SSKSpatialGridGetCellHash(int64_t column, int64_t row)
+{
+    uint64_t hash = (uint64_t)column * 0x9E3779B97F4A7C15ull;
+    hash ^= (uint64_t)row + 0x632BE59BD9B4E019ull + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 31;
+    
+    return hash;
+}
+
+static int64_t SSKSpatialGridGetCellCoordinate(const SSKSpatialGrid *grid, double coordinate)
+{
+    const double cellCoordinate = floor(coordinate / grid->cellSize);
+    
+    // Clamped before converting, since converting a double outside of the range of int64_t is undefined
+    if (cellCoordinate < -(double)SSKSpatialGridMaxCellCoordinate) {
+        return -SSKSpatialGridMaxCellCoordinate;
+    }
+    
+    if (cellCoordinate > (double)SSKSpatialGridMaxCellCoordinate) {
+        return SSKSpatialGridMaxCellCoordinate;
+    }
+    
+    return (int64_t)cellCoordinate;
+}
+
+static void SSKSpatialGridGetCellRange(const SSKSpatialGrid *grid, SSKTileRect rect, SSKSpatialGridEntry *entry)
+{
+    const double minX = rect.x;
+    const double minY = rect.y;
+    const double maxX = rect.x + rect.width;
+    const double maxY = rect.y + rect.height;
+    
+    // Rects that can't be placed in the grid get an empty cell range, and can't be found by any query
+    if (!isfinite(minX) || !isfinite(minY) || !isfinite(maxX) || !isfinite(maxY)) {
+        entry->minColumn = 0;
+        entry->minRow = 0;
+        entry->maxColumn = -1;
+        entry->maxRow = -1;
+        return;
+    }
+    
+    entry->minColumn = SSKSpatialGridGetCellCoordinate(grid, minX);
+    entry->minRow = SSKSpatialGridGetCellCoordinate(grid, minY);
+    entry->maxColumn = SSKSpatialGridGetCellCoordinate(grid, maxX);
+    entry->maxRow = SSKSpatialGridGetCellCoordinate(grid, maxY);
+}
+
+static double SSKSpatialGridGetCellCount(const SSKSpatialGridEntry *entry)
+{
+    if (entry->maxColumn < entry->minColumn || entry->maxRow < entry->minRow) {
+        return 0;
+    }
+    
+    // Computed using doubles, since the product of two clamped ranges can overflow 64 bits
+    return ((double)(entry->maxColumn - entry->minColumn) + 1) * ((double)(entry->maxRow - entry->minRow) + 1);
+}
+
+static SSKSpatialGridCell *SSKSpatialGridFindCell(const SSKSpatialGrid *grid, int64_t column, int64_t row)
+{
+    if (grid->cellCapacity == 0) {
+        return NULL;
+    }
+    
+    const size_t mask = grid->cellCapacity - 1;
+    
+    for (size_t index = SSKSpatialGridGetCellHash(column, row) & mask; ; index = (index + 1) & mask) {
+        SSKSpatialGridCell *cell = &grid->cells[index];
+        
+        if (!cell->isOccupied) {
+            return NULL;
+        }
+        
+        if (cell->column == column && cell->row == row) {
+            return cell;
+        }
+    }
+}
+
+static bool SSKSpatialGridReserveCells(SSKSpatialGrid *grid, size_t cellCount)
+{
+    // Keeping the table at most half full keeps probe sequences short
+    if (cellCount * 2 <= grid->cellCapacity) {
+        return true;
+    }
+    
+    size_t capacity = grid->cellCapacity > 0 ? grid->cellCapacity * 2 : 64;
+    
+    while (cellCount * 2 > capacity) {
+        capacity *= 2;
+    }
+    
+    SSKSpatialGridCell *cells = calloc(capacity, sizeof(SSKSpatialGridCell));
+    
+    if (!cells) {
+        return false;
+    }
+    
+    const size_t mask = capacity - 1;
+    
+    for (size_t oldIndex = 0; oldIndex < grid->cellCapacity; oldIndex++) {
+        const SSKSpatialGridCell *cell = &grid->cells[oldIndex];
+        
+        if (!cell->isOccupied) {
+            continue;
+        }
+        
+        size_t index = SSKSpatialGridGetCellHash(cell->column, cell->row) & mask;
+        
+        while (cells[index].isOccupied) {
+            index = (index + 1) & mask;
+        }
+        
+        cells[index] = *cell;
+    }
+    
+    free(grid->cells);
+    grid->cells = cells;
+    grid->cellCapacity = capacity;
+    
+    return true;
+}
+
+static SSKSpatialGridCell *SSKSpatialGridFindOrCreateCell(SSKSpatialGrid *grid, int64_t column, int64_t row)
+{
+    SSKSpatialGridCell *cell = SSKSpatialGridFindCell(grid, column, row);
+    
+    if (cell) {
+        return cell;
+    }
+    
+    if (!SSKSpatialGridReserveCells(grid, grid->cellCount + 1)) {
+        return NULL;
+    }
+    
+    const size_t mask = grid->cellCapacity - 1;
+    size_t index = SSKSpatialGridGetCellHash(column, row) & mask;
+    
+    while (grid->cells[index].isOccupied) {
+        index = (index + 1) & mask;
+    }
+    
+    cell = &grid->cells[index];
+    cell->column = column;
+    cell->row = row;
+    cell->isOccupied = true;
+    
+    grid->cellCount++;
+    
+    return cell;
+}
+
+static bool SSKSpatialGridCellAddEntry(SSKSpatialGridCell *cell, size_t entryID)
+{
+    if (cell->entryCount == cell->entryCapacity) {
+        size_t capacity = cell->entryCapacity > 0 ? cell->entryCapacity * 2 : 4;
+        size_t *entryIDs = realloc(cell->entryIDs, capacity * sizeof(size_t));
+        
+        if (!entryIDs) {
+            return false;
+        }
+        
+        cell->entryIDs = entryIDs;
+        cell->entryCapacity = capacity;
+    }
+    
+    cell->entryIDs[cell->entryCount] = entryID;
+    cell->entryCount++;
+    
+    return true;
+}
+
+static void SSKSpatialGridCellRemoveEntry(SSKSpatialGridCell *cell, size_t entryID)
+{
+    for (size_t index = 0; index < cell->entryCount; index++) {
+        if (cell->entryIDs[index] == entryID) {
+            cell->entryIDs[index] = cell->entryIDs[cell->entryCount - 1];
+            cell->entryCount--;
+            return;
+        }
+    }
+}
+
+static void SSKSpatialGridUnlinkEntry(SSKSpatialGrid *grid, size_t entryID)
+{
+    SSKSpatialGridEntry *entry = &grid->entries[entryID];
+    
+    if (entry->isOversized) {
+        // Swapping in the last oversized entry, which takes over the removed entry's index
+        const size_t lastEntryID = grid->oversizedEntryIDs[grid->oversizedEntryCount - 1];
+        grid->oversizedEntryIDs[entry->oversizedIndex] = lastEntryID;
+        grid->entries[lastEntryID].oversizedIndex = entry->oversizedIndex;
+        grid->oversizedEntryCount--;
+        
+        entry->isOversized = false;
+        return;
+    }
+    
+    for (int64_t row = entry->minRow; row <= entry->maxRow; row++) {
+        for (int64_t column = entry->minColumn; column <= entry->maxColumn; column++) {
+            SSKSpatialGridCell *cell = SSKSpatialGridFindCell(grid, column, row);
+            
+            if (cell) {
+                SSKSpatialGridCellRemoveEntry(cell, entryID);
+            }
+        }
+    }
+}
+
+static bool SSKSpatialGridLinkOversizedEntry(SSKSpatialGrid *grid, size_t entryID)
+{
+    if (grid->oversizedEntryCount == grid->oversizedEntryCapacity) {
+        size_t capacity = grid->oversizedEntryCapacity > 0 ? grid->oversizedEntryCapacity * 2 : 16;
+        size_t *oversizedEntryIDs = realloc(grid->oversizedEntryIDs, capacity * sizeof(size_t));
+        
+        if (!oversizedEntryIDs) {
+            return false;
+        }
+        
+        grid->oversizedEntryIDs = oversizedEntryIDs;
+        grid->oversizedEntryCapacity = capacity;
+    }
+    
+    SSKSpatialGridEntry *entry = &grid->entries[entryID];
+    entry->isOversized = true;
+    entry->oversizedIndex = grid->oversizedEntryCount;
+    
+    grid->oversizedEntryIDs[grid->oversizedEntryCount] = entryID;
+    grid->oversizedEntryCount++;
+    
+    return true;
+}
+
+static bool SSKSpatialGridLinkEntry(SSKSpatialGrid *grid, size_t entryID)
+{
+    const SSKSpatialGridEntry entry = grid->entries[entryID];
+    
+    if (SSKSpatialGridGetCellCount(&entry) > SSKSpatialGridMaxEntryCellCount) {
+        return SSKSpatialGridLinkOversizedEntry(grid, entryID);
+    }
+    
+    for (int64_t row = entry.minRow; row <= entry.maxRow; row++) {
+        for (int64_t column = entry.minColumn; column <= entry.maxColumn; column++) {
+            SSKSpatialGridCell *cell = SSKSpatialGridFindOrCreateCell(grid, column, row);
+            
+            if (!cell || !SSKSpatialGridCellAddEntry(cell, entryID)) {
+                SSKSpatialGridUnlinkEntry(grid, entryID);
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+static bool SSKSpatialGridRectsIntersect(SSKTileRect rect, SSKTileRect otherRect)
+{
+    return rect.x <= otherRect.x + otherRect.width &&
+           otherRect.x <= rect.x + rect.width &&
+           rect.y <= otherRect.y + otherRect.height &&
+           otherRect.y <= rect.y + rect.height;
+}
+
+/**
+ *  Report an entry found by the current query, unless it was already reported or doesn't intersect the query rect
+ *
+ *  @return The number of found entries, including this one if it was reported
+ */
+static size_t SSKSpatialGridVisitEntry(SSKSpatialGrid *grid, size_t entryID, SSKTileRect rect, size_t *entryIDs, size_t capacity, size_t foundCount)
+{
+    SSKSpatialGridEntry *entry = &grid->entries[entryID];
+    
+    if (entry->queryStamp == grid->queryStamp) {
+        return foundCount;
+    }
+    
+    entry->queryStamp = grid->queryStamp;
+    
+    if (!SSKSpatialGridRectsIntersect(entry->rect, rect)) {
+        return foundCount;
+    }
+    
+    if (foundCount < capacity) {
+        entryIDs[foundCount] = entryID;
+    }
+    
+    return foundCount + 1;
+}
+
+#pragma mark - Spatial grids
+
+void SSKSpatialGridInit(SSKSpatialGrid *grid, double cellSize)
+{
+    memset(grid, 0, sizeof(SSKSpatialGrid));
+    grid->cellSize = cellSize > 0 ? cellSize : 1;
+}
+
+void SSKSpatialGridDestroy(SSKSpatialGrid *grid)
+{
+    for (size_t index = 0; index < grid->cellCapacity; index++) {
+        free(grid->cells[index].entryIDs);
+    }
+    
+    free(grid->cells);
+    free(grid->entries);
+    free(grid->freeEntryIDs);
+    free(grid->oversizedEntryIDs);
+    
+    SSKSpatialGridInit(grid, grid->cellSize);
+}
+
+size_t SSKSpatialGridInsert(SSKSpatialGrid *grid, SSKTileRect rect)
+{
+    size_t entryID;
+    
+    if (grid->freeEntryCount > 0) {
+        entryID = grid->freeEntryIDs[grid->freeEntryCount - 1];
+    } else {
+        if (grid->entryCount == grid->entryCapacity) {
+            size_t capacity = grid->entryCapacity > 0 ? grid->entryCapacity * 2 : 64;
+            SSKSpatialGridEntry *entries = realloc(grid->entries, capacity * sizeof(SSKSpatialGridEntry));
+            
+            if (!entries) {
+                return SIZE_MAX;
+            }
+            
+            grid->entries = entries;
+            
+            // The free list can never be longer than the entry array, so it's grown alongside it
+            size_t *freeEntryIDs = realloc(grid->freeEntryIDs, capacity * sizeof(size_t));
+            
+            if (!freeEntryIDs) {
+                return SIZE_MAX;
+            }
+            
+            grid->freeEntryIDs = freeEntryIDs;
+            grid->entryCapacity = capacity;
+        }
+        
+        entryID = grid->entryCount;
+    }
+    
+    SSKSpatialGridEntry *entry = &grid->entries[entryID];
+    entry->rect = rect;
+    entry->queryStamp = 0;
+    entry->isInUse = true;
+    entry->isOversized = false;
+    SSKSpatialGridGetCellRange(grid, rect, entry);
+    
+    // A reused ID is only taken off the free list once the entry has been linked
+    if (!SSKSpatialGridLinkEntry(grid, entryID)) {
+        entry->isInUse = false;
+        return SIZE_MAX;
+    }
+    
+    if (grid->freeEntryCount > 0 && grid->freeEntryIDs[grid->freeEntryCount - 1] == entryID) {
+        grid->freeEntryCount--;
+    } else {
+        grid->entryCount++;
+    }
+    
+    return entryID;
+}
+
+bool SSKSpatialGridMove(SSKSpatialGrid *grid, size_t entryID, SSKTileRect rect)
+{
+    if (entryID >= grid->entryCount || !grid->entries[entryID].isInUse) {
+        return false;
+    }
+    
+    SSKSpatialGridEntry *entry = &grid->entries[entryID];
+    SSKSpatialGridEntry movedEntry = *entry;
+    movedEntry.rect = rect;
+    SSKSpatialGridGetCellRange(grid, rect, &movedEntry);
+    
+    const bool isInSameCells = movedEntry.minColumn == entry->minColumn && movedEntry.minRow == entry->minRow &&
+                               movedEntry.maxColumn == entry->maxColumn && movedEntry.maxRow == entry->maxRow;
+    
+    // Oversized entries stay in the same list for any cell range, so they're updated in place too
+    if (isInSameCells || (entry->isOversized && SSKSpatialGridGetCellCount(&movedEntry) > SSKSpatialGridMaxEntryCellCount)) {
+        *entry = movedEntry;
+        return true;
+    }
+    
+    SSKSpatialGridUnlinkEntry(grid, entryID);
+    movedEntry.isOversized = false;
+    *entry = movedEntry;
+    
+    if (!SSKSpatialGridLinkEntry(grid, entryID)) {
+        entry->isInUse = false;
+        grid->freeEntryIDs[grid->freeEntryCount] = entryID;
+        grid->freeEntryCount++;
+        
+        return false;
+    }
+    
+    return true;
+}
+
+void SSKSpatialGridRemove(SSKSpatialGrid *grid, size_t entryID)
+{
+    if (entryID >= grid->entryCount || !grid->entries[entryID].isInUse) {
+        return;
+    }
+    
+    SSKSpatialGridUnlinkEntry(grid, entryID);
+    grid->entries[entryID].isInUse = false;
+    
+    grid->freeEntryIDs[grid->freeEntryCount] = entryID;
+    grid->freeEntryCount++;
+}
+
+size_t SSKSpatialGridQueryPoint(SSKSpatialGrid *grid, double x, double y, size_t *entryIDs, size_t capacity)
+{
+    SSKTileRect rect;
+    rect.x = x;
+    rect.y = y;
+    rect.width = 0;
+    rect.height = 0;
+    
+    return SSKSpatialGridQueryRect(grid, rect, entryIDs, capacity);
+}
+
+size_t SSKSpatialGridQueryRect(SSKSpatialGrid *grid, SSKTileRect rect, size_t *entryIDs, size_t capacity)
+{
+    SSKSpatialGridEntry queryEntry;
+    SSKSpatialGridGetCellRange(grid, rect, &queryEntry);
+    
+    // Queries that can't be placed in the grid find nothing, just like entries that can't be placed
+    if (SSKSpatialGridGetCellCount(&queryEntry) == 0) {
+        return 0;
+    }
+    
+    // Entries overlapping multiple cells are only reported once, by stamping them with a per-query value
+    grid->queryStamp++;
+    
+    if (grid->queryStamp == 0) {
+        for (size_t entryID = 0; entryID < grid->entryCount; entryID++) {
+            grid->entries[entryID].queryStamp = 0;
+        }
+        
+        grid->queryStamp = 1;
+    }
+    
+    size_t foundCount = 0;
+    
+    for (size_t index = 0; index < grid->oversizedEntryCount; index++) {
+        foundCount = SSKSpatialGridVisitEntry(grid, grid->oversizedEntryIDs[index], rect, entryIDs, capacity, foundCount);
+    }
+    
+    // A query overlapping more cells than the table holds scans the table, rather than every cell it overlaps
+    if (SSKSpatialGridGetCellCount(&queryEntry) > (double)grid->cellCapacity) {
+        for (size_t cellIndex = 0; cellIndex < grid->cellCapacity; cellIndex++) {
+            const SSKSpatialGridCell *cell = &grid->cells[cellIndex];
+            
+            if (!cell->isOccupied || cell->column < queryEntry.minColumn || cell->column > queryEntry.maxColumn
+                || cell->row < queryEntry.minRow || cell->row > queryEntry.maxRow) {
+                continue;
+            }
+            
+            for (size_t index = 0; index < cell->entryCount; index++) {
+                foundCount = SSKSpatialGridVisitEntry(grid, cell->entryIDs[index], rect, entryIDs, capacity, foundCount);
+            }
+        }
+        
+        return foundCount;
+    }
+    
+    for (int64_t row = queryEntry.minRow; row <= queryEntry.maxRow; row++) {
+        for (int64_t column = queryEntry.minColumn; column <= queryEntry.maxColumn; column++) {
+            const SSKSpatialGridCell *cell = SSKSpatialGridFindCell(grid, column, row);
+            
+            if (!cell) {
+                continue;
+            }
+            
+            for (size_t index = 0; index < cell->entryCount; index++) {
+                foundCount = SSKSpatialGridVisitEntry(grid, cell->entryIDs[index], rect, entryIDs, capacity, foundCount);
+            }
+        }
+    }
+    
+    return foundCount;
+}
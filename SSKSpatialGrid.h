@@ -0,0 +1,156 @@
+#ifndef SSKSpatialGrid_h
+#define SSKSpatialGrid_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SSKTileLayout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  The maximum number of cells that an entry is stored in
+ *
+ *  @discussion Entries overlapping more cells than this are oversized, and are kept in a
+ *  separate list that every query checks, instead of in each of their cells.
+ */
+#define SSKSpatialGridMaxEntryCellCount 64
+
+/**
+ *  The largest cell coordinate of a spatial grid
+ *
+ *  @discussion Coordinates beyond this many cells from the origin are clamped to it, which
+ *  keeps them representable as integers. Entries & queries at those coordinates are still
+ *  compared using their exact rects.
+ */
+#define SSKSpatialGridMaxCellCoordinate ((int64_t)1 << 40)
+
+/**
+ *  An entry of a spatial grid
+ *
+ *  @discussion The cell range is the inclusive range of cells that the entry's rect overlaps,
+ *  which is what the entry is stored in, unless it's oversized. Oversized entries are stored at
+ *  "oversizedIndex" in the grid's oversized entry list instead. Entries that aren't in use are
+ *  kept in a free list, so that entry IDs stay stable & can be reused.
+ */
+typedef struct {
+    SSKTileRect rect;
+    int64_t minColumn;
+    int64_t minRow;
+    int64_t maxColumn;
+    int64_t maxRow;
+    size_t oversizedIndex;
+    uint32_t queryStamp;
+    bool isInUse;
+    bool isOversized;
+} SSKSpatialGridEntry;
+
+/**
+ *  A cell of a spatial grid, containing the IDs of all entries that overlap it
+ */
+typedef struct {
+    int64_t column;
+    int64_t row;
+    bool isOccupied;
+    size_t entryCount;
+    size_t entryCapacity;
+    size_t *entryIDs;
+} SSKSpatialGridCell;
+
+/**
+ *  A uniform grid that indexes rects by the cells they overlap
+ *
+ *  @discussion The grid is sparse: cells are stored in an open addressing hash table, and
+ *  are only created once an entry overlaps them, so the indexed area can be unbounded. Point
+ *  & rect queries only look at the entries of the cells that they overlap, and at all
+ *  oversized entries. Queries overlapping more cells than the table holds scan the table.
+ *
+ *  For best results, use a cell size that is around the size of a typical entry, since an
+ *  entry is stored in every cell it overlaps (up to SSKSpatialGridMaxEntryCellCount cells).
+ */
+typedef struct {
+    double cellSize;
+    size_t entryCount;
+    size_t entryCapacity;
+    SSKSpatialGridEntry *entries;
+    size_t freeEntryCount;
+    size_t *freeEntryIDs;
+    size_t cellCount;
+    size_t cellCapacity;
+    SSKSpatialGridCell *cells;
+    size_t oversizedEntryCount;
+    size_t oversizedEntryCapacity;
+    size_t *oversizedEntryIDs;
+    uint32_t queryStamp;
+} SSKSpatialGrid;
+
+#pragma mark - Spatial grids
+
+/**
+ *  Initialize an empty spatial grid
+ *
+ *  @param grid The grid to initialize
+ *  @param cellSize The width & height of each cell of the grid. Must be greater than zero.
+ */
+extern void SSKSpatialGridInit(SSKSpatialGrid *grid, double cellSize);
+
+/**
+ *  Free all memory used by a spatial grid, and make it empty
+ */
+extern void SSKSpatialGridDestroy(SSKSpatialGrid *grid);
+
+/**
+ *  Add a rect to a spatial grid
+ *
+ *  @return The ID of the added entry, or SIZE_MAX if memory for it could not be allocated
+ */
+extern size_t SSKSpatialGridInsert(SSKSpatialGrid *grid, SSKTileRect rect);
+
+/**
+ *  Move an entry of a spatial grid to a new rect
+ *
+ *  @return Whether the entry could be moved. False is returned if memory for the cells
+ *  that the entry moved into could not be allocated, in which case the entry is removed.
+ *
+ *  @discussion An entry that stays within the same cells is updated in place.
+ */
+extern bool SSKSpatialGridMove(SSKSpatialGrid *grid, size_t entryID, SSKTileRect rect);
+
+/**
+ *  Remove an entry from a spatial grid
+ */
+extern void SSKSpatialGridRemove(SSKSpatialGrid *grid, size_t entryID);
+
+/**
+ *  Find all entries of a spatial grid whose rect contains a point
+ *
+ *  @param grid The grid to search
+ *  @param x The x coordinate of the point
+ *  @param y The y coordinate of the point
+ *  @param entryIDs The array to write the IDs of the found entries to
+ *  @param capacity The number of IDs that fit in the array
+ *
+ *  @return The number of entries that were found. If this is larger than the capacity,
+ *  only the first "capacity" IDs were written, and the query should be repeated with a
+ *  larger array.
+ */
+extern size_t SSKSpatialGridQueryPoint(SSKSpatialGrid *grid, double x, double y, size_t *entryIDs, size_t capacity);
+
+/**
+ *  Find all entries of a spatial grid whose rect intersects a rect
+ *
+ *  @discussion See SSKSpatialGridQueryPoint for a description of the parameters & return value.
+ *  Rects that share an edge are considered to intersect.
+ */
+extern size_t SSKSpatialGridQueryRect(SSKSpatialGrid *grid, SSKTileRect rect, size_t *entryIDs, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
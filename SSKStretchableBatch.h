@@ -0,0 +1,118 @@
+#import <SpriteKit/SpriteKit.h>
+#import "SSKStretchableNode.h"
+#import "SSKNineSlice.h"
+
+/**
+ *  A single vertex of a stretchable batch
+ *
+ *  @discussion Positions use the coordinate space of the parent of the node that the
+ *  vertex belongs to, and texture coordinates use the unit coordinate space of the batch's
+ *  texture. The color components contain the node's color, and the blend factor contains
+ *  its colorBlendFactor (0 for nodes without a color).
+ */
+typedef struct {
+    float x;
+    float y;
+    float u;
+    float v;
+    float red;
+    float green;
+    float blue;
+    float colorBlendFactor;
+} SSKStretchableBatchVertex;
+
+/**
+ *  An object that gathers the geometry of many stretchable nodes sharing a texture
+ *  into a single vertex & index buffer, that can be drawn using one draw call
+ *
+ *  @discussion While a node belongs to a batch, it doesn't create any part nodes, so each
+ *  panel only costs a single node in the node tree. Instead, its tiled nine-slice geometry
+ *  is written into the batch's vertex buffer, which can be drawn by a custom renderer (for
+ *  example using SKRenderer or a Metal/OpenGL view) together with the batch's texture.
+ *
+ *  Changing the size, texture, cap insets or color of a node only marks it as dirty. Call
+ *  -update once per frame (for example from your scene's -didEvaluateActions) to rewrite the
+ *  geometry of the dirty nodes, and of the nodes that have moved. As long as the number of
+ *  tiles in the batch stays the same, all other nodes' vertices are left untouched.
+ *
+ *  Nodes are drawn in the order they were added to the batch. Nodes whose texture is not
+ *  the batch's texture, or that are hidden, don't contribute any geometry.
+ *
+ *  This class depends on SSKStretchableNode, SSKNineSlice, SSKTileLayout and SSKTileMesh.
+ */
+@interface SSKStretchableBatch : NSObject
+
+/**
+ *  The texture that all nodes in the batch share
+ */
+@property (nonatomic, strong, readonly) SKTexture *texture;
+
+/**
+ *  The nodes currently in the batch, in drawing order
+ */
+@property (nonatomic, strong, readonly) NSArray *nodes;
+
+/**
+ *  The vertex buffer of the batch
+ *
+ *  @discussion Contains SSKStretchableBatchVertex structs, 4 per tile. The contents of this
+ *  data are updated in place by -update, so copy it if you need to keep a snapshot.
+ */
+@property (nonatomic, strong, readonly) NSData *vertexData;
+
+/**
+ *  The index buffer of the batch
+ *
+ *  @discussion Contains uint32_t indices into the vertex buffer, describing a list of
+ *  counter-clockwise triangles (6 per tile).
+ */
+@property (nonatomic, strong, readonly) NSData *indexData;
+
+/**
+ *  The number of tiles the batch currently contains
+ */
+@property (nonatomic, readonly) NSUInteger tileCount;
+
+/**
+ *  The number of nodes whose geometry was rewritten by the last call to -update
+ */
+@property (nonatomic, readonly) NSUInteger updatedNodeCount;
+
+/**
+ *  Allocate and initialize a new batch for nodes using a texture
+ *
+ *  @param texture The texture that nodes added to the batch should use
+ */
++ (instancetype)batchWithTexture:(SKTexture *)texture;
+
+/**
+ *  Add a node to the batch
+ *
+ *  @param node The node to add. If the node already belongs to another batch, it's
+ *  removed from that batch first. The node's part nodes will be removed.
+ */
+- (void)addNode:(SSKStretchableNode *)node;
+
+/**
+ *  Remove a node from the batch
+ *
+ *  @param node The node to remove. The node's part nodes will be redrawn.
+ */
+- (void)removeNode:(SSKStretchableNode *)node;
+
+/**
+ *  Mark the geometry of a node in the batch as needing to be rewritten
+ *
+ *  @discussion SSKStretchableNode calls this method automatically whenever its size,
+ *  texture, cap insets or color changes, so you normally don't need to call it yourself.
+ */
+- (void)setNeedsUpdateForNode:(SSKStretchableNode *)node;
+
+/**
+ *  Rewrite the geometry of all dirty nodes in the batch
+ *
+ *  @discussion Call this method once per frame, before drawing the batch.
+ */
+- (void)update;
+
+@end
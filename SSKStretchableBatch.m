@@ -0,0 +1,324 @@
+#import "SSKStretchableBatch.h"
+
+#pragma mark - C Utilities
+
+static SSKTileSize SSKStretchableBatchGetTileSize(CGSize size)
+{
+    SSKTileSize tileSize;
+    tileSize.width = size.width;
+    tileSize.height = size.height;
+    
+    return tileSize;
+}
+
+static SSKNineSliceInsets SSKStretchableBatchGetNineSliceInsets(SSKEdgeInsetsType capInsets)
+{
+    SSKNineSliceInsets insets;
+    insets.top = capInsets.top;
+    insets.left = capInsets.left;
+    insets.bottom = capInsets.bottom;
+    insets.right = capInsets.right;
+    
+    return insets;
+}
+
+static void SSKStretchableBatchGetColorComponents(SKColor *color, CGFloat *red, CGFloat *green, CGFloat *blue)
+{
+    *red = 1;
+    *green = 1;
+    *blue = 1;
+
+#if TARGET_OS_IPHONE
+    [color getRed:red green:green blue:blue alpha:NULL];
+#else
+    [[color colorUsingColorSpace:[NSColorSpace deviceRGBColorSpace]] getRed:red green:green blue:blue alpha:NULL];
+#endif
+}
+
+#pragma mark - SSKStretchableNode (SSKStretchableBatchMembership)
+
+@interface SSKStretchableNode (SSKStretchableBatchMembership)
+
+- (void)setBatch:(SSKStretchableBatch *)batch;
+
+@end
+
+#pragma mark - SSKStretchableBatchPanel
+
+@interface SSKStretchableBatchPanel : NSObject
+{
+    @public
+    SSKTileMesh _mesh;
+}
+
+@property (nonatomic, weak) SSKStretchableNode *node;
+@property (nonatomic) BOOL needsGeometry;
+@property (nonatomic) BOOL needsWrite;
+@property (nonatomic) CGPoint position;
+@property (nonatomic, getter = isHidden) BOOL hidden;
+@property (nonatomic) float red;
+@property (nonatomic) float green;
+@property (nonatomic) float blue;
+@property (nonatomic) float colorBlendFactor;
+@property (nonatomic) NSUInteger firstVertex;
+
+@end
+
+@implementation SSKStretchableBatchPanel
+
+- (void)dealloc
+{
+    SSKTileMeshDestroy(&_mesh);
+}
+
+@end
+
+#pragma mark - SSKStretchableBatch
+
+@interface SSKStretchableBatch()
+
+@property (nonatomic, strong, readwrite) SKTexture *texture;
+@property (nonatomic, strong, readwrite) NSData *vertexData;
+@property (nonatomic, strong, readwrite) NSData *indexData;
+@property (nonatomic, readwrite) NSUInteger tileCount;
+@property (nonatomic, readwrite) NSUInteger updatedNodeCount;
+@property (nonatomic, strong) NSMutableArray *panels;
+@property (nonatomic, strong) NSMapTable *panelsByNode;
+@property (nonatomic) BOOL needsLayout;
+
+@end
+
+@implementation SSKStretchableBatch
+{
+    NSMutableData *_vertexBuffer;
+    NSMutableData *_indexBuffer;
+    SSKTileLayout _layout;
+}
+
++ (instancetype)batchWithTexture:(SKTexture *)texture
+{
+    SSKStretchableBatch *batch = [self new];
+    batch.texture = texture;
+    
+    return batch;
+}
+
+- (instancetype)init
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    _panels = [NSMutableArray new];
+    _panelsByNode = [NSMapTable weakToStrongObjectsMapTable];
+    _vertexBuffer = [NSMutableData new];
+    _indexBuffer = [NSMutableData new];
+    _vertexData = _vertexBuffer;
+    _indexData = _indexBuffer;
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    SSKTileLayoutDestroy(&_layout);
+}
+
+#pragma mark - Public
+
+- (NSArray *)nodes
+{
+    NSMutableArray *nodes = [NSMutableArray new];
+    
+    for (SSKStretchableBatchPanel *panel in self.panels) {
+        SSKStretchableNode *node = panel.node;
+        
+        if (node) {
+            [nodes addObject:node];
+        }
+    }
+    
+    return nodes;
+}
+
+- (void)addNode:(SSKStretchableNode *)node
+{
+    if (!node || node.batch == self) {
+        return;
+    }
+    
+    [node.batch removeNode:node];
+    
+    SSKStretchableBatchPanel *panel = [SSKStretchableBatchPanel new];
+    panel.node = node;
+    panel.needsGeometry = YES;
+    
+    [self.panels addObject:panel];
+    [self.panelsByNode setObject:panel forKey:node];
+    self.needsLayout = YES;
+    
+    [node setBatch:self];
+}
+
+- (void)removeNode:(SSKStretchableNode *)node
+{
+    SSKStretchableBatchPanel *panel = [self.panelsByNode objectForKey:node];
+    
+    if (!panel) {
+        return;
+    }
+    
+    [self.panels removeObjectIdenticalTo:panel];
+    [self.panelsByNode removeObjectForKey:node];
+    self.needsLayout = YES;
+    
+    [node setBatch:nil];
+}
+
+- (void)setNeedsUpdateForNode:(SSKStretchableNode *)node
+{
+    SSKStretchableBatchPanel *panel = [self.panelsByNode objectForKey:node];
+    panel.needsGeometry = YES;
+}
+
+- (void)update
+{
+    NSIndexSet *releasedPanelIndexes = [self.panels indexesOfObjectsPassingTest:^BOOL(SSKStretchableBatchPanel *panel, NSUInteger index, BOOL *stop) {
+        return panel.node == nil;
+    }];
+    
+    if ([releasedPanelIndexes count] > 0) {
+        [self.panels removeObjectsAtIndexes:releasedPanelIndexes];
+        self.needsLayout = YES;
+    }
+    
+    for (SSKStretchableBatchPanel *panel in self.panels) {
+        SSKStretchableNode *node = panel.node;
+        
+        if (panel.isHidden != node.hidden) {
+            panel.needsGeometry = YES;
+        }
+        
+        if (panel.needsGeometry) {
+            const size_t vertexCount = panel->_mesh.vertexCount;
+            
+            [self buildGeometryForPanel:panel];
+            
+            if (panel->_mesh.vertexCount != vertexCount) {
+                self.needsLayout = YES;
+            }
+            
+            panel.needsWrite = YES;
+        }
+        
+        if (!CGPointEqualToPoint(panel.position, node.position)) {
+            panel.position = node.position;
+            panel.needsWrite = YES;
+        }
+    }
+    
+    if (self.needsLayout) {
+        [self layoutPanels];
+    }
+    
+    NSUInteger updatedNodeCount = 0;
+    
+    for (SSKStretchableBatchPanel *panel in self.panels) {
+        if (panel.needsWrite) {
+            [self writeVerticesForPanel:panel];
+            updatedNodeCount++;
+        }
+    }
+    
+    self.updatedNodeCount = updatedNodeCount;
+}
+
+#pragma mark - Private
+
+- (void)buildGeometryForPanel:(SSKStretchableBatchPanel *)panel
+{
+    SSKStretchableNode *node = panel.node;
+    
+    panel.needsGeometry = NO;
+    panel.hidden = node.hidden;
+    
+    SSKTileMeshRemoveAllQuads(&panel->_mesh);
+    
+    if (node.hidden || !self.texture || node.texture != self.texture) {
+        return;
+    }
+    
+    CGFloat red, green, blue;
+    SSKStretchableBatchGetColorComponents(node.color, &red, &green, &blue);
+    
+    panel.red = (float)red;
+    panel.green = (float)green;
+    panel.blue = (float)blue;
+    panel.colorBlendFactor = node.color ? (float)MAX(0, MIN(1, node.colorBlendFactor)) : 0;
+    
+    SSKNineSlice slice;
+    SSKNineSliceCompute(&slice,
+                        SSKStretchableBatchGetTileSize(node.size),
+                        SSKStretchableBatchGetTileSize(self.texture.size),
+                        SSKStretchableBatchGetNineSliceInsets(node.textureCapInsets));
+    
+    SSKNineSliceAppendTiledMesh(&slice, &panel->_mesh, &_layout);
+}
+
+- (void)layoutPanels
+{
+    self.needsLayout = NO;
+    
+    NSUInteger vertexCount = 0;
+    
+    for (SSKStretchableBatchPanel *panel in self.panels) {
+        panel.firstVertex = vertexCount;
+        panel.needsWrite = YES;
+        vertexCount += panel->_mesh.vertexCount;
+    }
+    
+    const NSUInteger tileCount = vertexCount / 4;
+    const NSUInteger previousTileCount = self.tileCount;
+    
+    [_vertexBuffer setLength:vertexCount * sizeof(SSKStretchableBatchVertex)];
+    [_indexBuffer setLength:tileCount * 6 * sizeof(uint32_t)];
+    
+    // Every tile uses the same index pattern, so only the indices of added tiles need to be written
+    uint32_t *indices = [_indexBuffer mutableBytes];
+    const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+    
+    for (NSUInteger tileIndex = previousTileCount; tileIndex < tileCount; tileIndex++) {
+        for (NSUInteger index = 0; index < 6; index++) {
+            indices[tileIndex * 6 + index] = (uint32_t)(tileIndex * 4) + quadIndices[index];
+        }
+    }
+    
+    self.tileCount = tileCount;
+}
+
+- (void)writeVerticesForPanel:(SSKStretchableBatchPanel *)panel
+{
+    panel.needsWrite = NO;
+    
+    const SSKTileMeshVertex *meshVertices = panel->_mesh.vertices;
+    SSKStretchableBatchVertex *vertices = (SSKStretchableBatchVertex *)[_vertexBuffer mutableBytes] + panel.firstVertex;
+    
+    const float x = (float)panel.position.x;
+    const float y = (float)panel.position.y;
+    
+    for (size_t index = 0; index < panel->_mesh.vertexCount; index++) {
+        SSKStretchableBatchVertex vertex;
+        vertex.x = meshVertices[index].x + x;
+        vertex.y = meshVertices[index].y + y;
+        vertex.u = meshVertices[index].u;
+        vertex.v = meshVertices[index].v;
+        vertex.red = panel.red;
+        vertex.green = panel.green;
+        vertex.blue = panel.blue;
+        vertex.colorBlendFactor = panel.colorBlendFactor;
+        
+        vertices[index] = vertex;
+    }
+}
+
+@end
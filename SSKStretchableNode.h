@@ -1,7 +1,13 @@
 #import <SpriteKit/SpriteKit.h>
 #import "SSKTileableNode.h"
+#import "SSKTextureRegionCache.h"
+#import "SSKNineSlice.h"
+#import "SSKLayoutPass.h"
+#import "SSKTweenEngine.h"
 #import "SSKMultiplatform.h"
 
+@class SSKStretchableBatch;
+
 #pragma mark - SSKStretchableNode
 
 /**
@@ -9,9 +15,14 @@
  *  Using cap insets, it allows for cutting its texture up into tilable parts,
  *  to allow for graceful stretching without quality loss.
  *
- *  @discussion This class depends on SSKTilableNode.
+ *  @discussion This class depends on SSKTilableNode, SSKTextureRegionCache and
+ *  SSKNineSlice, which computes the geometry of the node's parts. Parts with a zero
+ *  area (for example, all parts but the center when using zero cap insets) are skipped.
+ *
+ *  Changes to the node's size, texture, cap insets & color are laid out through the shared
+ *  SSKLayoutPass, so when the pass is deferred, the node's parts are only updated once.
  */
-@interface SSKStretchableNode : SKNode
+@interface SSKStretchableNode : SKNode <SSKLayoutPassNode, SSKTweenResizable>
 
 /**
  *  The current size of the node
@@ -46,6 +57,22 @@
  */
 @property (nonatomic) CGFloat colorBlendFactor;
 
+/**
+ *  The cap insets the node is currently using when stretching its texture
+ *
+ *  @discussion Use -setTexture:capInsets: to change the node's cap insets.
+ */
+@property (nonatomic, readonly) SSKEdgeInsetsType textureCapInsets;
+
+/**
+ *  The batch that the node's geometry is currently gathered into, if any
+ *
+ *  @discussion Use -[SSKStretchableBatch addNode:] to add the node to a batch. While the
+ *  node belongs to a batch, it doesn't have any part nodes, and changes to its size,
+ *  texture, cap insets or color mark it as dirty in the batch instead of redrawing it.
+ */
+@property (nonatomic, weak, readonly) SSKStretchableBatch *batch;
+
 /**
  *  Allocate and initialize a new instance of JSStretchableNode
  *
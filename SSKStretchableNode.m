@@ -1,93 +1,31 @@
 #import "SSKStretchableNode.h"
+#import "SSKStretchableBatch.h"
 
 #pragma mark - C Utilities
 
-typedef enum : NSUInteger {
-    JSStretchableNodePartTopLeft,
-    JSStretchableNodePartTop,
-    JSStretchableNodePartTopRight,
-    JSStretchableNodePartRight,
-    JSStretchableNodePartBottomRight,
-    JSStretchableNodePartBottom,
-    JSStretchableNodePartBottomLeft,
-    JSStretchableNodePartLeft,
-    JSStretchableNodePartCenter
-} JSStretchableNodePart;
-
-static CGFloat JSStretchableNodeNoResizing = -9999;
-
-static CGRect JSStretchableNodeGetRectForPart(CGSize totalSize, SSKEdgeInsetsType capInsets, JSStretchableNodePart part)
+static SSKTileSize JSStretchableNodeGetTileSize(CGSize size)
 {
-    CGRect rect = CGRectZero;
+    SSKTileSize tileSize;
+    tileSize.width = size.width;
+    tileSize.height = size.height;
     
-    switch (part) {
-        case JSStretchableNodePartTopLeft: {
-            rect.origin.y = totalSize.height - capInsets.top;
-            rect.size = CGSizeMake(capInsets.left, capInsets.top);
-        }
-            break;
-        case JSStretchableNodePartTop: {
-            rect.origin.x = capInsets.left;
-            rect.origin.y = totalSize.height - capInsets.top;
-            rect.size.width = totalSize.width - capInsets.left - capInsets.right;
-            rect.size.height = capInsets.top;
-        }
-            break;
-        case JSStretchableNodePartTopRight: {
-            rect.origin.x = totalSize.width - capInsets.right;
-            rect.origin.y = totalSize.height - capInsets.top;
-            rect.size = CGSizeMake(capInsets.right, capInsets.top);
-        }
-            break;
-        case JSStretchableNodePartRight: {
-            rect.origin.x = totalSize.width - capInsets.right;
-            rect.origin.y = capInsets.bottom;
-            rect.size.width = capInsets.right;
-            rect.size.height = totalSize.height - capInsets.top - capInsets.bottom;
-        }
-            break;
-        case JSStretchableNodePartBottomRight: {
-            rect.origin.x = totalSize.width - capInsets.right;
-            rect.size = CGSizeMake(capInsets.right, capInsets.bottom);
-        }
-            break;
-        case JSStretchableNodePartBottom: {
-            rect.origin.x = capInsets.left;
-            rect.size.width = totalSize.width - capInsets.left - capInsets.right;
-            rect.size.height = capInsets.bottom;
-        }
-            break;
-        case JSStretchableNodePartBottomLeft:
-            rect.size = CGSizeMake(capInsets.left, capInsets.bottom);
-            break;
-        case JSStretchableNodePartLeft: {
-            rect.origin.y = capInsets.bottom;
-            rect.size.width = capInsets.left;
-            rect.size.height = totalSize.height - capInsets.top - capInsets.bottom;
-        }
-            break;
-        case JSStretchableNodePartCenter: {
-            rect.origin = CGPointMake(capInsets.left, capInsets.bottom);
-            rect.size.width = totalSize.width - capInsets.left - capInsets.right;
-            rect.size.height = totalSize.height - capInsets.top - capInsets.bottom;
-        }
-            break;
-    }
-    
-    return rect;
+    return tileSize;
 }
 
-static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRect partRect)
+static SSKNineSliceInsets JSStretchableNodeGetNineSliceInsets(SSKEdgeInsetsType capInsets)
 {
-    const CGSize textureSize = texture.size;
+    SSKNineSliceInsets insets;
+    insets.top = capInsets.top;
+    insets.left = capInsets.left;
+    insets.bottom = capInsets.bottom;
+    insets.right = capInsets.right;
     
-    CGRect textureRect;
-    textureRect.origin.x = partRect.origin.x / textureSize.width;
-    textureRect.origin.y = partRect.origin.y / textureSize.height;
-    textureRect.size.width = partRect.size.width / textureSize.width;
-    textureRect.size.height = partRect.size.height / textureSize.height;
+    return insets;
+}
 
-    return textureRect;
+static CGRect JSStretchableNodeGetRect(SSKTileRect rect)
+{
+    return CGRectMake(rect.x, rect.y, rect.width, rect.height);
 }
 
 #pragma mark - JSStretchableNode
@@ -95,11 +33,17 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
 @interface SSKStretchableNode()
 
 @property (nonatomic, strong) NSArray *partNodes;
-@property (nonatomic) SSKEdgeInsetsType textureCapInsets;
+@property (nonatomic, readwrite) SSKEdgeInsetsType textureCapInsets;
+@property (nonatomic, weak, readwrite) SSKStretchableBatch *batch;
+@property (nonatomic) BOOL needsLayout;
+@property (nonatomic) BOOL needsRedraw;
 
 @end
 
 @implementation SSKStretchableNode
+{
+    SSKNineSlice _slice;
+}
 
 + (instancetype)stretchableNodeWithSize:(CGSize)size imageNamed:(NSString *)imageName capInsets:(SSKEdgeInsetsType)capInsets
 {
@@ -121,9 +65,52 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
     return node;
 }
 
+#pragma mark - SSKLayoutPassNode
+
+- (void)setNeedsLayout
+{
+    self.needsLayout = YES;
+    
+    [[SSKLayoutPass sharedPass] scheduleNode:self];
+}
+
+- (void)layoutIfNeeded
+{
+    if (!self.needsLayout) {
+        return;
+    }
+    
+    self.needsLayout = NO;
+    
+    if (self.needsRedraw) {
+        [self drawPartNodes];
+    } else {
+        [self layoutPartNodes];
+    }
+}
+
+#pragma mark - Utilities
+
+- (void)setNeedsRedraw
+{
+    self.needsRedraw = YES;
+    
+    [self setNeedsLayout];
+}
+
 - (void)drawPartNodes
 {
+    self.needsRedraw = NO;
+    
     [self.partNodes makeObjectsPerformSelector:@selector(removeFromParent)];
+    _slice.count = 0;
+    
+    if (self.batch) {
+        self.partNodes = nil;
+        [self.batch setNeedsUpdateForNode:self];
+        
+        return;
+    }
     
     if (self.size.width == 0 || self.size.height == 0) {
         self.partNodes = nil;
@@ -146,14 +133,16 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
     
     NSMutableArray *partNodes = [NSMutableArray new];
     
-    const CGSize textureSize = self.texture.size;
+    SSKNineSliceCompute(&_slice,
+                        JSStretchableNodeGetTileSize(self.size),
+                        JSStretchableNodeGetTileSize(self.texture.size),
+                        JSStretchableNodeGetNineSliceInsets(self.textureCapInsets));
     
-    for (JSStretchableNodePart part = 0; part <= JSStretchableNodePartCenter; part++) {
-        CGRect partRect = JSStretchableNodeGetRectForPart(textureSize, self.textureCapInsets, part);
-        CGRect partTextureRect = JSStretchableNodeTextureRectFromPartRect(self.texture, partRect);
-        CGRect partNodeRect = JSStretchableNodeGetRectForPart(self.size, self.textureCapInsets, part);
+    for (size_t partIndex = 0; partIndex < _slice.count; partIndex++) {
+        CGRect partTextureRect = JSStretchableNodeGetRect(_slice.textureRects[partIndex]);
+        CGRect partNodeRect = JSStretchableNodeGetRect(_slice.rects[partIndex]);
         
-        SKTexture *partTexture = [SKTexture textureWithRect:partTextureRect inTexture:self.texture];
+        SKTexture *partTexture = [[SSKTextureRegionCache sharedCache] textureWithRect:partTextureRect inTexture:self.texture];
         SSKTileableNode *partNode = [SSKTileableNode tileableNodeWithSize:partNodeRect.size texture:partTexture];
         partNode.position = partNodeRect.origin;
         partNode.color = self.color;
@@ -166,6 +155,35 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
     self.partNodes = partNodes;
 }
 
+- (void)layoutPartNodes
+{
+    if (!self.texture || self.batch) {
+        [self drawPartNodes];
+        return;
+    }
+    
+    SSKNineSlice slice;
+    SSKNineSliceCompute(&slice,
+                        JSStretchableNodeGetTileSize(self.size),
+                        JSStretchableNodeGetTileSize(self.texture.size),
+                        JSStretchableNodeGetNineSliceInsets(self.textureCapInsets));
+    
+    if (!SSKNineSliceHasSameParts(&slice, &_slice)) {
+        [self drawPartNodes];
+        return;
+    }
+    
+    _slice = slice;
+    
+    for (size_t partIndex = 0; partIndex < slice.count; partIndex++) {
+        SSKTileableNode *partNode = [self.partNodes objectAtIndex:partIndex];
+        
+        CGRect partNodeRect = JSStretchableNodeGetRect(slice.rects[partIndex]);
+        partNode.position = partNodeRect.origin;
+        partNode.size = partNodeRect.size;
+    }
+}
+
 #pragma mark - Accessor overrides
 
 - (void)setTexture:(SKTexture *)texture capInsets:(SSKEdgeInsetsType)capInsets
@@ -173,7 +191,7 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
     _texture = texture;
     _textureCapInsets = capInsets;
     
-    [self drawPartNodes];
+    [self setNeedsRedraw];
 }
 
 - (void)setTexture:(SKTexture *)texture
@@ -184,7 +202,18 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
     
     _texture = texture;
     
-    [self drawPartNodes];
+    [self setNeedsRedraw];
+}
+
+- (void)setBatch:(SSKStretchableBatch *)batch
+{
+    if (_batch == batch) {
+        return;
+    }
+    
+    _batch = batch;
+    
+    [self setNeedsRedraw];
 }
 
 - (void)setZPosition:(CGFloat)zPosition
@@ -219,18 +248,7 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
         return;
     }
     
-    if ([self.partNodes count] < 2) {
-        [self drawPartNodes];
-        return;
-    }
-    
-    for (JSStretchableNodePart part = 0; part <= JSStretchableNodePartCenter; part++) {
-        SSKTileableNode *partNode = [self.partNodes objectAtIndex:part];
-        
-        CGRect partNodeRect = JSStretchableNodeGetRectForPart(size, self.textureCapInsets, part);
-        partNode.position = partNodeRect.origin;
-        partNode.size = partNodeRect.size;
-    }
+    [self setNeedsLayout];
 }
 
 - (void)setColor:(SKColor *)color
@@ -242,7 +260,7 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
     _color = color;
     
     if ([self.partNodes count] == 0) {
-        [self drawPartNodes];
+        [self setNeedsRedraw];
         
         return;
     }
@@ -261,7 +279,7 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
     _colorBlendFactor = colorBlendFactor;
     
     if ([self.partNodes count] == 0) {
-        [self drawPartNodes];
+        [self setNeedsRedraw];
         
         return;
     }
@@ -280,38 +298,23 @@ static CGRect JSStretchableNodeTextureRectFromPartRect(SKTexture *texture, CGRec
 + (SKAction *)resizeStretchableNodeToWidth:(CGFloat)width duration:(NSTimeInterval)duration
 {
     return [SKAction resizeStretchableNodeToWidth:width
-                                           height:JSStretchableNodeNoResizing
+                                           height:NAN
                                          duration:duration];
 }
 
 + (SKAction *)resizeStretchableNodeToHeight:(CGFloat)height duration:(NSTimeInterval)duration
 {
-    return [SKAction resizeStretchableNodeToWidth:JSStretchableNodeNoResizing
+    return [SKAction resizeStretchableNodeToWidth:NAN
                                            height:height
                                          duration:duration];
 }
 
 + (SKAction *)resizeStretchableNodeToWidth:(CGFloat)width height:(CGFloat)height duration:(NSTimeInterval)duration
 {
-    return [SKAction customActionWithDuration:duration actionBlock:^(SKNode *node, CGFloat elapsedTime) {
-        if (![node isKindOfClass:[SSKStretchableNode class]]) {
-           return;
-        }
-        
-        CGFloat percentageComplete = elapsedTime / duration;
-        SSKStretchableNode *stretchableNode = (SSKStretchableNode *)node;
-        CGSize nodeSize = stretchableNode.size;
-        
-        if (width != JSStretchableNodeNoResizing) {
-            nodeSize.width += (width - nodeSize.width) * percentageComplete;
-        }
-        
-        if (height != JSStretchableNodeNoResizing) {
-            nodeSize.height += (height - nodeSize.height) * percentageComplete;
-        }
-        
-        stretchableNode.size = nodeSize;
-    }];
+    return [SSKTweenEngine resizeActionToWidth:width
+                                        height:height
+                                      duration:duration
+                                        easing:SSKTweenEasingLinear];
 }
 
 @end
\ No newline at end of file
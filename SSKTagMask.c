@@ -0,0 +1,196 @@
+#include "SSKTagMask.h"
+
+#include <stdlib.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SSK_TAG_MASK_LANES 4
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SSK_TAG_MASK_LANES 2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SSK_TAG_MASK_LANES 2
+#else
+#define SSK_TAG_MASK_LANES 1
+#endif
+
+// The number of masks whose match bits fit in one 64-bit word
+#define SSKTagMaskBlockSize 64
+
+/**
+ *  A function that returns the match bits of up to SSKTagMaskBlockSize masks
+ */
+typedef uint64_t (*SSKTagMaskTableBlockKernel)(const uint64_t *masks, size_t count, uint64_t requiredMask, uint64_t excludedMask);
+
+#pragma mark - Utilities
+
+/**
+ *  Get the match bits of a block of masks, one mask at a time
+ *
+ *  @discussion A mask matches if (~mask & requiredMask) | (mask & excludedMask) is 0,
+ *  which tests both conditions with a single comparison.
+ */
+static uint64_t SSKTagMaskTableMatchBlockScalar(const uint64_t *masks, size_t count, uint64_t requiredMask, uint64_t excludedMask)
+{
+    uint64_t matchBits = 0;
+    
+    for (size_t index = 0; index < count; index++) {
+        const uint64_t mask = masks[index];
+        
+        if (((~mask & requiredMask) | (mask & excludedMask)) == 0) {
+            matchBits |= (uint64_t)1 << index;
+        }
+    }
+    
+    return matchBits;
+}
+
+#if SSK_TAG_MASK_LANES > 1
+
+/**
+ *  Vectorized version of SSKTagMaskTableMatchBlockScalar
+ *
+ *  @discussion The masks that don't fill a whole vector at the end of the block (the tail)
+ *  are tested by the scalar version. SSE2 has no 64-bit integer compare, so each lane is
+ *  compared as two 32-bit halves, which are then combined by swapping them within the lane.
+ */
+static uint64_t SSKTagMaskTableMatchBlockVectorized(const uint64_t *masks, size_t count, uint64_t requiredMask, uint64_t excludedMask)
+{
+    const size_t vectorizedCount = count & ~(size_t)(SSK_TAG_MASK_LANES - 1);
+    uint64_t matchBits = 0;
+    
+#if defined(__AVX2__)
+    const __m256i required = _mm256_set1_epi64x((long long)requiredMask);
+    const __m256i excluded = _mm256_set1_epi64x((long long)excludedMask);
+    const __m256i zero = _mm256_setzero_si256();
+    
+    for (size_t index = 0; index < vectorizedCount; index += SSK_TAG_MASK_LANES) {
+        __m256i mask = _mm256_loadu_si256((const __m256i *)(masks + index));
+        __m256i failedBits = _mm256_or_si256(_mm256_andnot_si256(mask, required), _mm256_and_si256(mask, excluded));
+        __m256i matches = _mm256_cmpeq_epi64(failedBits, zero);
+        
+        matchBits |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(matches)) << index;
+    }
+#elif defined(__SSE2__)
+    const __m128i required = _mm_set1_epi64x((long long)requiredMask);
+    const __m128i excluded = _mm_set1_epi64x((long long)excludedMask);
+    const __m128i zero = _mm_setzero_si128();
+    
+    for (size_t index = 0; index < vectorizedCount; index += SSK_TAG_MASK_LANES) {
+        __m128i mask = _mm_loadu_si128((const __m128i *)(masks + index));
+        __m128i failedBits = _mm_or_si128(_mm_andnot_si128(mask, required), _mm_and_si128(mask, excluded));
+        __m128i halfMatches = _mm_cmpeq_epi32(failedBits, zero);
+        __m128i matches = _mm_and_si128(halfMatches, _mm_shuffle_epi32(halfMatches, _MM_SHUFFLE(2, 3, 0, 1)));
+        
+        matchBits |= (uint64_t)_mm_movemask_pd(_mm_castsi128_pd(matches)) << index;
+    }
+#else
+    const uint64x2_t required = vdupq_n_u64(requiredMask);
+    const uint64x2_t excluded = vdupq_n_u64(excludedMask);
+    
+    for (size_t index = 0; index < vectorizedCount; index += SSK_TAG_MASK_LANES) {
+        uint64x2_t mask = vld1q_u64(masks + index);
+        uint64x2_t failedBits = vorrq_u64(vbicq_u64(required, mask), vandq_u64(mask, excluded));
+        uint64x2_t matches = vceqzq_u64(failedBits);
+        
+        matchBits |= ((vgetq_lane_u64(matches, 0) & 1) | (vgetq_lane_u64(matches, 1) & 2)) << index;
+    }
+#endif
+    
+    if (vectorizedCount < count) {
+        matchBits |= SSKTagMaskTableMatchBlockScalar(masks + vectorizedCount, count - vectorizedCount, requiredMask, excludedMask) << vectorizedCount;
+    }
+    
+    return matchBits;
+}
+
+#endif
+
+static size_t SSKTagMaskTableQueryWithBlockKernel(const SSKTagMaskTable *table,
+                                                  uint64_t requiredMask,
+                                                  uint64_t excludedMask,
+                                                  size_t *indices,
+                                                  size_t capacity,
+                                                  SSKTagMaskTableBlockKernel blockKernel)
+{
+    size_t matchCount = 0;
+    
+    for (size_t blockStart = 0; blockStart < table->count; blockStart += SSKTagMaskBlockSize) {
+        const size_t blockCount = table->count - blockStart < SSKTagMaskBlockSize ? table->count - blockStart : SSKTagMaskBlockSize;
+        uint64_t matchBits = blockKernel(table->masks + blockStart, blockCount, requiredMask, excludedMask);
+        
+        // Only the set bits are visited, so blocks without matches cost a single comparison
+        while (matchBits != 0) {
+            if (matchCount < capacity) {
+                indices[matchCount] = blockStart + (size_t)__builtin_ctzll(matchBits);
+            }
+            
+            matchCount++;
+            matchBits &= matchBits - 1;
+        }
+    }
+    
+    return matchCount;
+}
+
+#pragma mark - Tag mask tables
+
+void SSKTagMaskTableInit(SSKTagMaskTable *table)
+{
+    table->count = 0;
+    table->capacity = 0;
+    table->masks = NULL;
+}
+
+void SSKTagMaskTableDestroy(SSKTagMaskTable *table)
+{
+    free(table->masks);
+    
+    SSKTagMaskTableInit(table);
+}
+
+size_t SSKTagMaskTableAdd(SSKTagMaskTable *table, uint64_t mask)
+{
+    if (table->count == table->capacity) {
+        size_t capacity = table->capacity > 0 ? table->capacity * 2 : 64;
+        uint64_t *masks = realloc(table->masks, capacity * sizeof(uint64_t));
+        
+        if (!masks) {
+            return SIZE_MAX;
+        }
+        
+        table->masks = masks;
+        table->capacity = capacity;
+    }
+    
+    const size_t index = table->count;
+    table->masks[index] = mask;
+    table->count++;
+    
+    return index;
+}
+
+void SSKTagMaskTableRemove(SSKTagMaskTable *table, size_t index)
+{
+    if (index >= table->count) {
+        return;
+    }
+    
+    table->masks[index] = table->masks[table->count - 1];
+    table->count--;
+}
+
+size_t SSKTagMaskTableQuery(const SSKTagMaskTable *table, uint64_t requiredMask, uint64_t excludedMask, size_t *indices, size_t capacity)
+{
+#if SSK_TAG_MASK_LANES > 1
+    return SSKTagMaskTableQueryWithBlockKernel(table, requiredMask, excludedMask, indices, capacity, SSKTagMaskTableMatchBlockVectorized);
+#else
+    return SSKTagMaskTableQueryWithBlockKernel(table, requiredMask, excludedMask, indices, capacity, SSKTagMaskTableMatchBlockScalar);
+#endif
+}
+
+size_t SSKTagMaskTableQueryScalar(const SSKTagMaskTable *table, uint64_t requiredMask, uint64_t excludedMask, size_t *indices, size_t capacity)
+{
+    return SSKTagMaskTableQueryWithBlockKernel(table, requiredMask, excludedMask, indices, capacity, SSKTagMaskTableMatchBlockScalar);
+}
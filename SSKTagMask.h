@@ -0,0 +1,83 @@
+#ifndef SSKTagMask_h
+#define SSKTagMask_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  A flat, packed array of 64-bit tag masks
+ *
+ *  @discussion The first "count" masks are valid. Masks are removed by moving the last mask
+ *  into the removed mask's index, so that the array stays packed. Any parallel arrays kept
+ *  by the caller should do the same.
+ */
+typedef struct {
+    size_t count;
+    size_t capacity;
+    uint64_t *masks;
+} SSKTagMaskTable;
+
+#pragma mark - Tag mask tables
+
+/**
+ *  Initialize an empty tag mask table
+ */
+extern void SSKTagMaskTableInit(SSKTagMaskTable *table);
+
+/**
+ *  Free all memory used by a tag mask table, and make it empty
+ */
+extern void SSKTagMaskTableDestroy(SSKTagMaskTable *table);
+
+/**
+ *  Add a mask to a tag mask table
+ *
+ *  @return The index of the added mask, or SIZE_MAX if memory for it could not be allocated
+ */
+extern size_t SSKTagMaskTableAdd(SSKTagMaskTable *table, uint64_t mask);
+
+/**
+ *  Remove a mask from a tag mask table, moving the last mask into its index
+ */
+extern void SSKTagMaskTableRemove(SSKTagMaskTable *table, size_t index);
+
+/**
+ *  Find all masks of a tag mask table that have all required bits, and none of the excluded bits, set
+ *
+ *  @param table The table to search
+ *  @param requiredMask The bits that a mask must have set to match
+ *  @param excludedMask The bits that a mask must not have set to match
+ *  @param indices The array to write the indices of the matching masks to, in ascending order
+ *  @param capacity The number of indices that fit in the array
+ *
+ *  @return The number of matching masks. If this is larger than the capacity, only the first
+ *  "capacity" indices were written, and the query should be repeated with a larger array.
+ *
+ *  @discussion The masks are tested in blocks of 64, each producing a word with one match
+ *  bit per mask, using AVX2, SSE2 or NEON when the target supports it (AVX2 requires building
+ *  with SSK_NATIVE_SIMD, or -mavx2). Only the set bits of each word are then visited to write
+ *  the indices, so blocks without matches are skipped with a single comparison.
+ *  No memory is allocated.
+ */
+extern size_t SSKTagMaskTableQuery(const SSKTagMaskTable *table, uint64_t requiredMask, uint64_t excludedMask, size_t *indices, size_t capacity);
+
+/**
+ *  Find matching masks like SSKTagMaskTableQuery, without using vector instructions
+ *
+ *  @discussion Produces the same results as SSKTagMaskTableQuery. Useful as a reference
+ *  to verify & benchmark the vectorized version against.
+ */
+extern size_t SSKTagMaskTableQueryScalar(const SSKTagMaskTable *table, uint64_t requiredMask, uint64_t excludedMask, size_t *indices, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,298 @@
+#include "SSKTagSnapshot.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <dispatch/dispatch.h>
+#else
+#include <pthread.h>
+#endif
+
+#define SSKTagSnapshotChunkSize 4096
+#define SSKTagSnapshotMaximumThreadCount 64
+
+#pragma mark - Utilities
+
+typedef struct {
+    size_t count;
+    size_t capacity;
+    size_t *indices;
+} SSKTagSnapshotMatchBuffer;
+
+typedef struct {
+    const SSKTagSnapshot *snapshot;
+    int64_t tag;
+    bool returnOnFirstMatch;
+    size_t chunkCount;
+    size_t nextChunkIndex;
+    size_t firstMatchIndex;
+    bool didFail;
+    SSKTagSnapshotMatchBuffer buffers[SSKTagSnapshotMaximumThreadCount];
+} SSKTagSnapshotSearchContext;
+
+static bool SSKTagSnapshotAppendMatch(SSKTagSnapshotMatchBuffer *buffer, size_t index)
+{
+    if (buffer->count == buffer->capacity) {
+        size_t capacity = buffer->capacity > 0 ? buffer->capacity * 2 : 64;
+        size_t *indices = realloc(buffer->indices, capacity * sizeof(size_t));
+        
+        if (!indices) {
+            return false;
+        }
+        
+        buffer->indices = indices;
+        buffer->capacity = capacity;
+    }
+    
+    buffer->indices[buffer->count] = index;
+    buffer->count++;
+    
+    return true;
+}
+
+static void SSKTagSnapshotLowerFirstMatchIndex(SSKTagSnapshotSearchContext *search, size_t index)
+{
+    size_t firstMatchIndex = __atomic_load_n(&search->firstMatchIndex, __ATOMIC_RELAXED);
+    
+    while (index < firstMatchIndex) {
+        if (__atomic_compare_exchange_n(&search->firstMatchIndex, &firstMatchIndex, index, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            return;
+        }
+    }
+}
+
+static void SSKTagSnapshotRunWorker(void *context, size_t workerIndex)
+{
+    SSKTagSnapshotSearchContext *search = context;
+    SSKTagSnapshotMatchBuffer *buffer = &search->buffers[workerIndex];
+    const int64_t *tags = search->snapshot->tags;
+    const size_t count = search->snapshot->count;
+    const int64_t tag = search->tag;
+    
+    while (true) {
+        // Chunks are claimed in ascending order, so a worker that finishes early simply claims the next one
+        const size_t chunkIndex = __atomic_fetch_add(&search->nextChunkIndex, 1, __ATOMIC_RELAXED);
+        
+        if (chunkIndex >= search->chunkCount) {
+            return;
+        }
+        
+        const size_t start = chunkIndex * SSKTagSnapshotChunkSize;
+        const size_t end = start + SSKTagSnapshotChunkSize < count ? start + SSKTagSnapshotChunkSize : count;
+        
+        if (search->returnOnFirstMatch) {
+            // All chunks claimed from now on start after the earliest match found so far, so they can't contain the first match
+            if (start >= __atomic_load_n(&search->firstMatchIndex, __ATOMIC_RELAXED)) {
+                return;
+            }
+            
+            for (size_t index = start; index < end; index++) {
+                if (tags[index] == tag) {
+                    SSKTagSnapshotLowerFirstMatchIndex(search, index);
+                    break;
+                }
+            }
+            
+            continue;
+        }
+        
+        for (size_t index = start; index < end; index++) {
+            if (tags[index] == tag && !SSKTagSnapshotAppendMatch(buffer, index)) {
+                __atomic_store_n(&search->didFail, true, __ATOMIC_RELAXED);
+                return;
+            }
+        }
+    }
+}
+
+#ifndef __APPLE__
+
+typedef struct {
+    SSKTagSnapshotSearchContext *search;
+    size_t workerIndex;
+} SSKTagSnapshotWorker;
+
+static void *SSKTagSnapshotRunWorkerThread(void *context)
+{
+    const SSKTagSnapshotWorker *worker = context;
+    SSKTagSnapshotRunWorker(worker->search, worker->workerIndex);
+    
+    return NULL;
+}
+
+#endif
+
+static int SSKTagSnapshotCompareIndices(const void *index, const void *otherIndex)
+{
+    const size_t value = *(const size_t *)index;
+    const size_t otherValue = *(const size_t *)otherIndex;
+    
+    return value < otherValue ? -1 : (value > otherValue ? 1 : 0);
+}
+
+static bool SSKTagSnapshotReserveMatches(SSKTagSnapshot *snapshot, size_t matchCount)
+{
+    if (matchCount <= snapshot->matchCapacity) {
+        return true;
+    }
+    
+    size_t *matches = realloc(snapshot->matches, matchCount * sizeof(size_t));
+    
+    if (!matches) {
+        return false;
+    }
+    
+    snapshot->matches = matches;
+    snapshot->matchCapacity = matchCount;
+    
+    return true;
+}
+
+#pragma mark - Tag snapshots
+
+void SSKTagSnapshotInit(SSKTagSnapshot *snapshot)
+{
+    snapshot->count = 0;
+    snapshot->capacity = 0;
+    snapshot->tags = NULL;
+    snapshot->matchCount = 0;
+    snapshot->matchCapacity = 0;
+    snapshot->matches = NULL;
+}
+
+void SSKTagSnapshotDestroy(SSKTagSnapshot *snapshot)
+{
+    free(snapshot->tags);
+    free(snapshot->matches);
+    
+    SSKTagSnapshotInit(snapshot);
+}
+
+void SSKTagSnapshotRemoveAllTags(SSKTagSnapshot *snapshot)
+{
+    snapshot->count = 0;
+    snapshot->matchCount = 0;
+}
+
+bool SSKTagSnapshotAppend(SSKTagSnapshot *snapshot, int64_t tag)
+{
+    if (snapshot->count == snapshot->capacity) {
+        size_t capacity = snapshot->capacity > 0 ? snapshot->capacity * 2 : 256;
+        int64_t *tags = realloc(snapshot->tags, capacity * sizeof(int64_t));
+        
+        if (!tags) {
+            return false;
+        }
+        
+        snapshot->tags = tags;
+        snapshot->capacity = capacity;
+    }
+    
+    snapshot->tags[snapshot->count] = tag;
+    snapshot->count++;
+    
+    return true;
+}
+
+bool SSKTagSnapshotSearch(SSKTagSnapshot *snapshot, int64_t tag, bool returnOnFirstMatch, size_t threadCount)
+{
+    snapshot->matchCount = 0;
+    
+    // The context is too large for the stack, since it contains a buffer for every possible thread
+    SSKTagSnapshotSearchContext *search = calloc(1, sizeof(SSKTagSnapshotSearchContext));
+    
+    if (!search) {
+        return false;
+    }
+    
+    search->snapshot = snapshot;
+    search->tag = tag;
+    search->returnOnFirstMatch = returnOnFirstMatch;
+    search->chunkCount = (snapshot->count + SSKTagSnapshotChunkSize - 1) / SSKTagSnapshotChunkSize;
+    search->firstMatchIndex = SIZE_MAX;
+    
+    if (threadCount == 0) {
+        long coreCount = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = coreCount > 0 ? (size_t)coreCount : 1;
+    }
+    
+    if (threadCount > search->chunkCount) {
+        threadCount = search->chunkCount;
+    }
+    
+    if (threadCount > SSKTagSnapshotMaximumThreadCount) {
+        threadCount = SSKTagSnapshotMaximumThreadCount;
+    }
+    
+    if (threadCount <= 1) {
+        threadCount = 1;
+        SSKTagSnapshotRunWorker(search, 0);
+    } else {
+#ifdef __APPLE__
+        dispatch_apply_f(threadCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), search, SSKTagSnapshotRunWorker);
+#else
+        SSKTagSnapshotWorker workers[SSKTagSnapshotMaximumThreadCount];
+        pthread_t threads[SSKTagSnapshotMaximumThreadCount];
+        bool threadWasCreated[SSKTagSnapshotMaximumThreadCount];
+        
+        // The calling thread runs the first worker itself, instead of idling while waiting for the others
+        for (size_t workerIndex = 0; workerIndex < threadCount; workerIndex++) {
+            workers[workerIndex] = (SSKTagSnapshotWorker){search, workerIndex};
+            threadWasCreated[workerIndex] = false;
+            
+            if (workerIndex > 0) {
+                threadWasCreated[workerIndex] = pthread_create(&threads[workerIndex], NULL, SSKTagSnapshotRunWorkerThread, &workers[workerIndex]) == 0;
+            }
+        }
+        
+        SSKTagSnapshotRunWorker(search, 0);
+        
+        // Workers without a thread have nothing left to do, since the other workers claimed all chunks
+        for (size_t workerIndex = 1; workerIndex < threadCount; workerIndex++) {
+            if (threadWasCreated[workerIndex]) {
+                pthread_join(threads[workerIndex], NULL);
+            }
+        }
+#endif
+    }
+    
+    bool didSucceed = !search->didFail;
+    
+    if (returnOnFirstMatch) {
+        if (search->firstMatchIndex != SIZE_MAX && SSKTagSnapshotReserveMatches(snapshot, 1)) {
+            snapshot->matches[0] = search->firstMatchIndex;
+            snapshot->matchCount = 1;
+        }
+    } else if (didSucceed) {
+        size_t matchCount = 0;
+        
+        for (size_t workerIndex = 0; workerIndex < threadCount; workerIndex++) {
+            matchCount += search->buffers[workerIndex].count;
+        }
+        
+        didSucceed = SSKTagSnapshotReserveMatches(snapshot, matchCount);
+        
+        // Each buffer is already in ascending order, but chunks were claimed by the workers in any interleaving
+        for (size_t workerIndex = 0; didSucceed && workerIndex < threadCount; workerIndex++) {
+            const SSKTagSnapshotMatchBuffer *buffer = &search->buffers[workerIndex];
+            
+            for (size_t index = 0; index < buffer->count; index++) {
+                snapshot->matches[snapshot->matchCount] = buffer->indices[index];
+                snapshot->matchCount++;
+            }
+        }
+        
+        if (didSucceed && threadCount > 1) {
+            qsort(snapshot->matches, snapshot->matchCount, sizeof(size_t), SSKTagSnapshotCompareIndices);
+        }
+    }
+    
+    for (size_t workerIndex = 0; workerIndex < threadCount; workerIndex++) {
+        free(search->buffers[workerIndex].indices);
+    }
+    
+    free(search);
+    
+    return didSucceed;
+}
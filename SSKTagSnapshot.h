@@ -0,0 +1,82 @@
+#ifndef SSKTagSnapshot_h
+#define SSKTagSnapshot_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  A flat snapshot of the tags of a node tree, and the results of searching it
+ *
+ *  @discussion The first "count" tags are valid, and are stored in the order the nodes were
+ *  visited when taking the snapshot (depth-first for SKNode+SSKTags). Searching the snapshot
+ *  writes the indices of the matching tags to the match array, of which the first "matchCount"
+ *  are valid. Both arrays are grown as needed, and reused across searches.
+ *
+ *  Since a snapshot is plain memory, it can be searched from any thread, regardless of what
+ *  happens to the node tree it was taken from.
+ */
+typedef struct {
+    size_t count;
+    size_t capacity;
+    int64_t *tags;
+    size_t matchCount;
+    size_t matchCapacity;
+    size_t *matches;
+} SSKTagSnapshot;
+
+#pragma mark - Tag snapshots
+
+/**
+ *  Initialize an empty tag snapshot
+ */
+extern void SSKTagSnapshotInit(SSKTagSnapshot *snapshot);
+
+/**
+ *  Free all memory used by a tag snapshot, and make it empty
+ */
+extern void SSKTagSnapshotDestroy(SSKTagSnapshot *snapshot);
+
+/**
+ *  Remove all tags & matches from a tag snapshot, without freeing its memory
+ */
+extern void SSKTagSnapshotRemoveAllTags(SSKTagSnapshot *snapshot);
+
+/**
+ *  Append a tag to a tag snapshot
+ *
+ *  @return Whether the tag could be appended. False is returned if memory for it could not be allocated.
+ */
+extern bool SSKTagSnapshotAppend(SSKTagSnapshot *snapshot, int64_t tag);
+
+/**
+ *  Search a tag snapshot for a tag, using multiple threads
+ *
+ *  @param snapshot The snapshot to search. Its matches are replaced by the matches of this search.
+ *  @param tag The tag to look for
+ *  @param returnOnFirstMatch Whether only the first (lowest index) match should be found
+ *  @param threadCount The maximum number of threads to search with, or 0 to use all cores
+ *
+ *  @return Whether the search could be performed. False is returned if memory for the
+ *  matches could not be allocated, in which case the snapshot has no matches.
+ *
+ *  @discussion The tags are split into fixed-size chunks, which the threads claim one at a time,
+ *  so threads that finish early take over the remaining chunks. Each thread writes its matches
+ *  to its own buffer, and the buffers are merged into ascending order once all threads are done.
+ *  When returning on the first match, threads stop claiming chunks past the earliest match found
+ *  so far. Threads are created using GCD where available, and POSIX threads elsewhere. Small
+ *  snapshots are searched on the calling thread.
+ */
+extern bool SSKTagSnapshotSearch(SSKTagSnapshot *snapshot, int64_t tag, bool returnOnFirstMatch, size_t threadCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+#import <SpriteKit/SpriteKit.h>
+
+/**
+ *  A process-wide cache of textures representing regions of other textures
+ *
+ *  @discussion Creating a texture using +[SKTexture textureWithRect:inTexture:] allocates
+ *  a new texture object every time, even when a texture for the same region has already
+ *  been created. This cache hands back a shared texture for each (parent texture, rect)
+ *  combination instead. Rects are quantized before being compared, so that tiny floating
+ *  point differences between two computations of the same region still share a texture.
+ *
+ *  The cache only holds weak references to the textures it hands out, so a texture is
+ *  evicted as soon as nothing else is using it. It also doesn't retain any parent textures.
+ *  The entries left behind by evicted textures are purged every time the number of entries
+ *  has doubled since the last purge, and (on iOS) when the app receives a memory warning.
+ *
+ *  SSKTileableNode and SSKStretchableNode use the shared cache for all of their cropped textures.
+ */
+@interface SSKTextureRegionCache : NSObject
+
+/**
+ *  The number of lookups that returned an already cached texture
+ */
+@property (nonatomic, readonly) NSUInteger hitCount;
+
+/**
+ *  The number of lookups that had to create a new texture
+ */
+@property (nonatomic, readonly) NSUInteger missCount;
+
+/**
+ *  Return the shared, process-wide, texture region cache
+ */
++ (instancetype)sharedCache;
+
+/**
+ *  Return a texture representing a region of another texture
+ *
+ *  @param rect The region, in the unit coordinate space of the texture. This parameter
+ *  has the same semantics as for +[SKTexture textureWithRect:inTexture:].
+ *  @param texture The texture to get a region of
+ *
+ *  @discussion If a texture for the same region is currently cached, that texture is returned.
+ *  Otherwise, a new texture is created, cached & returned.
+ */
+- (SKTexture *)textureWithRect:(CGRect)rect inTexture:(SKTexture *)texture;
+
+/**
+ *  Remove all textures from the cache
+ */
+- (void)removeAllTextures;
+
+/**
+ *  Remove the entries of all textures that have been evicted, and of all deallocated parent textures
+ *
+ *  @discussion The cache calls this method automatically, but it can also be called at times
+ *  when a lot of textures are known to have gone away, like after unloading a level.
+ */
+- (void)purgeStaleEntries;
+
+/**
+ *  Reset the hit & miss counters to zero
+ */
+- (void)resetCounters;
+
+@end
@@ -0,0 +1,211 @@
+#import "SSKTextureRegionCache.h"
+
+/**
+ *  The number of steps per unit that texture region rects are quantized to
+ */
+static const double SSKTextureRegionCacheQuantization = 65536;
+
+/**
+ *  The minimum number of textures created between two purges of stale cache entries
+ */
+static const NSUInteger SSKTextureRegionCacheMinimumPurgeInterval = 256;
+
+#pragma mark - SSKTextureRegionKey
+
+@interface SSKTextureRegionKey : NSObject <NSCopying>
+{
+    @public
+    long long _x;
+    long long _y;
+    long long _width;
+    long long _height;
+}
+
+- (void)setRect:(CGRect)rect;
+
+@end
+
+@implementation SSKTextureRegionKey
+
+- (void)setRect:(CGRect)rect
+{
+    _x = llround(rect.origin.x * SSKTextureRegionCacheQuantization);
+    _y = llround(rect.origin.y * SSKTextureRegionCacheQuantization);
+    _width = llround(rect.size.width * SSKTextureRegionCacheQuantization);
+    _height = llround(rect.size.height * SSKTextureRegionCacheQuantization);
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    SSKTextureRegionKey *key = [[[self class] allocWithZone:zone] init];
+    key->_x = _x;
+    key->_y = _y;
+    key->_width = _width;
+    key->_height = _height;
+    
+    return key;
+}
+
+- (NSUInteger)hash
+{
+    NSUInteger hash = (NSUInteger)_x;
+    hash = hash * 31 + (NSUInteger)_y;
+    hash = hash * 31 + (NSUInteger)_width;
+    hash = hash * 31 + (NSUInteger)_height;
+    
+    return hash;
+}
+
+- (BOOL)isEqual:(id)object
+{
+    if (![object isKindOfClass:[SSKTextureRegionKey class]]) {
+        return NO;
+    }
+    
+    SSKTextureRegionKey *key = object;
+    
+    return key->_x == _x && key->_y == _y && key->_width == _width && key->_height == _height;
+}
+
+@end
+
+#pragma mark - SSKTextureRegionCache
+
+@interface SSKTextureRegionCache()
+
+@property (nonatomic, readwrite) NSUInteger hitCount;
+@property (nonatomic, readwrite) NSUInteger missCount;
+@property (nonatomic, strong) NSMapTable *regionTablesByTexture;
+@property (nonatomic, strong) SSKTextureRegionKey *lookupKey;
+@property (nonatomic) NSUInteger entryCount;
+@property (nonatomic) NSUInteger purgeEntryCount;
+
+@end
+
+@implementation SSKTextureRegionCache
+
++ (instancetype)sharedCache
+{
+    static SSKTextureRegionCache *sharedCache;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        sharedCache = [self new];
+    });
+    
+    return sharedCache;
+}
+
+- (id)init
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    _regionTablesByTexture = [NSMapTable weakToStrongObjectsMapTable];
+    _lookupKey = [SSKTextureRegionKey new];
+    _purgeEntryCount = SSKTextureRegionCacheMinimumPurgeInterval;
+
+#if TARGET_OS_IPHONE
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(purgeStaleEntries)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
+#endif
+
+    return self;
+}
+
+- (void)dealloc
+{
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (SKTexture *)textureWithRect:(CGRect)rect inTexture:(SKTexture *)texture
+{
+    if (!texture) {
+        return nil;
+    }
+    
+    @synchronized(self) {
+        NSMapTable *regionTable = [self.regionTablesByTexture objectForKey:texture];
+        
+        if (!regionTable) {
+            regionTable = [NSMapTable strongToWeakObjectsMapTable];
+            [self.regionTablesByTexture setObject:regionTable forKey:texture];
+        }
+        
+        [self.lookupKey setRect:rect];
+        
+        SKTexture *regionTexture = [regionTable objectForKey:self.lookupKey];
+        
+        if (regionTexture) {
+            self.hitCount++;
+            
+            return regionTexture;
+        }
+        
+        self.missCount++;
+        
+        regionTexture = [SKTexture textureWithRect:rect inTexture:texture];
+        [regionTable setObject:regionTexture forKey:[self.lookupKey copy]];
+        
+        // A miss may be for a region whose texture has gone away, so stale entries are purged as they pile up
+        self.entryCount++;
+        
+        if (self.entryCount >= self.purgeEntryCount) {
+            [self purgeStaleEntries];
+        }
+        
+        return regionTexture;
+    }
+}
+
+- (void)purgeStaleEntries
+{
+    @synchronized(self) {
+        NSMapTable *regionTablesByTexture = [NSMapTable weakToStrongObjectsMapTable];
+        NSUInteger entryCount = 0;
+        
+        // The keys of deallocated parent textures are skipped by the enumerator, so they're dropped by rebuilding the table
+        for (SKTexture *texture in [[self.regionTablesByTexture keyEnumerator] allObjects]) {
+            NSMapTable *regionTable = [self.regionTablesByTexture objectForKey:texture];
+            
+            for (SSKTextureRegionKey *key in [[regionTable keyEnumerator] allObjects]) {
+                if ([regionTable objectForKey:key]) {
+                    entryCount++;
+                } else {
+                    [regionTable removeObjectForKey:key];
+                }
+            }
+            
+            if ([regionTable count] > 0) {
+                [regionTablesByTexture setObject:regionTable forKey:texture];
+            }
+        }
+        
+        self.regionTablesByTexture = regionTablesByTexture;
+        
+        // Purging again once the number of entries has doubled keeps the cost of purging constant per created texture
+        self.entryCount = entryCount;
+        self.purgeEntryCount = MAX(entryCount * 2, SSKTextureRegionCacheMinimumPurgeInterval);
+    }
+}
+
+- (void)removeAllTextures
+{
+    @synchronized(self) {
+        [self.regionTablesByTexture removeAllObjects];
+        self.entryCount = 0;
+    }
+}
+
+- (void)resetCounters
+{
+    @synchronized(self) {
+        self.hitCount = 0;
+        self.missCount = 0;
+    }
+}
+
+@end
@@ -0,0 +1,394 @@
+#include "SSKTileLayout.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SSK_TILE_LAYOUT_LANES 4
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SSK_TILE_LAYOUT_LANES 2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SSK_TILE_LAYOUT_LANES 2
+#else
+#define SSK_TILE_LAYOUT_LANES 1
+#endif
+
+/**
+ *  Constants shared by all rows of a tile layout computation
+ */
+typedef struct {
+    double size;
+    double textureSize;
+    double textureX;
+    double textureScale;
+} SSKTileLayoutRowParameters;
+
+typedef void (*SSKTileLayoutRowKernel)(SSKTileLayout *layout, size_t index, size_t firstColumn, size_t columns, SSKTileLayoutRowParameters parameters);
+
+#pragma mark - Utilities
+
+static size_t SSKTileGridGetTileCount(double size, double textureSize)
+{
+    if (size <= 0 || textureSize <= 0) {
+        return 0;
+    }
+    
+    return (size_t)ceil(size / textureSize);
+}
+
+static double SSKTileGridGetTileLength(double size, double textureSize, size_t index)
+{
+    double remainingSize = size - textureSize * (double)index;
+    
+    return remainingSize < textureSize ? remainingSize : textureSize;
+}
+
+static bool SSKTileLayoutReserve(SSKTileLayout *layout, size_t capacity)
+{
+    // Room for one extra vector, since the SIMD row kernels always write whole vectors
+    capacity += SSK_TILE_LAYOUT_LANES - 1;
+    
+    if (layout->capacity >= capacity) {
+        return true;
+    }
+    
+    double **arrays[] = {
+        &layout->x, &layout->y, &layout->width, &layout->height,
+        &layout->textureX, &layout->textureY, &layout->textureWidth, &layout->textureHeight
+    };
+    
+    for (size_t arrayIndex = 0; arrayIndex < sizeof(arrays) / sizeof(arrays[0]); arrayIndex++) {
+        double *array = realloc(*arrays[arrayIndex], capacity * sizeof(double));
+        
+        if (!array) {
+            return false;
+        }
+        
+        *arrays[arrayIndex] = array;
+    }
+    
+    layout->capacity = capacity;
+    
+    return true;
+}
+
+#pragma mark - Tile grids
+
+SSKTileGrid SSKTileGridMake(SSKTileSize size, SSKTileSize textureSize, SSKTileRect textureRect)
+{
+    SSKTileGrid grid;
+    grid.size = size;
+    grid.textureSize = textureSize;
+    grid.textureRect = textureRect;
+    grid.columns = SSKTileGridGetTileCount(size.width, textureSize.width);
+    grid.rows = SSKTileGridGetTileCount(size.height, textureSize.height);
+    
+    if (grid.columns == 0 || grid.rows == 0) {
+        grid.columns = 0;
+        grid.rows = 0;
+    }
+    
+    return grid;
+}
+
+SSKTileRange SSKTileGridGetFullRange(const SSKTileGrid *grid)
+{
+    SSKTileRange range;
+    range.column = 0;
+    range.row = 0;
+    range.columns = grid->columns;
+    range.rows = grid->rows;
+    
+    return range;
+}
+
+void SSKTileGridGetTile(const SSKTileGrid *grid, size_t column, size_t row, SSKTileRect *rect, SSKTileRect *textureRect)
+{
+    const SSKTileSize textureSize = grid->textureSize;
+    
+    SSKTileRect tileRect;
+    tileRect.x = textureSize.width * (double)column;
+    tileRect.y = textureSize.height * (double)row;
+    tileRect.width = SSKTileGridGetTileLength(grid->size.width, textureSize.width, column);
+    tileRect.height = SSKTileGridGetTileLength(grid->size.height, textureSize.height, row);
+    
+    if (rect) {
+        *rect = tileRect;
+    }
+    
+    // Scaled the same way as by SSKTileLayoutCompute, so that both produce identical texture rects
+    if (textureRect) {
+        *textureRect = grid->textureRect;
+        textureRect->width = tileRect.width * (grid->textureRect.width / textureSize.width);
+        textureRect->height = tileRect.height * (grid->textureRect.height / textureSize.height);
+    }
+}
+
+bool SSKTileGridIsTileCropped(const SSKTileGrid *grid, size_t column, size_t row)
+{
+    if (column + 1 == grid->columns && grid->size.width < grid->textureSize.width * (double)grid->columns) {
+        return true;
+    }
+    
+    return row + 1 == grid->rows && grid->size.height < grid->textureSize.height * (double)grid->rows;
+}
+
+#pragma mark - Tile ranges
+
+static SSKTileRange SSKTileRangeMake(size_t column, size_t row, size_t columns, size_t rows)
+{
+    SSKTileRange range;
+    range.column = column;
+    range.row = row;
+    range.columns = columns;
+    range.rows = rows;
+    
+    return range;
+}
+
+SSKTileRange SSKTileRangeGetIntersection(SSKTileRange range, SSKTileRange otherRange)
+{
+    size_t minColumn = range.column > otherRange.column ? range.column : otherRange.column;
+    size_t minRow = range.row > otherRange.row ? range.row : otherRange.row;
+    size_t maxColumn = range.column + range.columns;
+    size_t maxRow = range.row + range.rows;
+    
+    if (otherRange.column + otherRange.columns < maxColumn) {
+        maxColumn = otherRange.column + otherRange.columns;
+    }
+    
+    if (otherRange.row + otherRange.rows < maxRow) {
+        maxRow = otherRange.row + otherRange.rows;
+    }
+    
+    if (maxColumn <= minColumn || maxRow <= minRow) {
+        return SSKTileRangeMake(0, 0, 0, 0);
+    }
+    
+    return SSKTileRangeMake(minColumn, minRow, maxColumn - minColumn, maxRow - minRow);
+}
+
+size_t SSKTileRangeSubtract(SSKTileRange range, SSKTileRange subtractedRange, SSKTileRange differences[4])
+{
+    if (range.columns == 0 || range.rows == 0) {
+        return 0;
+    }
+    
+    SSKTileRange intersection = SSKTileRangeGetIntersection(range, subtractedRange);
+    
+    if (intersection.columns == 0 || intersection.rows == 0) {
+        differences[0] = range;
+        
+        return 1;
+    }
+    
+    size_t count = 0;
+    
+    if (intersection.row > range.row) {
+        differences[count++] = SSKTileRangeMake(range.column, range.row, range.columns, intersection.row - range.row);
+    }
+    
+    if (intersection.row + intersection.rows < range.row + range.rows) {
+        size_t row = intersection.row + intersection.rows;
+        differences[count++] = SSKTileRangeMake(range.column, row, range.columns, range.row + range.rows - row);
+    }
+    
+    if (intersection.column > range.column) {
+        differences[count++] = SSKTileRangeMake(range.column, intersection.row, intersection.column - range.column, intersection.rows);
+    }
+    
+    if (intersection.column + intersection.columns < range.column + range.columns) {
+        size_t column = intersection.column + intersection.columns;
+        differences[count++] = SSKTileRangeMake(column, intersection.row, range.column + range.columns - column, intersection.rows);
+    }
+    
+    return count;
+}
+
+#pragma mark - Row kernels
+
+static void SSKTileLayoutComputeRowScalar(SSKTileLayout *layout, size_t index, size_t firstColumn, size_t columns, SSKTileLayoutRowParameters parameters)
+{
+    for (size_t column = firstColumn; column < firstColumn + columns; column++) {
+        const double width = SSKTileGridGetTileLength(parameters.size, parameters.textureSize, column);
+        
+        layout->x[index] = parameters.textureSize * (double)column;
+        layout->width[index] = width;
+        layout->textureX[index] = parameters.textureX;
+        layout->textureWidth[index] = width * parameters.textureScale;
+        
+        index++;
+    }
+}
+
+#if SSK_TILE_LAYOUT_LANES > 1
+
+/**
+ *  Vectorized version of SSKTileLayoutComputeRowScalar
+ *
+ *  @discussion The tile width is computed as min(textureSize, size - x) in every lane,
+ *  which crops the partial last column without branching. Lanes past the end of the
+ *  row are masked off by simply being overwritten: they spill into the first tiles of
+ *  the next row (which is computed afterwards), or into the layout's padding.
+ */
+static void SSKTileLayoutComputeRowVectorized(SSKTileLayout *layout, size_t index, size_t firstColumn, size_t columns, SSKTileLayoutRowParameters parameters)
+{
+#if defined(__AVX__)
+    const __m256d laneOffsets = _mm256_set_pd(3, 2, 1, 0);
+    const __m256d size = _mm256_set1_pd(parameters.size);
+    const __m256d textureSize = _mm256_set1_pd(parameters.textureSize);
+    const __m256d textureX = _mm256_set1_pd(parameters.textureX);
+    const __m256d textureScale = _mm256_set1_pd(parameters.textureScale);
+    
+    for (size_t lane = 0; lane < columns; lane += SSK_TILE_LAYOUT_LANES) {
+        __m256d column = _mm256_add_pd(_mm256_set1_pd((double)(firstColumn + lane)), laneOffsets);
+        __m256d x = _mm256_mul_pd(column, textureSize);
+        __m256d width = _mm256_min_pd(textureSize, _mm256_sub_pd(size, x));
+        
+        _mm256_storeu_pd(layout->x + index + lane, x);
+        _mm256_storeu_pd(layout->width + index + lane, width);
+        _mm256_storeu_pd(layout->textureX + index + lane, textureX);
+        _mm256_storeu_pd(layout->textureWidth + index + lane, _mm256_mul_pd(width, textureScale));
+    }
+#elif defined(__SSE2__)
+    const __m128d laneOffsets = _mm_set_pd(1, 0);
+    const __m128d size = _mm_set1_pd(parameters.size);
+    const __m128d textureSize = _mm_set1_pd(parameters.textureSize);
+    const __m128d textureX = _mm_set1_pd(parameters.textureX);
+    const __m128d textureScale = _mm_set1_pd(parameters.textureScale);
+    
+    for (size_t lane = 0; lane < columns; lane += SSK_TILE_LAYOUT_LANES) {
+        __m128d column = _mm_add_pd(_mm_set1_pd((double)(firstColumn + lane)), laneOffsets);
+        __m128d x = _mm_mul_pd(column, textureSize);
+        __m128d width = _mm_min_pd(textureSize, _mm_sub_pd(size, x));
+        
+        _mm_storeu_pd(layout->x + index + lane, x);
+        _mm_storeu_pd(layout->width + index + lane, width);
+        _mm_storeu_pd(layout->textureX + index + lane, textureX);
+        _mm_storeu_pd(layout->textureWidth + index + lane, _mm_mul_pd(width, textureScale));
+    }
+#else
+    const double laneOffsetValues[] = {0, 1};
+    const float64x2_t laneOffsets = vld1q_f64(laneOffsetValues);
+    const float64x2_t size = vdupq_n_f64(parameters.size);
+    const float64x2_t textureSize = vdupq_n_f64(parameters.textureSize);
+    const float64x2_t textureX = vdupq_n_f64(parameters.textureX);
+    const float64x2_t textureScale = vdupq_n_f64(parameters.textureScale);
+    
+    for (size_t lane = 0; lane < columns; lane += SSK_TILE_LAYOUT_LANES) {
+        float64x2_t column = vaddq_f64(vdupq_n_f64((double)(firstColumn + lane)), laneOffsets);
+        float64x2_t x = vmulq_f64(column, textureSize);
+        float64x2_t width = vminq_f64(textureSize, vsubq_f64(size, x));
+        
+        vst1q_f64(layout->x + index + lane, x);
+        vst1q_f64(layout->width + index + lane, width);
+        vst1q_f64(layout->textureX + index + lane, textureX);
+        vst1q_f64(layout->textureWidth + index + lane, vmulq_f64(width, textureScale));
+    }
+#endif
+}
+
+#endif
+
+static bool SSKTileLayoutComputeWithRowKernel(SSKTileLayout *layout, const SSKTileGrid *grid, SSKTileRange range, SSKTileLayoutRowKernel rowKernel)
+{
+    layout->count = 0;
+    
+    if (range.column >= grid->columns || range.row >= grid->rows) {
+        return false;
+    }
+    
+    if (range.columns > grid->columns - range.column) {
+        range.columns = grid->columns - range.column;
+    }
+    
+    if (range.rows > grid->rows - range.row) {
+        range.rows = grid->rows - range.row;
+    }
+    
+    const size_t count = range.columns * range.rows;
+    
+    if (count == 0 || !SSKTileLayoutReserve(layout, count)) {
+        return false;
+    }
+    
+    const SSKTileSize textureSize = grid->textureSize;
+    const SSKTileRect textureRect = grid->textureRect;
+    const double textureHeightScale = textureRect.height / textureSize.height;
+    
+    SSKTileLayoutRowParameters rowParameters;
+    rowParameters.size = grid->size.width;
+    rowParameters.textureSize = textureSize.width;
+    rowParameters.textureX = textureRect.x;
+    rowParameters.textureScale = textureRect.width / textureSize.width;
+    
+    size_t index = 0;
+    
+    for (size_t row = range.row; row < range.row + range.rows; row++) {
+        rowKernel(layout, index, range.column, range.columns, rowParameters);
+        
+        const double y = textureSize.height * (double)row;
+        const double height = SSKTileGridGetTileLength(grid->size.height, textureSize.height, row);
+        const double textureHeight = height * textureHeightScale;
+        
+        for (size_t column = 0; column < range.columns; column++) {
+            layout->y[index + column] = y;
+            layout->height[index + column] = height;
+            layout->textureY[index + column] = textureRect.y;
+            layout->textureHeight[index + column] = textureHeight;
+        }
+        
+        index += range.columns;
+    }
+    
+    layout->count = count;
+    
+    return true;
+}
+
+#pragma mark - Tile layouts
+
+void SSKTileLayoutInit(SSKTileLayout *layout)
+{
+    layout->count = 0;
+    layout->capacity = 0;
+    layout->x = NULL;
+    layout->y = NULL;
+    layout->width = NULL;
+    layout->height = NULL;
+    layout->textureX = NULL;
+    layout->textureY = NULL;
+    layout->textureWidth = NULL;
+    layout->textureHeight = NULL;
+}
+
+void SSKTileLayoutDestroy(SSKTileLayout *layout)
+{
+    free(layout->x);
+    free(layout->y);
+    free(layout->width);
+    free(layout->height);
+    free(layout->textureX);
+    free(layout->textureY);
+    free(layout->textureWidth);
+    free(layout->textureHeight);
+    
+    SSKTileLayoutInit(layout);
+}
+
+bool SSKTileLayoutCompute(SSKTileLayout *layout, const SSKTileGrid *grid, SSKTileRange range)
+{
+#if SSK_TILE_LAYOUT_LANES > 1
+    return SSKTileLayoutComputeWithRowKernel(layout, grid, range, SSKTileLayoutComputeRowVectorized);
+#else
+    return SSKTileLayoutComputeWithRowKernel(layout, grid, range, SSKTileLayoutComputeRowScalar);
+#endif
+}
+
+bool SSKTileLayoutComputeScalar(SSKTileLayout *layout, const SSKTileGrid *grid, SSKTileRange range)
+{
+    return SSKTileLayoutComputeWithRowKernel(layout, grid, range, SSKTileLayoutComputeRowScalar);
+}
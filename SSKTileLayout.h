@@ -0,0 +1,183 @@
+#ifndef SSKTileLayout_h
+#define SSKTileLayout_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  A platform-agnostic size, used by the tile layout functions
+ */
+typedef struct {
+    double width;
+    double height;
+} SSKTileSize;
+
+/**
+ *  A platform-agnostic rect, used by the tile layout functions
+ */
+typedef struct {
+    double x;
+    double y;
+    double width;
+    double height;
+} SSKTileRect;
+
+/**
+ *  Struct describing how a texture gets tiled across a size
+ *
+ *  @discussion Tiles are laid out from the bottom left corner, in rows of columns.
+ *  Every tile has the size of the texture, except for the tiles in the last column
+ *  and row, which are cropped to fit within the grid's size.
+ */
+typedef struct {
+    SSKTileSize size;
+    SSKTileSize textureSize;
+    SSKTileRect textureRect;
+    size_t columns;
+    size_t rows;
+} SSKTileGrid;
+
+/**
+ *  Struct describing a rectangular range of tiles within a tile grid
+ */
+typedef struct {
+    size_t column;
+    size_t row;
+    size_t columns;
+    size_t rows;
+} SSKTileRange;
+
+/**
+ *  A flat, struct-of-arrays list of tiles
+ *
+ *  @discussion Each array has room for at least "capacity" elements, of which
+ *  the first "count" are valid. The tiles are stored in rows of columns, starting
+ *  at the bottom left tile of the range that the layout was computed for.
+ *
+ *  The texture rect arrays contain the rect of the (potentially cropped) texture
+ *  each tile should display, in the same unit coordinate space as the texture
+ *  rect of the grid the layout was computed for.
+ */
+typedef struct {
+    size_t count;
+    size_t capacity;
+    double *x;
+    double *y;
+    double *width;
+    double *height;
+    double *textureX;
+    double *textureY;
+    double *textureWidth;
+    double *textureHeight;
+} SSKTileLayout;
+
+#pragma mark - Tile grids
+
+/**
+ *  Create a tile grid
+ *
+ *  @param size The total size that should be tiled
+ *  @param textureSize The size of the texture to tile
+ *  @param textureRect The unit coordinate rect of the texture to tile
+ *
+ *  @discussion If any of the sizes are empty, the grid will contain no tiles.
+ */
+extern SSKTileGrid SSKTileGridMake(SSKTileSize size, SSKTileSize textureSize, SSKTileRect textureRect);
+
+/**
+ *  Get a range covering all tiles of a tile grid
+ */
+extern SSKTileRange SSKTileGridGetFullRange(const SSKTileGrid *grid);
+
+/**
+ *  Get the geometry of a single tile within a tile grid
+ *
+ *  @param grid The grid to get the tile from
+ *  @param column The column of the tile
+ *  @param row The row of the tile
+ *  @param rect Will be assigned the rect of the tile, relative to the grid's origin
+ *  @param textureRect Will be assigned the unit coordinate texture rect of the tile
+ */
+extern void SSKTileGridGetTile(const SSKTileGrid *grid, size_t column, size_t row, SSKTileRect *rect, SSKTileRect *textureRect);
+
+/**
+ *  Return whether a tile within a tile grid is cropped, that is, smaller than the texture
+ */
+extern bool SSKTileGridIsTileCropped(const SSKTileGrid *grid, size_t column, size_t row);
+
+#pragma mark - Tile ranges
+
+/**
+ *  Get the intersection of two tile ranges
+ *
+ *  @discussion If the ranges don't intersect, an empty range is returned.
+ */
+extern SSKTileRange SSKTileRangeGetIntersection(SSKTileRange range, SSKTileRange otherRange);
+
+/**
+ *  Subtract a tile range from another tile range
+ *
+ *  @param range The range to subtract from
+ *  @param subtractedRange The range to subtract
+ *  @param differences Will be filled with up to 4 non-overlapping ranges that
+ *  together cover all tiles in the range that are not in the subtracted range
+ *
+ *  @return The number of ranges written to the differences array
+ */
+extern size_t SSKTileRangeSubtract(SSKTileRange range, SSKTileRange subtractedRange, SSKTileRange differences[4]);
+
+/**
+ *  Return whether a tile range contains a tile
+ */
+static inline bool SSKTileRangeContainsTile(SSKTileRange range, size_t column, size_t row)
+{
+    return column >= range.column && column < range.column + range.columns &&
+           row >= range.row && row < range.row + range.rows;
+}
+
+#pragma mark - Tile layouts
+
+/**
+ *  Initialize an empty tile layout
+ */
+extern void SSKTileLayoutInit(SSKTileLayout *layout);
+
+/**
+ *  Free all memory used by a tile layout, and make it empty
+ */
+extern void SSKTileLayoutDestroy(SSKTileLayout *layout);
+
+/**
+ *  Compute the tiles of a range within a tile grid
+ *
+ *  @param layout The layout to write the tiles into. Its arrays will be grown as needed.
+ *  @param grid The grid to compute the tiles of
+ *  @param range The range of tiles to compute. The range is clamped to the grid.
+ *
+ *  @return Whether the layout contains any tiles. False is also returned if memory
+ *  for the layout could not be allocated.
+ *
+ *  @discussion Whole rows of tiles are computed at once using SIMD instructions when
+ *  available (AVX or SSE2 on x86, NEON on 64-bit ARM), with a scalar fallback.
+ */
+extern bool SSKTileLayoutCompute(SSKTileLayout *layout, const SSKTileGrid *grid, SSKTileRange range);
+
+/**
+ *  Compute the tiles of a range within a tile grid, without using SIMD instructions
+ *
+ *  @discussion Produces the same layout as SSKTileLayoutCompute. Useful as a reference
+ *  to verify & benchmark the vectorized version against.
+ */
+extern bool SSKTileLayoutComputeScalar(SSKTileLayout *layout, const SSKTileGrid *grid, SSKTileRange range);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,231 @@
+#include "SSKTileMesh.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#pragma mark - Utilities
+
+static bool SSKTileMeshReserve(SSKTileMesh *mesh, size_t vertexCapacity, size_t indexCapacity)
+{
+    if (mesh->vertexCapacity < vertexCapacity) {
+        size_t capacity = mesh->vertexCapacity * 2 > vertexCapacity ? mesh->vertexCapacity * 2 : vertexCapacity;
+        SSKTileMeshVertex *vertices = realloc(mesh->vertices, capacity * sizeof(SSKTileMeshVertex));
+        
+        if (!vertices) {
+            return false;
+        }
+        
+        mesh->vertices = vertices;
+        mesh->vertexCapacity = capacity;
+    }
+    
+    if (mesh->indexCapacity < indexCapacity) {
+        size_t capacity = mesh->indexCapacity * 2 > indexCapacity ? mesh->indexCapacity * 2 : indexCapacity;
+        uint32_t *indices = realloc(mesh->indices, capacity * sizeof(uint32_t));
+        
+        if (!indices) {
+            return false;
+        }
+        
+        mesh->indices = indices;
+        mesh->indexCapacity = capacity;
+    }
+    
+    return true;
+}
+
+static SSKTileMeshVertex SSKTileMeshVertexMake(double x, double y, double u, double v)
+{
+    SSKTileMeshVertex vertex;
+    vertex.x = (float)x;
+    vertex.y = (float)y;
+    vertex.u = (float)u;
+    vertex.v = (float)v;
+    
+    return vertex;
+}
+
+static double SSKTileMeshGetEdgeValue(const SSKTileMeshVertex *a, const SSKTileMeshVertex *b, double x, double y)
+{
+    return ((double)b->x - a->x) * (y - a->y) - ((double)b->y - a->y) * (x - a->x);
+}
+
+static bool SSKTileMeshEdgeIsTopLeft(const SSKTileMeshVertex *a, const SSKTileMeshVertex *b)
+{
+    if (a->y == b->y) {
+        return b->x < a->x;
+    }
+    
+    return b->y < a->y;
+}
+
+static bool SSKTileMeshEdgeContainsPoint(const SSKTileMeshVertex *a, const SSKTileMeshVertex *b, double edgeValue)
+{
+    if (edgeValue > 0) {
+        return true;
+    }
+    
+    return edgeValue == 0 && SSKTileMeshEdgeIsTopLeft(a, b);
+}
+
+static long SSKTileMeshClampPixel(double value, size_t count)
+{
+    if (value < 0) {
+        return 0;
+    }
+    
+    if (value > (double)count) {
+        return (long)count;
+    }
+    
+    return (long)value;
+}
+
+static void SSKTileMeshRasterizeTriangle(const SSKTileMeshVertex *a, const SSKTileMeshVertex *b, const SSKTileMeshVertex *c, const SSKTileImage *texture, SSKTileImage *target)
+{
+    const double area = SSKTileMeshGetEdgeValue(a, b, c->x, c->y);
+    
+    if (area <= 0) {
+        return;
+    }
+    
+    const double minX = fmin(a->x, fmin(b->x, c->x));
+    const double maxX = fmax(a->x, fmax(b->x, c->x));
+    const double minY = fmin(a->y, fmin(b->y, c->y));
+    const double maxY = fmax(a->y, fmax(b->y, c->y));
+    
+    const long startColumn = SSKTileMeshClampPixel(floor(minX), target->width);
+    const long endColumn = SSKTileMeshClampPixel(ceil(maxX), target->width);
+    const long startRow = SSKTileMeshClampPixel(floor(minY), target->height);
+    const long endRow = SSKTileMeshClampPixel(ceil(maxY), target->height);
+    
+    for (long row = startRow; row < endRow; row++) {
+        const double y = (double)row + 0.5;
+        
+        for (long column = startColumn; column < endColumn; column++) {
+            const double x = (double)column + 0.5;
+            
+            const double weightA = SSKTileMeshGetEdgeValue(b, c, x, y);
+            const double weightB = SSKTileMeshGetEdgeValue(c, a, x, y);
+            const double weightC = SSKTileMeshGetEdgeValue(a, b, x, y);
+            
+            if (!SSKTileMeshEdgeContainsPoint(b, c, weightA) ||
+                !SSKTileMeshEdgeContainsPoint(c, a, weightB) ||
+                !SSKTileMeshEdgeContainsPoint(a, b, weightC)) {
+                continue;
+            }
+            
+            const double u = (weightA * a->u + weightB * b->u + weightC * c->u) / area;
+            const double v = (weightA * a->v + weightB * b->v + weightC * c->v) / area;
+            
+            long texelColumn = SSKTileMeshClampPixel(floor(u * (double)texture->width), texture->width - 1);
+            long texelRow = SSKTileMeshClampPixel(floor(v * (double)texture->height), texture->height - 1);
+            
+            target->pixels[(size_t)row * target->width + (size_t)column] = texture->pixels[(size_t)texelRow * texture->width + (size_t)texelColumn];
+        }
+    }
+}
+
+#pragma mark - Tile meshes
+
+void SSKTileMeshInit(SSKTileMesh *mesh)
+{
+    mesh->vertexCount = 0;
+    mesh->vertexCapacity = 0;
+    mesh->vertices = NULL;
+    mesh->indexCount = 0;
+    mesh->indexCapacity = 0;
+    mesh->indices = NULL;
+}
+
+void SSKTileMeshDestroy(SSKTileMesh *mesh)
+{
+    free(mesh->vertices);
+    free(mesh->indices);
+    
+    SSKTileMeshInit(mesh);
+}
+
+void SSKTileMeshRemoveAllQuads(SSKTileMesh *mesh)
+{
+    mesh->vertexCount = 0;
+    mesh->indexCount = 0;
+}
+
+bool SSKTileMeshAppendQuad(SSKTileMesh *mesh, SSKTileRect rect, SSKTileRect textureRect)
+{
+    if (!SSKTileMeshReserve(mesh, mesh->vertexCount + 4, mesh->indexCount + 6)) {
+        return false;
+    }
+    
+    const double maxX = rect.x + rect.width;
+    const double maxY = rect.y + rect.height;
+    const double maxU = textureRect.x + textureRect.width;
+    const double maxV = textureRect.y + textureRect.height;
+    
+    SSKTileMeshVertex *vertices = mesh->vertices + mesh->vertexCount;
+    vertices[0] = SSKTileMeshVertexMake(rect.x, rect.y, textureRect.x, textureRect.y);
+    vertices[1] = SSKTileMeshVertexMake(maxX, rect.y, maxU, textureRect.y);
+    vertices[2] = SSKTileMeshVertexMake(maxX, maxY, maxU, maxV);
+    vertices[3] = SSKTileMeshVertexMake(rect.x, maxY, textureRect.x, maxV);
+    
+    const uint32_t firstVertex = (uint32_t)mesh->vertexCount;
+    const uint32_t quadIndices[] = {0, 1, 2, 0, 2, 3};
+    
+    for (size_t index = 0; index < 6; index++) {
+        mesh->indices[mesh->indexCount + index] = firstVertex + quadIndices[index];
+    }
+    
+    mesh->vertexCount += 4;
+    mesh->indexCount += 6;
+    
+    return true;
+}
+
+bool SSKTileMeshBuild(SSKTileMesh *mesh, const SSKTileGrid *grid, SSKTileLayout *layout)
+{
+    SSKTileMeshRemoveAllQuads(mesh);
+    
+    if (!SSKTileLayoutCompute(layout, grid, SSKTileGridGetFullRange(grid))) {
+        return false;
+    }
+    
+    if (!SSKTileMeshReserve(mesh, layout->count * 4, layout->count * 6)) {
+        return false;
+    }
+    
+    for (size_t tileIndex = 0; tileIndex < layout->count; tileIndex++) {
+        SSKTileRect rect;
+        rect.x = layout->x[tileIndex];
+        rect.y = layout->y[tileIndex];
+        rect.width = layout->width[tileIndex];
+        rect.height = layout->height[tileIndex];
+        
+        SSKTileRect textureRect;
+        textureRect.x = layout->textureX[tileIndex];
+        textureRect.y = layout->textureY[tileIndex];
+        textureRect.width = layout->textureWidth[tileIndex];
+        textureRect.height = layout->textureHeight[tileIndex];
+        
+        SSKTileMeshAppendQuad(mesh, rect, textureRect);
+    }
+    
+    return true;
+}
+
+#pragma mark - Reference rasterizer
+
+void SSKTileMeshRasterize(const SSKTileMesh *mesh, const SSKTileImage *texture, SSKTileImage *target)
+{
+    if (texture->width == 0 || texture->height == 0) {
+        return;
+    }
+    
+    for (size_t index = 0; index + 2 < mesh->indexCount; index += 3) {
+        SSKTileMeshRasterizeTriangle(&mesh->vertices[mesh->indices[index]],
+                                     &mesh->vertices[mesh->indices[index + 1]],
+                                     &mesh->vertices[mesh->indices[index + 2]],
+                                     texture,
+                                     target);
+    }
+}
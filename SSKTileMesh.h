@@ -0,0 +1,118 @@
+#ifndef SSKTileMesh_h
+#define SSKTileMesh_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SSKTileLayout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  A single vertex of a tile mesh, with interleaved position & texture coordinates
+ *
+ *  @discussion Positions use the same coordinate space as the tile grid the mesh was
+ *  built from, and texture coordinates use the unit coordinate space of its texture rect.
+ */
+typedef struct {
+    float x;
+    float y;
+    float u;
+    float v;
+} SSKTileMeshVertex;
+
+/**
+ *  An interleaved vertex buffer and a triangle list index buffer, describing
+ *  any number of textured quads
+ *
+ *  @discussion Every quad uses 4 vertices (bottom left, bottom right, top right,
+ *  top left) and 6 indices (two counter-clockwise triangles).
+ */
+typedef struct {
+    size_t vertexCount;
+    size_t vertexCapacity;
+    SSKTileMeshVertex *vertices;
+    size_t indexCount;
+    size_t indexCapacity;
+    uint32_t *indices;
+} SSKTileMesh;
+
+/**
+ *  A 32-bit RGBA image, used by the reference rasterizer
+ *
+ *  @discussion Rows are stored bottom-up, to match SpriteKit's coordinate space.
+ *  That is, the first row of pixels is the one at y = 0.
+ */
+typedef struct {
+    size_t width;
+    size_t height;
+    uint32_t *pixels;
+} SSKTileImage;
+
+#pragma mark - Tile meshes
+
+/**
+ *  Initialize an empty tile mesh
+ */
+extern void SSKTileMeshInit(SSKTileMesh *mesh);
+
+/**
+ *  Free all memory used by a tile mesh, and make it empty
+ */
+extern void SSKTileMeshDestroy(SSKTileMesh *mesh);
+
+/**
+ *  Remove all quads from a tile mesh, without freeing its memory
+ */
+extern void SSKTileMeshRemoveAllQuads(SSKTileMesh *mesh);
+
+/**
+ *  Append a textured quad to a tile mesh
+ *
+ *  @param mesh The mesh to append the quad to
+ *  @param rect The rect the quad should cover
+ *  @param textureRect The unit coordinate texture rect to map onto the quad
+ *
+ *  @return Whether the quad could be appended. False is returned if memory
+ *  for the mesh could not be allocated.
+ */
+extern bool SSKTileMeshAppendQuad(SSKTileMesh *mesh, SSKTileRect rect, SSKTileRect textureRect);
+
+/**
+ *  Build a tile mesh containing one quad for every tile in a tile grid
+ *
+ *  @param mesh The mesh to build. Any existing quads will be removed.
+ *  @param grid The grid to build the mesh from
+ *  @param layout A layout used as scratch memory while building the mesh.
+ *  Pass the same layout across calls to avoid reallocating it.
+ *
+ *  @return Whether the mesh contains any quads
+ */
+extern bool SSKTileMeshBuild(SSKTileMesh *mesh, const SSKTileGrid *grid, SSKTileLayout *layout);
+
+#pragma mark - Reference rasterizer
+
+/**
+ *  Rasterize a tile mesh into an image, using nearest-neighbor texture sampling
+ *
+ *  @param mesh The mesh to rasterize
+ *  @param texture The texture to sample
+ *  @param target The image to draw into. Each pixel covered by a triangle is overwritten.
+ *
+ *  @discussion This rasterizer is meant as a slow, but exact reference to verify batched
+ *  geometry against, for example to check that a tile mesh produces the same pixels as
+ *  drawing every tile individually. A pixel is covered by a triangle if its center is
+ *  inside the triangle, following the top-left fill rule for pixels on an edge.
+ */
+extern void SSKTileMeshRasterize(const SSKTileMesh *mesh, const SSKTileImage *texture, SSKTileImage *target);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,9 +1,23 @@
 #import <SpriteKit/SpriteKit.h>
+#import "SSKTileLayout.h"
+#import "SSKTileMesh.h"
+#import "SSKTextureRegionCache.h"
+#import "SSKLayoutPass.h"
+#import "SSKTweenEngine.h"
 
 /**
  *  A node capable of seamlessly tiling its texture according to its size
+ *
+ *  @discussion This class depends on SSKTileLayout, which performs all of
+ *  the tiling math without depending on SpriteKit, and SSKTileMesh, which
+ *  builds the node's batched geometry. Cropped tile textures are shared
+ *  through SSKTextureRegionCache.
+ *
+ *  Changes to the node's size, texture & visible rect are laid out through the shared
+ *  SSKLayoutPass. When the pass is deferred, the node's tiles (and batched geometry)
+ *  are only updated once the pass is performed, or -layoutIfNeeded is called.
  */
-@interface SSKTileableNode : SKNode
+@interface SSKTileableNode : SKNode <SSKLayoutPassNode, SSKTweenResizable>
 
 /**
  *  The current size of the node
@@ -37,6 +51,58 @@
  */
 @property (nonatomic) CGFloat colorBlendFactor;
 
+/**
+ *  The rect (in the node's coordinate space) that is currently visible
+ *
+ *  @discussion The default is CGRectNull, meaning that the node will create
+ *  tiles covering its whole size. When set to any other rect, the node will
+ *  only keep the tiles that intersect that rect (expanded by visibleRectMargin),
+ *  which makes node count & memory usage depend on the size of the screen rather
+ *  than on the size of the node. Tiles that leave the visible rect are recycled
+ *  for tiles that enter it.
+ *
+ *  Update this property whenever the camera or viewport moves, for example by
+ *  converting the visible part of the scene into the node's coordinate space.
+ *  This property has no effect when batchesTiles is set to YES.
+ */
+@property (nonatomic) CGRect visibleRect;
+
+/**
+ *  The margin to expand the visible rect by when determining which tiles to keep
+ *
+ *  @discussion The default is 0. A margin of about one tile avoids tiles popping
+ *  in at the edges of the screen when the visible rect moves quickly.
+ */
+@property (nonatomic) CGFloat visibleRectMargin;
+
+/**
+ *  Whether the node should batch all of its tiles into a single mesh
+ *
+ *  @discussion The default is NO, meaning that the node will create a sprite node
+ *  for each of its tiles. When set to YES, the node won't create any sprite nodes,
+ *  and instead builds a single interleaved vertex buffer and index buffer covering
+ *  its whole size, which can be handed off to a custom renderer.
+ *
+ *  See SSKTileMesh for the layout of the buffers.
+ */
+@property (nonatomic) BOOL batchesTiles;
+
+/**
+ *  The vertex buffer of the node's batched mesh
+ *
+ *  @discussion Contains tightly packed SSKTileMeshVertex structs, in the node's
+ *  coordinate space. This is nil unless batchesTiles is set to YES.
+ */
+@property (nonatomic, strong, readonly) NSData *batchedVertexData;
+
+/**
+ *  The index buffer of the node's batched mesh
+ *
+ *  @discussion Contains tightly packed uint32_t indices, describing a list of
+ *  triangles. This is nil unless batchesTiles is set to YES.
+ */
+@property (nonatomic, strong, readonly) NSData *batchedIndexData;
+
 /**
  *  Allocate and initialize a new instance of SSKTileableNode
  *
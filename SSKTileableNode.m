@@ -1,14 +1,48 @@
 #import "SSKTileableNode.h"
 
-static CGFloat SSKTileableNodeNoResizing = -9999;
+static SSKTileSize SSKTileableNodeGetTileSize(CGSize size)
+{
+    SSKTileSize tileSize;
+    tileSize.width = size.width;
+    tileSize.height = size.height;
+    
+    return tileSize;
+}
+
+static SSKTileRect SSKTileableNodeGetTileRect(CGRect rect)
+{
+    SSKTileRect tileRect;
+    tileRect.x = rect.origin.x;
+    tileRect.y = rect.origin.y;
+    tileRect.width = rect.size.width;
+    tileRect.height = rect.size.height;
+    
+    return tileRect;
+}
+
+static NSNumber *SSKTileableNodeGetTileKey(size_t column, size_t row)
+{
+    return @(((unsigned long long)row << 32) | (unsigned long long)column);
+}
 
 @interface SSKTileableNode()
 
-@property (nonatomic, strong) NSMutableArray *partNodes;
+@property (nonatomic, strong) NSMutableDictionary *partNodes;
+@property (nonatomic, strong) NSMutableArray *reusablePartNodes;
+@property (nonatomic, strong, readwrite) NSData *batchedVertexData;
+@property (nonatomic, strong, readwrite) NSData *batchedIndexData;
+@property (nonatomic) BOOL needsLayout;
+@property (nonatomic) BOOL needsRedraw;
 
 @end
 
 @implementation SSKTileableNode
+{
+    SSKTileLayout _layout;
+    SSKTileMesh _mesh;
+    SSKTileGrid _grid;
+    SSKTileRange _tileRange;
+}
 
 + (instancetype)tileableNodeWithSize:(CGSize)size imageNamed:(NSString *)imageName
 {
@@ -27,64 +61,278 @@ static CGFloat SSKTileableNodeNoResizing = -9999;
     }
     
     SSKTileableNode *node = [self node];
-    node.partNodes = [NSMutableArray new];
+    node.partNodes = [NSMutableDictionary new];
+    node.reusablePartNodes = [NSMutableArray new];
     node.texture = texture;
     node.size = size;
     
     return node;
 }
 
+- (id)init
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    _visibleRect = CGRectNull;
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    SSKTileLayoutDestroy(&_layout);
+    SSKTileMeshDestroy(&_mesh);
+}
+
+#pragma mark - SSKLayoutPassNode
+
+- (void)setNeedsLayout
+{
+    self.needsLayout = YES;
+    
+    [[SSKLayoutPass sharedPass] scheduleNode:self];
+}
+
+- (void)layoutIfNeeded
+{
+    if (!self.needsLayout) {
+        return;
+    }
+    
+    self.needsLayout = NO;
+    
+    if (self.needsRedraw) {
+        [self drawPartNodes];
+    } else {
+        [self updatePartNodes];
+    }
+}
+
+#pragma mark - Utilities
+
+- (void)setNeedsRedraw
+{
+    self.needsRedraw = YES;
+    
+    [self setNeedsLayout];
+}
+
+- (SSKTileGrid)currentGrid
+{
+    return SSKTileGridMake(SSKTileableNodeGetTileSize(self.size),
+                           SSKTileableNodeGetTileSize(self.texture.size),
+                           SSKTileableNodeGetTileRect(self.texture.textureRect));
+}
+
+- (SSKTileRange)currentTileRange
+{
+    SSKTileRange fullRange = SSKTileGridGetFullRange(&_grid);
+    
+    if (CGRectIsNull(self.visibleRect) || fullRange.columns == 0) {
+        return fullRange;
+    }
+    
+    CGRect visibleRect = CGRectInset(self.visibleRect, -self.visibleRectMargin, -self.visibleRectMargin);
+    visibleRect = CGRectIntersection(visibleRect, CGRectMake(0, 0, _grid.size.width, _grid.size.height));
+    
+    if (CGRectIsNull(visibleRect)) {
+        return (SSKTileRange){0, 0, 0, 0};
+    }
+    
+    const CGSize textureSize = CGSizeMake(_grid.textureSize.width, _grid.textureSize.height);
+    
+    SSKTileRange visibleRange;
+    visibleRange.column = (size_t)floor(CGRectGetMinX(visibleRect) / textureSize.width);
+    visibleRange.row = (size_t)floor(CGRectGetMinY(visibleRect) / textureSize.height);
+    visibleRange.columns = (size_t)ceil(CGRectGetMaxX(visibleRect) / textureSize.width) - visibleRange.column;
+    visibleRange.rows = (size_t)ceil(CGRectGetMaxY(visibleRect) / textureSize.height) - visibleRange.row;
+    
+    return SSKTileRangeGetIntersection(fullRange, visibleRange);
+}
+
 - (void)drawPartNodes
 {
-    [self.partNodes makeObjectsPerformSelector:@selector(removeFromParent)];
+    self.needsRedraw = NO;
+    
+    [[self.partNodes allValues] makeObjectsPerformSelector:@selector(removeFromParent)];
     [self.partNodes removeAllObjects];
+    [self.reusablePartNodes removeAllObjects];
+    
+    _grid = [self currentGrid];
     
-    if (self.size.width <= 0 || self.size.height <= 0) {
+    if (self.batchesTiles) {
+        _tileRange = (SSKTileRange){0, 0, 0, 0};
+        [self buildBatchedMesh];
+        
         return;
     }
     
-    const CGSize textureSize = self.texture.size;
+    _tileRange = [self currentTileRange];
     
-    CGPoint drawPoint = CGPointZero;
+    [self addPartNodesInRange:_tileRange];
+}
+
+- (void)updatePartNodes
+{
+    SSKTileGrid grid = [self currentGrid];
     
-    while (true) {
-        CGSize tileSize;
-        tileSize.width = MIN(self.size.width - drawPoint.x, textureSize.width);
-        tileSize.height = MIN(self.size.height - drawPoint.y, textureSize.height);
+    if (self.batchesTiles) {
+        _grid = grid;
+        [self buildBatchedMesh];
         
-        SKTexture *tileTexture;
+        return;
+    }
+    
+    if (grid.textureSize.width != _grid.textureSize.width || grid.textureSize.height != _grid.textureSize.height) {
+        [self drawPartNodes];
+        return;
+    }
+    
+    SSKTileGrid previousGrid = _grid;
+    SSKTileRange previousTileRange = _tileRange;
+    
+    _grid = grid;
+    _tileRange = [self currentTileRange];
+    
+    SSKTileRange differences[4];
+    size_t numberOfDifferences = SSKTileRangeSubtract(previousTileRange, _tileRange, differences);
+    
+    for (size_t differenceIndex = 0; differenceIndex < numberOfDifferences; differenceIndex++) {
+        [self removePartNodesInRange:differences[differenceIndex]];
+    }
+    
+    SSKTileRange keptTileRange = SSKTileRangeGetIntersection(previousTileRange, _tileRange);
+    
+    const size_t trailingColumns[] = {previousGrid.columns - 1, grid.columns - 1};
+    const size_t trailingRows[] = {previousGrid.rows - 1, grid.rows - 1};
+    
+    for (size_t trailingIndex = 0; trailingIndex < 2; trailingIndex++) {
+        for (size_t row = keptTileRange.row; row < keptTileRange.row + keptTileRange.rows; row++) {
+            [self updatePartNodeAtColumn:trailingColumns[trailingIndex] row:row inRange:keptTileRange];
+        }
         
-        if (tileSize.width < textureSize.width || tileSize.height < textureSize.height) {
-            CGRect textureRect = self.texture.textureRect;
-            textureRect.size.width *= tileSize.width / textureSize.width;
-            textureRect.size.height *= tileSize.height / textureSize.height;
-            
-            tileTexture = [SKTexture textureWithRect:textureRect inTexture:self.texture];
+        for (size_t column = keptTileRange.column; column < keptTileRange.column + keptTileRange.columns; column++) {
+            [self updatePartNodeAtColumn:column row:trailingRows[trailingIndex] inRange:keptTileRange];
+        }
+    }
+    
+    numberOfDifferences = SSKTileRangeSubtract(_tileRange, previousTileRange, differences);
+    
+    for (size_t differenceIndex = 0; differenceIndex < numberOfDifferences; differenceIndex++) {
+        [self addPartNodesInRange:differences[differenceIndex]];
+    }
+}
+
+- (void)addPartNodesInRange:(SSKTileRange)range
+{
+    if (!SSKTileLayoutCompute(&_layout, &_grid, range)) {
+        return;
+    }
+    
+    for (size_t tileIndex = 0; tileIndex < _layout.count; tileIndex++) {
+        CGRect tileRect = CGRectMake(_layout.x[tileIndex],
+                                     _layout.y[tileIndex],
+                                     _layout.width[tileIndex],
+                                     _layout.height[tileIndex]);
+        
+        CGRect textureRect = CGRectMake(_layout.textureX[tileIndex],
+                                        _layout.textureY[tileIndex],
+                                        _layout.textureWidth[tileIndex],
+                                        _layout.textureHeight[tileIndex]);
+        
+        SKTexture *tileTexture = [self textureForTileWithRect:tileRect textureRect:textureRect];
+        SKSpriteNode *tileNode = [self.reusablePartNodes lastObject];
+        
+        if (tileNode) {
+            [self.reusablePartNodes removeLastObject];
+            tileNode.texture = tileTexture;
         } else {
-            tileTexture = self.texture;
+            tileNode = [SKSpriteNode spriteNodeWithTexture:tileTexture];
+            tileNode.anchorPoint = CGPointZero;
         }
         
-        SKSpriteNode *tileNode = [SKSpriteNode spriteNodeWithTexture:tileTexture];
-        tileNode.anchorPoint = CGPointZero;
-        tileNode.position = drawPoint;
-        tileNode.size = tileSize;
+        tileNode.position = tileRect.origin;
+        tileNode.size = tileRect.size;
+        tileNode.colorBlendFactor = self.colorBlendFactor;
         
-        [self addChild:tileNode];
-        [self.partNodes addObject:tileNode];
+        if (self.color) {
+            tileNode.color = self.color;
+        }
         
-        drawPoint.x += tileSize.width;
+        size_t column = range.column + tileIndex % range.columns;
+        size_t row = range.row + tileIndex / range.columns;
         
-        if (drawPoint.x >= self.size.width) {
-            drawPoint.x = 0;
-            drawPoint.y += tileSize.height;
+        [self addChild:tileNode];
+        [self.partNodes setObject:tileNode forKey:SSKTileableNodeGetTileKey(column, row)];
+    }
+}
+
+- (void)removePartNodesInRange:(SSKTileRange)range
+{
+    for (size_t row = range.row; row < range.row + range.rows; row++) {
+        for (size_t column = range.column; column < range.column + range.columns; column++) {
+            NSNumber *tileKey = SSKTileableNodeGetTileKey(column, row);
+            SKSpriteNode *tileNode = [self.partNodes objectForKey:tileKey];
             
-            if (drawPoint.y >= self.size.height) {
-                break;
+            [tileNode removeFromParent];
+            [self.partNodes removeObjectForKey:tileKey];
+            
+            if (tileNode && !CGRectIsNull(self.visibleRect)) {
+                [self.reusablePartNodes addObject:tileNode];
             }
         }
     }
 }
 
+- (void)updatePartNodeAtColumn:(size_t)column row:(size_t)row inRange:(SSKTileRange)range
+{
+    if (!SSKTileRangeContainsTile(range, column, row)) {
+        return;
+    }
+    
+    SKSpriteNode *tileNode = [self.partNodes objectForKey:SSKTileableNodeGetTileKey(column, row)];
+    
+    SSKTileRect tileRect;
+    SSKTileRect textureRect;
+    SSKTileGridGetTile(&_grid, column, row, &tileRect, &textureRect);
+    
+    CGSize tileSize = CGSizeMake(tileRect.width, tileRect.height);
+    
+    if (CGSizeEqualToSize(tileNode.size, tileSize)) {
+        return;
+    }
+    
+    tileNode.texture = [self textureForTileWithRect:CGRectMake(tileRect.x, tileRect.y, tileSize.width, tileSize.height)
+                                        textureRect:CGRectMake(textureRect.x, textureRect.y, textureRect.width, textureRect.height)];
+    tileNode.size = tileSize;
+}
+
+- (void)buildBatchedMesh
+{
+    if (!SSKTileMeshBuild(&_mesh, &_grid, &_layout)) {
+        self.batchedVertexData = [NSData data];
+        self.batchedIndexData = [NSData data];
+        
+        return;
+    }
+    
+    self.batchedVertexData = [NSData dataWithBytes:_mesh.vertices length:_mesh.vertexCount * sizeof(SSKTileMeshVertex)];
+    self.batchedIndexData = [NSData dataWithBytes:_mesh.indices length:_mesh.indexCount * sizeof(uint32_t)];
+}
+
+- (SKTexture *)textureForTileWithRect:(CGRect)tileRect textureRect:(CGRect)textureRect
+{
+    const CGSize textureSize = self.texture.size;
+    
+    if (tileRect.size.width < textureSize.width || tileRect.size.height < textureSize.height) {
+        return [[SSKTextureRegionCache sharedCache] textureWithRect:textureRect inTexture:self.texture];
+    }
+    
+    return self.texture;
+}
+
 #pragma mark - Accessor overrides
 
 - (void)setSize:(CGSize)size
@@ -95,7 +343,7 @@ static CGFloat SSKTileableNodeNoResizing = -9999;
     
     _size = size;
     
-    [self drawPartNodes];
+    [self setNeedsLayout];
 }
 
 - (void)setTexture:(SKTexture *)texture
@@ -106,7 +354,50 @@ static CGFloat SSKTileableNodeNoResizing = -9999;
     
     _texture = texture;
     
-    [self drawPartNodes];
+    [self setNeedsRedraw];
+}
+
+- (void)setVisibleRect:(CGRect)visibleRect
+{
+    if (CGRectEqualToRect(_visibleRect, visibleRect)) {
+        return;
+    }
+    
+    _visibleRect = visibleRect;
+    
+    if (CGRectIsNull(visibleRect)) {
+        [self.reusablePartNodes removeAllObjects];
+    }
+    
+    [self setNeedsLayout];
+}
+
+- (void)setVisibleRectMargin:(CGFloat)visibleRectMargin
+{
+    if (_visibleRectMargin == visibleRectMargin) {
+        return;
+    }
+    
+    _visibleRectMargin = visibleRectMargin;
+    
+    [self setNeedsLayout];
+}
+
+- (void)setBatchesTiles:(BOOL)batchesTiles
+{
+    if (_batchesTiles == batchesTiles) {
+        return;
+    }
+    
+    _batchesTiles = batchesTiles;
+    
+    if (!batchesTiles) {
+        SSKTileMeshDestroy(&_mesh);
+        self.batchedVertexData = nil;
+        self.batchedIndexData = nil;
+    }
+    
+    [self setNeedsRedraw];
 }
 
 - (void)setColor:(SKColor *)color
@@ -117,7 +408,11 @@ static CGFloat SSKTileableNodeNoResizing = -9999;
     
     _color = color;
     
-    for (SSKTileableNode *partNode in self.partNodes) {
+    for (SKSpriteNode *partNode in [self.partNodes objectEnumerator]) {
+        partNode.color = color;
+    }
+    
+    for (SKSpriteNode *partNode in self.reusablePartNodes) {
         partNode.color = color;
     }
 }
@@ -130,7 +425,11 @@ static CGFloat SSKTileableNodeNoResizing = -9999;
     
     _colorBlendFactor = colorBlendFactor;
     
-    for (SSKTileableNode *partNode in self.partNodes) {
+    for (SKSpriteNode *partNode in [self.partNodes objectEnumerator]) {
+        partNode.colorBlendFactor = colorBlendFactor;
+    }
+    
+    for (SKSpriteNode *partNode in self.reusablePartNodes) {
         partNode.colorBlendFactor = colorBlendFactor;
     }
 }
@@ -144,38 +443,23 @@ static CGFloat SSKTileableNodeNoResizing = -9999;
 + (SKAction *)resizeTileableNodeToWidth:(CGFloat)width duration:(NSTimeInterval)duration
 {
     return [SKAction resizeTileableNodeToWidth:width
-                                           height:SSKTileableNodeNoResizing
+                                           height:NAN
                                          duration:duration];
 }
 
 + (SKAction *)resizeTileableNodeToHeight:(CGFloat)height duration:(NSTimeInterval)duration
 {
-    return [SKAction resizeTileableNodeToWidth:SSKTileableNodeNoResizing
+    return [SKAction resizeTileableNodeToWidth:NAN
                                            height:height
                                          duration:duration];
 }
 
 + (SKAction *)resizeTileableNodeToWidth:(CGFloat)width height:(CGFloat)height duration:(NSTimeInterval)duration
 {
-    return [SKAction customActionWithDuration:duration actionBlock:^(SKNode *node, CGFloat elapsedTime) {
-        if (![node isKindOfClass:[SSKTileableNode class]]) {
-            return;
-        }
-        
-        CGFloat percentageComplete = elapsedTime / duration;
-        SSKTileableNode *tileableNode = (SSKTileableNode *)node;
-        CGSize nodeSize = tileableNode.size;
-        
-        if (width != SSKTileableNodeNoResizing) {
-            nodeSize.width += (width - nodeSize.width) * percentageComplete;
-        }
-        
-        if (height != SSKTileableNodeNoResizing) {
-            nodeSize.height += (height - nodeSize.height) * percentageComplete;
-        }
-        
-        tileableNode.size = nodeSize;
-    }];
+    return [SSKTweenEngine resizeActionToWidth:width
+                                        height:height
+                                      duration:duration
+                                        easing:SSKTweenEasingLinear];
 }
 
 @end
@@ -0,0 +1,300 @@
+#include "SSKTilemap.h"
+
+#include <stdlib.h>
+
+#pragma mark - Utilities
+
+static size_t SSKTilemapGetMinimum(size_t value, size_t otherValue)
+{
+    return value < otherValue ? value : otherValue;
+}
+
+static bool SSKTilemapChunkGeometryReserve(SSKTilemapChunkGeometry *geometry, size_t count)
+{
+    if (count <= geometry->capacity) {
+        return true;
+    }
+    
+    size_t capacity = geometry->capacity > 0 ? geometry->capacity : 64;
+    
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    
+    SSKTileID *tileIDs = realloc(geometry->tileIDs, capacity * sizeof(SSKTileID));
+    
+    if (tileIDs) {
+        geometry->tileIDs = tileIDs;
+    }
+    
+    SSKTileRect *rects = realloc(geometry->rects, capacity * sizeof(SSKTileRect));
+    
+    if (rects) {
+        geometry->rects = rects;
+    }
+    
+    SSKTileRect *textureRects = realloc(geometry->textureRects, capacity * sizeof(SSKTileRect));
+    
+    if (textureRects) {
+        geometry->textureRects = textureRects;
+    }
+    
+    bool *isCropped = realloc(geometry->isCropped, capacity * sizeof(bool));
+    
+    if (isCropped) {
+        geometry->isCropped = isCropped;
+    }
+    
+    // The arrays that could be grown are kept, but the capacity is only raised once all of them are
+    if (!tileIDs || !rects || !textureRects || !isCropped) {
+        return false;
+    }
+    
+    geometry->capacity = capacity;
+    
+    return true;
+}
+
+#pragma mark - Tilemaps
+
+bool SSKTilemapInit(SSKTilemap *tilemap, size_t columns, size_t rows, size_t chunkSize)
+{
+    tilemap->columns = 0;
+    tilemap->rows = 0;
+    tilemap->chunkSize = chunkSize;
+    tilemap->chunkColumns = 0;
+    tilemap->chunkRows = 0;
+    tilemap->tileIDs = NULL;
+    tilemap->chunkIsDirty = NULL;
+    tilemap->dirtyChunkCount = 0;
+    tilemap->dirtyChunks = NULL;
+    
+    if (chunkSize == 0) {
+        return false;
+    }
+    
+    const size_t chunkColumns = (columns + chunkSize - 1) / chunkSize;
+    const size_t chunkRows = (rows + chunkSize - 1) / chunkSize;
+    const size_t chunkCount = chunkColumns * chunkRows;
+    
+    // Allocating at least one element of each array, so that an empty tilemap is still a valid one
+    tilemap->tileIDs = calloc(columns * rows > 0 ? columns * rows : 1, sizeof(SSKTileID));
+    tilemap->chunkIsDirty = calloc(chunkCount > 0 ? chunkCount : 1, sizeof(bool));
+    tilemap->dirtyChunks = malloc((chunkCount > 0 ? chunkCount : 1) * sizeof(size_t));
+    
+    if (!tilemap->tileIDs || !tilemap->chunkIsDirty || !tilemap->dirtyChunks) {
+        SSKTilemapDestroy(tilemap);
+        tilemap->chunkSize = chunkSize;
+        
+        return false;
+    }
+    
+    tilemap->columns = columns;
+    tilemap->rows = rows;
+    tilemap->chunkColumns = chunkColumns;
+    tilemap->chunkRows = chunkRows;
+    
+    return true;
+}
+
+void SSKTilemapDestroy(SSKTilemap *tilemap)
+{
+    free(tilemap->tileIDs);
+    free(tilemap->chunkIsDirty);
+    free(tilemap->dirtyChunks);
+    
+    tilemap->columns = 0;
+    tilemap->rows = 0;
+    tilemap->chunkColumns = 0;
+    tilemap->chunkRows = 0;
+    tilemap->tileIDs = NULL;
+    tilemap->chunkIsDirty = NULL;
+    tilemap->dirtyChunkCount = 0;
+    tilemap->dirtyChunks = NULL;
+}
+
+SSKTileID SSKTilemapGetTileID(const SSKTilemap *tilemap, size_t column, size_t row)
+{
+    if (column >= tilemap->columns || row >= tilemap->rows) {
+        return 0;
+    }
+    
+    return tilemap->tileIDs[row * tilemap->columns + column];
+}
+
+size_t SSKTilemapFill(SSKTilemap *tilemap, SSKTileID tileID, size_t column, size_t row, size_t columns, size_t rows)
+{
+    if (column >= tilemap->columns || row >= tilemap->rows) {
+        return 0;
+    }
+    
+    const size_t maxColumn = column + SSKTilemapGetMinimum(columns, tilemap->columns - column);
+    const size_t maxRow = row + SSKTilemapGetMinimum(rows, tilemap->rows - row);
+    size_t changedCount = 0;
+    
+    for (size_t tileRow = row; tileRow < maxRow; tileRow++) {
+        SSKTileID *rowTileIDs = tilemap->tileIDs + tileRow * tilemap->columns;
+        const size_t chunkRow = tileRow / tilemap->chunkSize;
+        
+        // The row is filled one chunk at a time, so that each chunk is only marked once per row
+        for (size_t spanStart = column; spanStart < maxColumn;) {
+            const size_t chunkColumn = spanStart / tilemap->chunkSize;
+            const size_t spanEnd = SSKTilemapGetMinimum((chunkColumn + 1) * tilemap->chunkSize, maxColumn);
+            size_t spanChangedCount = 0;
+            
+            for (size_t tileColumn = spanStart; tileColumn < spanEnd; tileColumn++) {
+                spanChangedCount += rowTileIDs[tileColumn] != tileID;
+                rowTileIDs[tileColumn] = tileID;
+            }
+            
+            if (spanChangedCount > 0) {
+                SSKTilemapSetChunkDirty(tilemap, chunkRow * tilemap->chunkColumns + chunkColumn);
+                changedCount += spanChangedCount;
+            }
+            
+            spanStart = spanEnd;
+        }
+    }
+    
+    return changedCount;
+}
+
+void SSKTilemapSetChunkDirty(SSKTilemap *tilemap, size_t chunkIndex)
+{
+    if (chunkIndex >= tilemap->chunkColumns * tilemap->chunkRows || tilemap->chunkIsDirty[chunkIndex]) {
+        return;
+    }
+    
+    tilemap->chunkIsDirty[chunkIndex] = true;
+    tilemap->dirtyChunks[tilemap->dirtyChunkCount] = chunkIndex;
+    tilemap->dirtyChunkCount++;
+}
+
+void SSKTilemapSetAllChunksDirty(SSKTilemap *tilemap)
+{
+    const size_t chunkCount = tilemap->chunkColumns * tilemap->chunkRows;
+    
+    for (size_t chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++) {
+        SSKTilemapSetChunkDirty(tilemap, chunkIndex);
+    }
+}
+
+void SSKTilemapRemoveAllDirtyChunks(SSKTilemap *tilemap)
+{
+    for (size_t index = 0; index < tilemap->dirtyChunkCount; index++) {
+        tilemap->chunkIsDirty[tilemap->dirtyChunks[index]] = false;
+    }
+    
+    tilemap->dirtyChunkCount = 0;
+}
+
+#pragma mark - Chunk geometry
+
+void SSKTilemapChunkGeometryInit(SSKTilemapChunkGeometry *geometry)
+{
+    geometry->count = 0;
+    geometry->capacity = 0;
+    geometry->tileIDs = NULL;
+    geometry->rects = NULL;
+    geometry->textureRects = NULL;
+    geometry->isCropped = NULL;
+}
+
+void SSKTilemapChunkGeometryDestroy(SSKTilemapChunkGeometry *geometry)
+{
+    free(geometry->tileIDs);
+    free(geometry->rects);
+    free(geometry->textureRects);
+    free(geometry->isCropped);
+    
+    SSKTilemapChunkGeometryInit(geometry);
+}
+
+bool SSKTilemapComputeChunkGeometry(SSKTilemapChunkGeometry *geometry,
+                                    const SSKTilemap *tilemap,
+                                    size_t chunkIndex,
+                                    SSKTileSize tileSize,
+                                    const SSKTilemapTexture *textures,
+                                    size_t textureCount,
+                                    SSKTileLayout *layout)
+{
+    geometry->count = 0;
+    
+    if (chunkIndex >= tilemap->chunkColumns * tilemap->chunkRows) {
+        return true;
+    }
+    
+    const size_t firstColumn = (chunkIndex % tilemap->chunkColumns) * tilemap->chunkSize;
+    const size_t firstRow = (chunkIndex / tilemap->chunkColumns) * tilemap->chunkSize;
+    const size_t maxColumn = SSKTilemapGetMinimum(firstColumn + tilemap->chunkSize, tilemap->columns);
+    const size_t maxRow = SSKTilemapGetMinimum(firstRow + tilemap->chunkSize, tilemap->rows);
+    
+    // The tile ID that the layout currently contains the pieces of, or 0 if it contains none
+    SSKTileID layoutTileID = 0;
+    
+    for (size_t row = firstRow; row < maxRow; row++) {
+        for (size_t column = firstColumn; column < maxColumn; column++) {
+            const SSKTileID tileID = tilemap->tileIDs[row * tilemap->columns + column];
+            
+            if (tileID == 0 || tileID > textureCount) {
+                continue;
+            }
+            
+            const SSKTilemapTexture texture = textures[tileID - 1];
+            
+            if (tileID != layoutTileID) {
+                const SSKTileGrid grid = SSKTileGridMake(tileSize, texture.size, texture.textureRect);
+                
+                // Textures with an empty size produce an empty grid, which has no pieces
+                if (!SSKTileLayoutCompute(layout, &grid, SSKTileGridGetFullRange(&grid))) {
+                    layout->count = 0;
+                }
+                
+                layoutTileID = tileID;
+            }
+            
+            if (!SSKTilemapChunkGeometryReserve(geometry, geometry->count + layout->count)) {
+                return false;
+            }
+            
+            const double originX = (double)column * tileSize.width;
+            const double originY = (double)row * tileSize.height;
+            
+            for (size_t pieceIndex = 0; pieceIndex < layout->count; pieceIndex++) {
+                const size_t index = geometry->count + pieceIndex;
+                
+                SSKTileRect rect;
+                rect.x = originX + layout->x[pieceIndex];
+                rect.y = originY + layout->y[pieceIndex];
+                rect.width = layout->width[pieceIndex];
+                rect.height = layout->height[pieceIndex];
+                
+                SSKTileRect textureRect;
+                textureRect.x = layout->textureX[pieceIndex];
+                textureRect.y = layout->textureY[pieceIndex];
+                textureRect.width = layout->textureWidth[pieceIndex];
+                textureRect.height = layout->textureHeight[pieceIndex];
+                
+                geometry->tileIDs[index] = tileID;
+                geometry->rects[index] = rect;
+                geometry->textureRects[index] = textureRect;
+                geometry->isCropped[index] = rect.width < texture.size.width || rect.height < texture.size.height;
+            }
+            
+            geometry->count += layout->count;
+        }
+    }
+    
+    return true;
+}
+
+bool SSKTilemapChunkGeometryAppendToMesh(const SSKTilemapChunkGeometry *geometry, SSKTileMesh *mesh)
+{
+    for (size_t index = 0; index < geometry->count; index++) {
+        if (!SSKTileMeshAppendQuad(mesh, geometry->rects[index], geometry->textureRects[index])) {
+            return false;
+        }
+    }
+    
+    return true;
+}
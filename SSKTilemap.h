@@ -0,0 +1,170 @@
+#ifndef SSKTilemap_h
+#define SSKTilemap_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SSKTileLayout.h"
+#include "SSKTileMesh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  Type used to identify the type of a tile in a tilemap
+ *
+ *  @discussion A tile ID of n refers to the texture at index n - 1 of the tilemap's
+ *  textures. The ID 0 is used for empty tiles, which don't display anything.
+ */
+typedef uint16_t SSKTileID;
+
+/**
+ *  The texture of a tile ID, as needed to compute the geometry of its tiles
+ *
+ *  @discussion The size is the texture's size in points, and the texture rect is its
+ *  unit coordinate rect within its atlas. Textures with an empty size display nothing.
+ */
+typedef struct {
+    SSKTileSize size;
+    SSKTileRect textureRect;
+} SSKTilemapTexture;
+
+/**
+ *  The tile IDs of a tilemap, split into square chunks that are rebuilt when their tiles change
+ *
+ *  @discussion The tile IDs are stored in a dense array, in rows of columns starting at the
+ *  bottom left tile. Chunks are indexed the same way, in chunks rather than tiles. Changing
+ *  tiles marks their chunks as dirty, and the first "dirtyChunkCount" elements of the dirty
+ *  chunk array contain the indices of all dirty chunks, each once, in the order they were
+ *  first marked as dirty.
+ */
+typedef struct {
+    size_t columns;
+    size_t rows;
+    size_t chunkSize;
+    size_t chunkColumns;
+    size_t chunkRows;
+    SSKTileID *tileIDs;
+    bool *chunkIsDirty;
+    size_t dirtyChunkCount;
+    size_t *dirtyChunks;
+} SSKTilemap;
+
+/**
+ *  The pieces that the tiles of a chunk are displayed with
+ *
+ *  @discussion Each tile is made up of one or more pieces, since textures smaller than the
+ *  tile size are repeated, and textures larger than it are cropped (the same way an
+ *  SSKTileableNode tiles its texture). The first "count" elements of each array are valid.
+ *  Rects use the tilemap's coordinate space, and texture rects the unit coordinate space of
+ *  the tile's texture atlas. A piece is cropped when it's smaller than its texture.
+ */
+typedef struct {
+    size_t count;
+    size_t capacity;
+    SSKTileID *tileIDs;
+    SSKTileRect *rects;
+    SSKTileRect *textureRects;
+    bool *isCropped;
+} SSKTilemapChunkGeometry;
+
+#pragma mark - Tilemaps
+
+/**
+ *  Initialize a tilemap, with all tiles empty and no dirty chunks
+ *
+ *  @return Whether the tilemap could be initialized. False is returned if the chunk size is 0,
+ *  or if memory for the tilemap could not be allocated, in which case the tilemap is empty.
+ */
+extern bool SSKTilemapInit(SSKTilemap *tilemap, size_t columns, size_t rows, size_t chunkSize);
+
+/**
+ *  Free all memory used by a tilemap, and make it empty
+ */
+extern void SSKTilemapDestroy(SSKTilemap *tilemap);
+
+/**
+ *  Get the ID of the tile at a column & row, or 0 for columns & rows outside of the tilemap
+ */
+extern SSKTileID SSKTilemapGetTileID(const SSKTilemap *tilemap, size_t column, size_t row);
+
+/**
+ *  Set the ID of all tiles within a rectangular range of columns & rows
+ *
+ *  @return The number of tiles whose ID changed
+ *
+ *  @discussion The range is clamped to the tilemap. Only chunks containing tiles whose
+ *  ID changed are marked as dirty, by checking each row's chunks once rather than per tile.
+ */
+extern size_t SSKTilemapFill(SSKTilemap *tilemap, SSKTileID tileID, size_t column, size_t row, size_t columns, size_t rows);
+
+/**
+ *  Mark a chunk as dirty, if it isn't already
+ */
+extern void SSKTilemapSetChunkDirty(SSKTilemap *tilemap, size_t chunkIndex);
+
+/**
+ *  Mark all chunks of a tilemap as dirty
+ */
+extern void SSKTilemapSetAllChunksDirty(SSKTilemap *tilemap);
+
+/**
+ *  Mark all chunks of a tilemap as clean, once they have been rebuilt
+ */
+extern void SSKTilemapRemoveAllDirtyChunks(SSKTilemap *tilemap);
+
+#pragma mark - Chunk geometry
+
+/**
+ *  Initialize an empty chunk geometry
+ */
+extern void SSKTilemapChunkGeometryInit(SSKTilemapChunkGeometry *geometry);
+
+/**
+ *  Free all memory used by a chunk geometry, and make it empty
+ */
+extern void SSKTilemapChunkGeometryDestroy(SSKTilemapChunkGeometry *geometry);
+
+/**
+ *  Compute the pieces of all tiles of a chunk
+ *
+ *  @param geometry The geometry to write the pieces to. Its previous pieces are replaced.
+ *  @param tilemap The tilemap containing the chunk
+ *  @param chunkIndex The index of the chunk
+ *  @param tileSize The size of each tile
+ *  @param textures The textures of the tile IDs, indexed by tile ID - 1
+ *  @param textureCount The number of textures. Tiles with IDs that have no texture are skipped.
+ *  @param layout A layout used as scratch memory while tiling each tile.
+ *  Pass the same layout across calls to avoid reallocating it.
+ *
+ *  @return Whether the geometry could be computed. False is returned if memory for
+ *  it could not be allocated.
+ *
+ *  @discussion Since all tiles with the same ID are tiled the same way, consecutive tiles
+ *  with the same ID reuse the layout of the first one, offset to their own position.
+ */
+extern bool SSKTilemapComputeChunkGeometry(SSKTilemapChunkGeometry *geometry,
+                                           const SSKTilemap *tilemap,
+                                           size_t chunkIndex,
+                                           SSKTileSize tileSize,
+                                           const SSKTilemapTexture *textures,
+                                           size_t textureCount,
+                                           SSKTileLayout *layout);
+
+/**
+ *  Append the pieces of a chunk geometry to a tile mesh, as one quad per piece
+ *
+ *  @return Whether the pieces could be appended. False is returned if memory
+ *  for the mesh could not be allocated.
+ */
+extern bool SSKTilemapChunkGeometryAppendToMesh(const SSKTilemapChunkGeometry *geometry, SSKTileMesh *mesh);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
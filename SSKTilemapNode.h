@@ -0,0 +1,159 @@
+#import <SpriteKit/SpriteKit.h>
+#import "SSKTileLayout.h"
+#import "SSKTileMesh.h"
+#import "SSKTextureRegionCache.h"
+#import "SSKTilemap.h"
+
+/**
+ *  The tile ID used for tiles that should not display anything
+ */
+extern const SSKTileID SSKTileIDEmpty;
+
+/**
+ *  A node that displays a grid of tiles, each with its own texture
+ *
+ *  @discussion The tile IDs of a tilemap are stored in a dense 2D array, which is split
+ *  into square chunks. Whenever tiles change, only the chunks containing those tiles are
+ *  rebuilt. Make bulk edits within -performBatchUpdates: to rebuild each chunk only once.
+ *  The tile IDs, chunk bookkeeping & the geometry of each chunk are handled by SSKTilemap,
+ *  a plain C core. Rebuilt chunks reuse their existing sprite nodes.
+ *
+ *  Each tile displays its texture the same way an SSKTileableNode would, with the tile's
+ *  size as the node size. That is, textures smaller than the tile size are repeated, and
+ *  textures larger than the tile size are cropped.
+ *
+ *  This class depends on SSKTilemap, SSKTileLayout, SSKTileMesh and SSKTextureRegionCache.
+ */
+@interface SSKTilemapNode : SKNode
+
+/**
+ *  The number of columns of tiles in the tilemap
+ */
+@property (nonatomic, readonly) NSUInteger columns;
+
+/**
+ *  The number of rows of tiles in the tilemap
+ */
+@property (nonatomic, readonly) NSUInteger rows;
+
+/**
+ *  The size of each tile
+ */
+@property (nonatomic, readonly) CGSize tileSize;
+
+/**
+ *  The number of columns & rows of tiles that each chunk contains
+ */
+@property (nonatomic, readonly) NSUInteger chunkSize;
+
+/**
+ *  The textures that tiles use, indexed by tile ID - 1
+ *
+ *  @discussion The array is assumed to only contain SKTexture instances.
+ *  Setting this property will rebuild all chunks. Tiles with IDs that
+ *  have no texture won't display anything.
+ */
+@property (nonatomic, copy) NSArray *tileTextures;
+
+/**
+ *  Whether the tilemap should batch the tiles of each chunk into a single mesh
+ *
+ *  @discussion The default is NO, meaning that each chunk creates sprite nodes for its
+ *  tiles. When set to YES, chunks won't create any sprite nodes, and instead build a single
+ *  interleaved vertex buffer and index buffer each, which can be handed off to a custom
+ *  renderer. All tile textures should then be part of the same texture atlas.
+ *
+ *  See SSKTileMesh for the layout of the buffers.
+ */
+@property (nonatomic) BOOL batchesTiles;
+
+/**
+ *  Allocate and initialize a new instance of SSKTilemapNode, using a chunk size of 16
+ *
+ *  @param columns The number of columns of tiles
+ *  @param rows The number of rows of tiles
+ *  @param tileSize The size of each tile
+ *  @param tileTextures The textures that tiles use, indexed by tile ID - 1
+ *
+ *  @discussion All tiles are initially empty.
+ */
++ (instancetype)tilemapNodeWithColumns:(NSUInteger)columns
+                                  rows:(NSUInteger)rows
+                              tileSize:(CGSize)tileSize
+                          tileTextures:(NSArray *)tileTextures;
+
+/**
+ *  Allocate and initialize a new instance of SSKTilemapNode
+ *
+ *  @param columns The number of columns of tiles
+ *  @param rows The number of rows of tiles
+ *  @param tileSize The size of each tile
+ *  @param chunkSize The number of columns & rows of tiles each chunk should contain.
+ *  If this parameter is 0, this method will return nil, and no node will be created.
+ *  @param tileTextures The textures that tiles use, indexed by tile ID - 1
+ *
+ *  @discussion All tiles are initially empty.
+ */
++ (instancetype)tilemapNodeWithColumns:(NSUInteger)columns
+                                  rows:(NSUInteger)rows
+                              tileSize:(CGSize)tileSize
+                             chunkSize:(NSUInteger)chunkSize
+                          tileTextures:(NSArray *)tileTextures;
+
+/**
+ *  Return the ID of the tile at a column & row
+ *
+ *  @discussion SSKTileIDEmpty is returned for columns & rows outside of the tilemap.
+ */
+- (SSKTileID)tileIDAtColumn:(NSUInteger)column row:(NSUInteger)row;
+
+/**
+ *  Set the ID of the tile at a column & row
+ *
+ *  @discussion Setting the ID of a tile outside of the tilemap does nothing.
+ *  Unless called within -performBatchUpdates:, the chunk containing the
+ *  tile is rebuilt right away.
+ */
+- (void)setTileID:(SSKTileID)tileID atColumn:(NSUInteger)column row:(NSUInteger)row;
+
+/**
+ *  Set the ID of all tiles within a rectangular range of columns & rows
+ *
+ *  @discussion The range is clamped to the tilemap. Each affected chunk is only rebuilt once.
+ */
+- (void)fillTileID:(SSKTileID)tileID
+          inColumn:(NSUInteger)column
+               row:(NSUInteger)row
+           columns:(NSUInteger)columns
+              rows:(NSUInteger)rows;
+
+/**
+ *  Perform a set of tile edits, rebuilding the affected chunks once they are all done
+ *
+ *  @param updates A block that changes tile IDs of the tilemap
+ */
+- (void)performBatchUpdates:(dispatch_block_t)updates;
+
+/**
+ *  The vertex buffer of a chunk's batched mesh
+ *
+ *  @param chunkColumn The column of the chunk (in chunks, not tiles)
+ *  @param chunkRow The row of the chunk (in chunks, not tiles)
+ *
+ *  @discussion Contains tightly packed SSKTileMeshVertex structs, in the tilemap's
+ *  coordinate space. This is nil unless batchesTiles is set to YES.
+ */
+- (NSData *)batchedVertexDataForChunkAtColumn:(NSUInteger)chunkColumn row:(NSUInteger)chunkRow;
+
+/**
+ *  The index buffer of a chunk's batched mesh
+ *
+ *  @param chunkColumn The column of the chunk (in chunks, not tiles)
+ *  @param chunkRow The row of the chunk (in chunks, not tiles)
+ *
+ *  @discussion Contains tightly packed uint32_t indices, describing a list of
+ *  triangles. This is nil unless batchesTiles is set to YES.
+ */
+- (NSData *)batchedIndexDataForChunkAtColumn:(NSUInteger)chunkColumn row:(NSUInteger)chunkRow;
+
+@end
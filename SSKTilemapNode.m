@@ -0,0 +1,284 @@
+#import "SSKTilemapNode.h"
+
+const SSKTileID SSKTileIDEmpty = 0;
+
+static const NSUInteger SSKTilemapNodeDefaultChunkSize = 16;
+
+#pragma mark - SSKTilemapChunk
+
+@interface SSKTilemapChunk : NSObject
+{
+    @public
+    SSKTileMesh _mesh;
+}
+
+@property (nonatomic, strong) SKNode *node;
+@property (nonatomic, strong) NSData *vertexData;
+@property (nonatomic, strong) NSData *indexData;
+
+@end
+
+@implementation SSKTilemapChunk
+
+- (void)dealloc
+{
+    SSKTileMeshDestroy(&_mesh);
+}
+
+@end
+
+#pragma mark - SSKTilemapNode
+
+@interface SSKTilemapNode()
+
+@property (nonatomic, readwrite) NSUInteger columns;
+@property (nonatomic, readwrite) NSUInteger rows;
+@property (nonatomic, readwrite) CGSize tileSize;
+@property (nonatomic, readwrite) NSUInteger chunkSize;
+@property (nonatomic, strong) NSArray *chunks;
+@property (nonatomic) NSUInteger batchUpdateDepth;
+
+@end
+
+@implementation SSKTilemapNode
+{
+    SSKTilemap _tilemap;
+    SSKTilemapChunkGeometry _geometry;
+    SSKTileLayout _layout;
+    SSKTilemapTexture *_textures;
+}
+
++ (instancetype)tilemapNodeWithColumns:(NSUInteger)columns rows:(NSUInteger)rows tileSize:(CGSize)tileSize tileTextures:(NSArray *)tileTextures
+{
+    return [self tilemapNodeWithColumns:columns
+                                   rows:rows
+                               tileSize:tileSize
+                              chunkSize:SSKTilemapNodeDefaultChunkSize
+                           tileTextures:tileTextures];
+}
+
++ (instancetype)tilemapNodeWithColumns:(NSUInteger)columns rows:(NSUInteger)rows tileSize:(CGSize)tileSize chunkSize:(NSUInteger)chunkSize tileTextures:(NSArray *)tileTextures
+{
+    SSKTilemapNode *node = [self node];
+    
+    if (!SSKTilemapInit(&node->_tilemap, columns, rows, chunkSize)) {
+        return nil;
+    }
+    
+    node.columns = columns;
+    node.rows = rows;
+    node.tileSize = tileSize;
+    node.chunkSize = chunkSize;
+    [node createChunks];
+    node.tileTextures = tileTextures;
+    
+    return node;
+}
+
+- (void)dealloc
+{
+    SSKTilemapDestroy(&_tilemap);
+    SSKTilemapChunkGeometryDestroy(&_geometry);
+    SSKTileLayoutDestroy(&_layout);
+    free(_textures);
+}
+
+#pragma mark - Public
+
+- (SSKTileID)tileIDAtColumn:(NSUInteger)column row:(NSUInteger)row
+{
+    return SSKTilemapGetTileID(&_tilemap, column, row);
+}
+
+- (void)setTileID:(SSKTileID)tileID atColumn:(NSUInteger)column row:(NSUInteger)row
+{
+    [self fillTileID:tileID inColumn:column row:row columns:1 rows:1];
+}
+
+- (void)fillTileID:(SSKTileID)tileID inColumn:(NSUInteger)column row:(NSUInteger)row columns:(NSUInteger)columns rows:(NSUInteger)rows
+{
+    SSKTilemapFill(&_tilemap, tileID, column, row, columns, rows);
+    
+    if (self.batchUpdateDepth == 0) {
+        [self rebuildDirtyChunks];
+    }
+}
+
+- (void)performBatchUpdates:(dispatch_block_t)updates
+{
+    self.batchUpdateDepth++;
+    
+    if (updates) {
+        updates();
+    }
+    
+    self.batchUpdateDepth--;
+    
+    if (self.batchUpdateDepth == 0) {
+        [self rebuildDirtyChunks];
+    }
+}
+
+- (NSData *)batchedVertexDataForChunkAtColumn:(NSUInteger)chunkColumn row:(NSUInteger)chunkRow
+{
+    return [self chunkAtColumn:chunkColumn row:chunkRow].vertexData;
+}
+
+- (NSData *)batchedIndexDataForChunkAtColumn:(NSUInteger)chunkColumn row:(NSUInteger)chunkRow
+{
+    return [self chunkAtColumn:chunkColumn row:chunkRow].indexData;
+}
+
+#pragma mark - Accessor overrides
+
+- (void)setTileTextures:(NSArray *)tileTextures
+{
+    _tileTextures = [tileTextures copy];
+    
+    free(_textures);
+    _textures = calloc(MAX([_tileTextures count], 1), sizeof(SSKTilemapTexture));
+    
+    for (NSUInteger index = 0; _textures && index < [_tileTextures count]; index++) {
+        SKTexture *texture = [_tileTextures objectAtIndex:index];
+        
+        SSKTilemapTexture *tilemapTexture = &_textures[index];
+        tilemapTexture->size.width = texture.size.width;
+        tilemapTexture->size.height = texture.size.height;
+        tilemapTexture->textureRect.x = texture.textureRect.origin.x;
+        tilemapTexture->textureRect.y = texture.textureRect.origin.y;
+        tilemapTexture->textureRect.width = texture.textureRect.size.width;
+        tilemapTexture->textureRect.height = texture.textureRect.size.height;
+    }
+    
+    [self setNeedsRebuildForAllChunks];
+}
+
+- (void)setBatchesTiles:(BOOL)batchesTiles
+{
+    if (_batchesTiles == batchesTiles) {
+        return;
+    }
+    
+    _batchesTiles = batchesTiles;
+    
+    [self setNeedsRebuildForAllChunks];
+}
+
+#pragma mark - Chunks
+
+- (void)createChunks
+{
+    NSMutableArray *chunks = [NSMutableArray arrayWithCapacity:_tilemap.chunkColumns * _tilemap.chunkRows];
+    
+    for (NSUInteger chunkIndex = 0; chunkIndex < _tilemap.chunkColumns * _tilemap.chunkRows; chunkIndex++) {
+        SSKTilemapChunk *chunk = [SSKTilemapChunk new];
+        chunk.node = [SKNode node];
+        
+        [self addChild:chunk.node];
+        [chunks addObject:chunk];
+    }
+    
+    self.chunks = chunks;
+}
+
+- (SSKTilemapChunk *)chunkAtColumn:(NSUInteger)chunkColumn row:(NSUInteger)chunkRow
+{
+    if (chunkColumn >= _tilemap.chunkColumns || chunkRow >= _tilemap.chunkRows) {
+        return nil;
+    }
+    
+    return [self.chunks objectAtIndex:chunkRow * _tilemap.chunkColumns + chunkColumn];
+}
+
+- (void)setNeedsRebuildForAllChunks
+{
+    SSKTilemapSetAllChunksDirty(&_tilemap);
+    
+    if (self.batchUpdateDepth == 0) {
+        [self rebuildDirtyChunks];
+    }
+}
+
+- (void)rebuildDirtyChunks
+{
+    for (size_t index = 0; index < _tilemap.dirtyChunkCount; index++) {
+        [self rebuildChunkAtIndex:_tilemap.dirtyChunks[index]];
+    }
+    
+    SSKTilemapRemoveAllDirtyChunks(&_tilemap);
+}
+
+- (void)rebuildChunkAtIndex:(size_t)chunkIndex
+{
+    SSKTilemapChunk *chunk = [self.chunks objectAtIndex:chunkIndex];
+    
+    SSKTileSize tileSize;
+    tileSize.width = self.tileSize.width;
+    tileSize.height = self.tileSize.height;
+    
+    SSKTilemapComputeChunkGeometry(&_geometry, &_tilemap, chunkIndex, tileSize, _textures, [self.tileTextures count], &_layout);
+    
+    if (!self.batchesTiles) {
+        SSKTileMeshDestroy(&chunk->_mesh);
+        chunk.vertexData = nil;
+        chunk.indexData = nil;
+        
+        [self updateSpriteNodesOfChunk:chunk];
+        
+        return;
+    }
+    
+    [chunk.node removeAllChildren];
+    
+    SSKTileMeshRemoveAllQuads(&chunk->_mesh);
+    SSKTilemapChunkGeometryAppendToMesh(&_geometry, &chunk->_mesh);
+    
+    chunk.vertexData = [NSData dataWithBytes:chunk->_mesh.vertices length:chunk->_mesh.vertexCount * sizeof(SSKTileMeshVertex)];
+    chunk.indexData = [NSData dataWithBytes:chunk->_mesh.indices length:chunk->_mesh.indexCount * sizeof(uint32_t)];
+}
+
+- (void)updateSpriteNodesOfChunk:(SSKTilemapChunk *)chunk
+{
+    NSArray *spriteNodes = chunk.node.children;
+    const NSUInteger reusedCount = MIN([spriteNodes count], _geometry.count);
+    
+    // The chunk's existing sprite nodes are reused for its first pieces, so only the difference is added or removed
+    for (size_t pieceIndex = 0; pieceIndex < _geometry.count; pieceIndex++) {
+        const SSKTileRect rect = _geometry.rects[pieceIndex];
+        SKTexture *texture = [self.tileTextures objectAtIndex:_geometry.tileIDs[pieceIndex] - 1];
+        
+        if (_geometry.isCropped[pieceIndex]) {
+            const SSKTileRect textureRect = _geometry.textureRects[pieceIndex];
+            
+            texture = [[SSKTextureRegionCache sharedCache] textureWithRect:CGRectMake(textureRect.x,
+                                                                                      textureRect.y,
+                                                                                      textureRect.width,
+                                                                                      textureRect.height)
+                                                                 inTexture:texture];
+        }
+        
+        SKSpriteNode *spriteNode = nil;
+        
+        if (pieceIndex < reusedCount) {
+            spriteNode = [spriteNodes objectAtIndex:pieceIndex];
+            
+            if (spriteNode.texture != texture) {
+                spriteNode.texture = texture;
+            }
+        } else {
+            spriteNode = [SKSpriteNode spriteNodeWithTexture:texture];
+            spriteNode.anchorPoint = CGPointZero;
+            
+            [chunk.node addChild:spriteNode];
+        }
+        
+        spriteNode.position = CGPointMake(rect.x, rect.y);
+        spriteNode.size = CGSizeMake(rect.width, rect.height);
+    }
+    
+    if ([spriteNodes count] > reusedCount) {
+        [chunk.node removeChildrenInArray:[spriteNodes subarrayWithRange:NSMakeRange(reusedCount, [spriteNodes count] - reusedCount)]];
+    }
+}
+
+@end
@@ -0,0 +1,215 @@
+#include "SSKTween.h"
+
+#include <float.h>
+#include <stdlib.h>
+
+#pragma mark - Utilities
+
+static bool SSKTweenTableReserve(SSKTweenTable *table, size_t capacity)
+{
+    if (table->capacity >= capacity) {
+        return true;
+    }
+    
+    if (capacity < table->capacity * 2) {
+        capacity = table->capacity * 2;
+    }
+    
+    double **doubleArrays[] = {
+        &table->startX, &table->startY, &table->endX, &table->endY,
+        &table->startTime, &table->duration, &table->valueX, &table->valueY, &table->progress
+    };
+    
+    for (size_t arrayIndex = 0; arrayIndex < sizeof(doubleArrays) / sizeof(doubleArrays[0]); arrayIndex++) {
+        double *array = realloc(*doubleArrays[arrayIndex], capacity * sizeof(double));
+        
+        if (!array) {
+            return false;
+        }
+        
+        *doubleArrays[arrayIndex] = array;
+    }
+    
+    uint8_t *easing = realloc(table->easing, capacity * sizeof(uint8_t));
+    
+    if (!easing) {
+        return false;
+    }
+    
+    table->easing = easing;
+    
+    table->capacity = capacity;
+    
+    return true;
+}
+
+/**
+ *  Step a range of tweens, see SSKTweenTableStep
+ *
+ *  @discussion Taking the arrays as restrict-qualified parameters lets compilers assume that
+ *  they don't alias each other, which is required for the loop to be vectorized.
+ */
+static void SSKTweenTableStepKernel(size_t count,
+                                    const double * restrict startX,
+                                    const double * restrict startY,
+                                    const double * restrict endX,
+                                    const double * restrict endY,
+                                    double * restrict startTime,
+                                    const double * restrict duration,
+                                    const uint8_t * restrict easing,
+                                    double * restrict valueX,
+                                    double * restrict valueY,
+                                    double * restrict progress,
+                                    double currentTime)
+{
+    for (size_t index = 0; index < count; index++) {
+        // NAN != NAN, so tweens that haven't started yet start now
+        const double tweenStartTime = startTime[index] == startTime[index] ? startTime[index] : currentTime;
+        const double tweenDuration = duration[index];
+        
+        // Dividing by a clamped duration keeps the loop free of branches, zero durations are handled below
+        double tweenProgress = (currentTime - tweenStartTime) / (tweenDuration > DBL_MIN ? tweenDuration : DBL_MIN);
+        tweenProgress = tweenDuration > 0 ? tweenProgress : 1;
+        tweenProgress = tweenProgress < 0 ? 0 : tweenProgress;
+        tweenProgress = tweenProgress > 1 ? 1 : tweenProgress;
+        
+        // Every easing curve is the linear progress plus weighted deltas towards the quadratic & piecewise
+        // quadratic curves. Integer comparisons (rather than selects on the easing ID) keep the loop vectorizable.
+        const double quadraticDelta = tweenProgress * tweenProgress - tweenProgress;
+        const double easeInEaseOutDelta = (tweenProgress < 0.5 ? 2 * tweenProgress * tweenProgress : -1 + (4 - 2 * tweenProgress) * tweenProgress) - tweenProgress;
+        const double eased = tweenProgress +
+                             (double)((easing[index] == SSKTweenEasingEaseIn) - (easing[index] == SSKTweenEasingEaseOut)) * quadraticDelta +
+                             (double)(easing[index] == SSKTweenEasingEaseInEaseOut) * easeInEaseOutDelta;
+        
+        startTime[index] = tweenStartTime;
+        
+        // Written as a weighted sum, so that finished tweens land exactly on their end value
+        valueX[index] = startX[index] * (1 - eased) + endX[index] * eased;
+        valueY[index] = startY[index] * (1 - eased) + endY[index] * eased;
+        progress[index] = tweenProgress;
+    }
+}
+
+#pragma mark - Easing
+
+double SSKTweenGetEasedProgress(SSKTweenEasing easing, double progress)
+{
+    // Evaluated as a single tween from 0 to 1, so that the easing math only lives in the step kernel
+    const double zero = 0;
+    const double one = 1;
+    const uint8_t easingID = (uint8_t)easing;
+    
+    double startTime = 0;
+    double value;
+    double valueY;
+    double clampedProgress;
+    
+    SSKTweenTableStepKernel(1, &zero, &zero, &one, &zero, &startTime, &one, &easingID, &value, &valueY, &clampedProgress, progress);
+    
+    return value;
+}
+
+#pragma mark - Tween tables
+
+void SSKTweenTableInit(SSKTweenTable *table)
+{
+    table->count = 0;
+    table->capacity = 0;
+    table->startX = NULL;
+    table->startY = NULL;
+    table->endX = NULL;
+    table->endY = NULL;
+    table->startTime = NULL;
+    table->duration = NULL;
+    table->easing = NULL;
+    table->valueX = NULL;
+    table->valueY = NULL;
+    table->progress = NULL;
+}
+
+void SSKTweenTableDestroy(SSKTweenTable *table)
+{
+    free(table->startX);
+    free(table->startY);
+    free(table->endX);
+    free(table->endY);
+    free(table->startTime);
+    free(table->duration);
+    free(table->easing);
+    free(table->valueX);
+    free(table->valueY);
+    free(table->progress);
+    
+    SSKTweenTableInit(table);
+}
+
+size_t SSKTweenTableAdd(SSKTweenTable *table, double startX, double startY, double endX, double endY, double startTime, double duration, SSKTweenEasing easing)
+{
+    if (!SSKTweenTableReserve(table, table->count + 1)) {
+        return SIZE_MAX;
+    }
+    
+    const size_t index = table->count;
+    
+    table->startX[index] = startX;
+    table->startY[index] = startY;
+    table->endX[index] = endX;
+    table->endY[index] = endY;
+    table->startTime[index] = startTime;
+    table->duration[index] = duration > 0 ? duration : 0;
+    table->easing[index] = (uint8_t)easing;
+    table->valueX[index] = startX;
+    table->valueY[index] = startY;
+    table->progress[index] = 0;
+    
+    table->count++;
+    
+    return index;
+}
+
+void SSKTweenTableRemove(SSKTweenTable *table, size_t index)
+{
+    if (index >= table->count) {
+        return;
+    }
+    
+    const size_t lastIndex = table->count - 1;
+    
+    table->startX[index] = table->startX[lastIndex];
+    table->startY[index] = table->startY[lastIndex];
+    table->endX[index] = table->endX[lastIndex];
+    table->endY[index] = table->endY[lastIndex];
+    table->startTime[index] = table->startTime[lastIndex];
+    table->duration[index] = table->duration[lastIndex];
+    table->easing[index] = table->easing[lastIndex];
+    table->valueX[index] = table->valueX[lastIndex];
+    table->valueY[index] = table->valueY[lastIndex];
+    table->progress[index] = table->progress[lastIndex];
+    
+    table->count--;
+}
+
+size_t SSKTweenTableStep(SSKTweenTable *table, double currentTime)
+{
+    SSKTweenTableStepKernel(table->count,
+                            table->startX,
+                            table->startY,
+                            table->endX,
+                            table->endY,
+                            table->startTime,
+                            table->duration,
+                            table->easing,
+                            table->valueX,
+                            table->valueY,
+                            table->progress,
+                            currentTime);
+    
+    // Counted in a separate loop, since mixing integer & floating point results keeps the kernel from being vectorized
+    size_t finishedCount = 0;
+    
+    for (size_t index = 0; index < table->count; index++) {
+        finishedCount += table->progress[index] >= 1;
+    }
+    
+    return finishedCount;
+}
@@ -0,0 +1,118 @@
+#ifndef SSKTween_h
+#define SSKTween_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - Types
+
+/**
+ *  Enum describing the easing curves that tweens can use
+ */
+typedef enum {
+    SSKTweenEasingLinear,
+    SSKTweenEasingEaseIn,
+    SSKTweenEasingEaseOut,
+    SSKTweenEasingEaseInEaseOut
+} SSKTweenEasing;
+
+/**
+ *  A flat, struct-of-arrays list of two-component tweens
+ *
+ *  @discussion Each array has room for at least "capacity" elements, of which the first
+ *  "count" are valid. Every tween interpolates an (x, y) pair, which is enough to describe
+ *  sizes, positions & scales. Scalar values can simply leave the y component at zero.
+ *
+ *  A start time of NAN means that the tween starts at the next time the table is stepped.
+ *  The value & progress arrays are written by SSKTweenTableStep. A tween has finished
+ *  once its (linear, 0 - 1) progress reaches 1.
+ */
+typedef struct {
+    size_t count;
+    size_t capacity;
+    double *startX;
+    double *startY;
+    double *endX;
+    double *endY;
+    double *startTime;
+    double *duration;
+    uint8_t *easing;
+    double *valueX;
+    double *valueY;
+    double *progress;
+} SSKTweenTable;
+
+#pragma mark - Easing
+
+/**
+ *  Apply an easing curve to a linear progress value
+ *
+ *  @param easing The easing curve to apply
+ *  @param progress The linear progress, which will be clamped to 0 - 1
+ *
+ *  @return The eased progress, in the 0 - 1 range
+ */
+extern double SSKTweenGetEasedProgress(SSKTweenEasing easing, double progress);
+
+#pragma mark - Tween tables
+
+/**
+ *  Initialize an empty tween table
+ */
+extern void SSKTweenTableInit(SSKTweenTable *table);
+
+/**
+ *  Free all memory used by a tween table, and make it empty
+ */
+extern void SSKTweenTableDestroy(SSKTweenTable *table);
+
+/**
+ *  Add a tween to a tween table
+ *
+ *  @param table The table to add the tween to
+ *  @param startX The x component of the value to tween from
+ *  @param startY The y component of the value to tween from
+ *  @param endX The x component of the value to tween to
+ *  @param endY The y component of the value to tween to
+ *  @param startTime The time the tween starts at, or NAN to start at the next step
+ *  @param duration The duration of the tween. Tweens with a zero duration finish at their first step.
+ *  @param easing The easing curve of the tween
+ *
+ *  @return The index of the added tween, or SIZE_MAX if memory for it could not be allocated
+ */
+extern size_t SSKTweenTableAdd(SSKTweenTable *table, double startX, double startY, double endX, double endY, double startTime, double duration, SSKTweenEasing easing);
+
+/**
+ *  Remove a tween from a tween table
+ *
+ *  @discussion The last tween of the table is moved into the removed tween's index, so that
+ *  the arrays stay contiguous. Any parallel arrays kept by the caller should do the same.
+ */
+extern void SSKTweenTableRemove(SSKTweenTable *table, size_t index);
+
+/**
+ *  Step all tweens of a tween table to a point in time
+ *
+ *  @param table The table to step
+ *  @param currentTime The time to step the tweens to
+ *
+ *  @return The number of tweens that have finished
+ *
+ *  @discussion All tweens are computed in a single, branch-free loop over the table's
+ *  arrays, which clang vectorizes (as does gcc, when using -fno-trapping-math). The
+ *  results are written to the value & progress arrays. Values only depend on the current
+ *  time, never on the previous step, so tweens progress the same way regardless of the
+ *  frame rate.
+ */
+extern size_t SSKTweenTableStep(SSKTweenTable *table, double currentTime);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,103 @@
+#import <SpriteKit/SpriteKit.h>
+#import "SSKTween.h"
+
+/**
+ *  Protocol adopted by nodes that have a size that can be tweened
+ */
+@protocol SSKTweenResizable <NSObject>
+
+/**
+ *  The current size of the node
+ */
+@property (nonatomic) CGSize size;
+
+@end
+
+/**
+ *  A process-wide engine that animates many nodes at once, using a struct-of-arrays tween table
+ *
+ *  @discussion Instead of running one block-based SKAction per animated node, the engine keeps
+ *  the start & end values, start times, durations and easing curves of all active tweens in
+ *  contiguous arrays (see SSKTweenTable). Each frame, all tweens are stepped in one vectorizable
+ *  loop, and the results are then written back to their nodes in a single batch.
+ *
+ *  Call -updateWithCurrentTime: once per frame, from your scene's -update: method. Tweens are
+ *  computed from the current time, so they progress the same way regardless of the frame rate.
+ *  When the shared SSKLayoutPass is deferred, writing back the sizes only marks the nodes as
+ *  needing layout, so tweening hundreds of panels costs one layout per panel per frame.
+ *
+ *  This class depends on SSKTween.
+ */
+@interface SSKTweenEngine : NSObject
+
+/**
+ *  The number of tweens that are currently active
+ */
+@property (nonatomic, readonly) NSUInteger activeTweenCount;
+
+/**
+ *  Return the shared, process-wide, tween engine
+ */
++ (instancetype)sharedEngine;
+
+/**
+ *  Tween the size of a node
+ *
+ *  @param node The node to resize. The tween starts from the node's current size.
+ *  @param size The size the node should have once the tween is finished
+ *  @param duration The duration of the tween
+ *  @param easing The easing curve to use
+ *
+ *  @discussion The tween starts at the next call to -updateWithCurrentTime:. Any existing size
+ *  tween or resize action of the node is replaced. The engine doesn't retain the node, and tweens of nodes that
+ *  have been deallocated are removed.
+ */
+- (void)resizeNode:(SKNode<SSKTweenResizable> *)node
+            toSize:(CGSize)size
+          duration:(NSTimeInterval)duration
+            easing:(SSKTweenEasing)easing;
+
+/**
+ *  Remove all tweens of a node, leaving the node at its current size
+ *
+ *  @discussion This also stops any resize action of the node from resizing it.
+ */
+- (void)removeTweensForNode:(SKNode *)node;
+
+/**
+ *  Remove all tweens of a node, after giving the node the size its tween ends at
+ */
+- (void)finishTweensForNode:(SKNode *)node;
+
+/**
+ *  Step all active tweens & write the results back to their nodes
+ *
+ *  @param currentTime The current time, as passed to -[SKScene update:]
+ *
+ *  @discussion Like actions, tweens of paused nodes (or nodes within paused parents or scenes)
+ *  are held back, and the tweens of other nodes progress at the combined speed of the node
+ *  and its ancestors. Changes to a node's speed apply from the next update.
+ */
+- (void)updateWithCurrentTime:(NSTimeInterval)currentTime;
+
+/**
+ *  Create an action that resizes a node, using the same easing curves as the engine
+ *
+ *  @param width The width the node should have, or NAN to keep its width
+ *  @param height The height the node should have, or NAN to keep its height
+ *  @param duration The duration of the action
+ *  @param easing The easing curve to use
+ *
+ *  @discussion The action is driven by SpriteKit, so it honors the pausing & speed of the node
+ *  and its scene, and animates without -updateWithCurrentTime: being called. Each run of the
+ *  action computes its size using the engine's easing curves, and registers a token with the
+ *  shared engine, so that starting another resize action or engine tween on the node replaces
+ *  it (the replaced action then stops resizing the node), and removing the action simply stops
+ *  it. It can only be performed by nodes that adopt the SSKTweenResizable protocol.
+ */
++ (SKAction *)resizeActionToWidth:(CGFloat)width
+                           height:(CGFloat)height
+                         duration:(NSTimeInterval)duration
+                           easing:(SSKTweenEasing)easing;
+
+@end
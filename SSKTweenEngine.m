@@ -0,0 +1,330 @@
+#import "SSKTweenEngine.h"
+
+#pragma mark - C Utilities
+
+static CGFloat SSKTweenEngineGetEffectiveSpeedOfNode(SKNode *node)
+{
+    CGFloat speed = 1;
+    
+    // A node's actions are paused if it or any of its ancestors (including the scene) is paused, and scaled by all of their speeds
+    for (SKNode *ancestor = node; ancestor; ancestor = ancestor.parent) {
+        if (ancestor.paused) {
+            return 0;
+        }
+        
+        speed *= ancestor.speed;
+    }
+    
+    return speed;
+}
+
+#pragma mark - SSKTweenTarget
+
+@interface SSKTweenTarget : NSObject
+
+@property (nonatomic, weak) SKNode<SSKTweenResizable> *node;
+@property (nonatomic) size_t index;
+
+@end
+
+@implementation SSKTweenTarget
+
+@end
+
+#pragma mark - SSKTweenActionToken
+
+@interface SSKTweenActionToken : NSObject
+
+@property (nonatomic) CGSize startSize;
+@property (nonatomic) CGSize endSize;
+@property (nonatomic) CGFloat elapsedTime;
+
+@end
+
+@implementation SSKTweenActionToken
+
+@end
+
+#pragma mark - SSKTweenEngine
+
+@interface SSKTweenEngine()
+
+@property (nonatomic, strong) NSMutableArray *targets;
+@property (nonatomic, strong) NSMapTable *targetsByNode;
+@property (nonatomic, strong) NSMapTable *actionTokensByNode;
+@property (nonatomic) NSTimeInterval lastUpdateTime;
+
+- (void)beginActionTween:(SSKTweenActionToken *)token forNode:(SKNode *)node;
+- (BOOL)isActionTween:(SSKTweenActionToken *)token activeForNode:(SKNode *)node;
+- (void)endActionTween:(SSKTweenActionToken *)token forNode:(SKNode *)node;
+
+@end
+
+@implementation SSKTweenEngine
+{
+    SSKTweenTable _table;
+}
+
++ (instancetype)sharedEngine
+{
+    static SSKTweenEngine *sharedEngine;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        sharedEngine = [self new];
+    });
+    
+    return sharedEngine;
+}
+
++ (SKAction *)resizeActionToWidth:(CGFloat)width height:(CGFloat)height duration:(NSTimeInterval)duration easing:(SSKTweenEasing)easing
+{
+    // Each run of the action on a node gets its own token, since the same action can run on many nodes at once
+    NSMapTable *tokensByNode = [NSMapTable weakToStrongObjectsMapTable];
+    
+    return [SKAction customActionWithDuration:duration actionBlock:^(SKNode *node, CGFloat elapsedTime) {
+        if (![node conformsToProtocol:@protocol(SSKTweenResizable)]) {
+            return;
+        }
+        
+        SKNode<SSKTweenResizable> *resizableNode = (SKNode<SSKTweenResizable> *)node;
+        SSKTweenEngine *engine = [SSKTweenEngine sharedEngine];
+        SSKTweenActionToken *token = [tokensByNode objectForKey:node];
+        
+        // A new token is created when the action starts, or when it's rerun on the same node
+        if (!token || elapsedTime < token.elapsedTime) {
+            CGSize endSize = resizableNode.size;
+            
+            if (!isnan(width)) {
+                endSize.width = width;
+            }
+            
+            if (!isnan(height)) {
+                endSize.height = height;
+            }
+            
+            token = [SSKTweenActionToken new];
+            token.startSize = resizableNode.size;
+            token.endSize = endSize;
+            
+            [tokensByNode setObject:token forKey:node];
+            [engine beginActionTween:token forNode:node];
+        }
+        
+        token.elapsedTime = elapsedTime;
+        
+        // SpriteKit passes the elapsed time scaled by the node's speed, and stops calling while it's paused
+        const double progress = duration > 0 ? elapsedTime / duration : 1;
+        
+        // A later resize action or tween of the node replaces this one, which then leaves the node alone
+        if (![engine isActionTween:token activeForNode:node]) {
+            if (progress >= 1) {
+                [tokensByNode removeObjectForKey:node];
+            }
+            
+            return;
+        }
+        
+        const double easedProgress = SSKTweenGetEasedProgress(easing, progress);
+        const CGSize startSize = token.startSize;
+        const CGSize endSize = token.endSize;
+        
+        resizableNode.size = CGSizeMake(startSize.width + (endSize.width - startSize.width) * easedProgress,
+                                        startSize.height + (endSize.height - startSize.height) * easedProgress);
+        
+        if (progress >= 1) {
+            [tokensByNode removeObjectForKey:node];
+            [engine endActionTween:token forNode:node];
+        }
+    }];
+}
+
+- (id)init
+{
+    if (!(self = [super init])) {
+        return nil;
+    }
+    
+    _targets = [NSMutableArray new];
+    _targetsByNode = [NSMapTable weakToStrongObjectsMapTable];
+    _actionTokensByNode = [NSMapTable weakToStrongObjectsMapTable];
+    _lastUpdateTime = NAN;
+    SSKTweenTableInit(&_table);
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    SSKTweenTableDestroy(&_table);
+}
+
+#pragma mark - Public
+
+- (NSUInteger)activeTweenCount
+{
+    return _table.count;
+}
+
+- (void)resizeNode:(SKNode<SSKTweenResizable> *)node toSize:(CGSize)size duration:(NSTimeInterval)duration easing:(SSKTweenEasing)easing
+{
+    if (!node) {
+        return;
+    }
+    
+    [self removeTweensForNode:node];
+    
+    const CGSize startSize = node.size;
+    size_t index = SSKTweenTableAdd(&_table, startSize.width, startSize.height, size.width, size.height, NAN, duration, easing);
+    
+    if (index == SIZE_MAX) {
+        return;
+    }
+    
+    SSKTweenTarget *target = [SSKTweenTarget new];
+    target.node = node;
+    target.index = index;
+    
+    [self.targets addObject:target];
+    [self.targetsByNode setObject:target forKey:node];
+}
+
+- (void)removeTweensForNode:(SKNode *)node
+{
+    // Removing the token makes any running resize action of the node stop resizing it
+    [self.actionTokensByNode removeObjectForKey:node];
+    
+    SSKTweenTarget *target = [self.targetsByNode objectForKey:node];
+    
+    if (!target) {
+        return;
+    }
+    
+    [self.targetsByNode removeObjectForKey:node];
+    [self removeTweenAtIndex:target.index];
+}
+
+- (void)finishTweensForNode:(SKNode *)node
+{
+    SSKTweenActionToken *token = [self.actionTokensByNode objectForKey:node];
+    
+    if (token) {
+        ((SKNode<SSKTweenResizable> *)node).size = token.endSize;
+        [self.actionTokensByNode removeObjectForKey:node];
+    }
+    
+    SSKTweenTarget *target = [self.targetsByNode objectForKey:node];
+    
+    if (!target) {
+        return;
+    }
+    
+    target.node.size = CGSizeMake(_table.endX[target.index], _table.endY[target.index]);
+    
+    [self.targetsByNode removeObjectForKey:node];
+    [self removeTweenAtIndex:target.index];
+}
+
+- (void)updateWithCurrentTime:(NSTimeInterval)currentTime
+{
+    const NSTimeInterval timeDelta = isnan(self.lastUpdateTime) ? 0 : currentTime - self.lastUpdateTime;
+    self.lastUpdateTime = currentTime;
+    
+    if (_table.count == 0) {
+        return;
+    }
+    
+    double *startTime = _table.startTime;
+    
+    // Tweens of paused or slowed down nodes are held back by moving their start time forward, like SpriteKit does for actions
+    for (size_t index = 0; index < _table.count; index++) {
+        SKNode *node = [[self.targets objectAtIndex:index] node];
+        
+        if (!node || isnan(startTime[index])) {
+            continue;
+        }
+        
+        const CGFloat speed = SSKTweenEngineGetEffectiveSpeedOfNode(node);
+        
+        if (speed != 1) {
+            startTime[index] += timeDelta * (1 - speed);
+        }
+    }
+    
+    size_t finishedCount = SSKTweenTableStep(&_table, currentTime);
+    
+    const double *valueX = _table.valueX;
+    const double *valueY = _table.valueY;
+    
+    BOOL hasRemovedNodes = NO;
+    
+    for (size_t index = 0; index < _table.count; index++) {
+        SSKTweenTarget *target = [self.targets objectAtIndex:index];
+        SKNode<SSKTweenResizable> *node = target.node;
+        
+        if (!node) {
+            hasRemovedNodes = YES;
+            continue;
+        }
+        
+        node.size = CGSizeMake(valueX[index], valueY[index]);
+    }
+    
+    if (finishedCount == 0 && !hasRemovedNodes) {
+        return;
+    }
+    
+    // Iterating backwards, since removing a tween moves the last tween into its index
+    for (size_t index = _table.count; index > 0; index--) {
+        SSKTweenTarget *target = [self.targets objectAtIndex:index - 1];
+        SKNode *node = target.node;
+        
+        if (node && _table.progress[index - 1] < 1) {
+            continue;
+        }
+        
+        if (node) {
+            [self.targetsByNode removeObjectForKey:node];
+        }
+        
+        [self removeTweenAtIndex:index - 1];
+    }
+}
+
+#pragma mark - Resize actions
+
+- (void)beginActionTween:(SSKTweenActionToken *)token forNode:(SKNode *)node
+{
+    [self removeTweensForNode:node];
+    [self.actionTokensByNode setObject:token forKey:node];
+}
+
+- (BOOL)isActionTween:(SSKTweenActionToken *)token activeForNode:(SKNode *)node
+{
+    return [self.actionTokensByNode objectForKey:node] == token;
+}
+
+- (void)endActionTween:(SSKTweenActionToken *)token forNode:(SKNode *)node
+{
+    // Only the action that owns the node's current token may end it, so that finishing can't affect a newer tween
+    if ([self isActionTween:token activeForNode:node]) {
+        [self.actionTokensByNode removeObjectForKey:node];
+    }
+}
+
+#pragma mark - Utilities
+
+- (void)removeTweenAtIndex:(size_t)index
+{
+    const size_t lastIndex = _table.count - 1;
+    
+    SSKTweenTableRemove(&_table, index);
+    
+    SSKTweenTarget *lastTarget = [self.targets objectAtIndex:lastIndex];
+    lastTarget.index = index;
+    
+    [self.targets replaceObjectAtIndex:index withObject:lastTarget];
+    [self.targets removeLastObject];
+}
+
+@end
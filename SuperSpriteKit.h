@@ -6,7 +6,14 @@
 #import "SKSpriteNode+SSKAnimation.h"
 
 #import "SSKInteractionHandler.h"
+#import "SSKTextureRegionCache.h"
+#import "SSKLayoutPass.h"
+#import "SSKTweenEngine.h"
 #import "SSKMultiLineLabelNode.h"
 #import "SSKTileableNode.h"
+#import "SSKTilemapNode.h"
 #import "SSKStretchableNode.h"
-#import "SSKButtonNode.h"
\ No newline at end of file
+#import "SSKStretchableBatch.h"
+#import "SSKButtonNode.h"
+#import "SSKButtonStyle.h"
+#import "SSKListNode.h"
\ No newline at end of file
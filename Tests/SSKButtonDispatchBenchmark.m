@@ -0,0 +1,101 @@
+#import "SSKButtonNode.h"
+#include "SSKTestSupport.h"
+
+@interface SSKButtonDispatchBenchmarkTarget : NSObject
+
+@property (nonatomic) NSUInteger callCount;
+
+- (void)buttonNodeWasTapped:(SSKButtonNode *)buttonNode;
+
+@end
+
+@implementation SSKButtonDispatchBenchmarkTarget
+
+- (void)buttonNodeWasTapped:(SSKButtonNode *)buttonNode
+{
+    self.callCount++;
+}
+
+@end
+
+static double SSKButtonDispatchBenchmarkRun(NSArray *buttonNodes, NSUInteger roundCount)
+{
+    double startTime = SSKTestGetTime();
+    
+    for (NSUInteger round = 0; round < roundCount; round++) {
+        @autoreleasepool {
+            for (SSKButtonNode *buttonNode in buttonNodes) {
+                buttonNode.state = SSKButtonStateHighlighted;
+                buttonNode.state = SSKButtonStateNormal;
+            }
+        }
+    }
+    
+    return SSKTestGetTime() - startTime;
+}
+
+/**
+ *  Benchmarks dispatching actions across a large grid of buttons, by moving every button in
+ *  and out of the highlighted state, with no actions, target-actions & block handlers attached
+ *
+ *  @discussion The time per state change includes the button's own bookkeeping (like scheduling
+ *  its layout), so the cost of dispatch is the difference to the run without any actions.
+ */
+int main(void)
+{
+    @autoreleasepool {
+        const NSUInteger columnCount = 100;
+        const NSUInteger rowCount = 100;
+        const NSUInteger actionsPerButton = 4;
+        const NSUInteger roundCount = 10;
+        
+        NSMutableArray *targets = [NSMutableArray new];
+        NSMutableArray *buttonNodes = [NSMutableArray new];
+        NSMutableArray *targetButtonNodes = [NSMutableArray new];
+        NSMutableArray *handlerButtonNodes = [NSMutableArray new];
+        __block NSUInteger handlerCallCount = 0;
+        
+        // Targets are unique per state, so each action of a button gets its own target
+        for (NSUInteger actionIndex = 0; actionIndex < actionsPerButton; actionIndex++) {
+            [targets addObject:[SSKButtonDispatchBenchmarkTarget new]];
+        }
+        
+        for (NSUInteger index = 0; index < columnCount * rowCount; index++) {
+            SSKButtonNode *buttonNode = [SSKButtonNode buttonNodeWithSize:CGSizeMake(60, 30)];
+            [buttonNodes addObject:buttonNode];
+            
+            SSKButtonNode *targetButtonNode = [SSKButtonNode buttonNodeWithSize:CGSizeMake(60, 30)];
+            SSKButtonNode *handlerButtonNode = [SSKButtonNode buttonNodeWithSize:CGSizeMake(60, 30)];
+            
+            for (NSUInteger actionIndex = 0; actionIndex < actionsPerButton; actionIndex++) {
+                SSKButtonState state = actionIndex % 2 == 0 ? SSKButtonStateHighlighted : SSKButtonStateNormal;
+                [targetButtonNode addTarget:[targets objectAtIndex:actionIndex] action:@selector(buttonNodeWasTapped:) forState:state];
+                
+                [handlerButtonNode addActionHandler:^(SSKButtonNode *sender) {
+                    handlerCallCount++;
+                } forState:state];
+            }
+            
+            [targetButtonNodes addObject:targetButtonNode];
+            [handlerButtonNodes addObject:handlerButtonNode];
+        }
+        
+        const double stateChangeCount = (double)(columnCount * rowCount * roundCount * 2);
+        double baselineTime = SSKButtonDispatchBenchmarkRun(buttonNodes, roundCount);
+        double targetTime = SSKButtonDispatchBenchmarkRun(targetButtonNodes, roundCount);
+        double handlerTime = SSKButtonDispatchBenchmarkRun(handlerButtonNodes, roundCount);
+        
+        NSUInteger targetCallCount = 0;
+        
+        for (SSKButtonDispatchBenchmarkTarget *target in targets) {
+            targetCallCount += target.callCount;
+        }
+        
+        printf("buttons: %lu, state changes: %.0f\n", (unsigned long)(columnCount * rowCount), stateChangeCount);
+        printf("no actions: %.1f ns/state change\n", baselineTime * 1e9 / stateChangeCount);
+        printf("target-actions: %.1f ns/state change (%lu calls)\n", targetTime * 1e9 / stateChangeCount, (unsigned long)targetCallCount);
+        printf("block handlers: %.1f ns/state change (%lu calls)\n", handlerTime * 1e9 / stateChangeCount, (unsigned long)handlerCallCount);
+    }
+    
+    return 0;
+}
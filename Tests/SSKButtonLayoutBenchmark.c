@@ -0,0 +1,64 @@
+#include "SSKButtonLayout.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static void SSKButtonLayoutBenchmarkRun(size_t count)
+{
+    const size_t iterationCount = 200;
+    
+    SSKButtonLayoutInput *inputs = malloc(count * sizeof(SSKButtonLayoutInput));
+    SSKButtonLayoutOutput *outputs = malloc(count * sizeof(SSKButtonLayoutOutput));
+    unsigned int seed = 7;
+    
+    // A level select screen: a grid of equally sized buttons, with & without icons, and titles of varying widths
+    for (size_t index = 0; index < count; index++) {
+        memset(&inputs[index], 0, sizeof(SSKButtonLayoutInput));
+        inputs[index].width = 120;
+        inputs[index].height = 44;
+        inputs[index].hasIcon = index % 3 == 0;
+        inputs[index].iconWidth = 24;
+        inputs[index].iconHeight = 24;
+        inputs[index].iconLabelMargin = 6;
+        inputs[index].titleWidth = 20 + SSKTestGetRandom(&seed) % 60;
+    }
+    
+    double startTime = SSKTestGetTime();
+    
+    for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+        for (size_t index = 0; index < count; index++) {
+            SSKButtonLayoutCompute(&inputs[index], &outputs[index]);
+        }
+    }
+    
+    double serialTime = (SSKTestGetTime() - startTime) / iterationCount;
+    double checksum = outputs[count - 1].titleX;
+    
+    startTime = SSKTestGetTime();
+    
+    for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+        SSKButtonLayoutComputeBatch(inputs, outputs, count);
+    }
+    
+    double batchTime = (SSKTestGetTime() - startTime) / iterationCount;
+    checksum += outputs[count - 1].titleX;
+    
+    printf("buttons: %zu\n", count);
+    printf("  serial: %.3f ms (%.1f ns/button)\n", serialTime * 1000, serialTime * 1e9 / count);
+    printf("  batch: %.3f ms (%.1f ns/button, %.2fx, checksum %.0f)\n", batchTime * 1000, batchTime * 1e9 / count, serialTime / batchTime, checksum);
+    
+    free(inputs);
+    free(outputs);
+}
+
+/**
+ *  Benchmarks laying out large batches of buttons serially vs using SSKButtonLayoutComputeBatch
+ */
+int main(void)
+{
+    SSKButtonLayoutBenchmarkRun(10000);
+    SSKButtonLayoutBenchmarkRun(100000);
+    
+    return 0;
+}
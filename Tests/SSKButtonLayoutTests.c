@@ -0,0 +1,117 @@
+#include "SSKButtonLayout.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static SSKButtonLayoutInput SSKButtonLayoutTestsMakeInput(unsigned int *seed)
+{
+    SSKButtonLayoutInput input;
+    memset(&input, 0, sizeof(input));
+    
+    input.width = 40 + SSKTestGetRandom(seed) % 200;
+    input.height = 20 + SSKTestGetRandom(seed) % 60;
+    input.hasIcon = SSKTestGetRandom(seed) % 2 == 0;
+    input.iconWidth = SSKTestGetRandom(seed) % 32;
+    input.iconHeight = SSKTestGetRandom(seed) % 32;
+    input.iconLabelMargin = SSKTestGetRandom(seed) % 8;
+    input.titleWidth = (double)(SSKTestGetRandom(seed) % 1000) / 7;
+    input.titleOffsetTop = SSKTestGetRandom(seed) % 4;
+    input.titleOffsetLeft = SSKTestGetRandom(seed) % 4;
+    input.titleOffsetBottom = SSKTestGetRandom(seed) % 4;
+    input.titleOffsetRight = SSKTestGetRandom(seed) % 4;
+    
+    return input;
+}
+
+static bool SSKButtonLayoutTestsOutputsAreEqual(const SSKButtonLayoutOutput *output, const SSKButtonLayoutOutput *otherOutput)
+{
+    return output->iconX == otherOutput->iconX
+        && output->iconY == otherOutput->iconY
+        && output->titleX == otherOutput->titleX
+        && output->titleY == otherOutput->titleY
+        && output->titleIsLeftAligned == otherOutput->titleIsLeftAligned
+        && output->backgroundX == otherOutput->backgroundX
+        && output->backgroundY == otherOutput->backgroundY
+        && output->backgroundWidth == otherOutput->backgroundWidth
+        && output->backgroundHeight == otherOutput->backgroundHeight;
+}
+
+static void SSKButtonLayoutTestsSingleButton(void)
+{
+    SSKButtonLayoutInput input;
+    SSKButtonLayoutOutput output;
+    memset(&input, 0, sizeof(input));
+    
+    // Without an icon, the title is centered
+    input.width = 101;
+    input.height = 41;
+    input.titleWidth = 50;
+    SSKButtonLayoutCompute(&input, &output);
+    
+    SSKTestAssert(!output.titleIsLeftAligned);
+    SSKTestAssert(output.titleX == 50 && output.titleY == 20);
+    SSKTestAssert(output.backgroundWidth == 101 && output.backgroundHeight == 41);
+    
+    // With an icon, the icon & title are centered together, and the title is left aligned after the icon
+    input.hasIcon = true;
+    input.iconWidth = 20;
+    input.iconHeight = 20;
+    input.iconLabelMargin = 10;
+    SSKButtonLayoutCompute(&input, &output);
+    
+    SSKTestAssert(output.titleIsLeftAligned);
+    SSKTestAssert(output.iconX == 10 && output.iconY == 10);
+    SSKTestAssert(output.titleX == 40 && output.titleY == 20);
+    
+    // Title offsets are applied like edge insets
+    input.titleOffsetTop = 2;
+    input.titleOffsetLeft = 3;
+    input.titleOffsetBottom = 5;
+    input.titleOffsetRight = 7;
+    SSKButtonLayoutCompute(&input, &output);
+    
+    SSKTestAssert(output.titleX == 36 && output.titleY == 23);
+}
+
+static void SSKButtonLayoutTestsBatchMatchesSingleButtons(void)
+{
+    // Around the chunk size, and large enough to be split across all threads
+    const size_t counts[] = {0, 1, 1023, 1024, 1025, 10000, 100000};
+    unsigned int seed = 13;
+    
+    for (size_t countIndex = 0; countIndex < sizeof(counts) / sizeof(counts[0]); countIndex++) {
+        const size_t count = counts[countIndex];
+        SSKButtonLayoutInput *inputs = malloc((count + 1) * sizeof(SSKButtonLayoutInput));
+        SSKButtonLayoutOutput *outputs = malloc((count + 1) * sizeof(SSKButtonLayoutOutput));
+        
+        for (size_t index = 0; index < count; index++) {
+            inputs[index] = SSKButtonLayoutTestsMakeInput(&seed);
+        }
+        
+        // Every output must be written, and nothing past the last one
+        memset(outputs, 0xff, (count + 1) * sizeof(SSKButtonLayoutOutput));
+        SSKButtonLayoutOutput sentinel = outputs[count];
+        
+        SSKButtonLayoutComputeBatch(inputs, outputs, count);
+        
+        for (size_t index = 0; index < count; index++) {
+            SSKButtonLayoutOutput expectedOutput;
+            SSKButtonLayoutCompute(&inputs[index], &expectedOutput);
+            SSKTestAssert(SSKButtonLayoutTestsOutputsAreEqual(&outputs[index], &expectedOutput));
+        }
+        
+        SSKTestAssert(memcmp(&outputs[count], &sentinel, sizeof(SSKButtonLayoutOutput)) == 0);
+        
+        free(inputs);
+        free(outputs);
+    }
+}
+
+int main(void)
+{
+    SSKButtonLayoutTestsSingleButton();
+    SSKButtonLayoutTestsBatchMatchesSingleButtons();
+    
+    return SSKTestGetExitCode();
+}
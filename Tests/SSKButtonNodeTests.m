@@ -0,0 +1,78 @@
+#import "SSKButtonNode.h"
+#include "SSKTestSupport.h"
+
+#pragma mark - Utilities
+
+@interface SSKButtonNodeTestsTarget : NSObject
+
+@property (nonatomic) NSUInteger callCount;
+
+- (void)buttonNodeWasTapped:(SSKButtonNode *)buttonNode;
+
+@end
+
+@implementation SSKButtonNodeTestsTarget
+
+- (void)buttonNodeWasTapped:(SSKButtonNode *)buttonNode
+{
+    self.callCount++;
+}
+
+@end
+
+#pragma mark - Tests
+
+static void SSKButtonNodeTestsHandlersCanRemoveThemselves(void)
+{
+    SSKButtonNode *buttonNode = [SSKButtonNode buttonNodeWithSize:CGSizeMake(100, 40)];
+    SSKButtonNodeTestsTarget *target = [SSKButtonNodeTestsTarget new];
+    __block NSUInteger handlerCallCount = 0;
+    __block id handlerToken = nil;
+    
+    handlerToken = [buttonNode addActionHandler:^(SSKButtonNode *sender) {
+        handlerCallCount++;
+        [sender removeActionHandler:handlerToken forState:SSKButtonStateHighlighted];
+    } forState:SSKButtonStateHighlighted];
+    
+    [buttonNode addTarget:target action:@selector(buttonNodeWasTapped:) forState:SSKButtonStateHighlighted];
+    
+    // Removing a handler while the handlers are being performed must neither throw nor skip the next one
+    buttonNode.state = SSKButtonStateHighlighted;
+    SSKTestAssert(handlerCallCount == 1);
+    SSKTestAssert(target.callCount == 1);
+    
+    buttonNode.state = SSKButtonStateNormal;
+    buttonNode.state = SSKButtonStateHighlighted;
+    SSKTestAssert(handlerCallCount == 1);
+    SSKTestAssert(target.callCount == 2);
+}
+
+static void SSKButtonNodeTestsHandlersCanAddHandlers(void)
+{
+    SSKButtonNode *buttonNode = [SSKButtonNode buttonNodeWithSize:CGSizeMake(100, 40)];
+    __block NSUInteger addedHandlerCallCount = 0;
+    
+    [buttonNode addActionHandler:^(SSKButtonNode *sender) {
+        [sender addActionHandler:^(SSKButtonNode *innerSender) {
+            addedHandlerCallCount++;
+        } forState:SSKButtonStateHighlighted];
+    } forState:SSKButtonStateHighlighted];
+    
+    // Added handlers are only called the next time the button enters the state
+    buttonNode.state = SSKButtonStateHighlighted;
+    SSKTestAssert(addedHandlerCallCount == 0);
+    
+    buttonNode.state = SSKButtonStateNormal;
+    buttonNode.state = SSKButtonStateHighlighted;
+    SSKTestAssert(addedHandlerCallCount == 1);
+}
+
+int main(void)
+{
+    @autoreleasepool {
+        SSKButtonNodeTestsHandlersCanRemoveThemselves();
+        SSKButtonNodeTestsHandlersCanAddHandlers();
+    }
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,229 @@
+#include "SSKInputLog.h"
+#include "SSKTestSupport.h"
+
+#include <string.h>
+
+static const char *SSKInputLogTestsPath = "SSKInputLogTests.log";
+
+#pragma mark - Utilities
+
+static SSKInputEvent SSKInputLogTestsMakeEvent(size_t index)
+{
+    SSKInputEvent event;
+    memset(&event, 0, sizeof(event));
+    event.kind = (uint8_t)(index % (SSKInputEventKindSpecialKeyReleased + 1));
+    event.interactionType = (uint8_t)(index % 3);
+    event.key = (uint16_t)(index * 7);
+    event.pointerID = index * 1000003;
+    event.x = (double)index * 1.5;
+    event.y = -(double)index;
+    event.dx = 0.25;
+    event.dy = (double)index / 3;
+    
+    return event;
+}
+
+static void SSKInputLogTestsWriteFile(const void *bytes, size_t size)
+{
+    FILE *file = fopen(SSKInputLogTestsPath, "wb");
+    SSKTestAssert(file != NULL);
+    
+    if (size > 0) {
+        SSKTestAssert(fwrite(bytes, size, 1, file) == 1);
+    }
+    
+    fclose(file);
+}
+
+static bool SSKInputLogTestsWriteLog(const double *timestamps, size_t count)
+{
+    SSKInputLogWriter writer;
+    
+    if (!SSKInputLogWriterOpen(&writer, SSKInputLogTestsPath)) {
+        return false;
+    }
+    
+    for (size_t index = 0; index < count; index++) {
+        SSKInputEvent event = SSKInputLogTestsMakeEvent(index);
+        SSKTestAssert(SSKInputLogWriterAppend(&writer, timestamps[index], &event));
+    }
+    
+    SSKTestAssert(writer.recordCount == count);
+    
+    return SSKInputLogWriterClose(&writer);
+}
+
+#pragma mark - Tests
+
+static void SSKInputLogTestsRoundTrip(void)
+{
+    double timestamps[100];
+    
+    for (size_t index = 0; index < 100; index++) {
+        timestamps[index] = (double)index / 100;
+    }
+    
+    SSKTestAssert(SSKInputLogTestsWriteLog(timestamps, 100));
+    
+    SSKInputLogReader reader;
+    SSKTestAssert(SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    SSKTestAssert(reader.recordCount == 100);
+    
+    for (size_t index = 0; index < reader.recordCount; index++) {
+        const SSKInputLogRecord *record = &reader.records[index];
+        const SSKInputEvent event = SSKInputLogTestsMakeEvent(index);
+        
+        SSKTestAssert(record->timestamp == timestamps[index]);
+        SSKTestAssert(record->event.kind == event.kind);
+        SSKTestAssert(record->event.interactionType == event.interactionType);
+        SSKTestAssert(record->event.key == event.key);
+        SSKTestAssert(record->event.pointerID == event.pointerID);
+        SSKTestAssert(record->event.x == event.x && record->event.y == event.y);
+        SSKTestAssert(record->event.dx == event.dx && record->event.dy == event.dy);
+    }
+    
+    SSKInputLogReaderClose(&reader);
+    SSKTestAssert(reader.records == NULL && reader.recordCount == 0);
+    
+    // An empty log is still a valid one
+    SSKTestAssert(SSKInputLogTestsWriteLog(NULL, 0));
+    SSKTestAssert(SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    SSKTestAssert(reader.recordCount == 0);
+    SSKInputLogReaderClose(&reader);
+    
+    remove(SSKInputLogTestsPath);
+}
+
+static void SSKInputLogTestsIdenticalSessionsProduceIdenticalFiles(void)
+{
+    const double timestamps[3] = {0, 0.5, 1};
+    unsigned char bytes[2][8 + 3 * sizeof(SSKInputLogRecord)];
+    
+    for (size_t session = 0; session < 2; session++) {
+        SSKTestAssert(SSKInputLogTestsWriteLog(timestamps, 3));
+        
+        FILE *file = fopen(SSKInputLogTestsPath, "rb");
+        SSKTestAssert(file != NULL);
+        SSKTestAssert(fread(bytes[session], sizeof(bytes[session]), 1, file) == 1);
+        SSKTestAssert(fgetc(file) == EOF);
+        fclose(file);
+    }
+    
+    SSKTestAssert(memcmp(bytes[0], bytes[1], sizeof(bytes[0])) == 0);
+    
+    remove(SSKInputLogTestsPath);
+}
+
+static void SSKInputLogTestsRejectsCorruptHeaders(void)
+{
+    SSKInputLogReader reader;
+    
+    remove(SSKInputLogTestsPath);
+    SSKTestAssert(!SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    
+    // Empty & truncated headers
+    SSKInputLogTestsWriteFile(NULL, 0);
+    SSKTestAssert(!SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    
+    SSKInputLogTestsWriteFile("SSKL", 4);
+    SSKTestAssert(!SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    
+    // Wrong magic, with a valid version
+    unsigned char header[8] = {'S', 'S', 'K', 'X'};
+    const uint32_t version = 1;
+    memcpy(header + 4, &version, sizeof(version));
+    SSKInputLogTestsWriteFile(header, sizeof(header));
+    SSKTestAssert(!SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    SSKTestAssert(reader.records == NULL && reader.mapping == NULL);
+    
+    // Valid magic, with an unknown version
+    header[3] = 'L';
+    const uint32_t unknownVersion = 2;
+    memcpy(header + 4, &unknownVersion, sizeof(unknownVersion));
+    SSKInputLogTestsWriteFile(header, sizeof(header));
+    SSKTestAssert(!SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    
+    memcpy(header + 4, &version, sizeof(version));
+    SSKInputLogTestsWriteFile(header, sizeof(header));
+    SSKTestAssert(SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    SSKTestAssert(reader.recordCount == 0);
+    SSKInputLogReaderClose(&reader);
+    
+    remove(SSKInputLogTestsPath);
+}
+
+static void SSKInputLogTestsIgnoresTruncatedRecords(void)
+{
+    const double timestamps[2] = {0, 1};
+    SSKTestAssert(SSKInputLogTestsWriteLog(timestamps, 2));
+    
+    // A log cut off while recording keeps all of its complete records
+    FILE *file = fopen(SSKInputLogTestsPath, "ab");
+    SSKTestAssert(file != NULL);
+    SSKTestAssert(fwrite(timestamps, sizeof(double), 1, file) == 1);
+    fclose(file);
+    
+    SSKInputLogReader reader;
+    SSKTestAssert(SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    SSKTestAssert(reader.recordCount == 2);
+    SSKTestAssert(reader.records[1].timestamp == 1);
+    SSKInputLogReaderClose(&reader);
+    
+    remove(SSKInputLogTestsPath);
+}
+
+static void SSKInputLogTestsGetFrameEnd(void)
+{
+    const double frameDuration = 0.25;
+    const double timestamps[7] = {0, 0.1, 0.25, 0.3, 1.05, 1.1, 3};
+    SSKTestAssert(SSKInputLogTestsWriteLog(timestamps, 7));
+    
+    SSKInputLogReader reader;
+    SSKTestAssert(SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    
+    double frameEndTime = -1;
+    
+    SSKTestAssert(SSKInputLogReaderGetFrameEnd(&reader, 0, frameDuration, &frameEndTime) == 2);
+    SSKTestAssert(frameEndTime == 0.25);
+    
+    SSKTestAssert(SSKInputLogReaderGetFrameEnd(&reader, 2, frameDuration, &frameEndTime) == 4);
+    SSKTestAssert(frameEndTime == 0.5);
+    
+    // Empty frames are skipped
+    SSKTestAssert(SSKInputLogReaderGetFrameEnd(&reader, 4, frameDuration, &frameEndTime) == 6);
+    SSKTestAssert(frameEndTime == 1.25);
+    
+    SSKTestAssert(SSKInputLogReaderGetFrameEnd(&reader, 6, frameDuration, &frameEndTime) == 7);
+    SSKTestAssert(frameEndTime == 3.25);
+    
+    SSKTestAssert(SSKInputLogReaderGetFrameEnd(&reader, 7, frameDuration, &frameEndTime) == 7);
+    
+    // Without a frame duration, all remaining records are one frame
+    SSKTestAssert(SSKInputLogReaderGetFrameEnd(&reader, 1, 0, &frameEndTime) == 7);
+    SSKTestAssert(frameEndTime == 3);
+    
+    SSKInputLogReaderClose(&reader);
+    
+    // Timestamps that go back in time still make progress, one frame at a time
+    const double unorderedTimestamps[3] = {1, 0.5, 0.6};
+    SSKTestAssert(SSKInputLogTestsWriteLog(unorderedTimestamps, 3));
+    SSKTestAssert(SSKInputLogReaderOpen(&reader, SSKInputLogTestsPath));
+    
+    SSKTestAssert(SSKInputLogReaderGetFrameEnd(&reader, 0, frameDuration, &frameEndTime) == 3);
+    SSKTestAssert(frameEndTime == 1.25);
+    
+    SSKInputLogReaderClose(&reader);
+    
+    remove(SSKInputLogTestsPath);
+}
+
+int main(void)
+{
+    SSKInputLogTestsRoundTrip();
+    SSKInputLogTestsIdenticalSessionsProduceIdenticalFiles();
+    SSKInputLogTestsRejectsCorruptHeaders();
+    SSKInputLogTestsIgnoresTruncatedRecords();
+    SSKInputLogTestsGetFrameEnd();
+    
+    return SSKTestGetExitCode();
+}
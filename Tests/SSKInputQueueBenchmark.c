@@ -0,0 +1,95 @@
+#include "SSKInputQueue.h"
+#include "SSKTestSupport.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#define SSKInputQueueBenchmarkEventCount 4000000
+
+static int SSKInputQueueBenchmarkCompareLatencies(const void *latency, const void *otherLatency)
+{
+    const double value = *(const double *)latency;
+    const double otherValue = *(const double *)otherLatency;
+    
+    return value < otherValue ? -1 : (value > otherValue ? 1 : 0);
+}
+
+static void *SSKInputQueueBenchmarkRunProducer(void *context)
+{
+    SSKInputQueue *queue = context;
+    
+    for (size_t index = 0; index < SSKInputQueueBenchmarkEventCount; index++) {
+        // Every 64th event is a key event, so that there are runs of moves to coalesce, and the push time is stored as dy
+        SSKInputEvent event = {0};
+        event.kind = index % 64 == 0 ? SSKInputEventKindKeyPressed : SSKInputEventKindPointerMoved;
+        event.x = (double)index;
+        event.dx = 1;
+        event.dy = SSKTestGetTime();
+        
+        while (!SSKInputQueuePush(queue, &event)) {
+            sched_yield();
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ *  Benchmarks the input queue with a producer thread pushing events as fast as possible while
+ *  the consumer drains them, measuring throughput and the latency from push to drain
+ *
+ *  @discussion For drained events that moves were merged into, the latency is the average
+ *  latency of the merged events.
+ */
+int main(void)
+{
+    SSKInputQueue queue;
+    SSKInputQueueInit(&queue, 1024);
+    
+    SSKInputEvent *drainedEvents = malloc(1024 * sizeof(SSKInputEvent));
+    double *latencies = malloc(SSKInputQueueBenchmarkEventCount * sizeof(double));
+    size_t latencyCount = 0;
+    double lastIndex = -1;
+    double eventCount = 0;
+    
+    pthread_t producer;
+    double startTime = SSKTestGetTime();
+    pthread_create(&producer, NULL, SSKInputQueueBenchmarkRunProducer, &queue);
+    
+    while (lastIndex < SSKInputQueueBenchmarkEventCount - 1) {
+        size_t count = SSKInputQueueDrain(&queue, drainedEvents, 1024);
+        
+        if (count == 0) {
+            sched_yield();
+            continue;
+        }
+        
+        const double drainTime = SSKTestGetTime();
+        
+        for (size_t index = 0; index < count; index++) {
+            // Merging sums the velocities, so dx is the number of merged events, and dy the sum of their push times
+            const double mergedCount = drainedEvents[index].dx;
+            
+            latencies[latencyCount++] = drainTime - drainedEvents[index].dy / mergedCount;
+            lastIndex = drainedEvents[index].x;
+            eventCount += mergedCount;
+        }
+    }
+    
+    double totalTime = SSKTestGetTime() - startTime;
+    pthread_join(producer, NULL);
+    
+    qsort(latencies, latencyCount, sizeof(double), SSKInputQueueBenchmarkCompareLatencies);
+    
+    printf("events: %.0f, drained events: %zu (%.1f events/drained event)\n", eventCount, latencyCount, eventCount / latencyCount);
+    printf("throughput: %.1f M events/s (%.1f ns/event)\n", eventCount / totalTime / 1e6, totalTime * 1e9 / eventCount);
+    printf("latency: median %.2f us, p99 %.2f us, max %.2f us\n",
+           latencies[latencyCount / 2] * 1e6, latencies[latencyCount * 99 / 100] * 1e6, latencies[latencyCount - 1] * 1e6);
+    
+    free(drainedEvents);
+    free(latencies);
+    SSKInputQueueDestroy(&queue);
+    
+    return 0;
+}
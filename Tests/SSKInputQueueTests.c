@@ -0,0 +1,272 @@
+#include "SSKInputQueue.h"
+#include "SSKTestSupport.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+static SSKInputEvent SSKInputQueueTestsMakeEvent(SSKInputEventKind kind, uint64_t pointerID, double x)
+{
+    SSKInputEvent event = {0};
+    event.kind = kind;
+    event.pointerID = pointerID;
+    event.x = x;
+    event.y = -x;
+    event.dx = 1;
+    event.dy = 2;
+    
+    return event;
+}
+
+static size_t SSKInputQueueTestsPushAndDrain(const SSKInputEvent *events, size_t count, SSKInputEvent *drainedEvents, size_t capacity)
+{
+    SSKInputQueue queue;
+    SSKTestAssert(SSKInputQueueInit(&queue, 64));
+    
+    for (size_t index = 0; index < count; index++) {
+        SSKTestAssert(SSKInputQueuePush(&queue, &events[index]));
+    }
+    
+    size_t drainedCount = SSKInputQueueDrain(&queue, drainedEvents, capacity);
+    SSKInputQueueDestroy(&queue);
+    
+    return drainedCount;
+}
+
+static void SSKInputQueueTestsPushAndPop(void)
+{
+    SSKInputQueue queue;
+    SSKTestAssert(SSKInputQueueInit(&queue, 5));
+    SSKTestAssert(queue.capacity == 8);
+    
+    SSKInputEvent event;
+    SSKTestAssert(!SSKInputQueuePop(&queue, &event));
+    
+    // Wrapping around the ring buffer a few times
+    for (size_t round = 0; round < 3; round++) {
+        for (size_t index = 0; index < 8; index++) {
+            event = SSKInputQueueTestsMakeEvent(SSKInputEventKindKeyPressed, 0, (double)index);
+            SSKTestAssert(SSKInputQueuePush(&queue, &event));
+        }
+        
+        SSKTestAssert(!SSKInputQueuePush(&queue, &event));
+        
+        for (size_t index = 0; index < 8; index++) {
+            SSKTestAssert(SSKInputQueuePop(&queue, &event));
+            SSKTestAssert(event.x == (double)index);
+        }
+        
+        SSKTestAssert(!SSKInputQueuePop(&queue, &event));
+    }
+    
+    SSKInputQueueDestroy(&queue);
+}
+
+static void SSKInputQueueTestsMergesConsecutiveMoves(void)
+{
+    const SSKInputEvent events[] = {
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindPointStarted, 1, 0),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 1),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 2),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 3),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindPointEnded, 1, 4)
+    };
+    
+    SSKInputEvent drainedEvents[8];
+    size_t count = SSKInputQueueTestsPushAndDrain(events, 5, drainedEvents, 8);
+    
+    SSKTestAssert(count == 3);
+    SSKTestAssert(drainedEvents[0].kind == SSKInputEventKindPointStarted);
+    SSKTestAssert(drainedEvents[1].kind == SSKInputEventKindDrag);
+    SSKTestAssert(drainedEvents[1].x == 3 && drainedEvents[1].y == -3);
+    SSKTestAssert(drainedEvents[1].dx == 3 && drainedEvents[1].dy == 6);
+    SSKTestAssert(drainedEvents[2].kind == SSKInputEventKindPointEnded);
+}
+
+static void SSKInputQueueTestsKeepsOrderAcrossOtherEvents(void)
+{
+    // Drag, Shift pressed, drag: the second drag must still be handled after the key press
+    SSKInputEvent keyEvent = SSKInputQueueTestsMakeEvent(SSKInputEventKindSpecialKeyPressed, 0, 0);
+    SSKInputEvent otherPointerEvent = SSKInputQueueTestsMakeEvent(SSKInputEventKindPointStarted, 2, 0);
+    SSKInputEvent otherInteractionEvent = SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 0);
+    otherInteractionEvent.interactionType = 1;
+    
+    const SSKInputEvent separators[] = {
+        keyEvent,
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindKeyReleased, 0, 0),
+        otherPointerEvent,
+        otherInteractionEvent,
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindPointerMoved, 1, 0)
+    };
+    
+    for (size_t index = 0; index < sizeof(separators) / sizeof(separators[0]); index++) {
+        const SSKInputEvent events[] = {
+            SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 1),
+            separators[index],
+            SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 2)
+        };
+        
+        SSKInputEvent drainedEvents[8];
+        size_t count = SSKInputQueueTestsPushAndDrain(events, 3, drainedEvents, 8);
+        
+        SSKTestAssert(count == 3);
+        SSKTestAssert(drainedEvents[0].x == 1 && drainedEvents[0].dx == 1);
+        SSKTestAssert(drainedEvents[1].kind == separators[index].kind);
+        SSKTestAssert(drainedEvents[2].x == 2 && drainedEvents[2].dx == 1);
+    }
+}
+
+static void SSKInputQueueTestsMergesInterleavedPointers(void)
+{
+    // Two fingers dragging at once: A, B, A, B
+    const SSKInputEvent events[] = {
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 1),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 2, 2),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 3),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 2, 4),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 5),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindPointEnded, 2, 6),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 7),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 2, 8)
+    };
+    
+    SSKInputEvent drainedEvents[8];
+    size_t count = SSKInputQueueTestsPushAndDrain(events, 8, drainedEvents, 8);
+    
+    SSKTestAssert(count == 5);
+    SSKTestAssert(drainedEvents[0].pointerID == 1 && drainedEvents[0].x == 5 && drainedEvents[0].dx == 3);
+    SSKTestAssert(drainedEvents[1].pointerID == 2 && drainedEvents[1].x == 4 && drainedEvents[1].dx == 2);
+    
+    // Moves are not merged across the end of the second pointer
+    SSKTestAssert(drainedEvents[2].kind == SSKInputEventKindPointEnded);
+    SSKTestAssert(drainedEvents[3].pointerID == 1 && drainedEvents[3].x == 7 && drainedEvents[3].dx == 1);
+    SSKTestAssert(drainedEvents[4].pointerID == 2 && drainedEvents[4].x == 8 && drainedEvents[4].dx == 1);
+    
+    // A move of the same pointer with another kind stops the scan, rather than being skipped over
+    const SSKInputEvent mixedEvents[] = {
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 1),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindPointerMoved, 1, 2),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 2, 3),
+        SSKInputQueueTestsMakeEvent(SSKInputEventKindDrag, 1, 4)
+    };
+    
+    count = SSKInputQueueTestsPushAndDrain(mixedEvents, 4, drainedEvents, 8);
+    
+    SSKTestAssert(count == 4);
+    SSKTestAssert(drainedEvents[3].x == 4 && drainedEvents[3].dx == 1);
+}
+
+static void SSKInputQueueTestsDrainCapacity(void)
+{
+    SSKInputQueue queue;
+    SSKTestAssert(SSKInputQueueInit(&queue, 16));
+    
+    for (size_t index = 0; index < 10; index++) {
+        SSKInputEvent event = SSKInputQueueTestsMakeEvent(SSKInputEventKindKeyPressed, 0, (double)index);
+        SSKTestAssert(SSKInputQueuePush(&queue, &event));
+    }
+    
+    SSKInputEvent drainedEvents[4];
+    SSKTestAssert(SSKInputQueueDrain(&queue, drainedEvents, 4) == 4);
+    SSKTestAssert(drainedEvents[3].x == 3);
+    SSKTestAssert(SSKInputQueueDrain(&queue, drainedEvents, 4) == 4);
+    SSKTestAssert(drainedEvents[0].x == 4);
+    SSKTestAssert(SSKInputQueueDrain(&queue, drainedEvents, 4) == 2);
+    SSKTestAssert(SSKInputQueueDrain(&queue, drainedEvents, 4) == 0);
+    
+    SSKInputQueueDestroy(&queue);
+}
+
+#pragma mark - Stress test
+
+#define SSKInputQueueTestsStressEventCount 2000000
+
+static void *SSKInputQueueTestsRunProducer(void *context)
+{
+    SSKInputQueue *queue = context;
+    unsigned int seed = 17;
+    
+    for (size_t index = 0; index < SSKInputQueueTestsStressEventCount; index++) {
+        // Mostly drags from two pointers, with some key events in between, numbered by their x coordinate
+        unsigned int random = SSKTestGetRandom(&seed) % 16;
+        SSKInputEventKind kind = random == 0 ? SSKInputEventKindKeyPressed : SSKInputEventKindDrag;
+        SSKInputEvent event = SSKInputQueueTestsMakeEvent(kind, random < 12 ? 1 : 2, (double)index);
+        
+        while (!SSKInputQueuePush(queue, &event)) {
+            sched_yield();
+        }
+    }
+    
+    return NULL;
+}
+
+static void SSKInputQueueTestsStress(void)
+{
+    SSKInputQueue queue;
+    SSKTestAssert(SSKInputQueueInit(&queue, 256));
+    
+    pthread_t producer;
+    SSKTestAssert(pthread_create(&producer, NULL, SSKInputQueueTestsRunProducer, &queue) == 0);
+    
+    SSKInputEvent drainedEvents[64];
+    double lastIndex = -1;
+    double lastIndexOfPointer[3] = {-1, -1, -1};
+    double lastKeyIndex = -1;
+    double eventCount = 0;
+    size_t drainCount = 0;
+    
+    // Every event must be drained exactly once, either on its own or merged into an earlier move
+    // of its pointer. Moves of each pointer stay in order, and nothing is reordered across key events.
+    while (lastIndex < SSKInputQueueTestsStressEventCount - 1) {
+        size_t count = SSKInputQueueDrain(&queue, drainedEvents, drainCount % 2 == 0 ? 64 : 3);
+        drainCount++;
+        
+        if (count == 0) {
+            sched_yield();
+            continue;
+        }
+        
+        for (size_t index = 0; index < count; index++) {
+            const SSKInputEvent *event = &drainedEvents[index];
+            
+            SSKTestAssert(event->x > lastKeyIndex);
+            SSKTestAssert(event->x > lastIndexOfPointer[event->pointerID]);
+            SSKTestAssert(event->kind == SSKInputEventKindDrag || event->dx == 1);
+            
+            if (event->kind == SSKInputEventKindDrag) {
+                // A drag is never preceded by an unmerged drag of its pointer within the same run of drags
+                for (size_t previousIndex = index; previousIndex > 0 && drainedEvents[previousIndex - 1].kind == SSKInputEventKindDrag; previousIndex--) {
+                    SSKTestAssert(drainedEvents[previousIndex - 1].pointerID != event->pointerID);
+                }
+            } else {
+                SSKTestAssert(event->x > lastIndex);
+                lastKeyIndex = event->x;
+            }
+            
+            lastIndexOfPointer[event->pointerID] = event->x;
+            lastIndex = event->x > lastIndex ? event->x : lastIndex;
+            eventCount += event->dx;
+        }
+    }
+    
+    pthread_join(producer, NULL);
+    
+    SSKTestAssert(lastIndex == SSKInputQueueTestsStressEventCount - 1);
+    SSKTestAssert(eventCount == SSKInputQueueTestsStressEventCount);
+    
+    SSKInputEvent event;
+    SSKTestAssert(!SSKInputQueuePop(&queue, &event));
+    
+    SSKInputQueueDestroy(&queue);
+}
+
+int main(void)
+{
+    SSKInputQueueTestsPushAndPop();
+    SSKInputQueueTestsMergesConsecutiveMoves();
+    SSKInputQueueTestsKeepsOrderAcrossOtherEvents();
+    SSKInputQueueTestsMergesInterleavedPointers();
+    SSKInputQueueTestsDrainCapacity();
+    SSKInputQueueTestsStress();
+    
+    return SSKTestGetExitCode();
+}
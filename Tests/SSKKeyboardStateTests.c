@@ -0,0 +1,152 @@
+#include "SSKKeyboardState.h"
+#include "SSKTestSupport.h"
+
+#pragma mark - Tests
+
+static void SSKKeyboardStateTestsPressAndReleaseAcrossFrames(void)
+{
+    SSKKeyboardState state;
+    SSKKeyboardStateInit(&state);
+    
+    // Key events are only visible once the frame is advanced
+    SSKKeyboardStateSetKeyDown(&state, 4, true);
+    SSKTestAssert(!SSKKeyboardStateIsKeyDown(&state, 4));
+    SSKTestAssert(!SSKKeyboardStateWasKeyPressedThisFrame(&state, 4));
+    
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(SSKKeyboardStateIsKeyDown(&state, 4));
+    SSKTestAssert(SSKKeyboardStateWasKeyPressedThisFrame(&state, 4));
+    SSKTestAssert(!SSKKeyboardStateWasKeyReleasedThisFrame(&state, 4));
+    SSKTestAssert(!SSKKeyboardStateIsKeyDown(&state, 5));
+    
+    // Held keys stay down, but are only pressed in the frame they went down
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(SSKKeyboardStateIsKeyDown(&state, 4));
+    SSKTestAssert(!SSKKeyboardStateWasKeyPressedThisFrame(&state, 4));
+    
+    SSKKeyboardStateSetKeyDown(&state, 4, false);
+    SSKTestAssert(SSKKeyboardStateIsKeyDown(&state, 4));
+    
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(!SSKKeyboardStateIsKeyDown(&state, 4));
+    SSKTestAssert(!SSKKeyboardStateWasKeyPressedThisFrame(&state, 4));
+    SSKTestAssert(SSKKeyboardStateWasKeyReleasedThisFrame(&state, 4));
+    
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(!SSKKeyboardStateWasKeyReleasedThisFrame(&state, 4));
+}
+
+static void SSKKeyboardStateTestsPressAndReleaseWithinOneFrame(void)
+{
+    SSKKeyboardState state;
+    SSKKeyboardStateInit(&state);
+    
+    // A tap between two frames is reported as both pressed & released, but never as down
+    SSKKeyboardStateSetKeyDown(&state, 200, true);
+    SSKKeyboardStateSetKeyDown(&state, 200, false);
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(!SSKKeyboardStateIsKeyDown(&state, 200));
+    SSKTestAssert(SSKKeyboardStateWasKeyPressedThisFrame(&state, 200));
+    SSKTestAssert(SSKKeyboardStateWasKeyReleasedThisFrame(&state, 200));
+    
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(!SSKKeyboardStateWasKeyPressedThisFrame(&state, 200));
+    SSKTestAssert(!SSKKeyboardStateWasKeyReleasedThisFrame(&state, 200));
+    
+    // Releasing & pressing a held key between two frames keeps it down, and reports both
+    SSKKeyboardStateSetKeyDown(&state, 63, true);
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKKeyboardStateSetKeyDown(&state, 63, false);
+    SSKKeyboardStateSetKeyDown(&state, 63, true);
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(SSKKeyboardStateIsKeyDown(&state, 63));
+    SSKTestAssert(SSKKeyboardStateWasKeyPressedThisFrame(&state, 63));
+    SSKTestAssert(SSKKeyboardStateWasKeyReleasedThisFrame(&state, 63));
+}
+
+static void SSKKeyboardStateTestsKeyRepeat(void)
+{
+    SSKKeyboardState state;
+    SSKKeyboardStateInit(&state);
+    
+    SSKKeyboardStateSetKeyDown(&state, 64, true);
+    SSKKeyboardStateAdvanceFrame(&state);
+    
+    // Repeated key down events of a held key, and releases of a key that is up, have no effect
+    for (unsigned int frame = 0; frame < 3; frame++) {
+        SSKKeyboardStateSetKeyDown(&state, 64, true);
+        SSKKeyboardStateSetKeyDown(&state, 64, true);
+        SSKKeyboardStateSetKeyDown(&state, 65, false);
+        SSKKeyboardStateAdvanceFrame(&state);
+        
+        SSKTestAssert(SSKKeyboardStateIsKeyDown(&state, 64));
+        SSKTestAssert(!SSKKeyboardStateWasKeyPressedThisFrame(&state, 64));
+        SSKTestAssert(!SSKKeyboardStateWasKeyReleasedThisFrame(&state, 65));
+    }
+}
+
+static void SSKKeyboardStateTestsOutOfRangeKeys(void)
+{
+    SSKKeyboardState state;
+    SSKKeyboardStateInit(&state);
+    
+    // Key codes & special keys beyond the bitmaps are ignored, without touching any other key
+    SSKKeyboardStateSetKeyDown(&state, SSKKeyboardStateKeyCount, true);
+    SSKKeyboardStateSetKeyDown(&state, SSKKeyboardStateKeyCount + 64, true);
+    SSKKeyboardStateSetKeyDown(&state, 0xFFFFFFFF, true);
+    SSKKeyboardStateSetSpecialKeyDown(&state, 32, true);
+    SSKKeyboardStateSetSpecialKeyDown(&state, 0xFFFFFFFF, true);
+    SSKKeyboardStateAdvanceFrame(&state);
+    
+    SSKTestAssert(!SSKKeyboardStateIsKeyDown(&state, SSKKeyboardStateKeyCount));
+    SSKTestAssert(!SSKKeyboardStateWasKeyPressedThisFrame(&state, 0xFFFFFFFF));
+    SSKTestAssert(!SSKKeyboardStateIsSpecialKeyDown(&state, 32));
+    
+    for (unsigned int keyCode = 0; keyCode < SSKKeyboardStateKeyCount; keyCode++) {
+        SSKTestAssert(!SSKKeyboardStateIsKeyDown(&state, keyCode));
+    }
+    
+    SSKTestAssert(state.down.specialKeys == 0);
+    
+    // The highest valid codes are tracked like any other
+    SSKKeyboardStateSetKeyDown(&state, SSKKeyboardStateKeyCount - 1, true);
+    SSKKeyboardStateSetSpecialKeyDown(&state, 31, true);
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(SSKKeyboardStateIsKeyDown(&state, SSKKeyboardStateKeyCount - 1));
+    SSKTestAssert(SSKKeyboardStateIsSpecialKeyDown(&state, 31));
+    SSKTestAssert(SSKKeyboardStateWasSpecialKeyPressedThisFrame(&state, 31));
+}
+
+static void SSKKeyboardStateTestsSpecialKeys(void)
+{
+    SSKKeyboardState state;
+    SSKKeyboardStateInit(&state);
+    
+    // Special keys are tracked separately from key codes with the same value
+    SSKKeyboardStateSetSpecialKeyDown(&state, 2, true);
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(SSKKeyboardStateIsSpecialKeyDown(&state, 2));
+    SSKTestAssert(SSKKeyboardStateWasSpecialKeyPressedThisFrame(&state, 2));
+    SSKTestAssert(!SSKKeyboardStateIsKeyDown(&state, 2));
+    
+    SSKKeyboardStateSetSpecialKeyDown(&state, 2, false);
+    SSKKeyboardStateSetSpecialKeyDown(&state, 3, true);
+    SSKKeyboardStateSetSpecialKeyDown(&state, 3, false);
+    SSKKeyboardStateAdvanceFrame(&state);
+    SSKTestAssert(!SSKKeyboardStateIsSpecialKeyDown(&state, 2));
+    SSKTestAssert(SSKKeyboardStateWasSpecialKeyReleasedThisFrame(&state, 2));
+    SSKTestAssert(!SSKKeyboardStateIsSpecialKeyDown(&state, 3));
+    SSKTestAssert(SSKKeyboardStateWasSpecialKeyPressedThisFrame(&state, 3));
+    SSKTestAssert(SSKKeyboardStateWasSpecialKeyReleasedThisFrame(&state, 3));
+}
+
+int main(void)
+{
+    SSKKeyboardStateTestsPressAndReleaseAcrossFrames();
+    SSKKeyboardStateTestsPressAndReleaseWithinOneFrame();
+    SSKKeyboardStateTestsKeyRepeat();
+    SSKKeyboardStateTestsOutOfRangeKeys();
+    SSKKeyboardStateTestsSpecialKeys();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,62 @@
+#include "SSKListLayout.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+
+/**
+ *  Benchmarks the queries a scrolling list performs every frame (the rows within the visible
+ *  range), and changing row heights, for a list of 1M rows with variable heights
+ */
+int main(void)
+{
+    const size_t count = 1000000;
+    const size_t queryCount = 1000000;
+    const size_t heightChangeCount = 100;
+    const double visibleHeight = 800;
+    
+    double *heights = malloc(count * sizeof(double));
+    unsigned int seed = 23;
+    
+    for (size_t row = 0; row < count; row++) {
+        heights[row] = 30 + SSKTestGetRandom(&seed) % 60;
+    }
+    
+    SSKListLayout layout;
+    SSKListLayoutInit(&layout);
+    
+    double startTime = SSKTestGetTime();
+    SSKListLayoutSetRows(&layout, heights, 0, count);
+    double setRowsTime = SSKTestGetTime() - startTime;
+    
+    const double contentHeight = SSKListLayoutGetContentHeight(&layout);
+    size_t visibleRowCount = 0;
+    
+    startTime = SSKTestGetTime();
+    
+    for (size_t query = 0; query < queryCount; query++) {
+        const double top = (double)((SSKTestGetRandom(&seed) * 32768u + SSKTestGetRandom(&seed)) % (unsigned int)contentHeight);
+        size_t firstRow;
+        visibleRowCount += SSKListLayoutGetRowsInRange(&layout, top, visibleHeight, &firstRow);
+    }
+    
+    double queryTime = SSKTestGetTime() - startTime;
+    
+    startTime = SSKTestGetTime();
+    
+    // Rows near the top are the worst case, since every row below them moves
+    for (size_t change = 0; change < heightChangeCount; change++) {
+        SSKListLayoutSetRowHeight(&layout, change, 100 + (double)change);
+    }
+    
+    double heightChangeTime = SSKTestGetTime() - startTime;
+    
+    printf("rows: %zu, content height: %.0f\n", count, contentHeight);
+    printf("set rows: %.3f ms\n", setRowsTime * 1000);
+    printf("visible rows: %.1f ns/query (%.1f rows/query)\n", queryTime * 1e9 / queryCount, (double)visibleRowCount / queryCount);
+    printf("set row height (top rows): %.3f ms/change\n", heightChangeTime * 1000 / heightChangeCount);
+    
+    free(heights);
+    SSKListLayoutDestroy(&layout);
+    
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "SSKListLayout.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+
+/**
+ *  Return the last row whose top is at or above an offset, by checking every row
+ */
+static size_t SSKListLayoutTestsGetRowAtOffset(const double *heights, size_t count, double offset)
+{
+    size_t foundRow = 0;
+    double rowTop = 0;
+    
+    for (size_t row = 0; row < count; row++) {
+        if (rowTop <= offset) {
+            foundRow = row;
+        }
+        
+        rowTop += heights[row];
+    }
+    
+    return foundRow;
+}
+
+/**
+ *  Find the rows that intersect a range, by checking every row
+ */
+static size_t SSKListLayoutTestsGetRowsInRange(const double *heights, size_t count, double top, double height, size_t *firstRow)
+{
+    size_t foundCount = 0;
+    double rowTop = 0;
+    
+    *firstRow = 0;
+    
+    for (size_t row = 0; row < count; row++) {
+        const double rowBottom = rowTop + heights[row];
+        
+        if (rowTop < top + height && rowBottom > top) {
+            if (foundCount == 0) {
+                *firstRow = row;
+            }
+            
+            foundCount++;
+        }
+        
+        rowTop = rowBottom;
+    }
+    
+    return foundCount;
+}
+
+static void SSKListLayoutTestsEmpty(void)
+{
+    SSKListLayout layout;
+    SSKListLayoutInit(&layout);
+    
+    size_t firstRow = 1;
+    SSKTestAssert(SSKListLayoutGetContentHeight(&layout) == 0);
+    SSKTestAssert(SSKListLayoutGetRowOffset(&layout, 3) == 0);
+    SSKTestAssert(SSKListLayoutGetRowAtOffset(&layout, 10) == 0);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 0, 100, &firstRow) == 0 && firstRow == 0);
+    
+    SSKTestAssert(SSKListLayoutSetRows(&layout, NULL, 44, 0));
+    SSKTestAssert(SSKListLayoutGetContentHeight(&layout) == 0);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 0, 100, &firstRow) == 0);
+    
+    SSKListLayoutDestroy(&layout);
+}
+
+static void SSKListLayoutTestsDefaultHeight(void)
+{
+    SSKListLayout layout;
+    SSKListLayoutInit(&layout);
+    SSKTestAssert(SSKListLayoutSetRows(&layout, NULL, 10, 100));
+    
+    size_t firstRow;
+    SSKTestAssert(SSKListLayoutGetContentHeight(&layout) == 1000);
+    SSKTestAssert(SSKListLayoutGetRowOffset(&layout, 42) == 420);
+    SSKTestAssert(SSKListLayoutGetRowHeight(&layout, 42) == 10);
+    SSKTestAssert(SSKListLayoutGetRowHeight(&layout, 100) == 0);
+    
+    // Offsets on a row boundary belong to the row below it, and offsets outside the list are clamped
+    SSKTestAssert(SSKListLayoutGetRowAtOffset(&layout, 419.9) == 41);
+    SSKTestAssert(SSKListLayoutGetRowAtOffset(&layout, 420) == 42);
+    SSKTestAssert(SSKListLayoutGetRowAtOffset(&layout, -50) == 0);
+    SSKTestAssert(SSKListLayoutGetRowAtOffset(&layout, 5000) == 99);
+    
+    // A range ending exactly at the top of a row doesn't include it
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 420, 30, &firstRow) == 3 && firstRow == 42);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 415, 30, &firstRow) == 4 && firstRow == 41);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, -20, 25, &firstRow) == 1 && firstRow == 0);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 995, 100, &firstRow) == 1 && firstRow == 99);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 1000, 100, &firstRow) == 0);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, -100, 100, &firstRow) == 0);
+    
+    SSKListLayoutDestroy(&layout);
+}
+
+static void SSKListLayoutTestsCollapsedRows(void)
+{
+    const double heights[] = {10, 10, 0, 0, 10, 0};
+    
+    SSKListLayout layout;
+    SSKListLayoutInit(&layout);
+    SSKTestAssert(SSKListLayoutSetRows(&layout, heights, 0, 6));
+    
+    // Collapsed rows at the edges of a range are outside of it, while those within it are included
+    size_t firstRow;
+    SSKTestAssert(SSKListLayoutGetRowAtOffset(&layout, 20) == 4);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 0, 20, &firstRow) == 2 && firstRow == 0);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 15, 10, &firstRow) == 4 && firstRow == 1);
+    SSKTestAssert(SSKListLayoutGetRowsInRange(&layout, 20, 100, &firstRow) == 2 && firstRow == 4);
+    
+    SSKListLayoutDestroy(&layout);
+}
+
+static void SSKListLayoutTestsRandom(void)
+{
+    const size_t counts[] = {1, 2, 63, 64, 65, 1000};
+    unsigned int seed = 19;
+    
+    SSKListLayout layout;
+    SSKListLayoutInit(&layout);
+    
+    for (size_t countIndex = 0; countIndex < sizeof(counts) / sizeof(counts[0]); countIndex++) {
+        const size_t count = counts[countIndex];
+        double *heights = malloc(count * sizeof(double));
+        
+        // Whole number heights, so that the prefix sums are exact, with some rows that are collapsed
+        for (size_t row = 0; row < count; row++) {
+            heights[row] = SSKTestGetRandom(&seed) % 8 == 0 ? 0 : 1 + SSKTestGetRandom(&seed) % 100;
+        }
+        
+        SSKTestAssert(SSKListLayoutSetRows(&layout, heights, 0, count));
+        
+        for (size_t iteration = 0; iteration < 500; iteration++) {
+            // Changing row heights keeps the prefix sums in sync
+            if (iteration % 10 == 0) {
+                const size_t row = SSKTestGetRandom(&seed) % count;
+                heights[row] = SSKTestGetRandom(&seed) % 150;
+                SSKListLayoutSetRowHeight(&layout, row, heights[row]);
+            }
+            
+            double expectedOffset = 0;
+            
+            for (size_t row = 0; row < count; row++) {
+                SSKTestAssert(SSKListLayoutGetRowOffset(&layout, row) == expectedOffset);
+                SSKTestAssert(SSKListLayoutGetRowHeight(&layout, row) == heights[row]);
+                expectedOffset += heights[row];
+            }
+            
+            SSKTestAssert(SSKListLayoutGetContentHeight(&layout) == expectedOffset);
+            
+            const double contentHeight = SSKListLayoutGetContentHeight(&layout);
+            const double offset = (double)(SSKTestGetRandom(&seed) % ((unsigned int)contentHeight + 200)) - 100;
+            const double height = (double)(1 + SSKTestGetRandom(&seed) % 400);
+            
+            SSKTestAssert(SSKListLayoutGetRowAtOffset(&layout, offset) == SSKListLayoutTestsGetRowAtOffset(heights, count, offset));
+            
+            size_t firstRow;
+            size_t expectedFirstRow;
+            size_t rowCount = SSKListLayoutGetRowsInRange(&layout, offset, height, &firstRow);
+            size_t expectedRowCount = SSKListLayoutTestsGetRowsInRange(heights, count, offset, height, &expectedFirstRow);
+            
+            SSKTestAssert(rowCount == expectedRowCount);
+            SSKTestAssert(rowCount == 0 || firstRow == expectedFirstRow);
+        }
+        
+        free(heights);
+    }
+    
+    SSKListLayoutDestroy(&layout);
+}
+
+int main(void)
+{
+    SSKListLayoutTestsEmpty();
+    SSKListLayoutTestsDefaultHeight();
+    SSKListLayoutTestsCollapsedRows();
+    SSKListLayoutTestsRandom();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,56 @@
+#include "SSKNineSlice.h"
+#include "SSKTestSupport.h"
+
+/**
+ *  Benchmarks computing the geometry of 1M nine-slices of random sizes, and building the tiled
+ *  meshes of 10k of them, like a batch of panels being resized every frame
+ */
+int main(void)
+{
+    const size_t sliceCount = 1000000;
+    const size_t meshSliceCount = 10000;
+    const SSKTileSize textureSize = {64, 64};
+    const SSKNineSliceInsets insets = {12, 10, 12, 10};
+    
+    SSKNineSlice slice;
+    unsigned int seed = 6;
+    size_t partCount = 0;
+    
+    double startTime = SSKTestGetTime();
+    
+    for (size_t index = 0; index < sliceCount; index++) {
+        // Some sizes are smaller than the caps, which leaves out the edges & center
+        SSKTileSize size = {(double)(SSKTestGetRandom(&seed) % 400), (double)(SSKTestGetRandom(&seed) % 200)};
+        SSKNineSliceCompute(&slice, size, textureSize, insets);
+        partCount += slice.count;
+    }
+    
+    double computeTime = SSKTestGetTime() - startTime;
+    
+    printf("compute: %zu nine-slices (%zu parts) in %.3f ms (%.1f ns per nine-slice)\n",
+           sliceCount, partCount, computeTime * 1000, computeTime * 1e9 / sliceCount);
+    
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    startTime = SSKTestGetTime();
+    
+    for (size_t index = 0; index < meshSliceCount; index++) {
+        SSKTileSize size = {(double)(SSKTestGetRandom(&seed) % 400), (double)(SSKTestGetRandom(&seed) % 200)};
+        SSKNineSliceCompute(&slice, size, textureSize, insets);
+        SSKNineSliceAppendTiledMesh(&slice, &mesh, &layout);
+    }
+    
+    double meshTime = SSKTestGetTime() - startTime;
+    
+    printf("tiled mesh: %zu nine-slices (%zu quads) in %.3f ms (%.1f ns per quad)\n",
+           meshSliceCount, mesh.vertexCount / 4, meshTime * 1000, meshTime * 1e9 / (double)(mesh.vertexCount / 4));
+    
+    SSKTileMeshDestroy(&mesh);
+    SSKTileLayoutDestroy(&layout);
+    
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include "SSKNineSlice.h"
+#include "SSKTestSupport.h"
+
+#include <math.h>
+
+#pragma mark - Utilities
+
+static bool SSKNineSliceTestsRectIsEqual(SSKTileRect rect, double x, double y, double width, double height)
+{
+    const double tolerance = 1e-9;
+    
+    return fabs(rect.x - x) < tolerance && fabs(rect.y - y) < tolerance
+        && fabs(rect.width - width) < tolerance && fabs(rect.height - height) < tolerance;
+}
+
+/**
+ *  Return whether the quad of a part covers its rect, and maps its texture rect onto it
+ */
+static bool SSKNineSliceTestsQuadMatchesPart(const SSKNineSlice *slice, size_t index)
+{
+    const SSKTileRect rect = slice->rects[index];
+    const SSKTileRect textureRect = slice->textureRects[index];
+    const SSKTileMeshVertex *vertices = slice->vertices + index * 4;
+    
+    const float xs[4] = {(float)rect.x, (float)(rect.x + rect.width), (float)(rect.x + rect.width), (float)rect.x};
+    const float ys[4] = {(float)rect.y, (float)rect.y, (float)(rect.y + rect.height), (float)(rect.y + rect.height)};
+    const float us[4] = {(float)textureRect.x, (float)(textureRect.x + textureRect.width), (float)(textureRect.x + textureRect.width), (float)textureRect.x};
+    const float vs[4] = {(float)textureRect.y, (float)textureRect.y, (float)(textureRect.y + textureRect.height), (float)(textureRect.y + textureRect.height)};
+    
+    for (size_t vertex = 0; vertex < 4; vertex++) {
+        if (fabsf(vertices[vertex].x - xs[vertex]) > 1e-4f || fabsf(vertices[vertex].y - ys[vertex]) > 1e-4f
+            || fabsf(vertices[vertex].u - us[vertex]) > 1e-6f || fabsf(vertices[vertex].v - vs[vertex]) > 1e-6f) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+#pragma mark - Tests
+
+static void SSKNineSliceTestsComputeAllParts(void)
+{
+    SSKTileSize size = {100, 50};
+    SSKTileSize textureSize = {30, 20};
+    SSKNineSliceInsets insets = {4, 5, 6, 7};
+    
+    SSKNineSlice slice;
+    SSKNineSliceCompute(&slice, size, textureSize, insets);
+    
+    SSKTestAssert(slice.count == SSKNineSlicePartCount);
+    
+    for (size_t index = 0; index < slice.count; index++) {
+        SSKTestAssert(slice.parts[index] == (SSKNineSlicePart)index);
+        SSKTestAssert(SSKNineSliceTestsQuadMatchesPart(&slice, index));
+    }
+    
+    // Corners keep their size, edges & the center are stretched
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartTopLeft], 0, 46, 5, 4));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartTop], 5, 46, 88, 4));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartTopRight], 93, 46, 7, 4));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartRight], 93, 6, 7, 40));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartBottomRight], 93, 0, 7, 6));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartBottom], 5, 0, 88, 6));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartBottomLeft], 0, 0, 5, 6));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartLeft], 0, 6, 5, 40));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[SSKNineSlicePartCenter], 5, 6, 88, 40));
+    
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartTopLeft], 0, 16.0 / 20, 5.0 / 30, 4.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartTop], 5.0 / 30, 16.0 / 20, 18.0 / 30, 4.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartTopRight], 23.0 / 30, 16.0 / 20, 7.0 / 30, 4.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartRight], 23.0 / 30, 6.0 / 20, 7.0 / 30, 10.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartBottomRight], 23.0 / 30, 0, 7.0 / 30, 6.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartBottom], 5.0 / 30, 0, 18.0 / 30, 6.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartBottomLeft], 0, 0, 5.0 / 30, 6.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartLeft], 0, 6.0 / 20, 5.0 / 30, 10.0 / 20));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[SSKNineSlicePartCenter], 5.0 / 30, 6.0 / 20, 18.0 / 30, 10.0 / 20));
+    
+    // Texture sizes are exact, since tiling a part by a size that is off by a rounding error would add a near-zero tile
+    SSKTestAssert(slice.textureSizes[SSKNineSlicePartTop].width == 18 && slice.textureSizes[SSKNineSlicePartTop].height == 4);
+    SSKTestAssert(slice.textureSizes[SSKNineSlicePartTopRight].width == 7 && slice.textureSizes[SSKNineSlicePartTopRight].height == 4);
+    SSKTestAssert(slice.textureSizes[SSKNineSlicePartCenter].width == 18 && slice.textureSizes[SSKNineSlicePartCenter].height == 10);
+}
+
+static void SSKNineSliceTestsSkipZeroAreaParts(void)
+{
+    SSKTileSize size = {100, 50};
+    SSKTileSize textureSize = {30, 20};
+    SSKNineSlice slice;
+    
+    // Zero insets produce a single center part, covering the whole size & texture
+    SSKNineSliceInsets noInsets = {0, 0, 0, 0};
+    SSKNineSliceCompute(&slice, size, textureSize, noInsets);
+    
+    SSKTestAssert(slice.count == 1);
+    SSKTestAssert(slice.parts[0] == SSKNineSlicePartCenter);
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[0], 0, 0, 100, 50));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.textureRects[0], 0, 0, 1, 1));
+    SSKTestAssert(SSKNineSliceTestsQuadMatchesPart(&slice, 0));
+    
+    // Only horizontal insets leave the left, right & center parts, in part order, each with its own quad
+    SSKNineSliceInsets horizontalInsets = {0, 5, 0, 7};
+    SSKNineSliceCompute(&slice, size, textureSize, horizontalInsets);
+    
+    SSKTestAssert(slice.count == 3);
+    SSKTestAssert(slice.parts[0] == SSKNineSlicePartRight);
+    SSKTestAssert(slice.parts[1] == SSKNineSlicePartLeft);
+    SSKTestAssert(slice.parts[2] == SSKNineSlicePartCenter);
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[0], 93, 0, 7, 50));
+    SSKTestAssert(SSKNineSliceTestsRectIsEqual(slice.rects[1], 0, 0, 5, 50));
+    
+    for (size_t index = 0; index < slice.count; index++) {
+        SSKTestAssert(SSKNineSliceTestsQuadMatchesPart(&slice, index));
+    }
+    
+    // A size that only fits the caps leaves no center or edges
+    SSKNineSliceInsets insets = {4, 5, 6, 7};
+    SSKTileSize capSize = {12, 10};
+    SSKNineSliceCompute(&slice, capSize, textureSize, insets);
+    
+    SSKTestAssert(slice.count == 4);
+    SSKTestAssert(slice.parts[0] == SSKNineSlicePartTopLeft);
+    SSKTestAssert(slice.parts[1] == SSKNineSlicePartTopRight);
+    SSKTestAssert(slice.parts[2] == SSKNineSlicePartBottomRight);
+    SSKTestAssert(slice.parts[3] == SSKNineSlicePartBottomLeft);
+    
+    // Insets covering the whole texture leave no texture for the center
+    SSKTileSize insetTextureSize = {12, 10};
+    SSKNineSliceCompute(&slice, size, insetTextureSize, insets);
+    
+    SSKTestAssert(slice.count == 4);
+}
+
+static void SSKNineSliceTestsHasSameParts(void)
+{
+    SSKTileSize textureSize = {30, 20};
+    SSKNineSliceInsets insets = {4, 5, 6, 7};
+    SSKNineSlice slice, otherSlice;
+    
+    SSKTileSize size = {100, 50};
+    SSKTileSize otherSize = {200, 80};
+    SSKNineSliceCompute(&slice, size, textureSize, insets);
+    SSKNineSliceCompute(&otherSlice, otherSize, textureSize, insets);
+    
+    SSKTestAssert(SSKNineSliceHasSameParts(&slice, &otherSlice));
+    
+    SSKTileSize capSize = {12, 10};
+    SSKNineSliceCompute(&otherSlice, capSize, textureSize, insets);
+    
+    SSKTestAssert(!SSKNineSliceHasSameParts(&slice, &otherSlice));
+}
+
+static void SSKNineSliceTestsAppendTiledMesh(void)
+{
+    SSKTileSize size = {100, 50};
+    SSKTileSize textureSize = {30, 20};
+    SSKNineSliceInsets insets = {4, 5, 6, 7};
+    
+    SSKNineSlice slice;
+    SSKNineSliceCompute(&slice, size, textureSize, insets);
+    
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    // Existing quads are kept
+    SSKTileRect rect = {0, 0, 1, 1};
+    SSKTileMeshAppendQuad(&mesh, rect, rect);
+    
+    SSKTestAssert(SSKNineSliceAppendTiledMesh(&slice, &mesh, &layout));
+    
+    // Corners are 1 tile each, edges 5 (top & bottom) or 4 (left & right), and the center 5 x 4 tiles
+    const size_t quadCount = 1 + 4 + 5 * 2 + 4 * 2 + 5 * 4;
+    SSKTestAssert(mesh.vertexCount == quadCount * 4);
+    SSKTestAssert(mesh.indexCount == quadCount * 6);
+    
+    double area = 0;
+    bool isWithinBounds = true;
+    
+    for (size_t quad = 1; quad < quadCount; quad++) {
+        const SSKTileMeshVertex *vertices = mesh.vertices + quad * 4;
+        area += (double)(vertices[2].x - vertices[0].x) * (double)(vertices[2].y - vertices[0].y);
+        
+        for (size_t vertex = 0; vertex < 4; vertex++) {
+            isWithinBounds &= vertices[vertex].x >= 0 && vertices[vertex].x <= 100 && vertices[vertex].y >= 0 && vertices[vertex].y <= 50;
+            isWithinBounds &= vertices[vertex].u >= 0 && vertices[vertex].u <= 1 && vertices[vertex].v >= 0 && vertices[vertex].v <= 1;
+        }
+    }
+    
+    // The tiles cover the whole size exactly once
+    SSKTestAssert(fabs(area - 100 * 50) < 1e-3);
+    SSKTestAssert(isWithinBounds);
+    
+    SSKTileMeshDestroy(&mesh);
+    SSKTileLayoutDestroy(&layout);
+}
+
+int main(void)
+{
+    SSKNineSliceTestsComputeAllParts();
+    SSKNineSliceTestsSkipZeroAreaParts();
+    SSKNineSliceTestsHasSameParts();
+    SSKNineSliceTestsAppendTiledMesh();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,102 @@
+#import "SSKNodeSpatialIndex.h"
+#include "SSKTestSupport.h"
+
+#pragma mark - Utilities
+
+static SKSpriteNode *SSKNodeSpatialIndexTestsMakeNode(CGPoint position)
+{
+    SKSpriteNode *node = [SKSpriteNode spriteNodeWithColor:[SKColor redColor] size:CGSizeMake(10, 10)];
+    node.position = position;
+    
+    return node;
+}
+
+#pragma mark - Tests
+
+static void SSKNodeSpatialIndexTestsAddedNodesCanBeFoundRightAway(void)
+{
+    SKScene *scene = [SKScene sceneWithSize:CGSizeMake(500, 500)];
+    SKNode *node = SSKNodeSpatialIndexTestsMakeNode(CGPointMake(100, 100));
+    SKNode *unparentedNode = SSKNodeSpatialIndexTestsMakeNode(CGPointMake(100, 100));
+    [scene addChild:node];
+    
+    SSKNodeSpatialIndex *spatialIndex = [[SSKNodeSpatialIndex alloc] initWithCellSize:64];
+    [spatialIndex addNode:node inNode:scene];
+    [spatialIndex addNode:unparentedNode inNode:scene];
+    
+    // Nodes outside of the tree are kept, but can't be found until they're part of it
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(100, 100, 0, 0)] isEqualToArray:@[node]]);
+    
+    [scene addChild:unparentedNode];
+    [spatialIndex updateFramesInNode:scene];
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(100, 100, 0, 0)] count] == 2);
+    
+    [node removeFromParent];
+    [spatialIndex updateFramesInNode:scene];
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(100, 100, 0, 0)] isEqualToArray:@[unparentedNode]]);
+    
+    [spatialIndex removeNode:unparentedNode];
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(0, 0, 500, 500)] count] == 0);
+}
+
+static void SSKNodeSpatialIndexTestsFramesInAncestors(void)
+{
+    SKNode *rootNode = [SKNode node];
+    SKNode *scaledNode = [SKNode node];
+    scaledNode.position = CGPointMake(200, 0);
+    scaledNode.xScale = 2;
+    scaledNode.yScale = 2;
+    [rootNode addChild:scaledNode];
+    
+    SKNode *node = SSKNodeSpatialIndexTestsMakeNode(CGPointMake(10, 10));
+    [scaledNode addChild:node];
+    
+    CGRect frame = SSKNodeGetFrameInNode(node, rootNode);
+    SSKTestAssert(CGRectEqualToRect(frame, CGRectMake(210, 10, 20, 20)));
+    SSKTestAssert(CGRectEqualToRect(SSKNodeGetFrameInNode(node, scaledNode), CGRectMake(5, 5, 10, 10)));
+    
+    SSKNodeSpatialIndex *spatialIndex = [[SSKNodeSpatialIndex alloc] initWithCellSize:16];
+    [spatialIndex updateWithNodes:@[node] inNode:rootNode];
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(225, 25, 0, 0)] isEqualToArray:@[node]]);
+    
+    // Nodes left out of an update are removed
+    [spatialIndex updateWithNodes:@[] inNode:rootNode];
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(225, 25, 0, 0)] count] == 0);
+}
+
+static void SSKNodeSpatialIndexTestsDeallocatedNodesAreRemoved(void)
+{
+    SKNode *rootNode = [SKNode node];
+    SSKNodeSpatialIndex *spatialIndex = [[SSKNodeSpatialIndex alloc] initWithCellSize:64];
+    __weak SKNode *weakNode = nil;
+    
+    @autoreleasepool {
+        SKNode *node = SSKNodeSpatialIndexTestsMakeNode(CGPointZero);
+        [rootNode addChild:node];
+        [spatialIndex addNode:node inNode:rootNode];
+        weakNode = node;
+        
+        [node removeFromParent];
+    }
+    
+    SSKTestAssert(weakNode == nil);
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(-10, -10, 20, 20)] count] == 0);
+    
+    // The freed entry is reused by the next node
+    SKNode *otherNode = SSKNodeSpatialIndexTestsMakeNode(CGPointZero);
+    [rootNode addChild:otherNode];
+    [spatialIndex updateFramesInNode:rootNode];
+    [spatialIndex addNode:otherNode inNode:rootNode];
+    SSKTestAssert([[spatialIndex nodesInRect:CGRectMake(0, 0, 0, 0)] isEqualToArray:@[otherNode]]);
+}
+
+int main(void)
+{
+    @autoreleasepool {
+        SSKNodeSpatialIndexTestsAddedNodesCanBeFoundRightAway();
+        SSKNodeSpatialIndexTestsFramesInAncestors();
+        SSKNodeSpatialIndexTestsDeallocatedNodesAreRemoved();
+    }
+    
+    return SSKTestGetExitCode();
+}
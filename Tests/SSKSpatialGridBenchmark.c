@@ -0,0 +1,83 @@
+#include "SSKSpatialGrid.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+
+/**
+ *  Benchmarks a spatial grid of 100k randomly placed entries, under a mixed workload of
+ *  moves & point/rect queries, like a scene of tagged nodes that is indexed every frame
+ */
+int main(void)
+{
+    const size_t entryCount = 100000;
+    const size_t frameCount = 60;
+    const size_t movesPerFrame = 20000;
+    const size_t queriesPerFrame = 2000;
+    const double worldSize = 20000;
+    
+    SSKSpatialGrid grid;
+    SSKSpatialGridInit(&grid, 32);
+    
+    SSKTileRect *rects = malloc(entryCount * sizeof(SSKTileRect));
+    size_t *entryIDs = malloc(entryCount * sizeof(size_t));
+    size_t foundIDs[1024];
+    unsigned int seed = 3;
+    
+    double startTime = SSKTestGetTime();
+    
+    for (size_t index = 0; index < entryCount; index++) {
+        SSKTileRect rect = {
+            (double)(SSKTestGetRandom(&seed) * SSKTestGetRandom(&seed) % (unsigned int)worldSize),
+            (double)(SSKTestGetRandom(&seed) * SSKTestGetRandom(&seed) % (unsigned int)worldSize),
+            8 + SSKTestGetRandom(&seed) % 32,
+            8 + SSKTestGetRandom(&seed) % 32
+        };
+        
+        rects[index] = rect;
+        entryIDs[index] = SSKSpatialGridInsert(&grid, rect);
+    }
+    
+    double insertTime = SSKTestGetTime() - startTime;
+    double moveTime = 0;
+    double queryTime = 0;
+    size_t foundCount = 0;
+    
+    for (size_t frame = 0; frame < frameCount; frame++) {
+        startTime = SSKTestGetTime();
+        
+        for (size_t move = 0; move < movesPerFrame; move++) {
+            size_t index = (SSKTestGetRandom(&seed) * 32768u + SSKTestGetRandom(&seed)) % entryCount;
+            rects[index].x += (double)(SSKTestGetRandom(&seed) % 9) - 4;
+            rects[index].y += (double)(SSKTestGetRandom(&seed) % 9) - 4;
+            SSKSpatialGridMove(&grid, entryIDs[index], rects[index]);
+        }
+        
+        double queryStartTime = SSKTestGetTime();
+        moveTime += queryStartTime - startTime;
+        
+        for (size_t query = 0; query < queriesPerFrame; query++) {
+            double x = (double)(SSKTestGetRandom(&seed) * SSKTestGetRandom(&seed) % (unsigned int)worldSize);
+            double y = (double)(SSKTestGetRandom(&seed) * SSKTestGetRandom(&seed) % (unsigned int)worldSize);
+            
+            if (query % 2 == 0) {
+                foundCount += SSKSpatialGridQueryPoint(&grid, x, y, foundIDs, 1024);
+            } else {
+                SSKTileRect queryRect = {x, y, 200, 200};
+                foundCount += SSKSpatialGridQueryRect(&grid, queryRect, foundIDs, 1024);
+            }
+        }
+        
+        queryTime += SSKTestGetTime() - queryStartTime;
+    }
+    
+    printf("entries: %zu, frames: %zu, moves/frame: %zu, queries/frame: %zu\n", entryCount, frameCount, movesPerFrame, queriesPerFrame);
+    printf("insert all: %.3f ms\n", insertTime * 1000);
+    printf("moves: %.3f ms/frame (%.1f ns/move)\n", moveTime * 1000 / frameCount, moveTime * 1e9 / (frameCount * movesPerFrame));
+    printf("queries: %.3f ms/frame (%.1f ns/query, %zu entries found)\n", queryTime * 1000 / frameCount, queryTime * 1e9 / (frameCount * queriesPerFrame), foundCount);
+    
+    free(rects);
+    free(entryIDs);
+    SSKSpatialGridDestroy(&grid);
+    
+    return 0;
+}
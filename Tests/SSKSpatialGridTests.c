@@ -0,0 +1,219 @@
+#include "SSKSpatialGrid.h"
+#include "SSKTestSupport.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+#define SSKSpatialGridTestsEntryCount 2000
+
+#pragma mark - Utilities
+
+static SSKTileRect SSKSpatialGridTestsMakeRandomRect(unsigned int *seed)
+{
+    SSKTileRect rect;
+    rect.x = (double)(SSKTestGetRandom(seed) % 2000) - 1000;
+    rect.y = (double)(SSKTestGetRandom(seed) % 2000) - 1000;
+    rect.width = SSKTestGetRandom(seed) % 80;
+    rect.height = SSKTestGetRandom(seed) % 80;
+    
+    // Some rects are large enough to be oversized
+    if (SSKTestGetRandom(seed) % 20 == 0) {
+        rect.width = SSKTestGetRandom(seed) % 1500;
+        rect.height = SSKTestGetRandom(seed) % 1500;
+    }
+    
+    return rect;
+}
+
+static bool SSKSpatialGridTestsRectsIntersect(SSKTileRect rect, SSKTileRect otherRect)
+{
+    return rect.x <= otherRect.x + otherRect.width && otherRect.x <= rect.x + rect.width &&
+           rect.y <= otherRect.y + otherRect.height && otherRect.y <= rect.y + rect.height;
+}
+
+#pragma mark - Tests
+
+static void SSKSpatialGridTestsMatchBruteForce(void)
+{
+    SSKSpatialGrid grid;
+    SSKSpatialGridInit(&grid, 32);
+    
+    SSKTileRect rects[SSKSpatialGridTestsEntryCount];
+    bool isInserted[SSKSpatialGridTestsEntryCount];
+    size_t entryIDs[SSKSpatialGridTestsEntryCount];
+    size_t foundIDs[SSKSpatialGridTestsEntryCount];
+    unsigned int seed = 7;
+    
+    for (size_t index = 0; index < SSKSpatialGridTestsEntryCount; index++) {
+        rects[index] = SSKSpatialGridTestsMakeRandomRect(&seed);
+        entryIDs[index] = SSKSpatialGridInsert(&grid, rects[index]);
+        isInserted[index] = true;
+    }
+    
+    size_t mismatchCount = 0;
+    
+    for (size_t iteration = 0; iteration < 500; iteration++) {
+        // Mix moves, removals & re-insertions, which reuse the IDs of removed entries
+        size_t index = SSKTestGetRandom(&seed) % SSKSpatialGridTestsEntryCount;
+        
+        if (!isInserted[index]) {
+            rects[index] = SSKSpatialGridTestsMakeRandomRect(&seed);
+            entryIDs[index] = SSKSpatialGridInsert(&grid, rects[index]);
+            isInserted[index] = true;
+        } else if (iteration % 5 == 0) {
+            SSKSpatialGridRemove(&grid, entryIDs[index]);
+            isInserted[index] = false;
+        } else {
+            rects[index].x += (double)(SSKTestGetRandom(&seed) % 100) - 50;
+            rects[index].y += (double)(SSKTestGetRandom(&seed) % 100) - 50;
+            SSKSpatialGridMove(&grid, entryIDs[index], rects[index]);
+        }
+        
+        SSKTileRect queryRect = SSKSpatialGridTestsMakeRandomRect(&seed);
+        size_t foundCount = SSKSpatialGridQueryRect(&grid, queryRect, foundIDs, SSKSpatialGridTestsEntryCount);
+        size_t expectedCount = 0;
+        
+        for (size_t entryIndex = 0; entryIndex < SSKSpatialGridTestsEntryCount; entryIndex++) {
+            if (!isInserted[entryIndex] || !SSKSpatialGridTestsRectsIntersect(rects[entryIndex], queryRect)) {
+                continue;
+            }
+            
+            expectedCount++;
+            
+            bool isFound = false;
+            
+            for (size_t foundIndex = 0; foundIndex < foundCount && !isFound; foundIndex++) {
+                isFound = (foundIDs[foundIndex] == entryIDs[entryIndex]);
+            }
+            
+            mismatchCount += !isFound;
+        }
+        
+        mismatchCount += (foundCount != expectedCount);
+    }
+    
+    SSKTestAssert(mismatchCount == 0);
+    
+    SSKSpatialGridDestroy(&grid);
+}
+
+static void SSKSpatialGridTestsPointQueries(void)
+{
+    SSKSpatialGrid grid;
+    SSKSpatialGridInit(&grid, 10);
+    
+    SSKTileRect rect = {-5, -5, 10, 10};
+    size_t entryID = SSKSpatialGridInsert(&grid, rect);
+    size_t foundIDs[4];
+    
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 0, 0, foundIDs, 4) == 1 && foundIDs[0] == entryID);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 20, 0, foundIDs, 4) == 0);
+    
+    // An entry spanning many cells is still only returned once
+    SSKTileRect largeRect = {-100, -100, 200, 200};
+    SSKSpatialGridMove(&grid, entryID, largeRect);
+    SSKTestAssert(SSKSpatialGridQueryRect(&grid, largeRect, foundIDs, 4) == 1);
+    
+    SSKSpatialGridRemove(&grid, entryID);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 0, 0, foundIDs, 4) == 0);
+    
+    SSKSpatialGridDestroy(&grid);
+}
+
+static void SSKSpatialGridTestsOversizedEntries(void)
+{
+    SSKSpatialGrid grid;
+    SSKSpatialGridInit(&grid, 10);
+    
+    size_t foundIDs[4];
+    
+    // Entries overlapping too many cells aren't stored in any cell
+    SSKTileRect hugeRect = {-1e6, -1e6, 2e6, 2e6};
+    size_t entryID = SSKSpatialGridInsert(&grid, hugeRect);
+    SSKTestAssert(grid.entries[entryID].isOversized);
+    SSKTestAssert(grid.oversizedEntryCount == 1);
+    SSKTestAssert(grid.cellCount == 0);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 0, 0, foundIDs, 4) == 1 && foundIDs[0] == entryID);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 5e6, 0, foundIDs, 4) == 0);
+    
+    // Just at & above the limit
+    SSKTileRect limitRect = {0, 0, 79, 79};
+    size_t limitEntryID = SSKSpatialGridInsert(&grid, limitRect);
+    SSKTestAssert(!grid.entries[limitEntryID].isOversized);
+    limitRect.width = 80;
+    SSKTestAssert(SSKSpatialGridMove(&grid, limitEntryID, limitRect));
+    SSKTestAssert(grid.entries[limitEntryID].isOversized);
+    SSKTestAssert(grid.oversizedEntryCount == 2);
+    
+    // Removing an entry from the middle of the list keeps the other one findable
+    SSKSpatialGridRemove(&grid, entryID);
+    SSKTestAssert(grid.oversizedEntryCount == 1);
+    SSKTestAssert(grid.entries[limitEntryID].oversizedIndex == 0);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 50, 50, foundIDs, 4) == 1 && foundIDs[0] == limitEntryID);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, -50, -50, foundIDs, 4) == 0);
+    
+    // Oversized entries move in place, and go back into cells once they're small enough
+    SSKTestAssert(SSKSpatialGridMove(&grid, limitEntryID, hugeRect));
+    SSKTestAssert(grid.oversizedEntryCount == 1);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, -50, -50, foundIDs, 4) == 1);
+    
+    SSKTileRect smallRect = {-5, -5, 10, 10};
+    SSKTestAssert(SSKSpatialGridMove(&grid, limitEntryID, smallRect));
+    SSKTestAssert(!grid.entries[limitEntryID].isOversized);
+    SSKTestAssert(grid.oversizedEntryCount == 0);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 0, 0, foundIDs, 4) == 1 && foundIDs[0] == limitEntryID);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, -50, -50, foundIDs, 4) == 0);
+    
+    SSKSpatialGridDestroy(&grid);
+}
+
+static void SSKSpatialGridTestsExtremeCoordinates(void)
+{
+    SSKSpatialGrid grid;
+    SSKSpatialGridInit(&grid, 10);
+    
+    size_t foundIDs[8];
+    
+    // Coordinates beyond the largest cell coordinate share the edge cells, but are still compared exactly
+    SSKTileRect farRect = {1e300, 1e300, 1e290, 1e290};
+    size_t farEntryID = SSKSpatialGridInsert(&grid, farRect);
+    SSKTestAssert(farEntryID != SIZE_MAX);
+    SSKTestAssert(grid.entries[farEntryID].minColumn == SSKSpatialGridMaxCellCoordinate);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 1e300, 1e300, foundIDs, 8) == 1);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 1e200, 1e200, foundIDs, 8) == 0);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, -1e300, -1e300, foundIDs, 8) == 0);
+    
+    SSKTileRect negativeRect = {-DBL_MAX, -DBL_MAX, DBL_MAX, DBL_MAX};
+    size_t negativeEntryID = SSKSpatialGridInsert(&grid, negativeRect);
+    SSKTestAssert(grid.entries[negativeEntryID].minRow == -SSKSpatialGridMaxCellCoordinate);
+    SSKTestAssert(grid.entries[negativeEntryID].isOversized);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, -1, -1, foundIDs, 8) == 1 && foundIDs[0] == negativeEntryID);
+    
+    // Rects that can't be placed can't be found, and queries that can't be placed find nothing
+    SSKTileRect infiniteRect = {0, 0, INFINITY, 10};
+    SSKTileRect nanRect = {NAN, 0, 10, 10};
+    SSKSpatialGridInsert(&grid, infiniteRect);
+    SSKSpatialGridInsert(&grid, nanRect);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, 5, 5, foundIDs, 8) == 0);
+    SSKTestAssert(SSKSpatialGridQueryPoint(&grid, NAN, 5, foundIDs, 8) == 0);
+    SSKTestAssert(SSKSpatialGridQueryRect(&grid, infiniteRect, foundIDs, 8) == 0);
+    
+    // A query spanning the whole grid scans the cell table, and finds every entry once
+    SSKTileRect smallRect = {20, 20, 30, 30};
+    SSKSpatialGridInsert(&grid, smallRect);
+    SSKTileRect everywhereRect = {-1e300, -1e300, 2e300, 2e300};
+    SSKTestAssert(SSKSpatialGridQueryRect(&grid, everywhereRect, foundIDs, 8) == 3);
+    
+    SSKSpatialGridDestroy(&grid);
+}
+
+int main(void)
+{
+    SSKSpatialGridTestsMatchBruteForce();
+    SSKSpatialGridTestsPointQueries();
+    SSKSpatialGridTestsOversizedEntries();
+    SSKSpatialGridTestsExtremeCoordinates();
+    
+    return SSKTestGetExitCode();
+}
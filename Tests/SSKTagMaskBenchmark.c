@@ -0,0 +1,64 @@
+#include "SSKTagMask.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+
+static void SSKTagMaskBenchmarkRun(const char *name, const SSKTagMaskTable *table, uint64_t requiredMask, uint64_t excludedMask, size_t *indices)
+{
+    const size_t iterationCount = 50;
+    size_t matchCount = 0;
+    
+    double startTime = SSKTestGetTime();
+    
+    for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+        matchCount = SSKTagMaskTableQueryScalar(table, requiredMask, excludedMask, indices, table->count);
+    }
+    
+    double scalarTime = (SSKTestGetTime() - startTime) / iterationCount;
+    startTime = SSKTestGetTime();
+    
+    for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+        matchCount = SSKTagMaskTableQuery(table, requiredMask, excludedMask, indices, table->count);
+    }
+    
+    double time = (SSKTestGetTime() - startTime) / iterationCount;
+    
+    printf("%s: %zu matches, scalar %.3f ms, vectorized %.3f ms (%.2fx)\n",
+           name, matchCount, scalarTime * 1000, time * 1000, scalarTime / time);
+}
+
+/**
+ *  Benchmarks querying a table of 1M tag masks, with queries matching none, few & most of them,
+ *  using the vectorized query against the scalar one (build with SSK_NATIVE_SIMD for AVX2)
+ */
+int main(void)
+{
+    const size_t count = 1000000;
+    
+    SSKTagMaskTable table;
+    SSKTagMaskTableInit(&table);
+    
+    size_t *indices = malloc(count * sizeof(size_t));
+    unsigned int seed = 8;
+    
+    // Every bit is set in about half of the masks
+    for (size_t index = 0; index < count; index++) {
+        uint64_t mask = 0;
+        
+        for (size_t part = 0; part < 4; part++) {
+            mask = (mask << 16) | (uint64_t)(SSKTestGetRandom(&seed) & 0xffff);
+        }
+        
+        SSKTagMaskTableAdd(&table, mask);
+    }
+    
+    SSKTagMaskBenchmarkRun("no matches", &table, 0xffff, 0xffff0000, indices);
+    SSKTagMaskBenchmarkRun("few matches (1 in 1024)", &table, 0x1f, 0x3e0, indices);
+    SSKTagMaskBenchmarkRun("half matches", &table, 0x1, 0, indices);
+    SSKTagMaskBenchmarkRun("all matches", &table, 0, 0, indices);
+    
+    free(indices);
+    SSKTagMaskTableDestroy(&table);
+    
+    return 0;
+}
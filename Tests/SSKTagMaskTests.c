@@ -0,0 +1,209 @@
+#include "SSKTagMask.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+
+#pragma mark - Utilities
+
+static uint64_t SSKTagMaskTestsMakeMask(unsigned int *seed)
+{
+    // Masks only use a few bits, so that queries on them have a mix of matches & misses
+    return (uint64_t)(SSKTestGetRandom(seed) & 0xff) | ((uint64_t)(SSKTestGetRandom(seed) & 0x3) << 62);
+}
+
+static size_t SSKTagMaskTestsQueryReference(const SSKTagMaskTable *table, uint64_t requiredMask, uint64_t excludedMask, size_t *indices)
+{
+    size_t matchCount = 0;
+    
+    for (size_t index = 0; index < table->count; index++) {
+        const uint64_t mask = table->masks[index];
+        
+        if ((mask & requiredMask) == requiredMask && (mask & excludedMask) == 0) {
+            indices[matchCount++] = index;
+        }
+    }
+    
+    return matchCount;
+}
+
+static bool SSKTagMaskTestsIndicesAreEqual(const size_t *indices, const size_t *otherIndices, size_t count)
+{
+    for (size_t index = 0; index < count; index++) {
+        if (indices[index] != otherIndices[index]) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+#pragma mark - Tests
+
+static void SSKTagMaskTestsMatchReference(void)
+{
+    // Counts around the block size of 64 exercise the tails that don't fill a whole block or vector
+    const size_t counts[] = {0, 1, 2, 3, 5, 63, 64, 65, 66, 127, 128, 129, 200, 1000};
+    const size_t countCount = sizeof(counts) / sizeof(counts[0]);
+    
+    size_t *indices = malloc(1000 * sizeof(size_t));
+    size_t *scalarIndices = malloc(1000 * sizeof(size_t));
+    size_t *referenceIndices = malloc(1000 * sizeof(size_t));
+    unsigned int seed = 9;
+    size_t mismatchCount = 0;
+    
+    for (size_t countIndex = 0; countIndex < countCount; countIndex++) {
+        SSKTagMaskTable table;
+        SSKTagMaskTableInit(&table);
+        
+        for (size_t index = 0; index < counts[countIndex]; index++) {
+            SSKTagMaskTableAdd(&table, SSKTagMaskTestsMakeMask(&seed));
+        }
+        
+        for (size_t iteration = 0; iteration < 50; iteration++) {
+            uint64_t requiredMask = SSKTagMaskTestsMakeMask(&seed) & SSKTagMaskTestsMakeMask(&seed);
+            uint64_t excludedMask = SSKTagMaskTestsMakeMask(&seed) & SSKTagMaskTestsMakeMask(&seed) & ~requiredMask;
+            
+            size_t referenceCount = SSKTagMaskTestsQueryReference(&table, requiredMask, excludedMask, referenceIndices);
+            size_t matchCount = SSKTagMaskTableQuery(&table, requiredMask, excludedMask, indices, 1000);
+            size_t scalarMatchCount = SSKTagMaskTableQueryScalar(&table, requiredMask, excludedMask, scalarIndices, 1000);
+            
+            if (matchCount != referenceCount || !SSKTagMaskTestsIndicesAreEqual(indices, referenceIndices, referenceCount)) {
+                mismatchCount++;
+            }
+            
+            if (scalarMatchCount != referenceCount || !SSKTagMaskTestsIndicesAreEqual(scalarIndices, referenceIndices, referenceCount)) {
+                mismatchCount++;
+            }
+        }
+        
+        SSKTagMaskTableDestroy(&table);
+    }
+    
+    SSKTestAssert(mismatchCount == 0);
+    
+    free(indices);
+    free(scalarIndices);
+    free(referenceIndices);
+}
+
+static void SSKTagMaskTestsQueryRespectsCapacity(void)
+{
+    SSKTagMaskTable table;
+    SSKTagMaskTableInit(&table);
+    
+    for (size_t index = 0; index < 100; index++) {
+        SSKTagMaskTableAdd(&table, index % 2 == 0 ? 0x3 : 0x1);
+    }
+    
+    size_t indices[11];
+    indices[10] = SIZE_MAX;
+    
+    // All matches are counted, but only as many indices are written as fit
+    SSKTestAssert(SSKTagMaskTableQuery(&table, 0x2, 0, indices, 10) == 50);
+    SSKTestAssert(indices[0] == 0 && indices[9] == 18);
+    SSKTestAssert(indices[10] == SIZE_MAX);
+    
+    SSKTestAssert(SSKTagMaskTableQuery(&table, 0x1, 0x2, NULL, 0) == 50);
+    SSKTestAssert(SSKTagMaskTableQuery(&table, 0, 0, NULL, 0) == 100);
+    SSKTestAssert(SSKTagMaskTableQuery(&table, 0x4, 0, NULL, 0) == 0);
+    
+    SSKTagMaskTableDestroy(&table);
+}
+
+static void SSKTagMaskTestsRemoveMovesLastMask(void)
+{
+    SSKTagMaskTable table;
+    SSKTagMaskTableInit(&table);
+    
+    for (uint64_t mask = 1; mask <= 5; mask++) {
+        SSKTestAssert(SSKTagMaskTableAdd(&table, mask) == mask - 1);
+    }
+    
+    SSKTagMaskTableRemove(&table, 1);
+    SSKTestAssert(table.count == 4);
+    SSKTestAssert(table.masks[0] == 1 && table.masks[1] == 5 && table.masks[2] == 3 && table.masks[3] == 4);
+    
+    // Removing the last mask moves nothing, and out of range indices are ignored
+    SSKTagMaskTableRemove(&table, 3);
+    SSKTagMaskTableRemove(&table, 3);
+    SSKTestAssert(table.count == 3);
+    SSKTestAssert(table.masks[0] == 1 && table.masks[1] == 5 && table.masks[2] == 3);
+    
+    size_t indices[3];
+    SSKTestAssert(SSKTagMaskTableQuery(&table, 0x4, 0, indices, 3) == 1 && indices[0] == 1);
+    
+    SSKTagMaskTableDestroy(&table);
+}
+
+static void SSKTagMaskTestsSlotBookkeeping(void)
+{
+    const size_t ownerCount = 500;
+    
+    // Mirrors how SKNode+SSKTags keeps the slot of each node in sync with the table, as masks are swap-removed
+    SSKTagMaskTable table;
+    SSKTagMaskTableInit(&table);
+    
+    size_t *slotsByOwner = malloc(ownerCount * sizeof(size_t));
+    size_t *ownersBySlot = malloc(ownerCount * sizeof(size_t));
+    unsigned int seed = 4;
+    size_t mismatchCount = 0;
+    
+    for (size_t owner = 0; owner < ownerCount; owner++) {
+        slotsByOwner[owner] = SIZE_MAX;
+    }
+    
+    for (size_t iteration = 0; iteration < 20000; iteration++) {
+        const size_t owner = SSKTestGetRandom(&seed) % ownerCount;
+        const size_t slot = slotsByOwner[owner];
+        
+        if (slot == SIZE_MAX) {
+            size_t index = SSKTagMaskTableAdd(&table, (uint64_t)owner << 8);
+            slotsByOwner[owner] = index;
+            ownersBySlot[index] = owner;
+            continue;
+        }
+        
+        const size_t lastSlot = table.count - 1;
+        SSKTagMaskTableRemove(&table, slot);
+        
+        if (slot != lastSlot) {
+            ownersBySlot[slot] = ownersBySlot[lastSlot];
+            slotsByOwner[ownersBySlot[slot]] = slot;
+        }
+        
+        slotsByOwner[owner] = SIZE_MAX;
+    }
+    
+    // Every owner's mask is still at the owner's slot, and the query for it finds that slot
+    for (size_t owner = 0; owner < ownerCount; owner++) {
+        const size_t slot = slotsByOwner[owner];
+        
+        if (slot == SIZE_MAX) {
+            continue;
+        }
+        
+        size_t index = SIZE_MAX;
+        
+        if (table.masks[slot] != (uint64_t)owner << 8
+            || SSKTagMaskTableQuery(&table, (uint64_t)owner << 8, ~((uint64_t)owner << 8), &index, 1) != 1
+            || index != slot) {
+            mismatchCount++;
+        }
+    }
+    
+    SSKTestAssert(mismatchCount == 0);
+    
+    free(slotsByOwner);
+    free(ownersBySlot);
+    SSKTagMaskTableDestroy(&table);
+}
+
+int main(void)
+{
+    SSKTagMaskTestsMatchReference();
+    SSKTagMaskTestsQueryRespectsCapacity();
+    SSKTagMaskTestsRemoveMovesLastMask();
+    SSKTagMaskTestsSlotBookkeeping();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,101 @@
+#import "SKNode+SSKTags.h"
+#include "SSKTestSupport.h"
+
+static void SSKTagSearchBenchmarkAppendNodesWithTag(SKNode *node, NSInteger tag, NSMutableArray *foundNodes)
+{
+    // A plain serial depth-first search, like the one the tag APIs were originally implemented with
+    for (SKNode *child in node.children) {
+        if (child.ssk_tag == tag) {
+            [foundNodes addObject:child];
+        }
+    }
+    
+    for (SKNode *child in node.children) {
+        SSKTagSearchBenchmarkAppendNodesWithTag(child, tag, foundNodes);
+    }
+}
+
+static void SSKTagSearchBenchmarkRun(NSString *name, SKNode *rootNode, NSUInteger nodeCount)
+{
+    const NSUInteger iterationCount = 10;
+    NSUInteger serialMatchCount = 0, concurrentMatchCount = 0, indexedMatchCount = 0;
+    
+    double startTime = SSKTestGetTime();
+    
+    for (NSUInteger iteration = 0; iteration < iterationCount; iteration++) {
+        @autoreleasepool {
+            NSMutableArray *foundNodes = [NSMutableArray new];
+            SSKTagSearchBenchmarkAppendNodesWithTag(rootNode, 7, foundNodes);
+            serialMatchCount = [foundNodes count];
+        }
+    }
+    
+    double serialTime = (SSKTestGetTime() - startTime) / iterationCount;
+    startTime = SSKTestGetTime();
+    
+    for (NSUInteger iteration = 0; iteration < iterationCount; iteration++) {
+        @autoreleasepool {
+            concurrentMatchCount = [[rootNode ssk_concurrentlySearchChildNodesWithTag:7 returnOnFirstMatch:NO] count];
+        }
+    }
+    
+    double concurrentTime = (SSKTestGetTime() - startTime) / iterationCount;
+    startTime = SSKTestGetTime();
+    
+    for (NSUInteger iteration = 0; iteration < iterationCount; iteration++) {
+        @autoreleasepool {
+            indexedMatchCount = [[rootNode ssk_childNodesWithTag:7 recursive:YES] count];
+        }
+    }
+    
+    double indexedTime = (SSKTestGetTime() - startTime) / iterationCount;
+    
+    printf("%s tree: %lu nodes\n", [name UTF8String], (unsigned long)nodeCount);
+    printf("  serial tree search: %.3f ms (%lu found)\n", serialTime * 1000, (unsigned long)serialMatchCount);
+    printf("  concurrent search: %.3f ms (%lu found, %.2fx serial)\n", concurrentTime * 1000, (unsigned long)concurrentMatchCount, serialTime / concurrentTime);
+    printf("  indexed lookup: %.3f ms (%lu found, %.2fx serial)\n", indexedTime * 1000, (unsigned long)indexedMatchCount, serialTime / indexedTime);
+}
+
+/**
+ *  Benchmarks the whole -ssk_concurrentlySearchChildNodesWithTag: call (taking the snapshot of the
+ *  tree, and searching it), against a plain serial search of the tree, and the tag index
+ *
+ *  @discussion See SSKTagSnapshotBenchmark for how the search of the snapshot alone scales with cores.
+ */
+int main(void)
+{
+    @autoreleasepool {
+        const NSUInteger layerCount = 100;
+        const NSUInteger nodesPerLayer = 1000;
+        unsigned int seed = 5;
+        
+        SKNode *wideRootNode = [SKNode node];
+        
+        for (NSUInteger layerIndex = 0; layerIndex < layerCount; layerIndex++) {
+            SKNode *layerNode = [SKNode node];
+            [wideRootNode addChild:layerNode];
+            
+            for (NSUInteger index = 0; index < nodesPerLayer; index++) {
+                SKNode *node = [SKNode node];
+                node.ssk_tag = SSKTestGetRandom(&seed) % 1000;
+                [layerNode addChild:node];
+            }
+        }
+        
+        SSKTagSearchBenchmarkRun(@"wide", wideRootNode, layerCount * nodesPerLayer);
+        
+        SKNode *deepRootNode = [SKNode node];
+        SKNode *parentNode = deepRootNode;
+        
+        for (NSUInteger index = 0; index < 10000; index++) {
+            SKNode *node = [SKNode node];
+            node.ssk_tag = SSKTestGetRandom(&seed) % 1000;
+            [parentNode addChild:node];
+            parentNode = node;
+        }
+        
+        SSKTagSearchBenchmarkRun(@"deep (chain)", deepRootNode, 10000);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "SSKTagSnapshot.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ *  A synthetic node tree, stored as the first child & next sibling of each node
+ */
+typedef struct {
+    size_t count;
+    size_t *firstChild;
+    size_t *nextSibling;
+    int64_t *tags;
+} SSKTagSnapshotBenchmarkTree;
+
+static void SSKTagSnapshotBenchmarkTreeInit(SSKTagSnapshotBenchmarkTree *tree, size_t count, size_t branchingFactor, unsigned int seed)
+{
+    tree->count = count;
+    tree->firstChild = malloc(count * sizeof(size_t));
+    tree->nextSibling = malloc(count * sizeof(size_t));
+    tree->tags = malloc(count * sizeof(int64_t));
+    
+    size_t *lastChild = malloc(count * sizeof(size_t));
+    
+    for (size_t index = 0; index < count; index++) {
+        tree->firstChild[index] = SIZE_MAX;
+        tree->nextSibling[index] = SIZE_MAX;
+        tree->tags[index] = SSKTestGetRandom(&seed) % 1000;
+        lastChild[index] = SIZE_MAX;
+        
+        if (index == 0) {
+            continue;
+        }
+        
+        // Node 0 is the root, and every node has at most "branchingFactor" children (1 makes a chain)
+        const size_t parent = (index - 1) / branchingFactor;
+        
+        if (lastChild[parent] == SIZE_MAX) {
+            tree->firstChild[parent] = index;
+        } else {
+            tree->nextSibling[lastChild[parent]] = index;
+        }
+        
+        lastChild[parent] = index;
+    }
+    
+    free(lastChild);
+}
+
+static void SSKTagSnapshotBenchmarkTreeDestroy(SSKTagSnapshotBenchmarkTree *tree)
+{
+    free(tree->firstChild);
+    free(tree->nextSibling);
+    free(tree->tags);
+}
+
+static void SSKTagSnapshotBenchmarkTakeSnapshot(const SSKTagSnapshotBenchmarkTree *tree, SSKTagSnapshot *snapshot, size_t *stack)
+{
+    size_t stackCount = 0;
+    
+    SSKTagSnapshotRemoveAllTags(snapshot);
+    
+    // Descendants of the root, depth-first, like SKNode+SSKTags takes its snapshots
+    for (size_t child = tree->firstChild[0]; child != SIZE_MAX; child = tree->nextSibling[child]) {
+        stack[stackCount++] = child;
+    }
+    
+    while (stackCount > 0) {
+        const size_t node = stack[--stackCount];
+        SSKTagSnapshotAppend(snapshot, tree->tags[node]);
+        
+        for (size_t child = tree->firstChild[node]; child != SIZE_MAX; child = tree->nextSibling[child]) {
+            stack[stackCount++] = child;
+        }
+    }
+}
+
+static size_t SSKTagSnapshotBenchmarkSearchTree(const SSKTagSnapshotBenchmarkTree *tree, int64_t tag, size_t *stack)
+{
+    size_t stackCount = 0;
+    size_t matchCount = 0;
+    
+    // A serial search of the tree itself, which is what the concurrent search has to beat
+    for (size_t child = tree->firstChild[0]; child != SIZE_MAX; child = tree->nextSibling[child]) {
+        stack[stackCount++] = child;
+    }
+    
+    while (stackCount > 0) {
+        const size_t node = stack[--stackCount];
+        
+        if (tree->tags[node] == tag) {
+            matchCount++;
+        }
+        
+        for (size_t child = tree->firstChild[node]; child != SIZE_MAX; child = tree->nextSibling[child]) {
+            stack[stackCount++] = child;
+        }
+    }
+    
+    return matchCount;
+}
+
+static void SSKTagSnapshotBenchmarkRun(const char *name, size_t count, size_t branchingFactor, size_t maximumThreadCount)
+{
+    const size_t iterationCount = 20;
+    
+    SSKTagSnapshotBenchmarkTree tree;
+    SSKTagSnapshotBenchmarkTreeInit(&tree, count, branchingFactor, 5);
+    
+    SSKTagSnapshot snapshot;
+    SSKTagSnapshotInit(&snapshot);
+    
+    size_t *stack = malloc(count * sizeof(size_t));
+    
+    double startTime = SSKTestGetTime();
+    SSKTagSnapshotBenchmarkTakeSnapshot(&tree, &snapshot, stack);
+    double snapshotTime = SSKTestGetTime() - startTime;
+    
+    startTime = SSKTestGetTime();
+    
+    for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+        SSKTagSnapshotBenchmarkSearchTree(&tree, 7, stack);
+    }
+    
+    double serialTime = (SSKTestGetTime() - startTime) / iterationCount;
+    
+    printf("%s tree: %zu nodes, snapshot: %.3f ms, serial tree search: %.3f ms\n", name, count, snapshotTime * 1000, serialTime * 1000);
+    
+    double singleThreadTime = 0;
+    
+    for (size_t threadCount = 1; threadCount <= maximumThreadCount; threadCount *= 2) {
+        size_t matchCount = 0;
+        startTime = SSKTestGetTime();
+        
+        for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+            SSKTagSnapshotSearch(&snapshot, 7, false, threadCount);
+            matchCount += snapshot.matchCount;
+        }
+        
+        double searchTime = (SSKTestGetTime() - startTime) / iterationCount;
+        
+        startTime = SSKTestGetTime();
+        
+        for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+            SSKTagSnapshotSearch(&snapshot, 5000, true, threadCount);
+        }
+        
+        double missTime = (SSKTestGetTime() - startTime) / iterationCount;
+        
+        // The whole call takes a new snapshot every time
+        startTime = SSKTestGetTime();
+        
+        for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+            SSKTagSnapshotBenchmarkTakeSnapshot(&tree, &snapshot, stack);
+            SSKTagSnapshotSearch(&snapshot, 7, false, threadCount);
+        }
+        
+        double callTime = (SSKTestGetTime() - startTime) / iterationCount;
+        
+        if (threadCount == 1) {
+            singleThreadTime = searchTime;
+        }
+        
+        printf("  %2zu thread(s): all matches %.3f ms (%zu found, %.2fx), missing tag %.3f ms, whole call %.3f ms (%.2fx serial tree search)\n",
+               threadCount, searchTime * 1000, matchCount / iterationCount, singleThreadTime / searchTime, missTime * 1000,
+               callTime * 1000, serialTime / callTime);
+    }
+    
+    free(stack);
+    SSKTagSnapshotDestroy(&snapshot);
+    SSKTagSnapshotBenchmarkTreeDestroy(&tree);
+}
+
+/**
+ *  Benchmarks how searching a tag snapshot scales from 1 to all cores, for deep & wide trees.
+ *  The snapshot time is the serial part of -ssk_concurrentlySearchChildNodesWithTag:, and the whole
+ *  call (snapshot & search) is compared to a serial search of the tree itself. Since taking the
+ *  snapshot visits every node, the whole call can't be faster than a serial search.
+ *  The maximum thread count can be passed as an argument, and defaults to the number of cores.
+ */
+int main(int argc, char **argv)
+{
+    long coreCount = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t maximumThreadCount = coreCount > 0 ? (size_t)coreCount : 1;
+    
+    if (argc > 1 && atoi(argv[1]) > 0) {
+        maximumThreadCount = (size_t)atoi(argv[1]);
+    }
+    
+    printf("cores: %ld, maximum thread count: %zu\n", coreCount, maximumThreadCount);
+    
+    SSKTagSnapshotBenchmarkRun("deep (chain)", 1000000, 1, maximumThreadCount);
+    SSKTagSnapshotBenchmarkRun("deep (binary)", 1000000, 2, maximumThreadCount);
+    SSKTagSnapshotBenchmarkRun("wide (1000 children per node)", 1000000, 1000, maximumThreadCount);
+    
+    return 0;
+}
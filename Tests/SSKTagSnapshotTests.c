@@ -0,0 +1,106 @@
+#include "SSKTagSnapshot.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+
+static void SSKTagSnapshotTestsVerifySearch(SSKTagSnapshot *snapshot, int64_t tag, size_t threadCount)
+{
+    size_t expectedMatchCount = 0;
+    size_t expectedFirstMatch = SIZE_MAX;
+    
+    SSKTestAssert(SSKTagSnapshotSearch(snapshot, tag, false, threadCount));
+    
+    for (size_t index = 0; index < snapshot->count; index++) {
+        if (snapshot->tags[index] != tag) {
+            continue;
+        }
+        
+        if (expectedFirstMatch == SIZE_MAX) {
+            expectedFirstMatch = index;
+        }
+        
+        // Matches must be found in the snapshot's order, no matter which threads found them
+        SSKTestAssert(expectedMatchCount < snapshot->matchCount && snapshot->matches[expectedMatchCount] == index);
+        expectedMatchCount++;
+    }
+    
+    SSKTestAssert(snapshot->matchCount == expectedMatchCount);
+    
+    SSKTestAssert(SSKTagSnapshotSearch(snapshot, tag, true, threadCount));
+    
+    if (expectedFirstMatch == SIZE_MAX) {
+        SSKTestAssert(snapshot->matchCount == 0);
+    } else {
+        SSKTestAssert(snapshot->matchCount == 1 && snapshot->matches[0] == expectedFirstMatch);
+    }
+}
+
+static void SSKTagSnapshotTestsEmpty(void)
+{
+    SSKTagSnapshot snapshot;
+    SSKTagSnapshotInit(&snapshot);
+    
+    SSKTestAssert(SSKTagSnapshotSearch(&snapshot, 1, false, 0));
+    SSKTestAssert(snapshot.matchCount == 0);
+    SSKTestAssert(SSKTagSnapshotSearch(&snapshot, 1, true, 0));
+    SSKTestAssert(snapshot.matchCount == 0);
+    
+    SSKTagSnapshotDestroy(&snapshot);
+}
+
+static void SSKTagSnapshotTestsRandom(void)
+{
+    const size_t threadCounts[] = {1, 2, 3, 8, 0};
+    const size_t counts[] = {1, 100, 4096, 4097, 50000, 200000};
+    unsigned int seed = 11;
+    
+    SSKTagSnapshot snapshot;
+    SSKTagSnapshotInit(&snapshot);
+    
+    for (size_t countIndex = 0; countIndex < sizeof(counts) / sizeof(counts[0]); countIndex++) {
+        SSKTagSnapshotRemoveAllTags(&snapshot);
+        
+        for (size_t index = 0; index < counts[countIndex]; index++) {
+            SSKTestAssert(SSKTagSnapshotAppend(&snapshot, SSKTestGetRandom(&seed) % 1000));
+        }
+        
+        for (size_t threadIndex = 0; threadIndex < sizeof(threadCounts) / sizeof(threadCounts[0]); threadIndex++) {
+            // Common, rare & missing tags
+            SSKTagSnapshotTestsVerifySearch(&snapshot, 7, threadCounts[threadIndex]);
+            SSKTagSnapshotTestsVerifySearch(&snapshot, 999, threadCounts[threadIndex]);
+            SSKTagSnapshotTestsVerifySearch(&snapshot, 5000, threadCounts[threadIndex]);
+        }
+    }
+    
+    SSKTagSnapshotDestroy(&snapshot);
+}
+
+static void SSKTagSnapshotTestsFirstMatchInLastChunk(void)
+{
+    SSKTagSnapshot snapshot;
+    SSKTagSnapshotInit(&snapshot);
+    
+    for (size_t index = 0; index < 100000; index++) {
+        SSKTestAssert(SSKTagSnapshotAppend(&snapshot, 0));
+    }
+    
+    snapshot.tags[99999] = 3;
+    snapshot.tags[99998] = 3;
+    
+    SSKTagSnapshotTestsVerifySearch(&snapshot, 3, 4);
+    
+    // An earlier match must win over a later one, even if a thread finds the later one first
+    snapshot.tags[5] = 3;
+    SSKTagSnapshotTestsVerifySearch(&snapshot, 3, 4);
+    
+    SSKTagSnapshotDestroy(&snapshot);
+}
+
+int main(void)
+{
+    SSKTagSnapshotTestsEmpty();
+    SSKTagSnapshotTestsRandom();
+    SSKTagSnapshotTestsFirstMatchInLastChunk();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,221 @@
+#import "SKNode+SSKTags.h"
+#include "SSKTestSupport.h"
+
+#pragma mark - Utilities
+
+static SKSpriteNode *SSKTagsTestsMakeNode(NSInteger tag, CGPoint position)
+{
+    SKSpriteNode *node = [SKSpriteNode spriteNodeWithColor:[SKColor redColor] size:CGSizeMake(10, 10)];
+    node.position = position;
+    node.ssk_tag = tag;
+    
+    return node;
+}
+
+#pragma mark - Tests
+
+static void SSKTagsTestsLookups(void)
+{
+    SKNode *rootNode = [SKNode node];
+    SKNode *firstNode = SSKTagsTestsMakeNode(1, CGPointZero);
+    SKNode *secondNode = SSKTagsTestsMakeNode(1, CGPointZero);
+    SKNode *nestedNode = SSKTagsTestsMakeNode(1, CGPointZero);
+    
+    [rootNode addChild:firstNode];
+    [rootNode addChild:secondNode];
+    [secondNode addChild:nestedNode];
+    
+    SSKTestAssert(nestedNode.ssk_tag == 1);
+    SSKTestAssert([[nestedNode.userData objectForKey:@"SuperSpriteKit_Tag"] integerValue] == 1);
+    
+    // Non-recursive lookups follow the order of the children
+    SSKTestAssert([rootNode ssk_childNodeWithTag:1] == firstNode);
+    SSKTestAssert([[rootNode ssk_childNodesWithTag:1] isEqualToArray:(@[firstNode, secondNode])]);
+    
+    NSArray *recursiveMatches = [rootNode ssk_childNodesWithTag:1 recursive:YES];
+    SSKTestAssert([recursiveMatches count] == 3 && [recursiveMatches containsObject:nestedNode]);
+    
+    // Moving a node to another tree moves it to the index of that tree
+    SKNode *otherRootNode = [SKNode node];
+    [nestedNode moveToParent:otherRootNode];
+    
+    SSKTestAssert([[rootNode ssk_childNodesWithTag:1 recursive:YES] count] == 2);
+    SSKTestAssert([otherRootNode ssk_childNodeWithTag:1 recursive:YES] == nestedNode);
+    
+    nestedNode.ssk_tag = 2;
+    SSKTestAssert([otherRootNode ssk_childNodeWithTag:1 recursive:YES] == nil);
+    SSKTestAssert([otherRootNode ssk_childNodeWithTag:2 recursive:YES] == nestedNode);
+}
+
+static void SSKTagsTestsRecursiveLookupsAreDepthFirst(void)
+{
+    SKNode *rootNode = [SKNode node];
+    SKNode *branchNode = [SKNode node];
+    SKNode *otherBranchNode = [SKNode node];
+    SKNode *firstNode = SSKTagsTestsMakeNode(1, CGPointZero);
+    SKNode *secondNode = SSKTagsTestsMakeNode(1, CGPointZero);
+    SKNode *deepNode = SSKTagsTestsMakeNode(1, CGPointZero);
+    
+    [rootNode addChild:branchNode];
+    [rootNode addChild:otherBranchNode];
+    [otherBranchNode addChild:secondNode];
+    [branchNode addChild:firstNode];
+    [firstNode addChild:deepNode];
+    
+    // All children of a node are looked at before descending into any of them
+    for (NSUInteger iteration = 0; iteration < 8; iteration++) {
+        SSKTestAssert([rootNode ssk_childNodeWithTag:1 recursive:YES] == firstNode);
+    }
+    
+    SSKTestAssert([otherBranchNode ssk_childNodeWithTag:1 recursive:YES] == secondNode);
+    
+    [firstNode removeFromParent];
+    SSKTestAssert([rootNode ssk_childNodeWithTag:1 recursive:YES] == secondNode);
+    SSKTestAssert([[rootNode ssk_childNodesWithTag:1 recursive:YES] count] == 1);
+    SSKTestAssert([firstNode ssk_childNodeWithTag:1 recursive:YES] == deepNode);
+    
+    [otherBranchNode insertChild:firstNode atIndex:0];
+    SSKTestAssert([rootNode ssk_childNodeWithTag:1 recursive:YES] == firstNode);
+    SSKTestAssert([[rootNode ssk_childNodesWithTag:1 recursive:YES] count] == 3);
+    
+    [otherBranchNode removeAllChildren];
+    SSKTestAssert([rootNode ssk_childNodeWithTag:1 recursive:YES] == nil);
+}
+
+static void SSKTagsTestsStoredTagsAreIndexed(void)
+{
+    SKNode *rootNode = [SKNode node];
+    SKNode *storedNode = [SKNode node];
+    SKNode *copiedNode = SSKTagsTestsMakeNode(3, CGPointZero);
+    
+    // Tags that only exist in userData, like ones decoded from an archive, are picked up when a tree is first indexed
+    storedNode.userData = [NSMutableDictionary new];
+    [storedNode.userData setObject:@2 forKey:@"SuperSpriteKit_Tag"];
+    [rootNode addChild:storedNode];
+    
+    SSKTestAssert(storedNode.ssk_tag == 2);
+    SSKTestAssert([rootNode ssk_childNodeWithTag:2 recursive:YES] == storedNode);
+    
+    // ...or when added to a tree that is already indexed
+    SKNode *addedNode = [SKNode node];
+    addedNode.userData = [NSMutableDictionary new];
+    [addedNode.userData setObject:@2 forKey:@"SuperSpriteKit_Tag"];
+    [storedNode addChild:addedNode];
+    
+    SSKTestAssert([[rootNode ssk_childNodesWithTag:2 recursive:YES] count] == 2);
+    
+    // Copies carry their tag in userData only
+    SKNode *copy = [copiedNode copy];
+    [rootNode addChild:copy];
+    
+    SSKTestAssert([rootNode ssk_childNodeWithTag:3 recursive:YES] == copy);
+    
+    // Assigning a new dictionary changes the tag
+    NSMutableDictionary *userData = [NSMutableDictionary new];
+    [userData setObject:@4 forKey:@"SuperSpriteKit_Tag"];
+    copy.userData = userData;
+    
+    SSKTestAssert(copy.ssk_tag == 4);
+    SSKTestAssert([rootNode ssk_childNodeWithTag:3 recursive:YES] == nil);
+    SSKTestAssert([rootNode ssk_childNodeWithTag:4 recursive:YES] == copy);
+    
+    // Writing into the existing dictionary requires a rebuild
+    [copy.userData setObject:@5 forKey:@"SuperSpriteKit_Tag"];
+    [rootNode ssk_rebuildTagIndex];
+    
+    SSKTestAssert([rootNode ssk_childNodeWithTag:4 recursive:YES] == nil);
+    SSKTestAssert([rootNode ssk_childNodeWithTag:5 recursive:YES] == copy);
+}
+
+static void SSKTagsTestsTagMaskSlots(void)
+{
+    SKNode *rootNode = [SKNode node];
+    NSMutableArray *nodes = [NSMutableArray new];
+    
+    for (NSUInteger index = 0; index < 5; index++) {
+        SKNode *node = [SKNode node];
+        node.ssk_tagMask = 0x1 | (index % 2 == 0 ? 0x2 : 0);
+        [rootNode addChild:node];
+        [nodes addObject:node];
+    }
+    
+    SKNode *unparentedNode = [SKNode node];
+    unparentedNode.ssk_tagMask = 0x3;
+    
+    SSKTestAssert([[SKNode ssk_nodesWithTagMask:0x1 excludingTagMask:0] count] == 6);
+    SSKTestAssert([[rootNode ssk_childNodesWithTagMask:0x1 excludingTagMask:0] count] == 5);
+    SSKTestAssert([[rootNode ssk_childNodesWithTagMask:0x1 excludingTagMask:0x2] count] == 2);
+    
+    // Clearing a mask moves the last mask into its slot, which must still belong to the right node
+    SKNode *clearedNode = [nodes objectAtIndex:1];
+    clearedNode.ssk_tagMask = 0;
+    
+    SSKTestAssert(clearedNode.ssk_tagMask == 0);
+    SSKTestAssert(unparentedNode.ssk_tagMask == 0x3);
+    SSKTestAssert([[nodes objectAtIndex:4] ssk_tagMask] == 0x3);
+    SSKTestAssert([[rootNode ssk_childNodesWithTagMask:0x1 excludingTagMask:0x2] isEqualToArray:(@[[nodes objectAtIndex:3]])]);
+    
+    [[nodes objectAtIndex:0] removeFromParent];
+    SSKTestAssert([[rootNode ssk_childNodesWithTagMask:0x3 excludingTagMask:0] count] == 2);
+    SSKTestAssert([[nodes objectAtIndex:2] ssk_tagMask] == 0x3 && [[nodes objectAtIndex:3] ssk_tagMask] == 0x1);
+    
+    // Deallocated nodes give up their slot
+    __weak SKNode *weakNode = nil;
+    
+    @autoreleasepool {
+        SKNode *node = [SKNode node];
+        node.ssk_tagMask = 0x8;
+        weakNode = node;
+    }
+    
+    SSKTestAssert(weakNode == nil);
+    SSKTestAssert([[SKNode ssk_nodesWithTagMask:0x8 excludingTagMask:0] count] == 0);
+    SSKTestAssert([[SKNode ssk_nodesWithTagMask:0x3 excludingTagMask:0] containsObject:unparentedNode]);
+}
+
+static void SSKTagsTestsSpatialIndexRemovesNodes(void)
+{
+    SKNode *rootNode = [SKNode node];
+    SKNode *node = SSKTagsTestsMakeNode(1, CGPointZero);
+    SKNode *otherNode = SSKTagsTestsMakeNode(1, CGPointMake(100, 100));
+    
+    [rootNode addChild:node];
+    [rootNode addChild:otherNode];
+    
+    // The first indexed node gets entry 0, which must be removable like any other entry
+    [rootNode ssk_enableSpatialIndexForTag:1 cellSize:32];
+    SSKTestAssert([[rootNode ssk_nodesAtPoint:CGPointZero withTag:1] isEqualToArray:@[node]]);
+    
+    node.ssk_tag = 2;
+    [rootNode ssk_updateSpatialIndexes];
+    SSKTestAssert([[rootNode ssk_nodesAtPoint:CGPointZero withTag:1] count] == 0);
+    SSKTestAssert([[rootNode ssk_nodesAtPoint:CGPointMake(100, 100) withTag:1] isEqualToArray:@[otherNode]]);
+    
+    node.ssk_tag = 1;
+    [rootNode ssk_updateSpatialIndexes];
+    SSKTestAssert([[rootNode ssk_nodesAtPoint:CGPointZero withTag:1] isEqualToArray:@[node]]);
+    
+    [node removeFromParent];
+    [rootNode ssk_updateSpatialIndexes];
+    SSKTestAssert([[rootNode ssk_nodesAtPoint:CGPointZero withTag:1] count] == 0);
+    SSKTestAssert([[rootNode ssk_nodesInRect:CGRectMake(-50, -50, 200, 200) withTag:1] isEqualToArray:@[otherNode]]);
+    
+    // Moved nodes are found at their new position only
+    otherNode.position = CGPointMake(300, 300);
+    [rootNode ssk_updateSpatialIndexes];
+    SSKTestAssert([[rootNode ssk_nodesAtPoint:CGPointMake(100, 100) withTag:1] count] == 0);
+    SSKTestAssert([[rootNode ssk_nodesAtPoint:CGPointMake(300, 300) withTag:1] isEqualToArray:@[otherNode]]);
+}
+
+int main(void)
+{
+    @autoreleasepool {
+        SSKTagsTestsLookups();
+        SSKTagsTestsRecursiveLookupsAreDepthFirst();
+        SSKTagsTestsStoredTagsAreIndexed();
+        SSKTagsTestsTagMaskSlots();
+        SSKTagsTestsSpatialIndexRemovesNodes();
+    }
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,54 @@
+#ifndef SSKTestSupport_h
+#define SSKTestSupport_h
+
+#include <stdio.h>
+#include <time.h>
+
+/**
+ *  Minimal assertion & timing utilities shared by the tests and benchmarks of the portable C cores
+ *
+ *  @discussion A failing assertion is reported, but doesn't abort the test, so that a single run
+ *  reports all failures. Tests return SSKTestGetExitCode() from main().
+ */
+
+static int SSKTestFailureCount = 0;
+
+#define SSKTestAssert(condition) do { \
+    if (!(condition)) { \
+        fprintf(stderr, "%s:%d: Assertion failed: %s\n", __FILE__, __LINE__, #condition); \
+        SSKTestFailureCount++; \
+    } \
+} while (0)
+
+static inline int SSKTestGetExitCode(void)
+{
+    if (SSKTestFailureCount > 0) {
+        fprintf(stderr, "%d assertion(s) failed\n", SSKTestFailureCount);
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ *  Get the current time of a monotonic clock, in seconds
+ */
+static inline double SSKTestGetTime(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    
+    return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+}
+
+/**
+ *  Return a pseudo-random number, using a deterministic generator so that runs are repeatable
+ */
+static inline unsigned int SSKTestGetRandom(unsigned int *seed)
+{
+    *seed = *seed * 1103515245u + 12345u;
+    
+    return (*seed >> 16) & 0x7fff;
+}
+
+#endif
@@ -0,0 +1,49 @@
+#include "SSKTileLayout.h"
+#include "SSKTestSupport.h"
+
+/**
+ *  Compares the vectorized tile layout kernel against the scalar loop, by tiling a 4K
+ *  background with textures of various sizes
+ */
+int main(void)
+{
+    const double textureSizes[3] = {8, 16, 64};
+    const size_t iterationCount = 200;
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    printf("%-10s %10s %14s %14s %9s\n", "texture", "tiles", "simd (ms)", "scalar (ms)", "speedup");
+    
+    for (size_t sizeIndex = 0; sizeIndex < 3; sizeIndex++) {
+        SSKTileSize size = {3840, 2160};
+        SSKTileSize textureSize = {textureSizes[sizeIndex], textureSizes[sizeIndex]};
+        SSKTileRect textureRect = {0, 0, 1, 1};
+        SSKTileGrid grid = SSKTileGridMake(size, textureSize, textureRect);
+        SSKTileRange range = SSKTileGridGetFullRange(&grid);
+        
+        // Warm up, so that the layout's arrays are already allocated when timing
+        SSKTileLayoutCompute(&layout, &grid, range);
+        
+        double startTime = SSKTestGetTime();
+        
+        for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+            SSKTileLayoutCompute(&layout, &grid, range);
+        }
+        
+        double simdTime = (SSKTestGetTime() - startTime) / iterationCount;
+        startTime = SSKTestGetTime();
+        
+        for (size_t iteration = 0; iteration < iterationCount; iteration++) {
+            SSKTileLayoutComputeScalar(&layout, &grid, range);
+        }
+        
+        double scalarTime = (SSKTestGetTime() - startTime) / iterationCount;
+        
+        printf("%-10g %10zu %14.3f %14.3f %8.2fx\n", textureSizes[sizeIndex], layout.count, simdTime * 1000, scalarTime * 1000, scalarTime / simdTime);
+    }
+    
+    SSKTileLayoutDestroy(&layout);
+    
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "SSKTileLayout.h"
+#include "SSKTestSupport.h"
+
+#pragma mark - Utilities
+
+static bool SSKTileLayoutSIMDTestsLayoutsAreEqual(const SSKTileLayout *layout, const SSKTileLayout *otherLayout)
+{
+    if (layout->count != otherLayout->count) {
+        return false;
+    }
+    
+    for (size_t index = 0; index < layout->count; index++) {
+        if (layout->x[index] != otherLayout->x[index] ||
+            layout->y[index] != otherLayout->y[index] ||
+            layout->width[index] != otherLayout->width[index] ||
+            layout->height[index] != otherLayout->height[index] ||
+            layout->textureX[index] != otherLayout->textureX[index] ||
+            layout->textureY[index] != otherLayout->textureY[index] ||
+            layout->textureWidth[index] != otherLayout->textureWidth[index] ||
+            layout->textureHeight[index] != otherLayout->textureHeight[index]) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+#pragma mark - Tests
+
+static void SSKTileLayoutSIMDTestsMatchScalar(void)
+{
+    SSKTileLayout layout, scalarLayout;
+    SSKTileLayoutInit(&layout);
+    SSKTileLayoutInit(&scalarLayout);
+    
+    unsigned int seed = 1;
+    size_t mismatchCount = 0;
+    
+    // Random sizes & ranges exercise partial last columns & rows, and column counts that aren't multiples of the lane count
+    for (size_t iteration = 0; iteration < 2000; iteration++) {
+        SSKTileSize size = {SSKTestGetRandom(&seed) % 500 + (SSKTestGetRandom(&seed) % 100) / 7.0, SSKTestGetRandom(&seed) % 300 + 0.5};
+        SSKTileSize textureSize = {SSKTestGetRandom(&seed) % 40 + 1.5, SSKTestGetRandom(&seed) % 40 + 1};
+        SSKTileRect textureRect = {0.1, 0.2, 0.5, 0.25};
+        SSKTileGrid grid = SSKTileGridMake(size, textureSize, textureRect);
+        
+        SSKTileRange range;
+        range.column = SSKTestGetRandom(&seed) % 5;
+        range.row = SSKTestGetRandom(&seed) % 3;
+        range.columns = SSKTestGetRandom(&seed) % 30 + 1;
+        range.rows = SSKTestGetRandom(&seed) % 20 + 1;
+        
+        bool hasTiles = SSKTileLayoutCompute(&layout, &grid, range);
+        bool hasScalarTiles = SSKTileLayoutComputeScalar(&scalarLayout, &grid, range);
+        
+        if (hasTiles != hasScalarTiles || !SSKTileLayoutSIMDTestsLayoutsAreEqual(&layout, &scalarLayout)) {
+            mismatchCount++;
+        }
+    }
+    
+    SSKTestAssert(mismatchCount == 0);
+    
+    SSKTileLayoutDestroy(&layout);
+    SSKTileLayoutDestroy(&scalarLayout);
+}
+
+int main(void)
+{
+    SSKTileLayoutSIMDTestsMatchScalar();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,95 @@
+#include "SSKTileLayout.h"
+#include "SSKTestSupport.h"
+
+#include <math.h>
+
+#pragma mark - Utilities
+
+static SSKTileGrid SSKTileLayoutTestsMakeGrid(double width, double height, double textureWidth, double textureHeight)
+{
+    SSKTileSize size = {width, height};
+    SSKTileSize textureSize = {textureWidth, textureHeight};
+    SSKTileRect textureRect = {0.5, 0, 0.25, 0.5};
+    
+    return SSKTileGridMake(size, textureSize, textureRect);
+}
+
+static bool SSKTileLayoutTestsRectsAreEqual(SSKTileRect rect, double x, double y, double width, double height)
+{
+    return rect.x == x && rect.y == y && rect.width == width && rect.height == height;
+}
+
+static bool SSKTileLayoutTestsRectsAreClose(SSKTileRect rect, double x, double y, double width, double height)
+{
+    const double tolerance = 1e-12;
+    
+    return fabs(rect.x - x) < tolerance && fabs(rect.y - y) < tolerance
+        && fabs(rect.width - width) < tolerance && fabs(rect.height - height) < tolerance;
+}
+
+#pragma mark - Tests
+
+static void SSKTileLayoutTestsGrid(void)
+{
+    SSKTileGrid grid = SSKTileLayoutTestsMakeGrid(25, 12, 10, 10);
+    
+    SSKTestAssert(grid.columns == 3);
+    SSKTestAssert(grid.rows == 2);
+    SSKTestAssert(!SSKTileGridIsTileCropped(&grid, 1, 0));
+    SSKTestAssert(SSKTileGridIsTileCropped(&grid, 2, 0));
+    SSKTestAssert(SSKTileGridIsTileCropped(&grid, 0, 1));
+    
+    SSKTileRect rect, textureRect;
+    SSKTileGridGetTile(&grid, 2, 1, &rect, &textureRect);
+    
+    // The last tile is cropped to 5x2 points, which is half the width & a fifth of the height of the texture
+    SSKTestAssert(SSKTileLayoutTestsRectsAreEqual(rect, 20, 10, 5, 2));
+    SSKTestAssert(SSKTileLayoutTestsRectsAreClose(textureRect, 0.5, 0, 0.125, 0.1));
+    
+    SSKTileGrid emptyGrid = SSKTileLayoutTestsMakeGrid(25, 12, 0, 10);
+    SSKTestAssert(emptyGrid.columns == 0 || emptyGrid.rows == 0);
+}
+
+static void SSKTileLayoutTestsCompute(void)
+{
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    SSKTileGrid grid = SSKTileLayoutTestsMakeGrid(3840, 2160, 16, 24);
+    SSKTileRange ranges[3] = {
+        SSKTileGridGetFullRange(&grid),
+        {5, 7, 13, 9},
+        {grid.columns - 3, grid.rows - 2, 10, 10}
+    };
+    
+    for (size_t rangeIndex = 0; rangeIndex < 3; rangeIndex++) {
+        SSKTileRange range = SSKTileRangeGetIntersection(ranges[rangeIndex], SSKTileGridGetFullRange(&grid));
+        
+        SSKTestAssert(SSKTileLayoutCompute(&layout, &grid, ranges[rangeIndex]));
+        SSKTestAssert(layout.count == range.columns * range.rows);
+        
+        // The layout must match the geometry of each individual tile exactly, in rows of columns, since both use the same formulas
+        for (size_t index = 0; index < layout.count; index++) {
+            SSKTileRect rect, textureRect;
+            SSKTileGridGetTile(&grid, range.column + index % range.columns, range.row + index / range.columns, &rect, &textureRect);
+            
+            SSKTestAssert(SSKTileLayoutTestsRectsAreEqual(rect, layout.x[index], layout.y[index], layout.width[index], layout.height[index]));
+            SSKTestAssert(SSKTileLayoutTestsRectsAreEqual(textureRect, layout.textureX[index], layout.textureY[index], layout.textureWidth[index], layout.textureHeight[index]));
+        }
+    }
+    
+    SSKTileRange outsideRange = {grid.columns, 0, 4, 4};
+    SSKTestAssert(!SSKTileLayoutCompute(&layout, &grid, outsideRange));
+    SSKTestAssert(layout.count == 0);
+    
+    SSKTileLayoutDestroy(&layout);
+    SSKTestAssert(layout.capacity == 0);
+}
+
+int main(void)
+{
+    SSKTileLayoutTestsGrid();
+    SSKTileLayoutTestsCompute();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,168 @@
+#include "SSKTileMesh.h"
+#include "SSKTestSupport.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#pragma mark - Utilities
+
+static SSKTileImage SSKTileMeshTestsMakeImage(size_t width, size_t height)
+{
+    SSKTileImage image = {width, height, calloc(width * height, sizeof(uint32_t))};
+    
+    return image;
+}
+
+/**
+ *  Draw every tile of a grid as its own quad, the way the per-sprite path creates one sprite per tile
+ */
+static void SSKTileMeshTestsRasterizeTilesIndividually(const SSKTileGrid *grid, const SSKTileImage *texture, SSKTileImage *target)
+{
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    
+    for (size_t row = 0; row < grid->rows; row++) {
+        for (size_t column = 0; column < grid->columns; column++) {
+            SSKTileRect rect, textureRect;
+            SSKTileGridGetTile(grid, column, row, &rect, &textureRect);
+            
+            SSKTileMeshRemoveAllQuads(&mesh);
+            SSKTileMeshAppendQuad(&mesh, rect, textureRect);
+            SSKTileMeshRasterize(&mesh, texture, target);
+        }
+    }
+    
+    SSKTileMeshDestroy(&mesh);
+}
+
+#pragma mark - Tests
+
+static void SSKTileMeshTestsBuild(void)
+{
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    
+    SSKTileSize size = {25, 12};
+    SSKTileSize textureSize = {10, 10};
+    SSKTileRect textureRect = {0, 0, 1, 1};
+    SSKTileGrid grid = SSKTileGridMake(size, textureSize, textureRect);
+    
+    SSKTestAssert(SSKTileMeshBuild(&mesh, &grid, &layout));
+    SSKTestAssert(mesh.vertexCount == grid.columns * grid.rows * 4);
+    SSKTestAssert(mesh.indexCount == grid.columns * grid.rows * 6);
+    
+    // The last quad covers the cropped top right tile, and its bottom left vertex maps to the texture's origin
+    const SSKTileMeshVertex *vertices = &mesh.vertices[mesh.vertexCount - 4];
+    SSKTestAssert(vertices[0].x == 20 && vertices[0].y == 10 && vertices[0].u == 0 && vertices[0].v == 0);
+    SSKTestAssert(vertices[2].x == 25 && vertices[2].y == 12 && vertices[2].u == 0.5f && vertices[2].v == 0.2f);
+    
+    SSKTileMeshRemoveAllQuads(&mesh);
+    SSKTestAssert(mesh.vertexCount == 0 && mesh.indexCount == 0);
+    
+    SSKTileMeshDestroy(&mesh);
+    SSKTileLayoutDestroy(&layout);
+}
+
+static void SSKTileMeshTestsPixelEquivalence(void)
+{
+    const SSKTileSize sizes[3] = {{25, 12}, {64, 64}, {97, 41}};
+    const SSKTileSize textureSizes[3] = {{10, 10}, {16, 16}, {12, 7}};
+    const SSKTileRect textureRects[2] = {{0, 0, 1, 1}, {0.25, 0.5, 0.5, 0.5}};
+    
+    SSKTileImage texture = SSKTileMeshTestsMakeImage(32, 32);
+    
+    for (size_t index = 0; index < texture.width * texture.height; index++) {
+        texture.pixels[index] = (uint32_t)index + 1;
+    }
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    
+    for (size_t sizeIndex = 0; sizeIndex < 3; sizeIndex++) {
+        for (size_t rectIndex = 0; rectIndex < 2; rectIndex++) {
+            SSKTileGrid grid = SSKTileGridMake(sizes[sizeIndex], textureSizes[sizeIndex], textureRects[rectIndex]);
+            size_t width = (size_t)sizes[sizeIndex].width;
+            size_t height = (size_t)sizes[sizeIndex].height;
+            
+            SSKTileImage batchedImage = SSKTileMeshTestsMakeImage(width, height);
+            SSKTileImage individualImage = SSKTileMeshTestsMakeImage(width, height);
+            
+            SSKTileMeshBuild(&mesh, &grid, &layout);
+            SSKTileMeshRasterize(&mesh, &texture, &batchedImage);
+            SSKTileMeshTestsRasterizeTilesIndividually(&grid, &texture, &individualImage);
+            
+            SSKTestAssert(memcmp(batchedImage.pixels, individualImage.pixels, width * height * sizeof(uint32_t)) == 0);
+            
+            // Every pixel must be covered exactly once, so no pixel may be left empty
+            size_t emptyPixelCount = 0;
+            
+            for (size_t index = 0; index < width * height; index++) {
+                emptyPixelCount += (batchedImage.pixels[index] == 0);
+            }
+            
+            SSKTestAssert(emptyPixelCount == 0);
+            
+            free(batchedImage.pixels);
+            free(individualImage.pixels);
+        }
+    }
+    
+    SSKTileMeshDestroy(&mesh);
+    SSKTileLayoutDestroy(&layout);
+    free(texture.pixels);
+}
+
+static void SSKTileMeshTestsTiledPattern(void)
+{
+    // With a full texture rect, the tiled image repeats the texture, starting over every 10 pixels
+    SSKTileImage texture = SSKTileMeshTestsMakeImage(10, 10);
+    
+    for (size_t index = 0; index < 100; index++) {
+        texture.pixels[index] = (uint32_t)index + 1;
+    }
+    
+    SSKTileSize size = {25, 12};
+    SSKTileSize textureSize = {10, 10};
+    SSKTileRect textureRect = {0, 0, 1, 1};
+    SSKTileGrid grid = SSKTileGridMake(size, textureSize, textureRect);
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    SSKTileMeshBuild(&mesh, &grid, &layout);
+    
+    SSKTileImage image = SSKTileMeshTestsMakeImage(25, 12);
+    SSKTileMeshRasterize(&mesh, &texture, &image);
+    
+    size_t mismatchCount = 0;
+    
+    for (size_t y = 0; y < 12; y++) {
+        for (size_t x = 0; x < 25; x++) {
+            mismatchCount += (image.pixels[y * 25 + x] != (uint32_t)((y % 10) * 10 + (x % 10) + 1));
+        }
+    }
+    
+    SSKTestAssert(mismatchCount == 0);
+    
+    free(image.pixels);
+    free(texture.pixels);
+    SSKTileMeshDestroy(&mesh);
+    SSKTileLayoutDestroy(&layout);
+}
+
+int main(void)
+{
+    SSKTileMeshTestsBuild();
+    SSKTileMeshTestsPixelEquivalence();
+    SSKTileMeshTestsTiledPattern();
+    
+    return SSKTestGetExitCode();
+}
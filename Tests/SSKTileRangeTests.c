@@ -0,0 +1,126 @@
+#include "SSKTileLayout.h"
+#include "SSKTestSupport.h"
+
+#pragma mark - Utilities
+
+static SSKTileRange SSKTileRangeTestsMakeRange(size_t column, size_t row, size_t columns, size_t rows)
+{
+    SSKTileRange range = {column, row, columns, rows};
+    return range;
+}
+
+static size_t SSKTileRangeTestsCountTilesInRanges(const SSKTileRange *ranges, size_t count, size_t column, size_t row)
+{
+    size_t matchCount = 0;
+    
+    for (size_t index = 0; index < count; index++) {
+        if (SSKTileRangeContainsTile(ranges[index], column, row)) {
+            matchCount++;
+        }
+    }
+    
+    return matchCount;
+}
+
+static void SSKTileRangeTestsAssertSubtraction(SSKTileRange range, SSKTileRange subtractedRange)
+{
+    SSKTileRange differences[4];
+    size_t differenceCount = SSKTileRangeSubtract(range, subtractedRange, differences);
+    SSKTestAssert(differenceCount <= 4);
+    
+    // Every tile of the range must be covered by exactly one difference, unless it's in the subtracted range
+    for (size_t row = 0; row < 24; row++) {
+        for (size_t column = 0; column < 24; column++) {
+            size_t expectedCount = SSKTileRangeContainsTile(range, column, row) && !SSKTileRangeContainsTile(subtractedRange, column, row) ? 1 : 0;
+            SSKTestAssert(SSKTileRangeTestsCountTilesInRanges(differences, differenceCount, column, row) == expectedCount);
+        }
+    }
+    
+    for (size_t index = 0; index < differenceCount; index++) {
+        SSKTestAssert(differences[index].columns > 0 && differences[index].rows > 0);
+    }
+}
+
+#pragma mark - Tests
+
+static void SSKTileRangeTestsIntersection(void)
+{
+    SSKTileRange range = {0, 0, 10, 8};
+    
+    SSKTileRange intersection = SSKTileRangeGetIntersection(range, SSKTileRangeTestsMakeRange(3, 2, 4, 20));
+    SSKTestAssert(intersection.column == 3 && intersection.row == 2 && intersection.columns == 4 && intersection.rows == 6);
+    
+    intersection = SSKTileRangeGetIntersection(range, range);
+    SSKTestAssert(intersection.column == 0 && intersection.row == 0 && intersection.columns == 10 && intersection.rows == 8);
+    
+    // Ranges that only touch, or don't overlap at all, have an empty intersection
+    intersection = SSKTileRangeGetIntersection(range, SSKTileRangeTestsMakeRange(10, 0, 4, 4));
+    SSKTestAssert(intersection.columns == 0 && intersection.rows == 0);
+    
+    intersection = SSKTileRangeGetIntersection(range, SSKTileRangeTestsMakeRange(20, 20, 2, 2));
+    SSKTestAssert(intersection.columns == 0 && intersection.rows == 0);
+}
+
+static void SSKTileRangeTestsSubtract(void)
+{
+    SSKTileRange range = {2, 2, 10, 8};
+    
+    // Subtracted ranges overlapping each side, each corner, the middle, and all of the range
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(5, 4, 4, 20));
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(0, 4, 6, 2));
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(8, 0, 10, 5));
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(0, 8, 4, 4));
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(4, 4, 2, 2));
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(0, 0, 20, 20));
+    
+    SSKTileRange differences[4];
+    SSKTestAssert(SSKTileRangeSubtract(range, SSKTileRangeTestsMakeRange(4, 4, 2, 2), differences) == 4);
+}
+
+static void SSKTileRangeTestsSubtractDisjoint(void)
+{
+    SSKTileRange range = {0, 0, 10, 8};
+    SSKTileRange differences[4];
+    
+    // A range that doesn't overlap leaves the whole range as the only difference
+    SSKTestAssert(SSKTileRangeSubtract(range, SSKTileRangeTestsMakeRange(20, 20, 2, 2), differences) == 1);
+    SSKTestAssert(differences[0].column == 0 && differences[0].row == 0 && differences[0].columns == 10 && differences[0].rows == 8);
+    
+    SSKTestAssert(SSKTileRangeSubtract(range, SSKTileRangeTestsMakeRange(10, 0, 2, 8), differences) == 1);
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(10, 0, 2, 8));
+}
+
+static void SSKTileRangeTestsSubtractSelf(void)
+{
+    SSKTileRange range = {3, 1, 5, 6};
+    SSKTileRange differences[4];
+    
+    SSKTestAssert(SSKTileRangeSubtract(range, range, differences) == 0);
+}
+
+static void SSKTileRangeTestsEmpty(void)
+{
+    SSKTileRange range = {0, 0, 10, 8};
+    SSKTileRange differences[4];
+    
+    // Nothing is left of an empty range, and subtracting an empty range leaves the whole range
+    SSKTestAssert(SSKTileRangeSubtract(SSKTileRangeTestsMakeRange(2, 2, 0, 5), range, differences) == 0);
+    SSKTestAssert(SSKTileRangeSubtract(SSKTileRangeTestsMakeRange(2, 2, 5, 0), range, differences) == 0);
+    SSKTestAssert(SSKTileRangeSubtract(range, SSKTileRangeTestsMakeRange(2, 2, 0, 0), differences) == 1);
+    SSKTileRangeTestsAssertSubtraction(range, SSKTileRangeTestsMakeRange(2, 2, 0, 0));
+    
+    SSKTileRange intersection = SSKTileRangeGetIntersection(range, SSKTileRangeTestsMakeRange(2, 2, 0, 4));
+    SSKTestAssert(intersection.columns == 0 || intersection.rows == 0);
+    SSKTestAssert(!SSKTileRangeContainsTile(SSKTileRangeTestsMakeRange(2, 2, 0, 4), 2, 2));
+}
+
+int main(void)
+{
+    SSKTileRangeTestsIntersection();
+    SSKTileRangeTestsSubtract();
+    SSKTileRangeTestsSubtractDisjoint();
+    SSKTileRangeTestsSubtractSelf();
+    SSKTileRangeTestsEmpty();
+    
+    return SSKTestGetExitCode();
+}
@@ -0,0 +1,96 @@
+#include "SSKTilemap.h"
+#include "SSKTestSupport.h"
+
+/**
+ *  Benchmarks a 1024x1024 tilemap: 1M random single tile edits, 10k random rectangular fills,
+ *  and full rebuilds of the geometry & meshes of all of its chunks, like a level being loaded
+ */
+int main(void)
+{
+    const size_t columns = 1024;
+    const size_t rows = 1024;
+    const size_t editCount = 1000000;
+    const size_t fillCount = 10000;
+    const size_t rebuildCount = 5;
+    const SSKTileSize tileSize = {32, 32};
+    const SSKTilemapTexture textures[4] = {
+        {{32, 32}, {0, 0, 0.5, 0.5}},
+        {{32, 32}, {0.5, 0, 0.5, 0.5}},
+        {{16, 16}, {0, 0.5, 0.25, 0.25}},
+        {{48, 48}, {0.5, 0.5, 0.5, 0.5}}
+    };
+    
+    SSKTilemap tilemap;
+    SSKTilemapInit(&tilemap, columns, rows, 16);
+    
+    unsigned int seed = 7;
+    size_t changedCount = 0;
+    
+    double startTime = SSKTestGetTime();
+    
+    for (size_t index = 0; index < editCount; index++) {
+        const SSKTileID tileID = (SSKTileID)(SSKTestGetRandom(&seed) % 5);
+        changedCount += SSKTilemapFill(&tilemap, tileID, SSKTestGetRandom(&seed) % columns, SSKTestGetRandom(&seed) % rows, 1, 1);
+    }
+    
+    double editTime = SSKTestGetTime() - startTime;
+    
+    printf("edits: %zu tiles (%zu changed, %zu dirty chunks) in %.3f ms (%.1f ns per tile)\n",
+           editCount, changedCount, tilemap.dirtyChunkCount, editTime * 1000, editTime * 1e9 / editCount);
+    
+    SSKTilemapRemoveAllDirtyChunks(&tilemap);
+    changedCount = 0;
+    
+    startTime = SSKTestGetTime();
+    
+    for (size_t index = 0; index < fillCount; index++) {
+        const SSKTileID tileID = (SSKTileID)(1 + SSKTestGetRandom(&seed) % 4);
+        changedCount += SSKTilemapFill(&tilemap, tileID,
+                                       SSKTestGetRandom(&seed) % columns, SSKTestGetRandom(&seed) % rows,
+                                       1 + SSKTestGetRandom(&seed) % 64, 1 + SSKTestGetRandom(&seed) % 64);
+    }
+    
+    double fillTime = SSKTestGetTime() - startTime;
+    
+    printf("fills: %zu rects (%zu tiles changed) in %.3f ms (%.1f ns per changed tile)\n",
+           fillCount, changedCount, fillTime * 1000, fillTime * 1e9 / (double)changedCount);
+    
+    SSKTilemapChunkGeometry geometry;
+    SSKTilemapChunkGeometryInit(&geometry);
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    
+    size_t quadCount = 0;
+    
+    startTime = SSKTestGetTime();
+    
+    for (size_t rebuild = 0; rebuild < rebuildCount; rebuild++) {
+        SSKTilemapSetAllChunksDirty(&tilemap);
+        
+        for (size_t index = 0; index < tilemap.dirtyChunkCount; index++) {
+            SSKTilemapComputeChunkGeometry(&geometry, &tilemap, tilemap.dirtyChunks[index], tileSize, textures, 4, &layout);
+            
+            SSKTileMeshRemoveAllQuads(&mesh);
+            SSKTilemapChunkGeometryAppendToMesh(&geometry, &mesh);
+            quadCount += mesh.vertexCount / 4;
+        }
+        
+        SSKTilemapRemoveAllDirtyChunks(&tilemap);
+    }
+    
+    double rebuildTime = SSKTestGetTime() - startTime;
+    
+    printf("rebuilds: %zu full rebuilds (%zu quads) in %.3f ms (%.3f ms per rebuild, %.1f ns per quad)\n",
+           rebuildCount, quadCount, rebuildTime * 1000, rebuildTime * 1000 / rebuildCount, rebuildTime * 1e9 / (double)quadCount);
+    
+    SSKTileMeshDestroy(&mesh);
+    SSKTileLayoutDestroy(&layout);
+    SSKTilemapChunkGeometryDestroy(&geometry);
+    SSKTilemapDestroy(&tilemap);
+    
+    return 0;
+}
@@ -0,0 +1,263 @@
+#include "SSKTilemap.h"
+#include "SSKTestSupport.h"
+
+#include <math.h>
+
+#pragma mark - Utilities
+
+static bool SSKTilemapTestsRectIsEqual(SSKTileRect rect, double x, double y, double width, double height)
+{
+    const double tolerance = 1e-9;
+    
+    return fabs(rect.x - x) < tolerance && fabs(rect.y - y) < tolerance
+        && fabs(rect.width - width) < tolerance && fabs(rect.height - height) < tolerance;
+}
+
+#pragma mark - Tests
+
+static void SSKTilemapTestsInit(void)
+{
+    SSKTilemap tilemap;
+    
+    SSKTestAssert(!SSKTilemapInit(&tilemap, 10, 10, 0));
+    SSKTestAssert(tilemap.columns == 0 && tilemap.chunkColumns == 0);
+    SSKTilemapDestroy(&tilemap);
+    
+    // Partial chunks are rounded up
+    SSKTestAssert(SSKTilemapInit(&tilemap, 10, 5, 4));
+    SSKTestAssert(tilemap.chunkColumns == 3);
+    SSKTestAssert(tilemap.chunkRows == 2);
+    SSKTestAssert(tilemap.dirtyChunkCount == 0);
+    SSKTestAssert(SSKTilemapGetTileID(&tilemap, 9, 4) == 0);
+    SSKTilemapDestroy(&tilemap);
+    
+    SSKTestAssert(SSKTilemapInit(&tilemap, 0, 0, 4));
+    SSKTestAssert(SSKTilemapFill(&tilemap, 1, 0, 0, 1, 1) == 0);
+    SSKTilemapSetAllChunksDirty(&tilemap);
+    SSKTestAssert(tilemap.dirtyChunkCount == 0);
+    SSKTilemapDestroy(&tilemap);
+}
+
+static void SSKTilemapTestsFill(void)
+{
+    SSKTilemap tilemap;
+    SSKTilemapInit(&tilemap, 10, 10, 4);
+    
+    // The range is clamped to the tilemap
+    SSKTestAssert(SSKTilemapFill(&tilemap, 3, 8, 8, 5, 5) == 4);
+    SSKTestAssert(SSKTilemapGetTileID(&tilemap, 9, 9) == 3);
+    SSKTestAssert(SSKTilemapGetTileID(&tilemap, 7, 9) == 0);
+    SSKTestAssert(SSKTilemapGetTileID(&tilemap, 10, 9) == 0);
+    SSKTestAssert(SSKTilemapFill(&tilemap, 3, 10, 0, 1, 1) == 0);
+    
+    // Only tiles whose ID changes are counted
+    SSKTestAssert(SSKTilemapFill(&tilemap, 3, 7, 7, 3, 3) == 5);
+    SSKTestAssert(SSKTilemapFill(&tilemap, 3, 7, 7, 3, 3) == 0);
+    SSKTestAssert(SSKTilemapFill(&tilemap, 0, 0, 0, 10, 10) == 9);
+    SSKTestAssert(SSKTilemapFill(&tilemap, 1, 0, 0, 0, 10) == 0);
+    
+    SSKTilemapDestroy(&tilemap);
+}
+
+static void SSKTilemapTestsDirtyChunks(void)
+{
+    SSKTilemap tilemap;
+    SSKTilemapInit(&tilemap, 10, 10, 4);
+    
+    // Chunks are marked once, in the order they were first changed
+    SSKTilemapFill(&tilemap, 1, 5, 5, 1, 1);
+    SSKTilemapFill(&tilemap, 1, 0, 0, 1, 1);
+    SSKTilemapFill(&tilemap, 2, 5, 5, 2, 2);
+    SSKTestAssert(tilemap.dirtyChunkCount == 2);
+    SSKTestAssert(tilemap.dirtyChunks[0] == 4);
+    SSKTestAssert(tilemap.dirtyChunks[1] == 0);
+    
+    SSKTilemapRemoveAllDirtyChunks(&tilemap);
+    SSKTestAssert(tilemap.dirtyChunkCount == 0);
+    
+    // Setting tiles to the ID they already have doesn't mark their chunks
+    SSKTilemapFill(&tilemap, 2, 5, 5, 2, 2);
+    SSKTestAssert(tilemap.dirtyChunkCount == 0);
+    
+    // A fill spanning several chunks marks each of them, including partial edge chunks
+    SSKTilemapFill(&tilemap, 3, 3, 3, 7, 1);
+    SSKTestAssert(tilemap.dirtyChunkCount == 3);
+    SSKTestAssert(tilemap.dirtyChunks[0] == 0);
+    SSKTestAssert(tilemap.dirtyChunks[1] == 1);
+    SSKTestAssert(tilemap.dirtyChunks[2] == 2);
+    
+    SSKTilemapSetAllChunksDirty(&tilemap);
+    SSKTestAssert(tilemap.dirtyChunkCount == 9);
+    SSKTestAssert(tilemap.dirtyChunks[3] == 3);
+    SSKTestAssert(tilemap.dirtyChunks[8] == 8);
+    
+    SSKTilemapSetChunkDirty(&tilemap, 9);
+    SSKTestAssert(tilemap.dirtyChunkCount == 9);
+    
+    SSKTilemapRemoveAllDirtyChunks(&tilemap);
+    SSKTilemapSetChunkDirty(&tilemap, 8);
+    SSKTestAssert(tilemap.dirtyChunkCount == 1);
+    
+    SSKTilemapDestroy(&tilemap);
+}
+
+static void SSKTilemapTestsChunkGeometry(void)
+{
+    SSKTilemap tilemap;
+    SSKTilemapInit(&tilemap, 5, 5, 4);
+    
+    SSKTilemapChunkGeometry geometry;
+    SSKTilemapChunkGeometryInit(&geometry);
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    const SSKTileSize tileSize = {32, 32};
+    const SSKTilemapTexture textures[3] = {
+        {{32, 32}, {0, 0, 0.5, 0.5}},
+        {{16, 16}, {0.5, 0, 0.25, 0.25}},
+        {{64, 64}, {0, 0.5, 0.5, 0.5}}
+    };
+    
+    SSKTilemapFill(&tilemap, 1, 0, 0, 1, 1);
+    SSKTilemapFill(&tilemap, 2, 1, 0, 1, 1);
+    SSKTilemapFill(&tilemap, 3, 2, 0, 1, 1);
+    SSKTilemapFill(&tilemap, 4, 3, 0, 1, 1);
+    SSKTilemapFill(&tilemap, 1, 4, 4, 1, 1);
+    
+    SSKTestAssert(SSKTilemapComputeChunkGeometry(&geometry, &tilemap, 0, tileSize, textures, 3, &layout));
+    
+    // A texture matching the tile size is one piece, a smaller one repeats, and a larger one is cropped
+    SSKTestAssert(geometry.count == 6);
+    SSKTestAssert(geometry.tileIDs[0] == 1);
+    SSKTestAssert(SSKTilemapTestsRectIsEqual(geometry.rects[0], 0, 0, 32, 32));
+    SSKTestAssert(SSKTilemapTestsRectIsEqual(geometry.textureRects[0], 0, 0, 0.5, 0.5));
+    SSKTestAssert(!geometry.isCropped[0]);
+    
+    double repeatedArea = 0;
+    
+    for (size_t index = 1; index < 5; index++) {
+        SSKTestAssert(geometry.tileIDs[index] == 2);
+        SSKTestAssert(!geometry.isCropped[index]);
+        SSKTestAssert(geometry.rects[index].x >= 32 && geometry.rects[index].x + geometry.rects[index].width <= 64);
+        SSKTestAssert(SSKTilemapTestsRectIsEqual(geometry.textureRects[index], 0.5, 0, 0.25, 0.25));
+        repeatedArea += geometry.rects[index].width * geometry.rects[index].height;
+    }
+    
+    SSKTestAssert(fabs(repeatedArea - 32 * 32) < 1e-9);
+    
+    SSKTestAssert(geometry.tileIDs[5] == 3);
+    SSKTestAssert(geometry.isCropped[5]);
+    SSKTestAssert(fabs(geometry.rects[5].x - 64) < 1e-9);
+    SSKTestAssert(fabs(geometry.rects[5].width - 32) < 1e-9);
+    SSKTestAssert(fabs(geometry.textureRects[5].width - 0.25) < 1e-9);
+    
+    // The partial edge chunk only contains its own tile, offset to its position in the tilemap
+    SSKTestAssert(SSKTilemapComputeChunkGeometry(&geometry, &tilemap, 3, tileSize, textures, 3, &layout));
+    SSKTestAssert(geometry.count == 1);
+    SSKTestAssert(SSKTilemapTestsRectIsEqual(geometry.rects[0], 128, 128, 32, 32));
+    
+    SSKTestAssert(SSKTilemapComputeChunkGeometry(&geometry, &tilemap, 1, tileSize, textures, 3, &layout));
+    SSKTestAssert(geometry.count == 0);
+    
+    SSKTestAssert(SSKTilemapComputeChunkGeometry(&geometry, &tilemap, 4, tileSize, textures, 3, &layout));
+    SSKTestAssert(geometry.count == 0);
+    
+    SSKTilemapChunkGeometryDestroy(&geometry);
+    SSKTileLayoutDestroy(&layout);
+    SSKTilemapDestroy(&tilemap);
+}
+
+static void SSKTilemapTestsReuseLayout(void)
+{
+    SSKTilemap tilemap;
+    SSKTilemapInit(&tilemap, 8, 8, 8);
+    
+    SSKTilemapChunkGeometry geometry;
+    SSKTilemapChunkGeometryInit(&geometry);
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    const SSKTileSize tileSize = {10, 10};
+    const SSKTilemapTexture textures[2] = {
+        {{4, 4}, {0, 0, 0.25, 0.25}},
+        {{10, 10}, {0.5, 0.5, 0.5, 0.5}}
+    };
+    
+    // Alternating IDs make each tile recompute the layout, so both must produce the same pieces as runs of one ID
+    for (size_t row = 0; row < 8; row++) {
+        for (size_t column = 0; column < 8; column++) {
+            SSKTilemapFill(&tilemap, (SSKTileID)(1 + (column + row) % 2), column, row, 1, 1);
+        }
+    }
+    
+    SSKTestAssert(SSKTilemapComputeChunkGeometry(&geometry, &tilemap, 0, tileSize, textures, 2, &layout));
+    
+    // Each tile of the 4x4 texture is 3x3 pieces, and each tile of the 10x10 texture is one piece
+    SSKTestAssert(geometry.count == 32 * 9 + 32);
+    
+    double area = 0;
+    
+    for (size_t index = 0; index < geometry.count; index++) {
+        area += geometry.rects[index].width * geometry.rects[index].height;
+    }
+    
+    SSKTestAssert(fabs(area - 80 * 80) < 1e-6);
+    
+    const size_t alternatingCount = geometry.count;
+    
+    SSKTilemapFill(&tilemap, 1, 0, 0, 8, 4);
+    SSKTilemapFill(&tilemap, 2, 0, 4, 8, 4);
+    SSKTestAssert(SSKTilemapComputeChunkGeometry(&geometry, &tilemap, 0, tileSize, textures, 2, &layout));
+    SSKTestAssert(geometry.count == alternatingCount);
+    SSKTestAssert(SSKTilemapTestsRectIsEqual(geometry.rects[geometry.count - 1], 70, 70, 10, 10));
+    
+    SSKTilemapChunkGeometryDestroy(&geometry);
+    SSKTileLayoutDestroy(&layout);
+    SSKTilemapDestroy(&tilemap);
+}
+
+static void SSKTilemapTestsAppendToMesh(void)
+{
+    SSKTilemap tilemap;
+    SSKTilemapInit(&tilemap, 4, 4, 4);
+    
+    SSKTilemapChunkGeometry geometry;
+    SSKTilemapChunkGeometryInit(&geometry);
+    
+    SSKTileLayout layout;
+    SSKTileLayoutInit(&layout);
+    
+    SSKTileMesh mesh;
+    SSKTileMeshInit(&mesh);
+    
+    const SSKTileSize tileSize = {32, 32};
+    const SSKTilemapTexture texture = {{32, 32}, {0, 0, 1, 1}};
+    
+    SSKTilemapFill(&tilemap, 1, 1, 2, 2, 1);
+    SSKTilemapComputeChunkGeometry(&geometry, &tilemap, 0, tileSize, &texture, 1, &layout);
+    
+    SSKTestAssert(SSKTilemapChunkGeometryAppendToMesh(&geometry, &mesh));
+    SSKTestAssert(mesh.vertexCount == 8);
+    SSKTestAssert(mesh.indexCount == 12);
+    SSKTestAssert(mesh.vertices[0].x == 32 && mesh.vertices[0].y == 64);
+    SSKTestAssert(mesh.vertices[6].x == 96 && mesh.vertices[6].y == 96);
+    
+    SSKTileMeshDestroy(&mesh);
+    SSKTilemapChunkGeometryDestroy(&geometry);
+    SSKTileLayoutDestroy(&layout);
+    SSKTilemapDestroy(&tilemap);
+}
+
+int main(void)
+{
+    SSKTilemapTestsInit();
+    SSKTilemapTestsFill();
+    SSKTilemapTestsDirtyChunks();
+    SSKTilemapTestsChunkGeometry();
+    SSKTilemapTestsReuseLayout();
+    SSKTilemapTestsAppendToMesh();
+    
+    return SSKTestGetExitCode();
+}
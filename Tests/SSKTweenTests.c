@@ -0,0 +1,163 @@
+#include "SSKTween.h"
+#include "SSKTestSupport.h"
+
+#include <math.h>
+
+static bool SSKTweenTestsIsClose(double value, double expectedValue)
+{
+    return fabs(value - expectedValue) < 1e-9;
+}
+
+static void SSKTweenTestsEasing(void)
+{
+    const SSKTweenEasing easings[] = {SSKTweenEasingLinear, SSKTweenEasingEaseIn, SSKTweenEasingEaseOut, SSKTweenEasingEaseInEaseOut};
+    
+    for (size_t easingIndex = 0; easingIndex < 4; easingIndex++) {
+        const SSKTweenEasing easing = easings[easingIndex];
+        
+        // Every curve starts at 0, ends at 1, is clamped outside of that range, and never moves backwards
+        SSKTestAssert(SSKTweenGetEasedProgress(easing, 0) == 0);
+        SSKTestAssert(SSKTweenGetEasedProgress(easing, 1) == 1);
+        SSKTestAssert(SSKTweenGetEasedProgress(easing, -1) == 0);
+        SSKTestAssert(SSKTweenGetEasedProgress(easing, 2) == 1);
+        
+        double previousValue = 0;
+        
+        for (int step = 1; step <= 100; step++) {
+            double value = SSKTweenGetEasedProgress(easing, step / 100.0);
+            SSKTestAssert(value >= previousValue);
+            previousValue = value;
+        }
+    }
+    
+    SSKTestAssert(SSKTweenTestsIsClose(SSKTweenGetEasedProgress(SSKTweenEasingLinear, 0.25), 0.25));
+    SSKTestAssert(SSKTweenTestsIsClose(SSKTweenGetEasedProgress(SSKTweenEasingEaseIn, 0.5), 0.25));
+    SSKTestAssert(SSKTweenTestsIsClose(SSKTweenGetEasedProgress(SSKTweenEasingEaseOut, 0.5), 0.75));
+    SSKTestAssert(SSKTweenTestsIsClose(SSKTweenGetEasedProgress(SSKTweenEasingEaseInEaseOut, 0.25), 0.125));
+    SSKTestAssert(SSKTweenTestsIsClose(SSKTweenGetEasedProgress(SSKTweenEasingEaseInEaseOut, 0.5), 0.5));
+    SSKTestAssert(SSKTweenTestsIsClose(SSKTweenGetEasedProgress(SSKTweenEasingEaseInEaseOut, 0.75), 0.875));
+}
+
+static void SSKTweenTestsReachesEndValue(void)
+{
+    SSKTweenTable table;
+    SSKTweenTableInit(&table);
+    
+    // Values that can't be reached exactly by adding up fractions of their difference
+    for (size_t index = 0; index < 100; index++) {
+        SSKTestAssert(SSKTweenTableAdd(&table, 0.1 * index, 1.0 / 3, 100.7 - index, 2.0 / 3, NAN, 0.3 + 0.01 * index, (SSKTweenEasing)(index % 4)) == index);
+    }
+    
+    // Tweens that haven't started yet start at their first step
+    SSKTestAssert(SSKTweenTableStep(&table, 10) == 0);
+    
+    for (size_t index = 0; index < 100; index++) {
+        SSKTestAssert(table.startTime[index] == 10);
+        SSKTestAssert(table.valueX[index] == 0.1 * index);
+        SSKTestAssert(table.progress[index] == 0);
+    }
+    
+    SSKTestAssert(SSKTweenTableStep(&table, 10.5) > 0);
+    SSKTestAssert(SSKTweenTableStep(&table, 20) == 100);
+    
+    for (size_t index = 0; index < 100; index++) {
+        SSKTestAssert(table.valueX[index] == 100.7 - index);
+        SSKTestAssert(table.valueY[index] == 2.0 / 3);
+        SSKTestAssert(table.progress[index] == 1);
+    }
+    
+    SSKTweenTableDestroy(&table);
+}
+
+static void SSKTweenTestsZeroDuration(void)
+{
+    SSKTweenTable table;
+    SSKTweenTableInit(&table);
+    
+    SSKTweenTableAdd(&table, 1, 2, 3, 4, NAN, 0, SSKTweenEasingEaseIn);
+    SSKTweenTableAdd(&table, 1, 2, 3, 4, NAN, -5, SSKTweenEasingLinear);
+    
+    SSKTestAssert(SSKTweenTableStep(&table, 0) == 2);
+    SSKTestAssert(table.valueX[0] == 3 && table.valueY[0] == 4);
+    SSKTestAssert(table.valueX[1] == 3 && table.valueY[1] == 4);
+    
+    SSKTweenTableDestroy(&table);
+}
+
+static void SSKTweenTestsFrameRateIndependence(void)
+{
+    const double frameRates[] = {20, 30, 60, 144};
+    const double sampleTimes[] = {0.1, 0.25, 0.5, 0.75, 1};
+    double sampleValues[4][5];
+    
+    // Stepping at any frame rate gives the same value at the same point in time
+    for (size_t rateIndex = 0; rateIndex < 4; rateIndex++) {
+        SSKTweenTable table;
+        SSKTweenTableInit(&table);
+        SSKTweenTableAdd(&table, 10, 0, 110, 0, 0, 1, SSKTweenEasingEaseInEaseOut);
+        
+        size_t sampleIndex = 0;
+        size_t frameCount = (size_t)frameRates[rateIndex];
+        
+        for (size_t frame = 0; frame <= frameCount; frame++) {
+            const double time = (double)frame / frameRates[rateIndex];
+            SSKTweenTableStep(&table, time);
+            
+            // Sampling at the sample times, in between the frames too
+            while (sampleIndex < 5 && sampleTimes[sampleIndex] <= time) {
+                SSKTweenTableStep(&table, sampleTimes[sampleIndex]);
+                sampleValues[rateIndex][sampleIndex] = table.valueX[0];
+                sampleIndex++;
+                SSKTweenTableStep(&table, time);
+            }
+        }
+        
+        SSKTestAssert(sampleIndex == 5);
+        SSKTestAssert(table.valueX[0] == 110);
+        
+        SSKTweenTableDestroy(&table);
+    }
+    
+    for (size_t sampleIndex = 0; sampleIndex < 5; sampleIndex++) {
+        const double expectedValue = 10 + 100 * SSKTweenGetEasedProgress(SSKTweenEasingEaseInEaseOut, sampleTimes[sampleIndex]);
+        
+        for (size_t rateIndex = 0; rateIndex < 4; rateIndex++) {
+            SSKTestAssert(SSKTweenTestsIsClose(sampleValues[rateIndex][sampleIndex], expectedValue));
+        }
+    }
+}
+
+static void SSKTweenTestsRemove(void)
+{
+    SSKTweenTable table;
+    SSKTweenTableInit(&table);
+    
+    for (size_t index = 0; index < 5; index++) {
+        SSKTweenTableAdd(&table, (double)index, 0, 100 + (double)index, 0, 0, 1, SSKTweenEasingLinear);
+    }
+    
+    // The last tween moves into the removed tween's index
+    SSKTweenTableRemove(&table, 1);
+    SSKTestAssert(table.count == 4);
+    SSKTestAssert(table.startX[1] == 4 && table.endX[1] == 104);
+    
+    SSKTweenTableRemove(&table, 3);
+    SSKTweenTableRemove(&table, 10);
+    SSKTestAssert(table.count == 3);
+    
+    SSKTweenTableStep(&table, 0.5);
+    SSKTestAssert(table.valueX[0] == 50 && table.valueX[1] == 54 && table.valueX[2] == 52);
+    
+    SSKTweenTableDestroy(&table);
+}
+
+int main(void)
+{
+    SSKTweenTestsEasing();
+    SSKTweenTestsReachesEndValue();
+    SSKTweenTestsZeroDuration();
+    SSKTweenTestsFrameRateIndependence();
+    SSKTweenTestsRemove();
+    
+    return SSKTestGetExitCode();
+}